@@ -202,7 +202,6 @@ treat_as_music_sounds_longer_than_secs = 5,
   },
   lag_compensation = {
     confirm_controlled_character_death = true,
-	simulate_decorative_organisms_during_reconciliation = false,
 
 	effect_prediction = {
 	  predict_death_particles = true,
@@ -360,7 +359,8 @@ treat_as_music_sounds_longer_than_secs = 5,
 
   debugger = {
 	player = {
-		snapshot_interval_in_steps = 800
+		snapshot_interval_in_steps = 200,
+		keyframe_once_every_snapshots = 16
 	},
     grid = {
       render = {
@@ -751,6 +751,8 @@ treat_as_music_sounds_longer_than_secs = 5,
 	send_heartbeat_to_server_list_once_every_secs = 10,
 	resolve_server_list_address_once_every_secs = 60,
     sleep_mult = 0.1,
+	precise_tick_scheduling = true,
+	receive_packets_between_ticks = true,
     log_performance_once_every_secs = 1,
 
 	kick_if_no_network_payloads_for_secs = 10,
@@ -759,6 +761,7 @@ treat_as_music_sounds_longer_than_secs = 5,
 	time_limit_to_enter_game_since_connection = 15,
 
 	send_packets_once_every_tick = 1,
+	pace_client_sends_kbps = 0,
 	reset_resync_timer_once_every_secs = 4,
 	max_client_resyncs = 30,
 
@@ -770,9 +773,13 @@ treat_as_music_sounds_longer_than_secs = 5,
 	},
 
 	max_buffered_client_commands = 1280,
+	broadcast_only_effective_inputs = true,
 	state_hash_once_every_tick = 1,
     send_net_statistics_update_once_every_secs = 1,
 
+	max_lag_compensation_ms = 150,
+	update_lag_compensation_once_every_secs = 1,
+
     auto_authorize_loopback_for_rcon = true,
 	max_unauthorized_rcon_commands = 100,
 	max_bots = 0
@@ -788,6 +795,13 @@ treat_as_music_sounds_longer_than_secs = 5,
 
   },
 
+  arena_host = {
+	arenas = {},
+	num_workers = 0,
+	pin_workers_to_cores = true,
+	report_usage_once_every_secs = 60
+  },
+
   client = {
 	nickname = "Player",
 	rcon_password = "",
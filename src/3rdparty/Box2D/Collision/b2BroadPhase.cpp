@@ -29,6 +29,8 @@ b2BroadPhase::b2BroadPhase()
 	m_moveCapacity = 16;
 	m_moveCount = 0;
 	m_moveBuffer = (int32*)b2Alloc(m_moveCapacity * sizeof(int32));
+
+	m_staticTreeDirty = false;
 }
 
 b2BroadPhase::~b2BroadPhase()
@@ -37,9 +39,50 @@ b2BroadPhase::~b2BroadPhase()
 	b2Free(m_pairBuffer);
 }
 
-int32 b2BroadPhase::CreateProxy(const b2AABB& aabb, void* userData)
+static b2AABB b2MakeStaticFatAABB(const b2AABB& aabb)
+{
+	// Fattened just like in the dynamic tree, so that contacts with static bodies persist the same.
+	b2Vec2 r(b2_aabbExtension, b2_aabbExtension);
+
+	b2AABB fatAABB;
+	fatAABB.lowerBound = aabb.lowerBound - r;
+	fatAABB.upperBound = aabb.upperBound + r;
+	return fatAABB;
+}
+
+int32 b2BroadPhase::CreateProxy(const b2AABB& aabb, void* userData, bool isStatic)
 {
-	int32 proxyId = m_tree.CreateProxy(aabb, userData);
+	int32 proxyId;
+
+	if (isStatic)
+	{
+		b2StaticProxy proxy;
+		proxy.aabb = b2MakeStaticFatAABB(aabb);
+		proxy.userData = userData;
+
+		int32 index;
+
+		if (m_freeStaticProxies.empty())
+		{
+			index = static_cast<int32>(m_staticProxies.size());
+			b2Assert(index < e_staticProxyBase);
+			m_staticProxies.push_back(proxy);
+		}
+		else
+		{
+			index = m_freeStaticProxies.back();
+			m_freeStaticProxies.pop_back();
+			m_staticProxies[index] = proxy;
+		}
+
+		m_staticTreeDirty = true;
+		proxyId = e_staticProxyBase + index;
+	}
+	else
+	{
+		proxyId = m_tree.CreateProxy(aabb, userData);
+	}
+
 	++m_proxyCount;
 	BufferMove(proxyId);
 	return proxyId;
@@ -49,11 +92,37 @@ void b2BroadPhase::DestroyProxy(int32 proxyId)
 {
 	UnBufferMove(proxyId);
 	--m_proxyCount;
+
+	if (IsStaticProxy(proxyId))
+	{
+		int32 index = proxyId - e_staticProxyBase;
+		m_staticProxies[index].userData = NULL;
+		m_freeStaticProxies.push_back(index);
+		m_staticTreeDirty = true;
+		return;
+	}
+
 	m_tree.DestroyProxy(proxyId);
 }
 
 void b2BroadPhase::MoveProxy(int32 proxyId, const b2AABB& aabb, const b2Vec2& displacement)
 {
+	if (IsStaticProxy(proxyId))
+	{
+		// Static bodies are only ever teleported, so there is no displacement to predict.
+		b2StaticProxy& proxy = m_staticProxies[proxyId - e_staticProxyBase];
+
+		if (proxy.aabb.Contains(aabb))
+		{
+			return;
+		}
+
+		proxy.aabb = b2MakeStaticFatAABB(aabb);
+		m_staticTreeDirty = true;
+		BufferMove(proxyId);
+		return;
+	}
+
 	bool buffer = m_tree.MoveProxy(proxyId, aabb, displacement);
 	if (buffer)
 	{
@@ -119,6 +188,20 @@ bool b2BroadPhase::QueryCallback(int32 proxyId)
 }
 
 b2BroadPhase& b2BroadPhase::operator=(const b2BroadPhase& b) {
+	if (this == &b) {
+		return *this;
+	}
+
+	if (m_pairCapacity != b.m_pairCapacity) {
+		b2Free(m_pairBuffer);
+		m_pairBuffer = (b2Pair*)b2Alloc(b.m_pairCapacity * sizeof(b2Pair));
+	}
+
+	if (m_moveCapacity != b.m_moveCapacity) {
+		b2Free(m_moveBuffer);
+		m_moveBuffer = (int32*)b2Alloc(b.m_moveCapacity * sizeof(int32));
+	}
+
 	m_proxyCount = b.m_proxyCount;
 
 	m_moveCapacity = b.m_moveCapacity;
@@ -129,13 +212,68 @@ b2BroadPhase& b2BroadPhase::operator=(const b2BroadPhase& b) {
 
 	m_queryProxyId = b.m_queryProxyId;
 
-	m_pairBuffer = (b2Pair*)b2Alloc(m_pairCapacity * sizeof(b2Pair));
-	m_moveBuffer = (int32*)b2Alloc(m_moveCapacity * sizeof(int32));
-
 	memcpy(m_pairBuffer, b.m_pairBuffer, m_pairCount * sizeof(b2Pair));
 	memcpy(m_moveBuffer, b.m_moveBuffer, m_moveCount * sizeof(int32));
 
 	m_tree = b.m_tree;
 
+	m_staticProxies = b.m_staticProxies;
+	m_freeStaticProxies = b.m_freeStaticProxies;
+
+	// Shared as long as the source keeps its tree up to date, which it does between steps.
+	m_staticTree = b.m_staticTree;
+	m_staticTreeDirty = b.m_staticTreeDirty;
+
+	UpdateStaticTree();
+
 	return *this;
+}
+
+void b2BroadPhase::UpdateStaticTree()
+{
+	if (m_staticTreeDirty)
+	{
+		RebuildStaticTree();
+	}
+}
+
+void b2BroadPhase::RebuildStaticTree()
+{
+	m_staticTreeDirty = false;
+
+	thread_local std::vector<b2StaticTreeLeaf> leaves;
+	leaves.clear();
+
+	for (int32 i = 0; i < static_cast<int32>(m_staticProxies.size()); ++i)
+	{
+		const b2StaticProxy& proxy = m_staticProxies[i];
+
+		if (proxy.userData != NULL)
+		{
+			leaves.push_back({ proxy.aabb, e_staticProxyBase + i });
+		}
+	}
+
+	if (leaves.empty())
+	{
+		m_staticTree.reset();
+		return;
+	}
+
+	std::shared_ptr<b2StaticTree> tree = std::make_shared<b2StaticTree>();
+	tree->Build(leaves);
+	m_staticTree = std::move(tree);
+}
+
+void b2BroadPhase::ShiftOrigin(const b2Vec2& newOrigin)
+{
+	m_tree.ShiftOrigin(newOrigin);
+
+	for (b2StaticProxy& proxy : m_staticProxies)
+	{
+		proxy.aabb.lowerBound -= newOrigin;
+		proxy.aabb.upperBound -= newOrigin;
+	}
+
+	RebuildStaticTree();
 }
\ No newline at end of file
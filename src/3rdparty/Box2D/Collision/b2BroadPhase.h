@@ -22,7 +22,10 @@
 #include <Box2D/Common/b2Settings.h>
 #include <Box2D/Collision/b2Collision.h>
 #include <Box2D/Collision/b2DynamicTree.h>
+#include <Box2D/Collision/b2StaticTree.h>
 #include <algorithm>
+#include <memory>
+#include <vector>
 
 struct b2Pair
 {
@@ -30,24 +33,43 @@ struct b2Pair
 	int32 proxyIdB;
 };
 
+/// A proxy of a static body. Its userData is NULL once the proxy is destroyed.
+struct b2StaticProxy
+{
+	b2AABB aabb;
+	void* userData;
+};
+
 /// The broad-phase is used for computing pairs and performing volume queries and ray casts.
 /// This broad-phase does not persist pairs. Instead, this reports potentially new pairs.
 /// It is up to the client to consume the new pairs and to track subsequent overlap.
+///
+/// Proxies of static bodies are kept apart from the dynamic tree, in a b2StaticTree
+/// built anew on the first query after any of them changed.
+/// Copies of the broad-phase share the static tree until they change their static proxies,
+/// so copying a world does not copy its static geometry, which is usually most of it.
+/// Note that this makes the first query after such a change non-const in effect.
 class b2BroadPhase
 {
 public:
 
 	enum
 	{
-		e_nullProxy = -1
+		e_nullProxy = -1,
+		e_staticProxyBase = 1 << 30
 	};
 
 	b2BroadPhase();
 	~b2BroadPhase();
 
 	/// Create a proxy with an initial AABB. Pairs are not reported until
-	/// UpdatePairs is called.
-	int32 CreateProxy(const b2AABB& aabb, void* userData);
+	/// UpdatePairs is called. Static proxies never pair with each other.
+	int32 CreateProxy(const b2AABB& aabb, void* userData, bool isStatic = false);
+
+	static bool IsStaticProxy(int32 proxyId)
+	{
+		return proxyId >= e_staticProxyBase;
+	}
 
 	/// Destroy a proxy. It is up to the client to remove any pairs.
 	void DestroyProxy(int32 proxyId);
@@ -90,6 +112,13 @@ public:
 	template <typename T>
 	void RayCast(T* callback, const b2RayCastInput& input) const;
 
+	/// Get the tree of the static proxies. It must be up to date, see UpdateStaticTree.
+	/// Queries are const so that several threads may run them at once, hence they never rebuild the tree themselves.
+	const b2StaticTree& GetStaticTree() const;
+
+	/// Rebuild the tree of the static proxies if any of them was created, destroyed or moved since the last time.
+	void UpdateStaticTree();
+
 	/// Get the height of the embedded tree.
 	int32 GetTreeHeight() const;
 
@@ -109,14 +138,23 @@ private:
 
 	friend class physics_world_cache;
 	friend class b2DynamicTree;
+	friend class b2StaticTree;
 
 	void BufferMove(int32 proxyId);
 	void UnBufferMove(int32 proxyId);
 
 	bool QueryCallback(int32 proxyId);
 
+	void RebuildStaticTree();
+
 	b2DynamicTree m_tree;
 
+	std::vector<b2StaticProxy> m_staticProxies;
+	std::vector<int32> m_freeStaticProxies;
+
+	std::shared_ptr<const b2StaticTree> m_staticTree;
+	bool m_staticTreeDirty;
+
 	int32 m_proxyCount;
 
 	int32* m_moveBuffer;
@@ -148,21 +186,44 @@ inline bool b2PairLessThan(const b2Pair& pair1, const b2Pair& pair2)
 
 inline void* b2BroadPhase::GetUserData(int32 proxyId) const
 {
+	if (IsStaticProxy(proxyId))
+	{
+		return m_staticProxies[proxyId - e_staticProxyBase].userData;
+	}
+
 	return m_tree.GetUserData(proxyId);
 }
 
 inline bool b2BroadPhase::TestOverlap(int32 proxyIdA, int32 proxyIdB) const
 {
-	const b2AABB& aabbA = m_tree.GetFatAABB(proxyIdA);
-	const b2AABB& aabbB = m_tree.GetFatAABB(proxyIdB);
+	const b2AABB& aabbA = GetFatAABB(proxyIdA);
+	const b2AABB& aabbB = GetFatAABB(proxyIdB);
 	return b2TestOverlap(aabbA, aabbB);
 }
 
 inline const b2AABB& b2BroadPhase::GetFatAABB(int32 proxyId) const
 {
+	if (IsStaticProxy(proxyId))
+	{
+		return m_staticProxies[proxyId - e_staticProxyBase].aabb;
+	}
+
 	return m_tree.GetFatAABB(proxyId);
 }
 
+inline const b2StaticTree& b2BroadPhase::GetStaticTree() const
+{
+	b2Assert(m_staticTreeDirty == false);
+
+	if (m_staticTree == nullptr)
+	{
+		static const b2StaticTree empty;
+		return empty;
+	}
+
+	return *m_staticTree;
+}
+
 inline int32 b2BroadPhase::GetProxyCount() const
 {
 	return m_proxyCount;
@@ -189,6 +250,9 @@ void b2BroadPhase::UpdatePairs(T* callback)
 	// Reset pair buffer
 	m_pairCount = 0;
 
+	UpdateStaticTree();
+	const b2StaticTree& staticTree = GetStaticTree();
+
 	// Perform tree queries for all moving proxies.
 	for (int32 i = 0; i < m_moveCount; ++i)
 	{
@@ -200,10 +264,15 @@ void b2BroadPhase::UpdatePairs(T* callback)
 
 		// We have to query the tree with the fat AABB so that
 		// we don't fail to create a pair that may touch later.
-		const b2AABB& fatAABB = m_tree.GetFatAABB(m_queryProxyId);
+		const b2AABB& fatAABB = GetFatAABB(m_queryProxyId);
 
 		// Query tree, create pairs and add them pair buffer.
 		m_tree.Query(this, fatAABB);
+
+		if (IsStaticProxy(m_queryProxyId) == false)
+		{
+			staticTree.Query(this, fatAABB);
+		}
 	}
 
 	// Reset move buffer
@@ -217,8 +286,8 @@ void b2BroadPhase::UpdatePairs(T* callback)
 	while (i < m_pairCount)
 	{
 		b2Pair* primaryPair = m_pairBuffer + i;
-		void* userDataA = m_tree.GetUserData(primaryPair->proxyIdA);
-		void* userDataB = m_tree.GetUserData(primaryPair->proxyIdB);
+		void* userDataA = GetUserData(primaryPair->proxyIdA);
+		void* userDataB = GetUserData(primaryPair->proxyIdB);
 
 		callback->AddPair(userDataA, userDataB);
 		++i;
@@ -239,21 +308,33 @@ void b2BroadPhase::UpdatePairs(T* callback)
 	//m_tree.Rebalance(4);
 }
 
+// The static proxies go first: these are mostly walls, and a ray clipped by a wall skips more of the dynamic tree.
+
 template <typename T>
 inline void b2BroadPhase::Query(T* callback, const b2AABB& aabb) const
 {
+	if (GetStaticTree().Query(callback, aabb) == false)
+	{
+		return;
+	}
+
 	m_tree.Query(callback, aabb);
 }
 
 template <typename T>
 inline void b2BroadPhase::RayCast(T* callback, const b2RayCastInput& input) const
 {
-	m_tree.RayCast(callback, input);
-}
+	float32 maxFraction = GetStaticTree().RayCast(callback, input);
 
-inline void b2BroadPhase::ShiftOrigin(const b2Vec2& newOrigin)
-{
-	m_tree.ShiftOrigin(newOrigin);
+	if (maxFraction == 0.0f)
+	{
+		return;
+	}
+
+	b2RayCastInput dynamicInput = input;
+	dynamicInput.maxFraction = maxFraction;
+
+	m_tree.RayCast(callback, dynamicInput);
 }
 
 #endif
@@ -794,7 +794,10 @@ void b2DynamicTree::ShiftOrigin(const b2Vec2& newOrigin)
 
 b2DynamicTree& b2DynamicTree::operator=(const b2DynamicTree& b) 
 {
-	this->~b2DynamicTree();
+	if (this == &b)
+	{
+		return *this;
+	}
 
 	const auto bytes = b.m_nodeCapacity * sizeof(b2TreeNode);
 #if DEBUG_PHYSICS_WORLD_CACHE_COPY
@@ -805,7 +808,14 @@ b2DynamicTree& b2DynamicTree::operator=(const b2DynamicTree& b)
 #endif
 #endif
 
-	m_nodes = (b2TreeNode*)b2Alloc(static_cast<int32>(bytes));
+	/* Trees assigned over and over again usually keep their capacity, so keep the node buffer too. */
+
+	if (m_nodes == nullptr || m_nodeCapacity != b.m_nodeCapacity)
+	{
+		b2Free(m_nodes);
+		m_nodes = (b2TreeNode*)b2Alloc(static_cast<int32>(bytes));
+	}
+
 	memcpy(m_nodes, b.m_nodes, bytes);
 
 	m_root = b.m_root;
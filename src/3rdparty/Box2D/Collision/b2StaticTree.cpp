@@ -0,0 +1,128 @@
+/*
+* Copyright (c) 2009 Erin Catto http://www.box2d.org
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include <Box2D/Collision/b2StaticTree.h>
+#include <algorithm>
+
+void b2StaticTree::Build(std::vector<b2StaticTreeLeaf>& leaves)
+{
+	m_nodes.clear();
+
+	if (leaves.empty())
+	{
+		return;
+	}
+
+	m_nodes.reserve(2 * leaves.size() - 1);
+	BuildRecursive(leaves.data(), static_cast<int32>(leaves.size()));
+}
+
+int32 b2StaticTree::BuildRecursive(b2StaticTreeLeaf* leaves, int32 count)
+{
+	const int32 nodeId = static_cast<int32>(m_nodes.size());
+	m_nodes.emplace_back();
+
+	if (count == 1)
+	{
+		b2StaticTreeNode& leaf = m_nodes[nodeId];
+		leaf.aabb = leaves[0].aabb;
+		leaf.proxyId = leaves[0].proxyId;
+		leaf.child2 = b2_nullNode;
+		return nodeId;
+	}
+
+	b2AABB centers;
+	centers.lowerBound = centers.upperBound = leaves[0].aabb.GetCenter();
+
+	for (int32 i = 1; i < count; ++i)
+	{
+		const b2Vec2 c = leaves[i].aabb.GetCenter();
+		centers.lowerBound = b2Min(centers.lowerBound, c);
+		centers.upperBound = b2Max(centers.upperBound, c);
+	}
+
+	const b2Vec2 spread = centers.upperBound - centers.lowerBound;
+	const bool alongX = spread.x >= spread.y;
+
+	const int32 half = count / 2;
+
+	// The proxy id breaks ties, so the order is total and both halves are the same sets of leaves
+	// no matter how a standard library implements nth_element.
+	std::nth_element(leaves, leaves + half, leaves + count, [alongX](const b2StaticTreeLeaf& a, const b2StaticTreeLeaf& b)
+	{
+		const b2Vec2 ca = a.aabb.GetCenter();
+		const b2Vec2 cb = b.aabb.GetCenter();
+
+		const float32 ka = alongX ? ca.x : ca.y;
+		const float32 kb = alongX ? cb.x : cb.y;
+
+		if (ka != kb)
+		{
+			return ka < kb;
+		}
+
+		return a.proxyId < b.proxyId;
+	});
+
+	const int32 child1 = BuildRecursive(leaves, half);
+	const int32 child2 = BuildRecursive(leaves + half, count - half);
+
+	b2StaticTreeNode& node = m_nodes[nodeId];
+	node.aabb.Combine(m_nodes[child1].aabb, m_nodes[child2].aabb);
+	node.proxyId = b2_nullNode;
+	node.child2 = child2;
+
+	return nodeId;
+}
+
+int32 b2StaticTree::GetHeight() const
+{
+	if (m_nodes.empty())
+	{
+		return 0;
+	}
+
+	struct Entry
+	{
+		int32 nodeId;
+		int32 depth;
+	};
+
+	b2GrowableStack<Entry, 256> stack;
+	stack.Push({ 0, 0 });
+
+	int32 height = 0;
+
+	while (stack.GetCount() > 0)
+	{
+		const Entry entry = stack.Pop();
+		const b2StaticTreeNode& node = m_nodes[entry.nodeId];
+
+		if (node.IsLeaf())
+		{
+			height = b2Max(height, entry.depth);
+		}
+		else
+		{
+			stack.Push({ entry.nodeId + 1, entry.depth + 1 });
+			stack.Push({ node.child2, entry.depth + 1 });
+		}
+	}
+
+	return height;
+}
@@ -0,0 +1,224 @@
+/*
+* Copyright (c) 2009 Erin Catto http://www.box2d.org
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef B2_STATIC_TREE_H
+#define B2_STATIC_TREE_H
+
+#include <Box2D/Collision/b2Collision.h>
+#include <Box2D/Collision/b2DynamicTree.h>
+#include <Box2D/Common/b2GrowableStack.h>
+#include <vector>
+
+/// A proxy to be put into a static tree.
+struct b2StaticTreeLeaf
+{
+	b2AABB aabb;
+	int32 proxyId;
+};
+
+/// A node in the static tree. The client does not interact with this directly.
+struct b2StaticTreeNode
+{
+	bool IsLeaf() const
+	{
+		return proxyId != b2_nullNode;
+	}
+
+	b2AABB aabb;
+
+	/// The proxy of a leaf, b2_nullNode for an internal node.
+	int32 proxyId;
+
+	/// The first child of an internal node always directly follows it, this is the second one.
+	int32 child2;
+};
+
+/// An immutable bounding volume hierarchy over proxies that do not move.
+/// Unlike b2DynamicTree, it is built in one go from all the proxies at once:
+/// every node is split in half along the longer axis of its proxies' centers.
+/// The nodes are packed in depth-first order, so a traversal mostly walks forward in memory.
+///
+/// The build depends on nothing but the order and the AABBs of the leaves,
+/// so the same proxies always yield the very same tree.
+class b2StaticTree
+{
+public:
+	/// Build the tree anew. The leaves are reordered.
+	void Build(std::vector<b2StaticTreeLeaf>& leaves);
+
+	/// Query an AABB for overlapping proxies. The callback class
+	/// is called for each proxy that overlaps the supplied AABB.
+	/// @return false if the callback has terminated the query.
+	template <typename T>
+	bool Query(T* callback, const b2AABB& aabb) const;
+
+	/// Ray-cast against the proxies in the tree, just like b2DynamicTree::RayCast.
+	/// The children are visited first to second.
+	/// @return the fraction the ray was clipped to, or 0 if the callback has terminated the ray cast.
+	template <typename T>
+	float32 RayCast(T* callback, const b2RayCastInput& input) const;
+
+	/// The root node, or b2_nullNode if the tree is empty.
+	int32 GetRoot() const
+	{
+		return m_nodes.empty() ? b2_nullNode : 0;
+	}
+
+	const b2StaticTreeNode& GetNode(int32 nodeId) const
+	{
+		b2Assert(0 <= nodeId && nodeId < GetNodeCount());
+		return m_nodes[nodeId];
+	}
+
+	int32 GetNodeCount() const
+	{
+		return static_cast<int32>(m_nodes.size());
+	}
+
+	/// Compute the height of the tree in O(N) time.
+	int32 GetHeight() const;
+
+private:
+	int32 BuildRecursive(b2StaticTreeLeaf* leaves, int32 count);
+
+	std::vector<b2StaticTreeNode> m_nodes;
+};
+
+template <typename T>
+inline bool b2StaticTree::Query(T* callback, const b2AABB& aabb) const
+{
+	if (m_nodes.empty())
+	{
+		return true;
+	}
+
+	b2GrowableStack<int32, 256> stack;
+	stack.Push(0);
+
+	while (stack.GetCount() > 0)
+	{
+		int32 nodeId = stack.Pop();
+		const b2StaticTreeNode* node = m_nodes.data() + nodeId;
+
+		if (b2TestOverlap(node->aabb, aabb))
+		{
+			if (node->IsLeaf())
+			{
+				bool proceed = callback->QueryCallback(node->proxyId);
+				if (proceed == false)
+				{
+					return false;
+				}
+			}
+			else
+			{
+				stack.Push(node->child2);
+				stack.Push(nodeId + 1);
+			}
+		}
+	}
+
+	return true;
+}
+
+template <typename T>
+inline float32 b2StaticTree::RayCast(T* callback, const b2RayCastInput& input) const
+{
+	float32 maxFraction = input.maxFraction;
+
+	if (m_nodes.empty())
+	{
+		return maxFraction;
+	}
+
+	b2Vec2 p1 = input.p1;
+	b2Vec2 p2 = input.p2;
+	b2Vec2 r = p2 - p1;
+	b2Assert(r.LengthSquared() > 0.0f);
+	r.Normalize();
+
+	// v is perpendicular to the segment.
+	b2Vec2 v = b2Cross(1.0f, r);
+	b2Vec2 abs_v = b2Abs(v);
+
+	// Build a bounding box for the segment.
+	b2AABB segmentAABB;
+	{
+		b2Vec2 t = p1 + maxFraction * (p2 - p1);
+		segmentAABB.lowerBound = b2Min(p1, t);
+		segmentAABB.upperBound = b2Max(p1, t);
+	}
+
+	b2GrowableStack<int32, 256> stack;
+	stack.Push(0);
+
+	while (stack.GetCount() > 0)
+	{
+		int32 nodeId = stack.Pop();
+		const b2StaticTreeNode* node = m_nodes.data() + nodeId;
+
+		if (b2TestOverlap(node->aabb, segmentAABB) == false)
+		{
+			continue;
+		}
+
+		// Separating axis for segment (Gino, p80).
+		// |dot(v, p1 - c)| > dot(|v|, h)
+		b2Vec2 c = node->aabb.GetCenter();
+		b2Vec2 h = node->aabb.GetExtents();
+		float32 separation = b2Abs(b2Dot(v, p1 - c)) - b2Dot(abs_v, h);
+		if (separation > 0.0f)
+		{
+			continue;
+		}
+
+		if (node->IsLeaf())
+		{
+			b2RayCastInput subInput;
+			subInput.p1 = input.p1;
+			subInput.p2 = input.p2;
+			subInput.maxFraction = maxFraction;
+
+			float32 value = callback->RayCastCallback(subInput, node->proxyId);
+
+			if (value == 0.0f)
+			{
+				// The client has terminated the ray cast.
+				return 0.0f;
+			}
+
+			if (value > 0.0f)
+			{
+				// Update segment bounding box.
+				maxFraction = value;
+				b2Vec2 t = p1 + maxFraction * (p2 - p1);
+				segmentAABB.lowerBound = b2Min(p1, t);
+				segmentAABB.upperBound = b2Max(p1, t);
+			}
+		}
+		else
+		{
+			stack.Push(node->child2);
+			stack.Push(nodeId + 1);
+		}
+	}
+
+	return maxFraction;
+}
+
+#endif
@@ -229,3 +229,31 @@ void b2BlockAllocator::Clear()
 
 	memset(m_freeLists, 0, sizeof(m_freeLists));
 }
+
+void b2BlockAllocator::FreeAllBlocks()
+{
+	memset(m_freeLists, 0, sizeof(m_freeLists));
+
+#if DEBUG_PHYSICS_WORLD_CACHE_COPY
+	m_numAllocatedObjects = 0;
+#endif
+
+	for (int32 i = 0; i < m_chunkCount; ++i)
+	{
+		b2Chunk* chunk = m_chunks + i;
+
+		const int32 blockSize = chunk->blockSize;
+		const int32 index = s_blockSizeLookup[blockSize];
+		const int32 blockCount = b2_chunkSize / blockSize;
+
+		for (int32 j = 0; j < blockCount - 1; ++j)
+		{
+			b2Block* block = (b2Block*)((int8*)chunk->blocks + blockSize * j);
+			block->next = (b2Block*)((int8*)chunk->blocks + blockSize * (j + 1));
+		}
+
+		b2Block* last = (b2Block*)((int8*)chunk->blocks + blockSize * (blockCount - 1));
+		last->next = m_freeLists[index];
+		m_freeLists[index] = chunk->blocks;
+	}
+}
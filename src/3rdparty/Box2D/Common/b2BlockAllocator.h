@@ -47,6 +47,11 @@ public:
 
 	void Clear();
 
+	/// Return every block to the free lists while keeping the chunks,
+	/// so that refilling the allocator does not go to the system allocator again.
+	/// Allocations larger than b2_maxBlockSize are not tracked and must be freed beforehand.
+	void FreeAllBlocks();
+
 	b2BlockAllocator& operator=(const b2BlockAllocator&) {
 		return *this;
 	}
@@ -23,9 +23,16 @@
 
 b2Version b2_version = {2, 3, 0};
 
+#if B2_COUNT_ALLOCATIONS
+static thread_local unsigned long long b2_numAllocations = 0;
+#endif
+
 // Memory allocators. Modify these to use your own allocator.
 void* b2Alloc(int32 size)
 {
+#if B2_COUNT_ALLOCATIONS
+	++b2_numAllocations;
+#endif
 	return malloc(size);
 }
 
@@ -34,6 +41,15 @@ void b2Free(void* mem)
 	free(mem);
 }
 
+unsigned long long b2GetNumAllocations()
+{
+#if B2_COUNT_ALLOCATIONS
+	return b2_numAllocations;
+#else
+	return 0;
+#endif
+}
+
 // You can modify this to use your logging facility.
 void b2Log(const char* string, ...)
 {
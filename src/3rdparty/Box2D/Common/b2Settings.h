@@ -133,6 +133,10 @@ void* b2Alloc(int32 size);
 /// If you implement b2Alloc, you should also implement this function.
 void b2Free(void* mem);
 
+/// Number of b2Alloc calls made by the calling thread so far, for profiling.
+/// Always zero unless built with B2_COUNT_ALLOCATIONS, so that b2Alloc stays a bare malloc.
+unsigned long long b2GetNumAllocations();
+
 /// Logging function.
 void b2Log(const char* string, ...);
 
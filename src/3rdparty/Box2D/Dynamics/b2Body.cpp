@@ -115,6 +115,8 @@ void b2Body::SetType(b2BodyType type)
 		return;
 	}
 
+	bool wasStatic = m_type == b2_staticBody;
+
 	m_type = type;
 
 	ResetMassData();
@@ -140,8 +142,19 @@ void b2Body::SetType(b2BodyType type)
 	}
 	m_contactList = NULL;
 
-	// Touch the proxies so that new contacts will be created (when appropriate)
 	b2BroadPhase* broadPhase = &m_world->m_contactManager.m_broadPhase;
+
+	// Static proxies are kept apart from the others, so they have to be created anew.
+	if (wasStatic != (m_type == b2_staticBody) && (m_flags & e_activeFlag))
+	{
+		for (b2Fixture* f = m_fixtureList; f; f = f->m_next)
+		{
+			f->DestroyProxies(broadPhase);
+			f->CreateProxies(broadPhase, m_xf);
+		}
+	}
+
+	// Touch the proxies so that new contacts will be created (when appropriate)
 	for (b2Fixture* f = m_fixtureList; f; f = f->m_next)
 	{
 		int32 proxyCount = f->m_proxyCount;
@@ -83,6 +83,37 @@ b2World::~b2World()
 	}
 }
 
+void b2World::ClearKeepingMemory()
+{
+	// Some shapes allocate using b2Alloc.
+	b2Body* b = m_bodyList;
+	while (b)
+	{
+		b2Body* bNext = b->m_next;
+
+		b2Fixture* f = b->m_fixtureList;
+		while (f)
+		{
+			b2Fixture* fNext = f->m_next;
+			f->m_proxyCount = 0;
+			f->Destroy(&m_blockAllocator);
+			f = fNext;
+		}
+
+		b = bNext;
+	}
+
+	m_blockAllocator.FreeAllBlocks();
+
+	m_bodyList = NULL;
+	m_jointList = NULL;
+	m_contactManager.m_contactList = NULL;
+
+	m_bodyCount = 0;
+	m_jointCount = 0;
+	m_contactManager.m_contactCount = 0;
+}
+
 void b2World::SetContactFilter(b2ContactFilter* filter)
 {
 	m_contactManager.m_contactFilter = filter;
@@ -945,11 +976,19 @@ void b2World::Step(float32 dt, int32 velocityIterations, int32 positionIteration
 		ClearForces();
 	}
 
+	// So that the queries between steps, possibly run from many threads, never have to build it.
+	UpdateStaticTree();
+
 	m_flags &= ~e_locked;
 
 	m_profile.step = stepTimer.GetMilliseconds();
 }
 
+void b2World::UpdateStaticTree()
+{
+	m_contactManager.m_broadPhase.UpdateStaticTree();
+}
+
 void b2World::ClearForces()
 {
 }
@@ -48,6 +48,16 @@ public:
 	/// Destruct the world. All physics entities are destroyed and all heap memory is released.
 	~b2World();
 
+	/// Destroy all physics entities but keep the blocks of the allocator,
+	/// so that a world assigned right after does not have to allocate them again.
+	/// The world is left in an unusable state until it is assigned to.
+	void ClearKeepingMemory();
+
+	/// Rebuild the tree of the static geometry if any static fixture changed.
+	/// Step does it at its end. Call it after creating, destroying or moving static bodies outside of a step,
+	/// before any query is run.
+	void UpdateStaticTree();
+
 	/// Register a destruction listener. The listener is owned by you and must
 	/// remain in scope.
 
@@ -4,6 +4,7 @@
 #include "application/arena/mode_and_rules.h"
 
 #include "application/arena/arena_utils.h"
+#include "game/modes/round_template.h"
 #include "test_scenes/test_scene_settings.h"
 #include "view/game_drawing_settings.h"
 
@@ -30,7 +31,7 @@ class basic_arena_handle {
 				ensure(vars != nullptr);
 
 				if constexpr(M::needs_initial_signi) {
-					const auto in = I { *vars, self.initial_signi, self.advanced_cosm };
+					const auto in = I { *vars, self.initial_signi, self.advanced_cosm, self.initial_round };
 
 					return callback(typed_mode, in);
 				}
@@ -66,6 +67,15 @@ public:
 	maybe_const_ref_t<C, predefined_rulesets> rulesets;
 	const cosmos_solvable_significant& initial_signi;
 
+	/* Null where the initial state may change under the mode's feet, e.g. in the debugger. */
+	maybe_const_ptr_t<C, round_template> initial_round = nullptr;
+
+	void invalidate_initial_round() const {
+		if (initial_round != nullptr) {
+			initial_round->invalidate();
+		}
+	}
+
 	template <class T>
 	void transfer_all_solvables(T& from) {
 		advanced_cosm.assign_solvable(from.advanced_cosm);
@@ -144,6 +154,7 @@ public:
 		);
 
 		target_initial_signi = advanced_cosm.get_solvable().significant;
+		invalidate_initial_round();
 	}
 
 	template <class S>
@@ -189,6 +200,7 @@ public:
 		rulesets.meta.playtest_default = id;
 
 		target_initial_signi = advanced_cosm.get_solvable().significant;
+		invalidate_initial_round();
 	}
 
 	template <class... Args>
@@ -40,6 +40,7 @@
 #include "application/setups/editor/editor_settings.h"
 #include "application/setups/server/server_start_input.h"
 #include "application/setups/server/server_vars.h"
+#include "application/setups/server/arena_host_vars.h"
 #include "application/setups/client/client_start_input.h"
 #include "application/setups/client/client_vars.h"
 #include "application/setups/client/lag_compensation_settings.h"
@@ -156,6 +157,7 @@ struct config_lua_table {
 	server_solvable_vars server_solvable;
 	private_server_vars private_server;
 	augs::dedicated_server_input dedicated_server;
+	arena_host_vars arena_host;
 
 	client_start_input default_client_start;
 	client_vars client;
@@ -557,18 +557,6 @@ void settings_gui_state::perform(
 					revertable_enum_radio(SCOPE_CFG_NVP(wall_light_drawing_precision));
 				}
 
-				ImGui::Separator();
-
-				text_color("Decorations", yellow);
-
-				ImGui::Separator();
-
-				auto& scope_cfg = config.lag_compensation;
-
-				{
-					revertable_checkbox(SCOPE_CFG_NVP(simulate_decorative_organisms_during_reconciliation));
-				}
-
 				break;
 			}
 			case settings_pane::AUDIO: {
@@ -1341,7 +1329,8 @@ void settings_gui_state::perform(
 				if (auto node = scoped_tree_node("Player")) {
 					auto& scope_cfg = config.debugger.player;
 
-					revertable_slider(SCOPE_CFG_NVP(snapshot_interval_in_steps), 400u, 5000u);
+					revertable_slider(SCOPE_CFG_NVP(snapshot_interval_in_steps), 50u, 5000u);
+					revertable_slider(SCOPE_CFG_NVP(keyframe_once_every_snapshots), 1u, 64u);
 				}
 
 				if (auto node = scoped_tree_node("Debug")) {
@@ -1710,7 +1699,16 @@ void do_server_vars(
 
 	ImGui::Separator();
 
-	revertable_slider(SCOPE_CFG_NVP(sleep_mult), 0.0f, 0.9f);
+	revertable_checkbox(SCOPE_CFG_NVP(precise_tick_scheduling));
+
+	if (!scope_cfg.precise_tick_scheduling) {
+		revertable_slider(SCOPE_CFG_NVP(sleep_mult), 0.0f, 0.9f);
+	}
+	else {
+		revertable_checkbox(SCOPE_CFG_NVP(receive_packets_between_ticks));
+	}
+
+	revertable_slider(SCOPE_CFG_NVP(pace_client_sends_kbps), 0u, 10000u);
 }
 
 #undef CONFIG_NVP
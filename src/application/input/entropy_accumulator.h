@@ -83,7 +83,7 @@ struct entropy_accumulator {
 				}
 			}
 
-			concatenate(player.intents, new_intents);
+			player.append_intents(new_intents);
 
 			player += cosmic;
 		}
@@ -0,0 +1,543 @@
+#include <deque>
+#include <memory>
+#include <vector>
+#include <limits>
+#include <optional>
+#include <algorithm>
+
+#include "augs/log.h"
+#include "augs/misc/randomization.h"
+#include "augs/misc/latency_histogram.h"
+#include "augs/misc/timing/tick_scheduler.h"
+
+#include "application/network/client_adapter.hpp"
+#include "application/network/network_messages.h"
+#include "application/network/net_message_translation.h"
+#include "application/network/motion_delta_coder.h"
+#include "application/network/resolve_address_result.h"
+#include "application/setups/client/demo_step.h"
+#include "application/setups/client/demo_container.h"
+#include "application/network/client_swarm.h"
+
+using swarm_clock = augs::tick_scheduler::clock;
+
+static uint64_t to_ns(const swarm_clock::duration d) {
+	return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(d).count());
+}
+
+static double to_ms(const uint64_t ns) {
+	return ns / 1e6;
+}
+
+enum class swarm_client_state {
+	CONNECTING,
+	PENDING_INITIAL_STATE,
+	PENDING_FIRST_STEP,
+	IN_GAME,
+	GONE
+};
+
+struct swarm_client {
+	unsigned index = 0;
+	std::unique_ptr<client_adapter> adapter;
+
+	swarm_client_state state = swarm_client_state::CONNECTING;
+	bool faction_chosen = false;
+
+	motion_delta_coder outgoing_motions;
+	randomization rng;
+
+	/* Send times of the entropies that the server has not yet reported as accepted. */
+	std::deque<swarm_clock::time_point> unaccepted;
+	std::optional<swarm_clock::time_point> when_last_step_arrived;
+
+	std::vector<game_intent_type> held;
+	unsigned ticks_until_change = 0;
+	basic_vec2<short> aim_drift;
+
+	std::size_t demo_step = 0;
+};
+
+struct swarm_stats {
+	augs::latency_histogram step_intervals;
+	augs::latency_histogram command_latencies;
+
+	std::size_t steps_received = 0;
+	std::size_t entropies_sent = 0;
+	std::size_t failed_to_connect = 0;
+	std::size_t dropped = 0;
+	std::size_t kicked = 0;
+
+	void clear_window() {
+		step_intervals.clear();
+		command_latencies.clear();
+		steps_received = 0;
+		entropies_sent = 0;
+	}
+};
+
+struct swarm_message_handler {
+	swarm_client& client;
+	swarm_stats& stats;
+	swarm_clock::time_point now;
+
+	void accept_entropies(const prestep_client_context& context) {
+		const auto n = std::min(static_cast<std::size_t>(context.num_entropies_accepted), client.unaccepted.size());
+
+		for (std::size_t i = 0; i < n; ++i) {
+			stats.command_latencies.record(to_ns(now - client.unaccepted.front()));
+			client.unaccepted.pop_front();
+		}
+	}
+
+	void step_arrived() {
+		if (client.when_last_step_arrived) {
+			stats.step_intervals.record(to_ns(now - *client.when_last_step_arrived));
+		}
+
+		client.when_last_step_arrived = now;
+		++stats.steps_received;
+	}
+
+	template <class T, class F>
+	message_handler_result handle_server_payload(F&& read_payload) {
+		constexpr auto abort_v = message_handler_result::ABORT_AND_DISCONNECT;
+		constexpr auto continue_v = message_handler_result::CONTINUE;
+
+		/*
+			Only what the swarm needs is ever deserialized.
+			Everything else - most importantly the initial state - is dropped as it came.
+		*/
+
+		if constexpr (std::is_same_v<T, initial_arena_state_payload<false>>) {
+			if (client.state == swarm_client_state::PENDING_INITIAL_STATE) {
+				client.state = swarm_client_state::PENDING_FIRST_STEP;
+
+				/* Like a client without an avatar file, let the server know there won't be any. */
+
+				arena_player_avatar_payload no_avatar;
+
+				client.adapter->send_payload(
+					game_channel_type::COMMUNICATIONS,
+
+					session_id_type::dead(),
+					no_avatar
+				);
+			}
+		}
+		else if constexpr (std::is_same_v<T, server_broadcasted_chat>) {
+			T payload;
+
+			if (!read_payload(payload)) {
+				return abort_v;
+			}
+
+			if (payload.recipient_shall_kindly_leave) {
+				LOG("Swarm client %x was kicked: %x", client.index, std::string(payload.message));
+
+				++stats.kicked;
+				client.state = swarm_client_state::GONE;
+
+				return abort_v;
+			}
+		}
+#if CONTEXTS_SEPARATE
+		else if constexpr (std::is_same_v<T, prestep_client_context>) {
+			T payload;
+
+			if (!read_payload(payload)) {
+				return abort_v;
+			}
+
+			accept_entropies(payload);
+		}
+#endif
+		else if constexpr (std::is_same_v<T, networked_server_step_entropy>) {
+			const bool joined = 
+				client.state == swarm_client_state::PENDING_FIRST_STEP
+				|| client.state == swarm_client_state::IN_GAME
+			;
+
+			if (!joined) {
+				return continue_v;
+			}
+
+			T payload;
+
+			if (!read_payload(payload)) {
+				return abort_v;
+			}
+
+			if (client.state == swarm_client_state::PENDING_FIRST_STEP) {
+				client.state = swarm_client_state::IN_GAME;
+			}
+
+#if !CONTEXTS_SEPARATE
+			accept_entropies(payload.context);
+#endif
+			step_arrived();
+		}
+		else if constexpr (std::is_same_v<T, server_solvable_vars>) {
+			if (client.state == swarm_client_state::CONNECTING) {
+				client.state = swarm_client_state::PENDING_INITIAL_STATE;
+			}
+		}
+
+		return continue_v;
+	}
+
+	template <class M>
+	void demo_record_server_message(M&) {}
+
+	void log_malicious_server() {
+		LOG("Swarm client %x has received an unexpected message.", client.index);
+	}
+
+	void disconnect() {
+		client.adapter->disconnect();
+	}
+};
+
+/*
+	Holds a few directions at once and changes them every quarter of a second to two seconds,
+	sometimes sprinting or shooting, while the crosshair drifts around like a hand on a mouse.
+*/
+
+static void script_entropy(swarm_client& c, const unsigned tickrate, total_client_entropy& out) {
+	auto& rng = c.rng;
+	auto& intents = out.cosmic.intents;
+
+	if (c.ticks_until_change == 0) {
+		for (const auto i : c.held) {
+			intents.push_back({ i, intent_change::RELEASED });
+		}
+
+		c.held.clear();
+
+		const game_intent_type directions[] = {
+			game_intent_type::MOVE_FORWARD,
+			game_intent_type::MOVE_BACKWARD,
+			game_intent_type::MOVE_LEFT,
+			game_intent_type::MOVE_RIGHT
+		};
+
+		const auto first = rng.randval(0, 3);
+		c.held.push_back(directions[first]);
+
+		if (rng.randval(0, 1) == 0) {
+			/* Diagonally - never the opposite of the first direction. */
+			c.held.push_back(directions[(first < 2 ? 2 : 0) + rng.randval(0, 1)]);
+		}
+
+		if (rng.randval(0, 3) == 0) {
+			c.held.push_back(game_intent_type::SPRINT);
+		}
+
+		if (rng.randval(0, 2) == 0) {
+			c.held.push_back(game_intent_type::SHOOT);
+		}
+
+		for (const auto i : c.held) {
+			intents.push_back({ i, intent_change::PRESSED });
+		}
+
+		c.ticks_until_change = static_cast<unsigned>(rng.randval(static_cast<int>(std::max(tickrate / 4, 1u)), static_cast<int>(tickrate * 2)));
+	}
+
+	--c.ticks_until_change;
+
+	auto drift = [&](const short v) {
+		return static_cast<short>(std::clamp(v + rng.randval(-2, 2), -12, 12));
+	};
+
+	c.aim_drift.x = drift(c.aim_drift.x);
+	c.aim_drift.y = drift(c.aim_drift.y);
+
+	out.cosmic.motions[game_motion_type::MOVE_CROSSHAIR] = c.aim_drift;
+}
+
+/*
+	Only the intents and motions of the recorded player are replayed.
+	Item transfers, wielding and purchases refer to entities and state of the recorded match,
+	so they would mean nothing to the server the swarm plays on.
+*/
+
+static void replay_entropy(swarm_client& c, demo_container& demo, total_client_entropy& out) {
+	if (demo.size() == 0) {
+		return;
+	}
+
+	const auto& step = demo.get_step(static_cast<demo_step_num_type>(c.demo_step));
+	c.demo_step = (c.demo_step + 1) % demo.size();
+
+	if (step.local_entropy == std::nullopt) {
+		return;
+	}
+
+	const auto& players = step.local_entropy->cosmic.players;
+
+	if (players.empty()) {
+		return;
+	}
+
+	const auto& recorded = players.begin()->second.commands;
+
+	out.cosmic.append_intents(recorded.intents);
+	out.cosmic.motions = recorded.motions;
+}
+
+static void log_swarm_report(
+	const std::vector<swarm_client>& clients,
+	const swarm_stats& stats,
+	const double window_secs
+) {
+	std::size_t num_connecting = 0;
+	std::size_t num_joining = 0;
+	std::size_t num_in_game = 0;
+
+	augs::latency_histogram rtts;
+
+	float min_sent = std::numeric_limits<float>::max();
+	float max_sent = 0.f;
+	float total_sent = 0.f;
+
+	float min_received = std::numeric_limits<float>::max();
+	float max_received = 0.f;
+	float total_received = 0.f;
+
+	for (const auto& c : clients) {
+		switch (c.state) {
+			case swarm_client_state::CONNECTING: ++num_connecting; break;
+			case swarm_client_state::PENDING_INITIAL_STATE: ++num_joining; break;
+			case swarm_client_state::PENDING_FIRST_STEP: ++num_joining; break;
+			case swarm_client_state::IN_GAME: ++num_in_game; break;
+			default: break;
+		}
+
+		if (c.state != swarm_client_state::IN_GAME) {
+			continue;
+		}
+
+		const auto info = c.adapter->get_network_info();
+
+		rtts.record(static_cast<uint64_t>(std::max(info.rtt_ms, 0.f) * 1e6));
+
+		min_sent = std::min(min_sent, info.sent_kbps);
+		max_sent = std::max(max_sent, info.sent_kbps);
+		total_sent += info.sent_kbps;
+
+		min_received = std::min(min_received, info.received_kbps);
+		max_received = std::max(max_received, info.received_kbps);
+		total_received += info.received_kbps;
+	}
+
+	LOG(
+		"Swarm: %x in game, %x joining, %x connecting, %x failed to connect, %x dropped, %x kicked.",
+		num_in_game,
+		num_joining,
+		num_connecting,
+		stats.failed_to_connect,
+		stats.dropped,
+		stats.kicked
+	);
+
+	if (num_in_game == 0) {
+		return;
+	}
+
+	auto log_percentiles = [](const auto& label, const augs::latency_histogram& h) {
+		LOG(
+			"%x: p50 %3f ms, p99 %3f ms, p999 %3f ms, max %3f ms (%x samples)",
+			label,
+			to_ms(h.percentile(0.5)),
+			to_ms(h.percentile(0.99)),
+			to_ms(h.percentile(0.999)),
+			to_ms(h.get_max()),
+			h.get_count()
+		);
+	};
+
+	LOG(
+		"Server steps per client per second: %2f. Entropies sent per second: %2f.",
+		stats.steps_received / window_secs / num_in_game,
+		stats.entropies_sent / window_secs
+	);
+
+	log_percentiles("Server step interval", stats.step_intervals);
+	log_percentiles("Entropy accepted after", stats.command_latencies);
+	log_percentiles("RTT", rtts);
+
+	LOG(
+		"Per client kbps sent: min %2f avg %2f max %2f. Received: min %2f avg %2f max %2f.",
+		min_sent,
+		total_sent / num_in_game,
+		max_sent,
+		min_received,
+		total_received / num_in_game,
+		max_received
+	);
+}
+
+void run_client_swarm(const client_swarm_settings& settings) {
+	const auto tickrate = std::max(settings.tickrate, 1u);
+	const auto polls_per_tick = std::max(settings.polls_per_tick, 1u);
+
+	std::optional<demo_container> demo;
+
+	if (!settings.replayed_demo.empty()) {
+		try {
+			demo.emplace();
+			demo->open(settings.replayed_demo);
+
+			LOG("Swarm clients will replay %x steps from %x.", demo->size(), settings.replayed_demo);
+		}
+		catch (const std::exception& err) {
+			LOG("Failed to open %x: %x. Swarm clients will be scripted.", settings.replayed_demo, err.what());
+			demo.reset();
+		}
+	}
+
+	LOG(
+		"Connecting %x clients to %x:%x at %x Hz for %x seconds.",
+		settings.num_clients,
+		settings.server.address,
+		settings.server.default_port,
+		tickrate,
+		settings.duration_secs
+	);
+
+	std::vector<swarm_client> clients;
+	clients.reserve(settings.num_clients);
+
+	swarm_stats stats;
+	augs::tick_scheduler scheduler;
+
+	const auto inv_poll_rate = 1.0 / (tickrate * polls_per_tick);
+
+	auto secs_since = [](const swarm_clock::time_point since, const swarm_clock::time_point now) {
+		return std::chrono::duration<double>(now - since).count();
+	};
+
+	const auto started = swarm_clock::now();
+	auto when_last_reported = started;
+	auto when_last_connected = started;
+
+	for (uint64_t poll = 0;; ++poll) {
+		scheduler.wait_until(started + std::chrono::duration_cast<swarm_clock::duration>(std::chrono::duration<double>(poll * inv_poll_rate)));
+
+		const auto now = swarm_clock::now();
+
+		if (secs_since(started, now) >= settings.duration_secs) {
+			break;
+		}
+
+		/* Stagger the connections, as a server would rarely see everyone join at the same moment. */
+
+		if (clients.size() < settings.num_clients && secs_since(when_last_connected, now) >= settings.connect_once_every_secs) {
+			auto& c = clients.emplace_back();
+
+			c.index = static_cast<unsigned>(clients.size() - 1);
+			c.rng = randomization(static_cast<rng_seed_type>(c.index + 1));
+			c.adapter = std::make_unique<client_adapter>(std::nullopt);
+
+			if (demo) {
+				c.demo_step = (c.index * demo->size()) / settings.num_clients;
+			}
+
+			const auto resolution = c.adapter->connect(settings.server);
+
+			if (resolution.result != resolve_result_type::OK) {
+				LOG("Swarm client %x couldn't connect: %x", c.index, resolution.report());
+
+				c.state = swarm_client_state::GONE;
+				++stats.failed_to_connect;
+			}
+			else {
+				requested_client_settings requested;
+				requested.chosen_nickname = typesafe_sprintf("Swarm%x", c.index);
+
+				c.adapter->send_payload(
+					game_channel_type::CLIENT_COMMANDS,
+					std::as_const(requested)
+				);
+			}
+
+			when_last_connected = now;
+		}
+
+		const bool is_tick = poll % polls_per_tick == 0;
+		const auto yojimbo_now = yojimbo_time();
+
+		for (auto& c : clients) {
+			if (c.state == swarm_client_state::GONE) {
+				continue;
+			}
+
+			c.adapter->advance(yojimbo_now, swarm_message_handler { c, stats, now });
+
+			if (c.state == swarm_client_state::GONE) {
+				/* Kicked. */
+				continue;
+			}
+
+			if (c.adapter->has_connection_failed() || c.adapter->is_disconnected()) {
+				if (c.state == swarm_client_state::CONNECTING) {
+					++stats.failed_to_connect;
+				}
+				else {
+					++stats.dropped;
+				}
+
+				c.state = swarm_client_state::GONE;
+				continue;
+			}
+
+			if (!is_tick) {
+				continue;
+			}
+
+			if (c.state == swarm_client_state::IN_GAME) {
+				total_client_entropy entropy;
+
+				if (!c.faction_chosen) {
+					entropy.mode = mode_commands::team_choice(faction_type::DEFAULT);
+					c.faction_chosen = true;
+				}
+
+				if (demo) {
+					replay_entropy(c, *demo, entropy);
+				}
+				else {
+					script_entropy(c, tickrate, entropy);
+				}
+
+				c.outgoing_motions.encode(entropy);
+
+				c.adapter->send_payload(
+					game_channel_type::CLIENT_COMMANDS,
+					entropy
+				);
+
+				c.unaccepted.push_back(now);
+				++stats.entropies_sent;
+			}
+
+			c.adapter->send_packets();
+		}
+
+		if (is_tick && secs_since(when_last_reported, now) >= settings.report_once_every_secs) {
+			log_swarm_report(clients, stats, secs_since(when_last_reported, now));
+
+			stats.clear_window();
+			when_last_reported = now;
+		}
+	}
+
+	log_swarm_report(clients, stats, secs_since(when_last_reported, swarm_clock::now()));
+
+	for (auto& c : clients) {
+		if (c.state != swarm_client_state::GONE) {
+			c.adapter->disconnect();
+		}
+	}
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include "augs/filesystem/path.h"
+#include "application/network/address_and_port.h"
+
+/*
+	Connects many synthetic clients to a running server from a single process,
+	to find out how many players the server can take before it falls behind.
+
+	Every client speaks the real protocol through its own client_adapter:
+	it introduces itself, waits for the initial state without ever deserializing it,
+	chooses a faction and then sends a client entropy once every tick.
+	The entropies are either scripted - running around, aiming and shooting at random -
+	or replayed from the inputs of the local player recorded in a demo,
+	each client starting at a different step.
+
+	Nothing is simulated on this side, so a single thread can drive hundreds of clients.
+	Once every report_once_every_secs, the swarm logs what can be seen from the wire:
+	how regularly the server steps arrive, how long it takes for a sent entropy to be accepted,
+	round-trip times and per-client bandwidth.
+*/
+
+struct client_swarm_settings {
+	address_and_port server;
+	augs::path_type replayed_demo;
+
+	unsigned num_clients = 16;
+
+	/* 
+		Has to match the tickrate of the server's arena (--client-swarm-tickrate).
+		It is part of the initial state, which the swarm never deserializes.
+	*/
+
+	unsigned tickrate = 60;
+
+	/* Incoming packets are received this many times per tick, so the arrival times are more precise than a tick. */
+	unsigned polls_per_tick = 8;
+
+	double duration_secs = 60.0;
+	double connect_once_every_secs = 0.05;
+	double report_once_every_secs = 5.0;
+};
+
+void run_client_swarm(const client_swarm_settings&);
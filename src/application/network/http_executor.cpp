@@ -0,0 +1,372 @@
+#include <algorithm>
+
+#include "augs/log.h"
+#include "augs/templates/container_templates.h"
+#include "application/detail_file_paths.h"
+#include "application/network/http_executor.h"
+
+http_executor::http_executor(const http_executor_settings& settings) : settings(settings) {
+	const auto num_workers = std::max(settings.num_workers, 1u);
+
+	for (unsigned i = 0; i < num_workers; ++i) {
+		workers.emplace_back([this]() { work(); });
+	}
+}
+
+http_executor::~http_executor() {
+	{
+		std::scoped_lock lock(lk);
+		quit = true;
+	}
+
+	request_pushed.notify_all();
+
+	for (auto& w : workers) {
+		w.join();
+	}
+}
+
+http_request_id http_executor::push(http_request request) {
+	std::scoped_lock lock(lk);
+
+	if (queue.size() >= std::max(settings.max_queued_requests, 1u)) {
+		auto& oldest = queue.front();
+
+		LOG("HTTP queue is full (%x). Dropping the request to %x%x.", queue.size(), oldest.request.scheme_host_port, oldest.request.location);
+
+		if (oldest.request.wants_response) {
+			http_response dropped;
+			dropped.id = oldest.id;
+			dropped.dropped = true;
+
+			responses.emplace_back(std::move(dropped));
+		}
+
+		queue.pop_front();
+		++stats.num_dropped;
+	}
+
+	const auto id = next_id++;
+	queue.push_back({ id, clock::now(), std::move(request) });
+
+	request_pushed.notify_one();
+	return id;
+}
+
+std::vector<http_response> http_executor::take_responses() {
+	std::scoped_lock lock(lk);
+	return std::exchange(responses, {});
+}
+
+http_executor_stats http_executor::get_stats() const {
+	std::scoped_lock lock(lk);
+	return stats;
+}
+
+static bool can_merge(const http_request& a, const http_request& b) {
+	return
+		a.merge != nullptr
+		&& a.merge == b.merge
+		&& !a.wants_response
+		&& !b.wants_response
+		&& a.scheme_host_port == b.scheme_host_port
+		&& a.location == b.location
+	;
+}
+
+void http_executor::merge_queued_into(queued_request& into) {
+	unsigned num_merged = 1;
+
+	for (auto it = queue.begin(); it != queue.end() && num_merged < settings.max_merged_requests;) {
+		if (can_merge(into.request, it->request) && into.request.merge(into.request.items, it->request.items)) {
+			it = queue.erase(it);
+
+			++num_merged;
+			++stats.num_merged;
+		}
+		else {
+			++it;
+		}
+	}
+}
+
+std::unique_ptr<httplib::Client> http_executor::open_connection(const std::string& scheme_host_port) {
+	auto connection = std::make_unique<httplib::Client>(scheme_host_port);
+
+#if BUILD_OPENSSL
+	const auto ca_path = CA_CERT_PATH;
+	connection->set_ca_cert_path(ca_path.c_str());
+	connection->enable_server_certificate_verification(true);
+#endif
+	connection->set_keep_alive(true);
+	connection->set_follow_location(true);
+	connection->set_connection_timeout(settings.timeout_secs);
+	connection->set_read_timeout(settings.timeout_secs);
+	connection->set_write_timeout(settings.timeout_secs);
+
+	return connection;
+}
+
+void http_executor::work() {
+	auto when_ready = [&](const queued_request& q) {
+		if (q.request.merge != nullptr && !q.request.wants_response) {
+			return q.when_pushed + std::chrono::duration_cast<clock::duration>(std::chrono::duration<float>(settings.batch_window_secs));
+		}
+
+		return q.when_pushed;
+	};
+
+	std::unique_lock<std::mutex> lock(lk);
+
+	for (;;) {
+		if (queue.empty()) {
+			if (quit) {
+				return;
+			}
+
+			request_pushed.wait(lock);
+			continue;
+		}
+
+		const auto now = clock::now();
+
+		auto ready = queue.end();
+		auto earliest = clock::time_point::max();
+
+		for (auto it = queue.begin(); it != queue.end(); ++it) {
+			const auto when = when_ready(*it);
+
+			/* When quitting, nothing is worth waiting for. */
+			if (quit || when <= now) {
+				ready = it;
+				break;
+			}
+
+			earliest = std::min(earliest, when);
+		}
+
+		if (ready == queue.end()) {
+			request_pushed.wait_until(lock, earliest);
+			continue;
+		}
+
+		auto job = std::move(*ready);
+		queue.erase(ready);
+
+		merge_queued_into(job);
+
+		const auto& destination = job.request.scheme_host_port;
+
+		std::unique_ptr<httplib::Client> connection;
+
+		if (auto& idle = idle_connections[destination]; !idle.empty()) {
+			connection = std::move(idle.back());
+			idle.pop_back();
+		}
+
+		lock.unlock();
+
+		bool opened = false;
+		http_response response;
+		response.id = job.id;
+
+		try {
+			if (connection == nullptr) {
+				connection = open_connection(destination);
+				opened = true;
+			}
+
+			if (auto result = connection->Post(job.request.location.c_str(), job.request.items)) {
+				response.status = result->status;
+				response.body = std::move(result->body);
+			}
+			else {
+				LOG("HTTP request to %x%x failed: %x", destination, job.request.location, httplib::to_string(result.error()));
+			}
+		}
+		catch (const std::exception& err) {
+			LOG("HTTP request to %x%x failed: %x", destination, job.request.location, err.what());
+		}
+
+		lock.lock();
+
+		if (opened) {
+			++stats.num_connections_opened;
+		}
+
+		if (response.status != 0) {
+			++stats.num_sent;
+
+			auto& idle = idle_connections[destination];
+
+			if (idle.size() < std::max(settings.num_workers, 1u)) {
+				idle.emplace_back(std::move(connection));
+			}
+		}
+		else {
+			/* Whatever state the connection was left in, don't reuse it. */
+			++stats.num_failed;
+		}
+
+		if (job.request.wants_response) {
+			responses.emplace_back(std::move(response));
+		}
+	}
+}
+
+#if BUILD_UNIT_TESTS
+#include <atomic>
+#include <future>
+#include <Catch/single_include/catch2/catch.hpp>
+
+static bool merge_test_payloads(httplib::MultipartFormDataItems& into, const httplib::MultipartFormDataItems& from) {
+	if (into.size() != 1 || from.size() != 1) {
+		return false;
+	}
+
+	into[0].content += "," + from[0].content;
+	return true;
+}
+
+TEST_CASE("HttpExecutor ReusesMergesAndDrops") {
+	httplib::Server stand_in;
+
+	std::mutex received_lk;
+	std::vector<std::string> received;
+	std::vector<int> remote_ports;
+
+	std::promise<void> slow_entered;
+	std::promise<void> release_slow;
+	auto released = release_slow.get_future().share();
+
+	stand_in.Post("/hook", [&](const httplib::Request& req, httplib::Response& res) {
+		std::scoped_lock lock(received_lk);
+
+		received.push_back(req.get_file_value("payload").content);
+		remote_ports.push_back(req.remote_port);
+
+		res.set_content("ok:" + received.back(), "text/plain");
+	});
+
+	stand_in.Post("/slow", [&](const httplib::Request&, httplib::Response& res) {
+		slow_entered.set_value();
+		released.wait();
+
+		res.set_content("slow", "text/plain");
+	});
+
+	const auto port = stand_in.bind_to_any_port("127.0.0.1");
+	REQUIRE(port > 0);
+
+	std::thread listener([&]() { stand_in.listen_after_bind(); });
+
+	while (!stand_in.is_running()) {
+		std::this_thread::yield();
+	}
+
+	const auto destination = typesafe_sprintf("http://127.0.0.1:%x", port);
+
+	auto make_request = [&](const std::string& location, const std::string& content) {
+		http_request r;
+		r.scheme_host_port = destination;
+		r.location = location;
+		r.items = { { "payload", content, "", "" } };
+
+		return r;
+	};
+
+	auto wait_for_responses = [](http_executor& executor, const std::size_t n) {
+		std::vector<http_response> all;
+
+		while (all.size() < n) {
+			concatenate(all, executor.take_responses());
+			std::this_thread::yield();
+		}
+
+		return all;
+	};
+
+	{
+		/* One connection for all requests sent one after another. */
+
+		http_executor executor({ 1, 64, 10, 0.f, 5 });
+
+		for (int i = 0; i < 3; ++i) {
+			auto r = make_request("/hook", std::to_string(i));
+			r.wants_response = true;
+
+			const auto id = executor.push(std::move(r));
+			const auto responses = wait_for_responses(executor, 1);
+
+			REQUIRE(responses[0].id == id);
+			REQUIRE(responses[0].status == 200);
+			REQUIRE(responses[0].body == "ok:" + std::to_string(i));
+		}
+
+		REQUIRE(executor.get_stats().num_connections_opened == 1);
+	}
+
+	{
+		std::scoped_lock lock(received_lk);
+
+		REQUIRE(received.size() == 3);
+		REQUIRE(remote_ports[0] == remote_ports[1]);
+		REQUIRE(remote_ports[1] == remote_ports[2]);
+
+		received.clear();
+	}
+
+	{
+		/* Whatever comes within the batch window is sent as one request. */
+
+		http_executor executor({ 2, 64, 10, 0.5f, 5 });
+
+		for (int i = 0; i < 3; ++i) {
+			auto r = make_request("/hook", std::to_string(i));
+			r.merge = merge_test_payloads;
+
+			executor.push(std::move(r));
+		}
+
+		while (executor.get_stats().num_sent == 0) {
+			std::this_thread::yield();
+		}
+
+		REQUIRE(executor.get_stats().num_merged == 2);
+	}
+
+	{
+		std::scoped_lock lock(received_lk);
+
+		REQUIRE(received.size() == 1);
+		REQUIRE(received[0] == "0,1,2");
+	}
+
+	{
+		/* The only worker is stuck, so the queue fills up and the oldest request gets dropped. */
+
+		http_executor executor({ 1, 2, 10, 0.f, 5 });
+
+		executor.push(make_request("/slow", ""));
+		slow_entered.get_future().wait();
+
+		auto first = make_request("/hook", "dropped");
+		first.wants_response = true;
+
+		const auto dropped_id = executor.push(std::move(first));
+		executor.push(make_request("/hook", "a"));
+		executor.push(make_request("/hook", "b"));
+
+		const auto responses = wait_for_responses(executor, 1);
+
+		REQUIRE(responses[0].id == dropped_id);
+		REQUIRE(responses[0].dropped);
+		REQUIRE(executor.get_stats().num_dropped == 1);
+
+		release_slow.set_value();
+	}
+
+	stand_in.stop();
+	listener.join();
+}
+#endif
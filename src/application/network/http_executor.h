@@ -0,0 +1,112 @@
+#pragma once
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <memory>
+#include <string>
+#include <vector>
+#include <optional>
+#include <unordered_map>
+#include <condition_variable>
+
+#include "3rdparty/include_httplib.h"
+
+/*
+	Sends HTTP POST requests on a fixed number of worker threads.
+
+	Connections are kept alive and reused for later requests to the same host.
+	The queue is bounded: once it is full, the oldest queued request is dropped to make room.
+
+	Requests that pass the same merge function and go to the same url
+	may be merged into one while they wait in the queue.
+	A request that is old enough to be sent first waits for batch_window_secs
+	after it was pushed, so that whatever comes right after it can be merged into it.
+*/
+
+using http_request_id = uint64_t;
+
+/* Returns false if the two can't be merged, leaving into as it was. */
+using http_merge_function = bool(*)(httplib::MultipartFormDataItems& into, const httplib::MultipartFormDataItems& from);
+
+struct http_request {
+	/* E.g. "https://discord.com" or "http://127.0.0.1:8080" */
+	std::string scheme_host_port;
+	std::string location;
+
+	httplib::MultipartFormDataItems items;
+
+	http_merge_function merge = nullptr;
+
+	/* If set, the response will be returned by take_responses. Such requests are never merged. */
+	bool wants_response = false;
+};
+
+struct http_response {
+	http_request_id id = 0;
+
+	/* 0 if there was no response at all. */
+	int status = 0;
+	std::string body;
+
+	bool dropped = false;
+};
+
+struct http_executor_settings {
+	unsigned num_workers = 2;
+	unsigned max_queued_requests = 64;
+	unsigned max_merged_requests = 10;
+	float batch_window_secs = 0.f;
+	int timeout_secs = 5;
+};
+
+struct http_executor_stats {
+	std::size_t num_sent = 0;
+	std::size_t num_failed = 0;
+	std::size_t num_dropped = 0;
+	std::size_t num_merged = 0;
+	std::size_t num_connections_opened = 0;
+};
+
+class http_executor {
+	using clock = std::chrono::steady_clock;
+
+	struct queued_request {
+		http_request_id id = 0;
+		clock::time_point when_pushed;
+		http_request request;
+	};
+
+	const http_executor_settings settings;
+
+	mutable std::mutex lk;
+	std::condition_variable request_pushed;
+
+	std::deque<queued_request> queue;
+	std::vector<http_response> responses;
+	std::unordered_map<std::string, std::vector<std::unique_ptr<httplib::Client>>> idle_connections;
+
+	http_executor_stats stats;
+	http_request_id next_id = 1;
+	bool quit = false;
+
+	std::vector<std::thread> workers;
+
+	void work();
+	void merge_queued_into(queued_request&);
+	std::unique_ptr<httplib::Client> open_connection(const std::string& scheme_host_port);
+
+public:
+	explicit http_executor(const http_executor_settings&);
+
+	/* Sends everything still queued before returning. */
+	~http_executor();
+
+	http_executor(const http_executor&) = delete;
+	http_executor& operator=(const http_executor&) = delete;
+
+	http_request_id push(http_request);
+
+	std::vector<http_response> take_responses();
+
+	http_executor_stats get_stats() const;
+};
@@ -0,0 +1,104 @@
+#pragma once
+#include <array>
+#include "augs/templates/container_templates.h"
+#include "application/network/server_step_entropy.h"
+
+/*
+	Replaces crosshair motions with their differences from the previous step's motions of the same players,
+	so that a steadily moving mouse is sent as a sequence of small numbers.
+
+	The sender and the receiver each hold a coder for a single stream of entropies
+	and must pass every entropy of that stream through it, in order.
+	A player without a motion in a given step counts as having moved by zero.
+
+	The arithmetic wraps around on 16 bits, so decoding is exact for any input.
+*/
+
+class motion_delta_coder {
+	using offset_type = raw_game_motion_offset_type;
+	using per_player_offsets = std::array<offset_type, max_mode_players_v>;
+
+	per_player_offsets previous = {};
+	per_player_offsets current = {};
+
+	static short wrapping_add(const short a, const short b) {
+		return static_cast<short>(static_cast<uint16_t>(a) + static_cast<uint16_t>(b));
+	}
+
+	static short wrapping_sub(const short a, const short b) {
+		return static_cast<short>(static_cast<uint16_t>(a) - static_cast<uint16_t>(b));
+	}
+
+	static offset_type encode_one(offset_type& motion, const offset_type& last) {
+		const auto absolute = motion;
+
+		motion.x = wrapping_sub(motion.x, last.x);
+		motion.y = wrapping_sub(motion.y, last.y);
+
+		return absolute;
+	}
+
+	static offset_type decode_one(offset_type& motion, const offset_type& last) {
+		motion.x = wrapping_add(motion.x, last.x);
+		motion.y = wrapping_add(motion.y, last.y);
+
+		return motion;
+	}
+
+	template <class F>
+	void code_single(total_mode_player_entropy& entropy, F op) {
+		auto& last = previous[0];
+
+		if (auto* const motion = mapped_or_nullptr(entropy.cosmic.motions, game_motion_type::MOVE_CROSSHAIR)) {
+			last = op(*motion, last);
+		}
+		else {
+			last = {};
+		}
+	}
+
+	template <class F>
+	void code_step(compact_server_step_entropy& entropy, F op) {
+		current.fill({});
+
+		for (auto& p : entropy.players) {
+			const auto i = p.player_id.value;
+
+			if (i >= current.size()) {
+				continue;
+			}
+
+			if (auto* const motion = mapped_or_nullptr(p.total.cosmic.motions, game_motion_type::MOVE_CROSSHAIR)) {
+				current[i] = op(*motion, previous[i]);
+			}
+		}
+
+		std::swap(previous, current);
+	}
+
+public:
+	void encode(compact_server_step_entropy& entropy) {
+		code_step(entropy, encode_one);
+	}
+
+	void decode(compact_server_step_entropy& entropy) {
+		code_step(entropy, decode_one);
+	}
+
+	void encode(total_mode_player_entropy& entropy) {
+		code_single(entropy, encode_one);
+	}
+
+	void decode(total_mode_player_entropy& entropy) {
+		code_single(entropy, decode_one);
+	}
+
+	void reset() {
+		previous.fill({});
+	}
+
+	/* Coders that compare equal code every further entropy identically. */
+	bool operator==(const motion_delta_coder& b) const {
+		return previous == b.previous;
+	}
+};
@@ -0,0 +1,542 @@
+#include <array>
+#include <optional>
+#include <algorithm>
+
+#include "augs/log.h"
+#include "augs/misc/scope_guard.h"
+#include "augs/readwrite/memory_stream.h"
+#include "augs/readwrite/byte_file.h"
+#include "augs/filesystem/file.h"
+
+#include "application/network/network_messages.h"
+#include "application/setups/client/demo_file.h"
+#include "application/setups/client/demo_step.h"
+#include "application/setups/client/demo_container.h"
+#include "application/network/net_message_readwrite.h"
+#include "application/network/motion_delta_coder.h"
+#include "application/network/net_bandwidth_benchmark.h"
+
+namespace legacy_encoding {
+	/*
+		The wire format of step entropies before the variable-length codes were introduced.
+		Kept only as a baseline for measure_demo_bandwidth, so it can only write.
+	*/
+
+	template <class Stream>
+	bool serialize(Stream& s, total_mode_player_entropy& payload) {
+		static_assert(Stream::IsWriting);
+
+		auto& m = payload.mode;
+		auto& c = payload.cosmic;
+
+		bool has_mode_command = logically_set(m);
+
+		bool has_cast_spell = logically_set(c.cast_spell);
+		bool has_wield = logically_set(c.wield);
+		bool has_intents = logically_set(c.intents);
+		bool has_motions = logically_set(c.motions);
+		bool has_transfer = logically_set(c.transfer);
+
+		auto motion = has_motions ? c.motions.at(game_motion_type::MOVE_CROSSHAIR) : raw_game_motion_offset_type();
+
+		motion.x = std::clamp(motion.x, mouse_rel_min_v, mouse_rel_max_v);
+		motion.y = std::clamp(motion.y, mouse_rel_min_v, mouse_rel_max_v);
+
+		auto one_byte_pred = [&](const auto& coord) {
+			return coord >= -7 && coord <= 8;
+		};
+
+		auto two_byte_pred = [&](const auto& coord) {
+			return coord >= -127 && coord <= 128;
+		};
+
+		bool motion_writable_in_one_byte = has_motions && one_byte_pred(motion.x) && one_byte_pred(motion.y);
+		bool motion_writable_in_two_bytes = has_motions && two_byte_pred(motion.x) && two_byte_pred(motion.y);
+
+		serialize_bool(s, has_mode_command);
+		serialize_bool(s, has_cast_spell);
+		serialize_bool(s, has_wield);
+		serialize_bool(s, has_intents);
+		serialize_bool(s, has_motions);
+		serialize_bool(s, has_transfer);
+
+		serialize_bool(s, motion_writable_in_one_byte);
+		serialize_bool(s, motion_writable_in_two_bytes);
+
+		if (has_mode_command) {
+			if (!net_messages::serialize(s, m)) {
+				return false;
+			}
+		}
+
+		if (has_cast_spell) {
+			if (!net_messages::serialize_trivial_as_bytes(s, c.cast_spell)) {
+				return false;
+			}
+		}
+
+		if (has_wield) {
+			if (!net_messages::serialize(s, c.wield)) {
+				return false;
+			}
+		}
+
+		if (has_intents) {
+			auto num_intents = static_cast<uint8_t>(c.intents.size());
+			serialize_int(s, num_intents, 1, max_game_intents_per_step_v);
+
+			for (auto& i : c.intents) {
+				auto pressed = i.change == intent_change::PRESSED;
+				auto intent = int(i.intent);
+
+				serialize_bool(s, pressed);
+				serialize_int(s, intent, 0, int(game_intent_type::COUNT) - 1);
+			}
+
+			serialize_align(s);
+		}
+
+		if (has_motions) {
+			int min_bound = mouse_rel_min_v;
+			int max_bound = mouse_rel_max_v;
+
+			if (motion_writable_in_one_byte) {
+				min_bound = -7;
+				max_bound = 8;
+			}
+			else if (motion_writable_in_two_bytes) {
+				min_bound = -127;
+				max_bound = 128;
+			}
+
+			const auto offset = -min_bound;
+
+			int x = motion.x + offset;
+			int y = motion.y + offset;
+
+			serialize_int(s, x, 0, max_bound + offset);
+			serialize_int(s, y, 0, max_bound + offset);
+		}
+
+		if (has_transfer) {
+			if (!net_messages::serialize_trivial_as_bytes(s, c.transfer)) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	template <class Stream>
+	bool serialize(Stream& s, networked_server_step_entropy& total_networked) {
+		static_assert(Stream::IsWriting);
+
+		auto& i = total_networked.payload;
+		auto& g = i.general;
+
+#if !CONTEXTS_SEPARATE
+		if (!net_messages::serialize(s, total_networked.context)) {
+			return false;
+		}
+#endif
+
+		auto& state_hash = total_networked.meta.state_hash;
+		bool has_state_hash = logically_set(state_hash);
+
+		bool has_players = logically_set(i.players);
+		bool has_added_player = logically_set(g.added_player);
+		bool has_removed_player = logically_set(g.removed_player);
+		bool has_special_command = logically_set(g.special_command);
+		bool reinference_necessary = total_networked.meta.reinference_necessary;
+
+		serialize_bool(s, has_state_hash);
+		serialize_bool(s, has_players);
+		serialize_bool(s, has_added_player);
+		serialize_bool(s, has_removed_player);
+		serialize_bool(s, has_special_command);
+
+		serialize_bool(s, reinference_necessary);
+
+		serialize_align(s);
+
+		if (has_state_hash) {
+			uint32_t hash = *state_hash;
+			serialize_uint32(s, hash);
+		}
+
+		if (has_players) {
+			auto cnt = static_cast<int>(i.players.size());
+			serialize_int(s, cnt, 1, max_mode_players_v);
+
+			for (auto& pp : i.players) {
+				if (!net_messages::serialize(s, pp.player_id)) {
+					return false;
+				}
+
+				if (!serialize(s, pp.total)) {
+					return false;
+				}
+			}
+		}
+
+		if (has_added_player) {
+			if (!net_messages::serialize(s, g.added_player)) {
+				return false;
+			}
+		}
+
+		if (has_removed_player) {
+			if (!net_messages::serialize(s, g.removed_player)) {
+				return false;
+			}
+		}
+
+		if (has_special_command) {
+			if (!net_messages::serialize(s, g.special_command)) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
+
+template <class F>
+static std::size_t bytes_when_written(F&& serialize_with) {
+	uint8_t buffer[max_packet_size_v];
+	auto stream = yojimbo::WriteStream(yojimbo::GetDefaultAllocator(), buffer, sizeof(buffer));
+
+	if (!serialize_with(stream)) {
+		return 0;
+	}
+
+	stream.Flush();
+	return stream.GetBytesProcessed();
+}
+
+void measure_demo_bandwidth(const augs::path_type& demo_path) {
+	LOG("Measuring the bandwidth of step entropies recorded in %x", demo_path);
+
+	demo_container steps;
+	steps.open(demo_path);
+
+	motion_delta_coder incoming_motions;
+	motion_delta_coder filtered_motions;
+
+	std::size_t num_entropies = 0;
+	std::size_t current_total = 0;
+	std::size_t legacy_total = 0;
+	std::size_t filtered_total = 0;
+	std::size_t current_max = 0;
+	std::size_t legacy_max = 0;
+
+	/*
+		The server sends every step to every client,
+		so its egress grows with the square of the number of players.
+	*/
+
+	std::size_t current_egress = 0;
+	std::size_t filtered_egress = 0;
+	std::size_t max_players = 0;
+
+	/*
+		Only what can be told from the entropies themselves: 
+		players join as spectators and then choose a team.
+		A player whose faction is unknown counts as having a character.
+	*/
+
+	std::array<std::optional<faction_type>, max_mode_players_v> factions;
+
+	auto is_spectator = [&](const mode_player_id id) {
+		return id.value < factions.size() && factions[id.value] == faction_type::SPECTATOR;
+	};
+
+	auto num_players = [&]() {
+		return static_cast<std::size_t>(std::count_if(factions.begin(), factions.end(), [](const auto& f) { return f != std::nullopt; }));
+	};
+
+	for (demo_step_num_type n = 0; n < steps.size(); ++n) {
+		for (const auto& serialized : steps.get_step(n).serialized_messages) {
+			auto measure = [&](auto& typed_msg) {
+				using net_message_type = remove_cref<decltype(typed_msg)>;
+
+				if constexpr(std::is_same_v<net_message_type, net_messages::server_step_entropy>) {
+					networked_server_step_entropy entropy;
+					typed_msg.read_payload(entropy);
+
+					const auto current = bytes_when_written([&](auto& stream) {
+						return net_messages::serialize(stream, entropy);
+					});
+
+					incoming_motions.decode(entropy.payload);
+
+					const auto legacy = bytes_when_written([&](auto& stream) {
+						return legacy_encoding::serialize(stream, entropy);
+					});
+
+					/* What broadcast_only_effective_inputs would have left of it. */
+
+					auto filtered = entropy;
+
+					{
+						auto& players = filtered.payload.players;
+
+						for (auto& p : players) {
+							if (is_spectator(p.player_id)) {
+								p.total.cosmic = {};
+							}
+						}
+
+						erase_if(players, [](const auto& p) { return p.total.empty(); });
+					}
+
+					filtered_motions.encode(filtered.payload);
+
+					const auto filtered_bytes = bytes_when_written([&](auto& stream) {
+						return net_messages::serialize(stream, filtered);
+					});
+
+					{
+						const auto& general = entropy.payload.general;
+
+						if (general.added_player.is_set() && general.added_player.id.value < factions.size()) {
+							factions[general.added_player.id.value] = general.added_player.faction;
+						}
+
+						if (general.removed_player.is_set() && general.removed_player.value < factions.size()) {
+							factions[general.removed_player.value] = std::nullopt;
+						}
+
+						for (const auto& p : entropy.payload.players) {
+							if (const auto choice = std::get_if<mode_commands::team_choice>(&p.total.mode)) {
+								if (p.player_id.value < factions.size()) {
+									factions[p.player_id.value] = *choice;
+								}
+							}
+						}
+					}
+
+					const auto recipients = std::max(num_players(), std::size_t(1));
+
+					++num_entropies;
+
+					current_total += current;
+					legacy_total += legacy;
+					filtered_total += filtered_bytes;
+
+					current_egress += current * recipients;
+					filtered_egress += filtered_bytes * recipients;
+					max_players = std::max(max_players, recipients);
+
+					current_max = std::max(current_max, current);
+					legacy_max = std::max(legacy_max, legacy);
+				}
+
+				return message_handler_result::CONTINUE;
+			};
+
+			::replay_serialized_net_message(serialized, measure);
+		}
+	}
+
+	if (num_entropies == 0) {
+		LOG("The demo has no step entropies.");
+		return;
+	}
+
+	const auto n = static_cast<double>(num_entropies);
+
+	LOG("Step entropies: %x over %x recorded steps.", num_entropies, steps.size());
+	LOG("Current format: %x bytes per tick on average, %x at most, %x in total.", current_total / n, current_max, current_total);
+	LOG("Legacy format:  %x bytes per tick on average, %x at most, %x in total.", legacy_total / n, legacy_max, legacy_total);
+	LOG("Current/legacy: %x", static_cast<double>(current_total) / std::max(legacy_total, std::size_t(1)));
+
+	LOG("Only effective inputs: %x bytes per tick on average, %x in total.", filtered_total / n, filtered_total);
+	LOG("Server egress to up to %x players: %x bytes per tick, %x with only effective inputs.", max_players, current_egress / n, filtered_egress / n);
+	LOG("Filtered/current egress: %x", static_cast<double>(filtered_egress) / std::max(current_egress, std::size_t(1)));
+}
+
+#if BUILD_UNIT_TESTS
+#include <Catch/single_include/catch2/catch.hpp>
+#include "augs/misc/randomization.h"
+
+TEST_CASE("NetSerialization FuzzedEntropiesRoundTrip") {
+	randomization rng(1337);
+
+	auto random_motion = [&]() {
+		const auto limit = rng.randval(0, 3) == 0 ? int(mouse_rel_max_v) : 12;
+
+		return raw_game_motion_offset_type(
+			static_cast<short>(rng.randval(-limit, limit)),
+			static_cast<short>(rng.randval(-limit, limit))
+		);
+	};
+
+	auto random_intents = [&](step_game_intents& ints) {
+		const auto num_types = static_cast<int>(game_intent_type::COUNT);
+
+		auto random_change = [&]() {
+			return rng.randval(0, 1) ? intent_change::PRESSED : intent_change::RELEASED;
+		};
+
+		if (rng.randval(0, 1)) {
+			/* Sorted and unique, so that the bitset form is eligible. */
+
+			for (int t = 0; t < num_types; ++t) {
+				if (rng.randval(0, 2) == 0) {
+					ints.push_back({ static_cast<game_intent_type>(t), random_change() });
+				}
+			}
+		}
+		else {
+			const auto n = rng.randval(0, 8);
+
+			for (int i = 0; i < n; ++i) {
+				ints.push_back({ static_cast<game_intent_type>(rng.randval(0, num_types - 1)), random_change() });
+			}
+		}
+	};
+
+	auto random_player_entropy = [&]() {
+		total_mode_player_entropy t;
+
+		if (rng.randval(0, 9) == 0) {
+			t.mode = mode_commands::team_choice { faction_type::RESISTANCE };
+		}
+
+		if (rng.randval(0, 9) == 0) {
+			t.cosmic.cast_spell.set_index(rng.randval(0u, spell_id::max_index_v - 1));
+		}
+
+		if (rng.randval(0, 1)) {
+			random_intents(t.cosmic.intents);
+		}
+
+		if (rng.randval(0, 3) != 0) {
+			t.cosmic.motions[game_motion_type::MOVE_CROSSHAIR] = random_motion();
+		}
+
+		return t;
+	};
+
+	auto round_trip = [&](auto message_type_tag, auto sent, auto& encoder, auto& decoder, auto& get_coded) {
+		using payload_type = decltype(sent);
+		using message_type = typename decltype(message_type_tag)::type;
+
+		auto coded = sent;
+		encoder.encode(get_coded(coded));
+
+		std::vector<uint8_t> buffer(16 * 1024);
+
+		auto write_stream = yojimbo::WriteStream(yojimbo::GetDefaultAllocator(), buffer.data(), static_cast<int>(buffer.size()));
+
+		message_type sent_msg;
+		sent_msg.write_payload(coded);
+		REQUIRE(sent_msg.Serialize(write_stream));
+		write_stream.Flush();
+
+		auto read_stream = yojimbo::ReadStream(yojimbo::GetDefaultAllocator(), buffer.data(), write_stream.GetBytesProcessed());
+
+		message_type received_msg;
+		REQUIRE(received_msg.Serialize(read_stream));
+
+		payload_type received;
+		received_msg.read_payload(received);
+		decoder.decode(get_coded(received));
+
+		REQUIRE(received == sent);
+
+		sent_msg.Release();
+		received_msg.Release();
+	};
+
+	{
+		motion_delta_coder encoder;
+		motion_delta_coder decoder;
+
+		auto get_coded = [](total_client_entropy& e) -> auto& { return e; };
+
+		for (int i = 0; i < 2000; ++i) {
+			round_trip(std::type_identity<net_messages::client_entropy>(), random_player_entropy(), encoder, decoder, get_coded);
+		}
+	}
+
+	{
+		motion_delta_coder encoder;
+		motion_delta_coder decoder;
+
+		auto get_coded = [](networked_server_step_entropy& e) -> auto& { return e.payload; };
+
+		for (int i = 0; i < 2000; ++i) {
+			networked_server_step_entropy sent;
+
+			if (rng.randval(0, 7) == 0) {
+				sent.meta.state_hash = rng.randval(0u, std::numeric_limits<uint32_t>::max());
+			}
+
+			for (uint32_t id = 0; id < max_mode_players_v; ++id) {
+				if (rng.randval(0, 7) == 0) {
+					sent.payload.players.push_back({ mode_player_id(id), random_player_entropy() });
+				}
+			}
+
+			if (rng.randval(0, 3) == 0) {
+				/* Entries out of order must survive too, even if the server never sends them this way. */
+				auto& p = sent.payload.players;
+
+				for (std::size_t j = 1; j < p.size(); ++j) {
+					std::swap(p[j], p[rng.randval(0u, static_cast<uint32_t>(j))]);
+				}
+			}
+
+			round_trip(std::type_identity<net_messages::server_step_entropy>(), sent, encoder, decoder, get_coded);
+		}
+	}
+}
+
+TEST_CASE("NetSerialization SharedMotionEncoding") {
+	/* 
+		The server encodes a step once for all clients whose coders compare equal,
+		which holds as soon as they have all received the same previous step.
+	*/
+
+	auto step_with_motion = [](const uint32_t id, const short x, const short y) {
+		compact_server_step_entropy e;
+
+		total_mode_player_entropy t;
+		t.cosmic.motions[game_motion_type::MOVE_CROSSHAIR] = { x, y };
+
+		e.players.push_back({ mode_player_id(id), t });
+		return e;
+	};
+
+	motion_delta_coder veteran;
+	motion_delta_coder newcomer;
+
+	for (short i = 0; i < 10; ++i) {
+		auto e = step_with_motion(0, i, -i);
+		veteran.encode(e);
+	}
+
+	REQUIRE(!(veteran == newcomer));
+
+	{
+		auto a = step_with_motion(1, 5, 5);
+		auto b = a;
+
+		veteran.encode(a);
+		newcomer.encode(b);
+	}
+
+	REQUIRE(veteran == newcomer);
+
+	auto a = step_with_motion(1, 7, 3);
+	auto b = a;
+
+	veteran.encode(a);
+	newcomer.encode(b);
+
+	REQUIRE(a == b);
+	REQUIRE(a.players[0].total.cosmic.motions.at(game_motion_type::MOVE_CROSSHAIR) == raw_game_motion_offset_type(2, -2));
+}
+#endif
@@ -0,0 +1,13 @@
+#pragma once
+#include "augs/filesystem/path.h"
+
+/*
+	Replays the server messages recorded in a demo
+	and logs how many bytes per tick the step entropies take in the current wire format,
+	compared to the format that sent motions as absolute values and ids aligned to whole bytes.
+
+	It also projects the egress of the server, which sends every step to every player,
+	with and without the inputs that broadcast_only_effective_inputs leaves out.
+*/
+
+void measure_demo_bandwidth(const augs::path_type& demo_path);
@@ -0,0 +1,101 @@
+#pragma once
+#include <cstdint>
+
+/*
+	Variable-length codes for yojimbo streams.
+	They are meant for values that are small most of the time but are occasionally large,
+	e.g. crosshair motions or gaps between sorted player ids.
+*/
+
+namespace net_messages {
+	constexpr uint32_t bit_width(uint32_t v) {
+		uint32_t n = 0;
+
+		while (v > 0) {
+			++n;
+			v >>= 1;
+		}
+
+		return n;
+	}
+
+	constexpr uint32_t zigzag(const int v) {
+		return v >= 0 ? static_cast<uint32_t>(v) * 2 : static_cast<uint32_t>(-(v + 1)) * 2 + 1;
+	}
+
+	constexpr int unzigzag(const uint32_t z) {
+		return (z & 1) ? -static_cast<int>(z / 2) - 1 : static_cast<int>(z / 2);
+	}
+
+	/*
+		Number of bits that an exponential-Golomb code of order k takes for a value.
+		With k = 0: 0 takes 1 bit, 1-2 take 3 bits, 3-6 take 5 bits and so on.
+		Higher orders spend more bits on small values and less on large ones.
+	*/
+
+	constexpr uint32_t exp_golomb_bits(const uint32_t value, const uint32_t k) {
+		return 2 * bit_width(value + (1u << k)) - 1 - k;
+	}
+
+	template <class Stream>
+	bool serialize_exp_golomb(Stream& s, uint32_t& value, const uint32_t k, const uint32_t max_value) {
+		const auto max_width = bit_width(max_value + (1u << k));
+
+		uint32_t width = 0;
+
+		if (Stream::IsWriting) {
+			if (value > max_value) {
+				return false;
+			}
+
+			width = bit_width(value + (1u << k));
+		}
+
+		/*
+			The width of the value is written in unary:
+			as many zeros as there are bits above k + 1, then a single one.
+		*/
+
+		uint32_t current_width = k + 1;
+
+		for (;;) {
+			bool terminated = Stream::IsWriting && current_width == width;
+			serialize_bool(s, terminated);
+
+			if (terminated) {
+				break;
+			}
+
+			if (++current_width > max_width) {
+				return false;
+			}
+		}
+
+		width = current_width;
+
+		/* The leading one is implied by the width. */
+
+		const auto leading_one = 1u << (width - 1);
+		uint32_t remainder = 0;
+
+		if (Stream::IsWriting) {
+			remainder = (value + (1u << k)) - leading_one;
+		}
+
+		if (width > 1) {
+			serialize_bits(s, remainder, width - 1);
+		}
+
+		if (Stream::IsReading) {
+			const auto decoded = (leading_one + remainder) - (1u << k);
+
+			if (decoded > max_value) {
+				return false;
+			}
+
+			value = decoded;
+		}
+
+		return true;
+	}
+}
@@ -1,13 +1,16 @@
 #pragma once
+#include "augs/readwrite/to_bytes.h"
 
 template <class T>
 constexpr bool is_block_message_v = std::is_base_of_v<only_block_message, T>;
 
-template <class F>
-decltype(auto) replay_serialized_net_message(const std::vector<std::byte>& bytes, F&& callback) {
+/* The bytes can be anything with data() and size(), e.g. a view into a mapped demo file. */
+
+template <class B, class F>
+decltype(auto) replay_serialized_net_message(const B& bytes, F&& callback) {
 	using Id = type_in_list_id<server_message_variant>;
 
-	auto ar = augs::cref_memory_stream(bytes);
+	auto ar = augs::make_read_stream(bytes.data(), bytes.size());
 
 	Id id;
 	augs::read_bytes(ar, id);
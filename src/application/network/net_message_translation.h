@@ -13,6 +13,9 @@ struct initial_arena_state_payload {
 	maybe_const_ref_t<C, online_mode_and_rules> mode;
 	maybe_const_ref_t<C, uint32_t> client_id;
 	maybe_const_ref_t<C, rcon_level_type> rcon;
+
+	/* How many of the steps that follow were sent only for the client to catch up, see join_epoch. */
+	maybe_const_ref_t<C, uint32_t> num_catch_up_steps;
 };
 
 template <class T, class P>
@@ -188,6 +191,15 @@ namespace net_messages {
 		augs::read_bytes(s, in.client_id);
 		augs::read_bytes(s, in.rcon);
 
+		/* Demos recorded before the join epochs end right here. */
+
+		if (s.has_unread_bytes()) {
+			augs::read_bytes(s, in.num_catch_up_steps);
+		}
+		else {
+			in.num_catch_up_steps = 0;
+		}
+
 		NSR_LOG_NVPS(in.client_id);
 
 		return true;
@@ -206,6 +218,7 @@ namespace net_messages {
 			augs::write_bytes(s, in.mode);
 			augs::write_bytes(s, in.client_id);
 			augs::write_bytes(s, in.rcon);
+			augs::write_bytes(s, in.num_catch_up_steps);
 		};
 
 		NSR_LOG("SENDING INITIAL STATE");
@@ -6,6 +6,8 @@
 #include "augs/readwrite/to_bytes.h"
 #include "game/modes/mode_commands/match_command.h"
 #include "augs/window_framework/mouse_rel_bound.h"
+#include "application/network/net_bit_codes.h"
+#include "game/detail/lag_compensation/hitbox_history.h"
 
 namespace net_messages {
 	template <class Stream, class V>
@@ -170,6 +172,7 @@ namespace net_messages {
 		serialize_float(s, settings.crosshair_sensitivity.y);
 
 		serialize_bool(s, settings.keep_movement_forces_relative_to_crosshair);
+		serialize_int(s, settings.lag_compensation_steps, 0, max_lag_compensation_steps_v);
 
 		return true;
 	}
@@ -310,6 +313,150 @@ namespace net_messages {
 		return true;
 	}
 
+	template <class Stream>
+	bool serialize(Stream& s, spell_id& id) {
+		auto index = id.get_index();
+		serialize_int(s, index, 0, spell_id::max_index_v - 1);
+		id.set_index(index);
+		return true;
+	}
+
+	template <class Stream>
+	bool serialize(Stream& s, step_game_intents& ints) {
+		constexpr auto num_types = static_cast<uint32_t>(game_intent_type::COUNT);
+		static_assert(num_types <= 32, "The intent bitset must fit in a single serialize_bits call.");
+
+		/*
+			Intents are sent either as a list of (pressed, type) pairs,
+			or - if they are sorted by type with no duplicates - as a bitset of types
+			followed by a single pressed/released bit for each of the set types.
+
+			The sender picks whichever is shorter.
+			Intents are never reordered as the order in which they are applied matters.
+		*/
+
+		auto list_bits = [&]() {
+			return exp_golomb_bits(static_cast<uint32_t>(ints.size()) - 1, 0) + static_cast<uint32_t>(ints.size()) * (1 + bit_width(num_types - 1));
+		};
+
+		auto bitset_bits = [&]() {
+			return num_types + static_cast<uint32_t>(ints.size());
+		};
+
+		auto sorted_and_unique = [&]() {
+			for (std::size_t i = 1; i < ints.size(); ++i) {
+				if (!(ints[i - 1].intent < ints[i].intent)) {
+					return false;
+				}
+			}
+
+			return true;
+		};
+
+		bool as_bitset = Stream::IsWriting && sorted_and_unique() && bitset_bits() < list_bits();
+		serialize_bool(s, as_bitset);
+
+		if (as_bitset) {
+			uint32_t types = 0;
+
+			if (Stream::IsWriting) {
+				for (const auto& i : ints) {
+					types |= 1u << static_cast<uint32_t>(i.intent);
+				}
+			}
+
+			serialize_bits(s, types, num_types);
+
+			if (Stream::IsReading) {
+				ints.clear();
+
+				for (uint32_t t = 0; t < num_types; ++t) {
+					if (types & (1u << t)) {
+						ints.push_back({ static_cast<game_intent_type>(t), intent_change::PRESSED });
+					}
+				}
+
+				if (ints.empty()) {
+					return false;
+				}
+			}
+		}
+		else {
+			uint32_t num_intents_minus_one = static_cast<uint32_t>(ints.size()) - 1;
+
+			if (!serialize_exp_golomb(s, num_intents_minus_one, 0, max_game_intents_per_step_v - 1)) {
+				return false;
+			}
+
+			if (Stream::IsReading) {
+				ints.resize(num_intents_minus_one + 1);
+			}
+
+			for (auto& i : ints) {
+				auto intent = int(i.intent);
+				serialize_int(s, intent, 0, int(num_types) - 1);
+				i.intent = static_cast<game_intent_type>(intent);
+			}
+		}
+
+		for (auto& i : ints) {
+			auto pressed = i.change == intent_change::PRESSED;
+			serialize_bool(s, pressed);
+			i.change = pressed ? intent_change::PRESSED : intent_change::RELEASED;
+		}
+
+		return true;
+	}
+
+	template <class Stream>
+	bool serialize(Stream& s, raw_game_motion_offset_type& motion) {
+		/*
+			Both coordinates are zigzag-encoded and written with an exponential-Golomb code
+			whose order the sender chooses so that the motion takes the least bits.
+		*/
+
+		static constexpr uint32_t orders[] = { 0, 2, 4, 7 };
+		static constexpr uint32_t max_zigzag_v = std::numeric_limits<uint16_t>::max();
+
+		uint32_t zx = 0;
+		uint32_t zy = 0;
+		int order_index = 0;
+
+		if (Stream::IsWriting) {
+			zx = zigzag(motion.x);
+			zy = zigzag(motion.y);
+
+			auto cost = [&](const int oi) {
+				return exp_golomb_bits(zx, orders[oi]) + exp_golomb_bits(zy, orders[oi]);
+			};
+
+			for (int oi = 1; oi < 4; ++oi) {
+				if (cost(oi) < cost(order_index)) {
+					order_index = oi;
+				}
+			}
+		}
+
+		serialize_int(s, order_index, 0, 3);
+
+		const auto k = orders[order_index];
+
+		if (!serialize_exp_golomb(s, zx, k, max_zigzag_v)) {
+			return false;
+		}
+
+		if (!serialize_exp_golomb(s, zy, k, max_zigzag_v)) {
+			return false;
+		}
+
+		if (Stream::IsReading) {
+			motion.x = static_cast<short>(unzigzag(zx));
+			motion.y = static_cast<short>(unzigzag(zy));
+		}
+
+		return true;
+	}
+
 	template <class Stream>
 	bool serialize(Stream& s, total_mode_player_entropy& payload) {
 		auto& m = payload.mode;
@@ -327,17 +474,6 @@ namespace net_messages {
 		bool has_motions = logically_set(c.motions);
 		bool has_transfer = logically_set(c.transfer);
 
-		auto one_byte_pred = [&](const auto& coord) {
-			return coord >= -7 && coord <= 8;
-		};
-
-		auto two_byte_pred = [&](const auto& coord) {
-			return coord >= -127 && coord <= 128;
-		};
-
-		bool motion_writable_in_one_byte = has_motions && one_byte_pred(get_motion().x) && one_byte_pred(get_motion().y);
-		bool motion_writable_in_two_bytes = has_motions && two_byte_pred(get_motion().x) && two_byte_pred(get_motion().y);
-
 		serialize_bool(s, has_mode_command);
 		serialize_bool(s, has_cast_spell);
 		serialize_bool(s, has_wield);
@@ -345,9 +481,6 @@ namespace net_messages {
 		serialize_bool(s, has_motions);
 		serialize_bool(s, has_transfer);
 
-		serialize_bool(s, motion_writable_in_one_byte);
-		serialize_bool(s, motion_writable_in_two_bytes);
-
 		if (has_mode_command) {
 			if (!serialize(s, m)) {
 				return false;
@@ -355,7 +488,7 @@ namespace net_messages {
 		}
 
 		if (has_cast_spell) {
-			if (!serialize_trivial_as_bytes(s, c.cast_spell)) {
+			if (!serialize(s, c.cast_spell)) {
 				return false;
 			}
 		}
@@ -367,102 +500,81 @@ namespace net_messages {
 		}
 
 		if (has_intents) {
-			auto& ints = c.intents;
-			auto num_intents = static_cast<uint8_t>(ints.size());
-
-			/*
-				6 bits for the number of intents
-
-				1 bit for whether it was pressed or released
-				currently 5 bits for the intent id
-
-				= ~6 bits per intent
-			*/
-
-			serialize_int(s, num_intents, 1, 64);
-
-			if (Stream::IsReading) {
-				ints.resize(num_intents);
-			}
-
-			static_assert(int(game_intent_type::COUNT) < 128);
-
-			for (auto& i : ints) {
-				auto pressed = i.change == intent_change::PRESSED;
-				auto intent = int(i.intent);
-
-				serialize_bool(s, pressed);
-				serialize_int(s, intent, 0, int(game_intent_type::COUNT) - 1);
-
-				i.change = pressed ? intent_change::PRESSED : intent_change::RELEASED;
-				i.intent = static_cast<game_intent_type>(intent);
+			if (!serialize(s, c.intents)) {
+				return false;
 			}
-
-			serialize_align(s);
 		}
 
 		if (has_motions) {
 			static_assert(int(game_motion_type::COUNT) == 1);
 
-			const auto pos_before = s.GetBytesProcessed();
-
-			int min_bound = 0;
-			int max_bound = 0;
-
-			if (motion_writable_in_one_byte) {
-				min_bound = -7;
-				max_bound = 8;
-			}
-			else if (motion_writable_in_two_bytes) {
-				min_bound = -127;
-				max_bound = 128;
+			if (!serialize(s, get_motion())) {
+				return false;
 			}
-			else {
-				min_bound = mouse_rel_min_v;
-				max_bound = mouse_rel_max_v;
+		}
+
+		if (has_transfer) {
+			if (!serialize_trivial_as_bytes(s, c.transfer)) {
+				return false;
 			}
+		}
 
-			const auto offset = -min_bound;
+		return true;
+	}
 
-			const auto min_io_bound = 0;
-			const auto max_io_bound = max_bound + offset;
+	template <class Stream>
+	bool serialize_player_ids_and_entropies(Stream& s, std::vector<client_entropy_entry>& p) {
+		const auto max_id = mode_player_id::machine_admin().value;
 
-			if (Stream::IsReading) {
-				auto& mot = get_motion();
+		auto cnt = static_cast<int>(p.size());
+		serialize_int(s, cnt, 1, max_mode_players_v);
 
-				serialize_int(s, mot.x, min_io_bound, max_io_bound);
-				serialize_int(s, mot.y, min_io_bound, max_io_bound);
+		if (Stream::IsReading) {
+			p.resize(cnt);
+		}
 
-				mot.x -= offset;
-				mot.y -= offset;
+		/*
+			The server sends the entries sorted by player id,
+			so it is enough to send the gaps between consecutive ids.
+		*/
+
+		auto strictly_ascending = [&]() {
+			for (std::size_t i = 1; i < p.size(); ++i) {
+				if (!(p[i - 1].player_id < p[i].player_id)) {
+					return false;
+				}
 			}
-			else {
-				auto mot = get_motion();
 
-				mot.x += offset;
-				mot.y += offset;
+			return true;
+		};
 
-				serialize_int(s, mot.x, min_io_bound, max_io_bound);
-				serialize_int(s, mot.y, min_io_bound, max_io_bound);
-			}
+		bool as_gaps = Stream::IsWriting && strictly_ascending();
+		serialize_bool(s, as_gaps);
 
-			{
-				const auto pos_after = s.GetBytesProcessed();
+		uint32_t lowest_next_id = 0;
 
-				if (motion_writable_in_one_byte) {
-					ensure_eq(1, pos_after - pos_before);
-				}
-				else if (motion_writable_in_two_bytes) {
-					ensure_eq(2, pos_after - pos_before);
+		for (auto& pp : p) {
+			auto& id = pp.player_id.value;
+
+			if (as_gaps) {
+				if (lowest_next_id > max_id) {
+					return false;
 				}
-				else {
-					ensure_eq(3, pos_after - pos_before);
+
+				uint32_t gap = id - lowest_next_id;
+
+				if (!serialize_exp_golomb(s, gap, 0, max_id - lowest_next_id)) {
+					return false;
 				}
+
+				id = lowest_next_id + gap;
+				lowest_next_id = id + 1;
+			}
+			else {
+				serialize_int(s, id, 0, max_id);
 			}
-		}
 
-		if (has_transfer) {
-			if (!serialize_trivial_as_bytes(s, c.transfer)) {
+			if (!serialize(s, pp.total)) {
 				return false;
 			}
 		}
@@ -511,23 +623,8 @@ namespace net_messages {
 		}
 
 		if (has_players) {
-			auto& p = i.players;
-			auto cnt = static_cast<int>(p.size());
-
-			serialize_int(s, cnt, 1, max_mode_players_v);
-
-			if (Stream::IsReading) {
-				p.resize(cnt);
-			}
-
-			for (auto& pp : p) {
-				if (!serialize(s, pp.player_id)) {
-					return false;
-				}
-
-				if (!serialize(s, pp.total)) {
-					return false;
-				}
+			if (!serialize_player_ids_and_entropies(s, i.players)) {
+				return false;
 			}
 		}
 
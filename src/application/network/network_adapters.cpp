@@ -1,3 +1,4 @@
+#include <mutex>
 #include "application/network/resolve_address.h"
 #include "application/network/server_adapter.h"
 #include "application/network/client_adapter.h"
@@ -10,6 +11,7 @@
 #include "3rdparty/yojimbo/netcode.io/netcode.c"
 #include "augs/readwrite/byte_readwrite.h"
 #include "augs/templates/thread_templates.h"
+#include "augs/templates/container_templates.h"
 
 #undef SendMessage
 #undef SetPort
@@ -29,10 +31,12 @@ void GameAdapter::OnServerClientDisconnected(const client_id_type clientIndex) {
 }
 
 void server_adapter::stop() {
+	unhook_send_scheduler();
 	server.Stop();
 }
 
 void server_adapter::client_connected(const client_id_type id) {
+	send_scheduler.reset_client(id);
 	pending_events.push_back({ id, true });
 }
 
@@ -104,7 +108,7 @@ game_connection_config::game_connection_config() {
 }
 
 void game_connection_config::set_max_packet_size(const unsigned s) {
-	protocolId = 8412;
+	protocolId = 8415;
 
 	maxPacketSize = s;
     maxPacketFragments = (int) ceil( maxPacketSize / packetFragmentSize );
@@ -179,6 +183,136 @@ bool auxiliary_command_function(void* context, struct netcode_address_t* from, u
 	return adapter->auxiliary_command_callback(*from, reinterpret_cast<const std::byte*>(packet), bytes);
 }
 
+/*
+	Netcode calls its send and receive overrides with the same context as yojimbo's own callbacks,
+	which yojimbo needs for itself, so the adapter is looked up by that context instead.
+*/
+
+static std::mutex hooked_adapters_lk;
+static std::vector<std::pair<void*, server_adapter*>> hooked_adapters;
+
+static server_adapter* find_hooked_adapter(void* const netcode_context) {
+	std::scoped_lock lock(hooked_adapters_lk);
+
+	for (const auto& h : hooked_adapters) {
+		if (h.first == netcode_context) {
+			return h.second;
+		}
+	}
+
+	return nullptr;
+}
+
+void server_send_packet_override(void* context, struct netcode_address_t* to, NETCODE_CONST uint8_t* packet, int bytes) {
+	if (auto* const adapter = find_hooked_adapter(context)) {
+		adapter->schedule_send(*to, packet, bytes);
+	}
+}
+
+int server_receive_packet_override(void* context, struct netcode_address_t* from, uint8_t* packet, int max_bytes) {
+	if (auto* const adapter = find_hooked_adapter(context)) {
+		return adapter->receive_from_sockets(*from, packet, max_bytes);
+	}
+
+	return 0;
+}
+
+void server_adapter::hook_send_scheduler() {
+	if (auto* const s = server.GetServerDetail()) {
+		{
+			std::scoped_lock lock(hooked_adapters_lk);
+			hooked_adapters.emplace_back(s->config.callback_context, this);
+		}
+
+		s->config.send_packet_override = server_send_packet_override;
+		s->config.receive_packet_override = server_receive_packet_override;
+		s->config.override_send_and_receive = 1;
+
+		send_scheduler_hooked = true;
+	}
+}
+
+void server_adapter::unhook_send_scheduler() {
+	if (!send_scheduler_hooked) {
+		return;
+	}
+
+	if (auto* const s = server.GetServerDetail()) {
+		flush_sends();
+
+		/* Whatever netcode sends from now on, like the disconnect packets on stop, goes straight to the socket. */
+		s->config.override_send_and_receive = 0;
+	}
+
+	std::scoped_lock lock(hooked_adapters_lk);
+	erase_if(hooked_adapters, [this](const auto& h) { return h.second == this; });
+
+	send_scheduler_hooked = false;
+}
+
+void server_adapter::schedule_send(const netcode_address_t& to, const uint8_t* const packet, const int bytes) {
+	client_id_type client_id = -1;
+
+	if (auto* const s = server.GetServerDetail()) {
+		auto address = to;
+
+		for (int i = 0; i < s->max_clients; ++i) {
+			if (s->client_connected[i] && netcode_address_equal(&s->client_address[i], &address)) {
+				client_id = i;
+				break;
+			}
+		}
+	}
+
+	send_scheduler.push(client_id, to, reinterpret_cast<const std::byte*>(packet), static_cast<std::size_t>(bytes), yojimbo_time());
+}
+
+int server_adapter::receive_from_sockets(netcode_address_t& from, uint8_t* const packet, const int max_bytes) {
+	auto* const s = server.GetServerDetail();
+
+	if (s == nullptr) {
+		return 0;
+	}
+
+	/* Same as what netcode reads when nothing overrides it. */
+
+	int bytes = 0;
+
+	if (s->socket_holder.ipv4.handle != 0) {
+		bytes = netcode_socket_receive_packet(&s->socket_holder.ipv4, &from, packet, max_bytes);
+	}
+
+	if (bytes == 0 && s->socket_holder.ipv6.handle != 0) {
+		bytes = netcode_socket_receive_packet(&s->socket_holder.ipv6, &from, packet, max_bytes);
+	}
+
+	return bytes;
+}
+
+void server_adapter::flush_sends() {
+	if (auto* const s = server.GetServerDetail()) {
+		auto& h = s->socket_holder;
+
+		send_scheduler.flush(
+			yojimbo_time(),
+			h.ipv4.handle != 0 ? &h.ipv4 : nullptr,
+			h.ipv6.handle != 0 ? &h.ipv6 : nullptr
+		);
+	}
+}
+
+void server_adapter::set_send_pacing(const uint32_t max_kbps_per_client) {
+	send_scheduler.set_pacing(max_kbps_per_client);
+}
+
+client_send_rates server_adapter::get_send_rates(const client_id_type id) const {
+	return send_scheduler.get_rates(id);
+}
+
+server_send_totals server_adapter::take_send_totals() {
+	return send_scheduler.take_totals();
+}
+
 server_adapter::server_adapter(const augs::server_listen_input& in, auxiliary_command_callback_type auxiliary_command_callback) :
 	connection_config(in),
 	adapter(this),
@@ -199,14 +333,38 @@ server_adapter::server_adapter(const augs::server_listen_input& in, auxiliary_co
 		detail->config.auxiliary_command_function = auxiliary_command_function;
 		detail->config.auxiliary_command_context = this;
 	}
+
+	hook_send_scheduler();
+}
+
+server_adapter::~server_adapter() {
+	unhook_send_scheduler();
 }
 
 void server_adapter::disconnect_client(const client_id_type& id) {
 	server.DisconnectClient(id);
+	flush_sends();
+}
+
+void server_adapter::receive_packets() {
+	if (!server.IsRunning() || last_advanced_time == std::nullopt) {
+		return;
+	}
+
+	/* 
+		Yojimbo reads the socket when its time advances. 
+		Passing the same time again reads the packets but leaves all timeouts and resends alone.
+	*/
+
+	server.AdvanceTime(*last_advanced_time);
+	server.ReceivePackets();
+
+	flush_sends();
 }
 
 void server_adapter::send_packets() {
 	server.SendPackets();
+	flush_sends();
 }
 
 client_adapter::client_adapter(const std::optional<port_type> preferred_binding_port) :
@@ -0,0 +1,30 @@
+#pragma once
+#include "application/network/interpolation_transfer.h"
+
+/*
+	Decorative organisms are only ever advanced in the cosmos that is being viewed,
+	once per step that moves it forward in time - never during reconciliation.
+	Transferring the referential solvable into the predicted one would throw them back
+	to wherever they were in the referential cosmos, so they are carried over the transfer instead.
+*/
+
+template <class E>
+struct organism_transfer_cache {
+	entity_property_vector<E, components::transform> transforms;
+	entity_property_vector<E, components::movement_path> movement_paths;
+	entity_property_vector<E, components::animation> animations;
+	entity_property_vector<E, augs::pool_indirector<cosmic_pool_size_type>> indirectors;
+};
+
+using entities_with_movement_path = entity_types_having_all_of<invariants::movement_path>;
+using organism_transfer_caches = per_type_container<entities_with_movement_path, organism_transfer_cache>;
+
+void save_organisms(
+	organism_transfer_caches& caches,
+	const cosmos& source
+);
+
+void restore_organisms(
+	const organism_transfer_caches& caches,
+	cosmos& target
+);
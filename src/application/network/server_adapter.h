@@ -1,7 +1,9 @@
 #pragma once
+#include <optional>
 #include <functional>
 #include "augs/global_libraries.h"
 #include "application/network/network_adapters.h"
+#include "application/network/server_send_scheduler.h"
 
 struct netcode_socket_t;
 
@@ -9,6 +11,8 @@ using auxiliary_command_callback_type = std::function<bool (const netcode_addres
 
 class server_adapter {
 	friend bool auxiliary_command_function(void* context, struct netcode_address_t* from, uint8_t* packet, int bytes);
+	friend void server_send_packet_override(void* context, struct netcode_address_t* to, NETCODE_CONST uint8_t* packet, int bytes);
+	friend int server_receive_packet_override(void* context, struct netcode_address_t* from, uint8_t* packet, int max_bytes);
 
 	std::array<uint8_t, yojimbo::KeyBytes> privateKey = {};
 	game_connection_config connection_config;
@@ -22,6 +26,19 @@ class server_adapter {
 	};
 
 	std::vector<connection_event> pending_events;
+	std::optional<net_time_t> last_advanced_time;
+
+	server_send_scheduler send_scheduler;
+	bool send_scheduler_hooked = false;
+
+	void hook_send_scheduler();
+	void unhook_send_scheduler();
+
+	void schedule_send(const netcode_address_t& to, const uint8_t* packet, int bytes);
+	int receive_from_sockets(netcode_address_t& from, uint8_t* packet, int max_bytes);
+
+	/* Hands everything netcode has sent since the last flush to the kernel. */
+	void flush_sends();
 
 	friend GameAdapter;
 
@@ -39,6 +56,7 @@ class server_adapter {
 
 public:
 	server_adapter(const augs::server_listen_input&, auxiliary_command_callback_type);
+	~server_adapter();
 
 	template <class H>
 	void advance(
@@ -46,6 +64,12 @@ public:
 		H&& handler
 	);
 
+	/*
+		Reads whatever arrived on the socket since the last advance, without advancing the time.
+		The messages stay queued until the next advance handles them.
+	*/
+	void receive_packets();
+
 	void send_packets();
 	void stop();
 
@@ -86,6 +110,12 @@ public:
 
 	void set(augs::maybe_network_simulator);
 
+	/* 0 sends everything as soon as it is due. */
+	void set_send_pacing(uint32_t max_kbps_per_client);
+
+	client_send_rates get_send_rates(client_id_type) const;
+	server_send_totals take_send_totals();
+
 	network_info get_network_info(client_id_type) const;
 	server_network_info get_server_network_info() const;
 
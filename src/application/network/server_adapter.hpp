@@ -26,6 +26,11 @@ void server_adapter::advance(const net_time_t server_time, H&& handler) {
     server.AdvanceTime(server_time);
     server.ReceivePackets();
 
+	/* Keep-alives, handshake responses and whatever the network simulator let through. */
+	flush_sends();
+
+	last_advanced_time = server_time;
+
 	process_connections_disconnections(std::forward<H>(handler));
 
 	for (int i = 0; i < static_cast<int>(max_incoming_connections_v); i++) {
@@ -0,0 +1,229 @@
+#include <utility>
+#include <algorithm>
+#include "augs/network/netcode_sockets.h"
+#include "application/network/server_send_scheduler.h"
+
+static bool is_valid_client(const client_id_type id) {
+	return id >= 0 && id < static_cast<client_id_type>(max_incoming_connections_v);
+}
+
+void server_send_scheduler::set_pacing(const uint32_t max_kbps) {
+	max_bytes_per_second = static_cast<double>(max_kbps) * 1000 / 8;
+
+	for (auto& c : clients) {
+		c.when_last_refilled = -1.0;
+	}
+}
+
+void server_send_scheduler::refill(client_state& c, const net_time_t now) {
+	const auto burst = std::max(max_bytes_per_second * pacing_burst_secs, double(NETCODE_MAX_PACKET_BYTES));
+
+	if (c.when_last_refilled < 0.0) {
+		c.budget_bytes = burst;
+	}
+	else {
+		const auto dt = std::max(0.0, now - c.when_last_refilled);
+		c.budget_bytes = std::min(c.budget_bytes + max_bytes_per_second * dt, burst);
+	}
+
+	c.when_last_refilled = now;
+}
+
+void server_send_scheduler::enqueue(client_state* const c, const netcode_address_t& to, const std::byte* const data, const std::size_t n) {
+	if (to.type == NETCODE_ADDRESS_IPV6) {
+		ipv6_batch.push(to, data, n);
+	}
+	else {
+		ipv4_batch.push(to, data, n);
+	}
+
+	if (c != nullptr) {
+		++c->window_datagrams;
+		c->window_bytes += n;
+	}
+
+	++totals.datagrams;
+	totals.bytes += n;
+}
+
+void server_send_scheduler::push(
+	const client_id_type client_id,
+	const netcode_address_t& to,
+	const std::byte* const data,
+	const std::size_t n,
+	const net_time_t now
+) {
+	if (!is_valid_client(client_id)) {
+		enqueue(nullptr, to, data, n);
+		return;
+	}
+
+	auto& c = clients[client_id];
+
+	if (!is_pacing()) {
+		enqueue(&c, to, data, n);
+		return;
+	}
+
+	refill(c, now);
+
+	/* The budget may go into debt by one datagram so that no datagram is ever too large to pass. */
+
+	if (c.held.empty() && c.budget_bytes > 0.0) {
+		c.budget_bytes -= static_cast<double>(n);
+		enqueue(&c, to, data, n);
+	}
+	else if (c.held.size() < max_held_per_client_v) {
+		c.held.push_back({ to, std::vector<std::byte>(data, data + n) });
+	}
+	else {
+		++c.rates.num_dropped;
+	}
+}
+
+void server_send_scheduler::flush(const net_time_t now, netcode_socket_t* const ipv4, netcode_socket_t* const ipv6) {
+	for (auto& c : clients) {
+		if (!c.held.empty()) {
+			if (is_pacing()) {
+				refill(c, now);
+			}
+
+			while (!c.held.empty() && (!is_pacing() || c.budget_bytes > 0.0)) {
+				const auto& d = c.held.front();
+
+				c.budget_bytes -= static_cast<double>(d.bytes.size());
+				enqueue(&c, d.to, d.bytes.data(), d.bytes.size());
+
+				c.held.pop_front();
+			}
+		}
+
+		c.rates.num_held = static_cast<uint32_t>(c.held.size());
+	}
+
+	auto send = [&](augs::udp_batch& batch, netcode_socket_t* const socket) {
+		if (batch.empty()) {
+			return;
+		}
+
+		if (socket != nullptr) {
+			totals.system_calls += batch.send_all(*socket);
+		}
+		else {
+			batch.clear();
+		}
+	};
+
+	send(ipv4_batch, ipv4);
+	send(ipv6_batch, ipv6);
+
+	update_rates(now);
+}
+
+void server_send_scheduler::update_rates(const net_time_t now) {
+	if (when_window_started < 0.0) {
+		when_window_started = now;
+		return;
+	}
+
+	const auto elapsed = now - when_window_started;
+
+	if (elapsed < 1.0) {
+		return;
+	}
+
+	for (auto& c : clients) {
+		c.rates.packets_per_second = static_cast<float>(c.window_datagrams / elapsed);
+		c.rates.bytes_per_second = static_cast<float>(c.window_bytes / elapsed);
+
+		c.window_datagrams = 0;
+		c.window_bytes = 0;
+	}
+
+	when_window_started = now;
+}
+
+void server_send_scheduler::reset_client(const client_id_type id) {
+	if (is_valid_client(id)) {
+		clients[id] = {};
+	}
+}
+
+client_send_rates server_send_scheduler::get_rates(const client_id_type id) const {
+	if (is_valid_client(id)) {
+		return clients[id].rates;
+	}
+
+	return {};
+}
+
+server_send_totals server_send_scheduler::take_totals() {
+	return std::exchange(totals, {});
+}
+
+#if BUILD_UNIT_TESTS
+#include <Catch/single_include/catch2/catch.hpp>
+
+TEST_CASE("ServerSendScheduler PacesEachClientSeparately") {
+	server_send_scheduler scheduler;
+
+	/* 80 kbps is 10000 bytes per second, in bursts of 1300 bytes at most. */
+	scheduler.set_pacing(80);
+
+	netcode_address_t to {};
+	to.type = NETCODE_ADDRESS_IPV4;
+
+	const auto datagram = std::vector<std::byte>(500);
+
+	auto push = [&](const client_id_type id, const net_time_t now) {
+		scheduler.push(id, to, datagram.data(), datagram.size(), now);
+	};
+
+	for (int i = 0; i < 10; ++i) {
+		push(0, 0.0);
+		push(1, 0.0);
+	}
+
+	/* Handshakes and the like are never held back. */
+	for (int i = 0; i < 10; ++i) {
+		push(-1, 0.0);
+	}
+
+	scheduler.flush(0.0, nullptr, nullptr);
+
+	REQUIRE(scheduler.get_rates(0).num_held == 7);
+	REQUIRE(scheduler.get_rates(1).num_held == 7);
+	REQUIRE(scheduler.take_totals().datagrams == 3 + 3 + 10);
+
+	/* Another 2000 bytes worth of budget after 0.2 seconds, but no more than a burst. */
+	scheduler.flush(0.2, nullptr, nullptr);
+
+	REQUIRE(scheduler.get_rates(0).num_held == 4);
+	REQUIRE(scheduler.take_totals().datagrams == 3 + 3);
+
+	scheduler.flush(1.0, nullptr, nullptr);
+
+	REQUIRE(scheduler.get_rates(0).num_held == 1);
+
+	/* Nine went out to each client during the first second. */
+	REQUIRE(scheduler.get_rates(0).packets_per_second == Approx(9.0f));
+	REQUIRE(scheduler.get_rates(0).bytes_per_second == Approx(4500.0f));
+
+	scheduler.set_pacing(0);
+	scheduler.flush(1.5, nullptr, nullptr);
+
+	REQUIRE(scheduler.get_rates(0).num_held == 0);
+	REQUIRE(scheduler.get_rates(1).num_held == 0);
+
+	scheduler.flush(2.0, nullptr, nullptr);
+
+	/* And the last one during the next. */
+	REQUIRE(scheduler.get_rates(0).packets_per_second == Approx(1.0f));
+	REQUIRE(scheduler.get_rates(0).bytes_per_second == Approx(500.0f));
+
+	scheduler.reset_client(0);
+
+	REQUIRE(scheduler.get_rates(0).packets_per_second == 0.0f);
+	REQUIRE(scheduler.get_rates(1).packets_per_second == Approx(1.0f));
+}
+#endif
@@ -0,0 +1,98 @@
+#pragma once
+#include <array>
+#include <deque>
+#include <vector>
+#include "augs/network/udp_batch.h"
+#include "augs/network/network_types.h"
+
+struct client_send_rates {
+	float packets_per_second = 0.f;
+	float bytes_per_second = 0.f;
+
+	/* Datagrams that wait for the pacing to let them through. */
+	uint32_t num_held = 0;
+	uint64_t num_dropped = 0;
+};
+
+struct server_send_totals {
+	uint64_t datagrams = 0;
+	uint64_t bytes = 0;
+	uint64_t system_calls = 0;
+};
+
+/*
+	Everything netcode sends from the server socket goes through here instead of straight to sendto.
+
+	Yojimbo already coalesces all messages due for a client, across all channels,
+	into a single packet per send_packets, so there is nothing more to merge here.
+	What remains is that each of these packets used to cost a system call of its own.
+	The scheduler queues them and the server adapter flushes them with one sendmmsg
+	per up to udp_batch::max_datagrams_per_call_v datagrams, once per send_packets and advance.
+
+	With pacing, a client is allowed at most max_kbps on average,
+	in bursts of up to pacing_burst_secs worth of it.
+	Whatever exceeds it is held in order and released by later flushes.
+	Datagrams to addresses that are not connected clients, like handshakes, are never held.
+*/
+
+class server_send_scheduler {
+	static constexpr double pacing_burst_secs = 0.05;
+	static constexpr std::size_t max_held_per_client_v = 256;
+
+	struct held_datagram {
+		netcode_address_t to;
+		std::vector<std::byte> bytes;
+	};
+
+	struct client_state {
+		double budget_bytes = 0.0;
+		net_time_t when_last_refilled = -1.0;
+
+		std::deque<held_datagram> held;
+
+		uint64_t window_datagrams = 0;
+		uint64_t window_bytes = 0;
+
+		client_send_rates rates;
+	};
+
+	std::array<client_state, max_incoming_connections_v> clients;
+
+	augs::udp_batch ipv4_batch;
+	augs::udp_batch ipv6_batch;
+
+	double max_bytes_per_second = 0.0;
+	net_time_t when_window_started = -1.0;
+
+	server_send_totals totals;
+
+	bool is_pacing() const {
+		return max_bytes_per_second > 0.0;
+	}
+
+	void refill(client_state&, net_time_t now);
+	void enqueue(client_state*, const netcode_address_t& to, const std::byte* data, std::size_t n);
+	void update_rates(net_time_t now);
+
+public:
+	/* 0 turns the pacing off. Held datagrams are released on the next flush. */
+	void set_pacing(uint32_t max_kbps);
+
+	/* client_id is -1 if the address does not belong to a connected client. */
+	void push(
+		client_id_type client_id,
+		const netcode_address_t& to,
+		const std::byte* data,
+		std::size_t n,
+		net_time_t now
+	);
+
+	void flush(net_time_t now, netcode_socket_t* ipv4, netcode_socket_t* ipv6);
+
+	void reset_client(client_id_type);
+
+	client_send_rates get_rates(client_id_type) const;
+
+	/* Since the last call. */
+	server_send_totals take_totals();
+};
@@ -51,8 +51,13 @@ struct compact_server_step_entropy {
 	}
 
 	template <class F, class G>
-	auto unpack(F&& mode_id_to_entity_id, G&& get_settings_for) const {
-		server_step_entropy out;
+	void unpack_into(server_step_entropy& out, F&& mode_id_to_entity_id, G&& get_settings_for) const {
+		/* 
+			Clearing instead of constructing anew keeps the capacities of the target,
+			so an entropy object reused from step to step does not allocate.
+		*/
+
+		out.clear();
 		out.general = general;
 
 		for (const auto& p : players) {
@@ -72,7 +77,12 @@ struct compact_server_step_entropy {
 				}
 			}
 		}
+	}
 
+	template <class F, class G>
+	auto unpack(F&& mode_id_to_entity_id, G&& get_settings_for) const {
+		server_step_entropy out;
+		unpack_into(out, std::forward<F>(mode_id_to_entity_id), std::forward<G>(get_settings_for));
 		return out;
 	}
 
@@ -144,3 +144,74 @@ void simulation_receiver::drag_mispredictions_into_past(
 		);
 	}
 }
+
+#if BUILD_UNIT_TESTS
+#include <unordered_set>
+#include <Catch/single_include/catch2/catch.hpp>
+
+TEST_CASE("SimulationReceiver SteadyStateEntropiesDoNotAllocate") {
+	compact_server_step_entropy compact;
+
+	for (unsigned i = 0; i < 16; ++i) {
+		client_entropy_entry entry;
+		entry.player_id = mode_player_id(i);
+		entry.total.cosmic.motions[game_motion_type::MOVE_CROSSHAIR] = { 1, -1 };
+		entry.total.cosmic.intents.push_back({ game_intent_type::SHOOT, intent_change::PRESSED });
+
+		compact.players.push_back(entry);
+	}
+
+	auto mode_id_to_entity_id = [](const mode_player_id& mode_id) {
+		entity_id out;
+		out.raw.indirection_index = mode_id.value;
+		out.type_id.set<controlled_character>();
+		return out;
+	};
+
+	auto get_settings_for = [](const mode_player_id&) {
+		return per_character_input_settings();
+	};
+
+	server_step_entropy unpacked;
+	compact.unpack_into(unpacked, mode_id_to_entity_id, get_settings_for);
+
+	REQUIRE(unpacked.cosmic.players.size() == 16);
+
+	/* 
+		Any heap allocation in the steady state would have to move the player storage
+		of either the unpacked entropy or one of the recycled predicted entropies.
+	*/
+
+	const auto* const unpacked_storage = std::addressof(*unpacked.cosmic.players.begin());
+	const auto unpacked_capacity = unpacked.cosmic.players.capacity();
+
+	augs::recycling_vector<server_step_entropy> predicted;
+	std::unordered_set<const void*> storages_after_warmup;
+
+	const auto warmup_steps = 10;
+	const auto max_predicted = 6;
+
+	for (int step = 0; step < 100; ++step) {
+		compact.unpack_into(unpacked, mode_id_to_entity_id, get_settings_for);
+
+		REQUIRE(std::addressof(*unpacked.cosmic.players.begin()) == unpacked_storage);
+		REQUIRE(unpacked.cosmic.players.capacity() == unpacked_capacity);
+
+		const auto& pushed = predicted.push_back(unpacked);
+		REQUIRE(pushed == unpacked);
+
+		const auto* const pushed_storage = std::addressof(*pushed.cosmic.players.begin());
+
+		if (step < warmup_steps) {
+			storages_after_warmup.emplace(pushed_storage);
+		}
+		else {
+			REQUIRE(storages_after_warmup.find(pushed_storage) != storages_after_warmup.end());
+		}
+
+		if (predicted.size() >= max_predicted) {
+			erase_first_n(predicted, max_predicted / 2);
+		}
+	}
+}
+#endif
@@ -4,6 +4,7 @@
 #include "augs/log.h"
 
 #include "augs/network/jitter_buffer.h"
+#include "augs/templates/recycling_vector.h"
 #include "augs/templates/logically_empty.h"
 #include "game/cosmos/cosmic_functions.h"
 
@@ -14,6 +15,7 @@
 #include "application/network/simulation_receiver_settings.h"
 
 #include "application/network/interpolation_transfer.h"
+#include "application/network/organism_transfer.h"
 
 /* Prediction is too costly in debug builds. */
 #define USE_CLIENT_PREDICTION NDEBUG
@@ -77,9 +79,13 @@ public:
 	};
 
 	std::vector<prestep_client_context> incoming_contexts;
-	std::vector<incoming_entropy_entry> incoming_entropies;
-	std::vector<simulated_entropy_type> predicted_entropies;
+	augs::recycling_vector<incoming_entropy_entry> incoming_entropies;
+	augs::recycling_vector<simulated_entropy_type> predicted_entropies;
 	interpolation_transfer_caches transfer_caches;
+	organism_transfer_caches organism_caches;
+
+	/* Reused for every unpacked step so that unpacking does not allocate. */
+	simulated_entropy_type unpacked_entropy;
 
 	bool schedule_reprediction = false;
 
@@ -99,7 +105,12 @@ public:
 		const received_entropy_type& payload
 	) {
 		incoming_contexts.push_back(context);
-		incoming_entropies.push_back({meta, payload});
+
+		{
+			auto& new_entry = incoming_entropies.push_back({});
+			new_entry.meta = meta;
+			new_entry.payload = payload;
+		}
 
 		if (incoming_contexts.size() < incoming_entropies.size()) {
 			incoming_contexts.emplace_back();
@@ -204,15 +215,22 @@ public:
 				}
 
 				{
-					const bool shall_reinfer = meta.reinference_necessary || logically_set(actual_server_step.payload.general.added_player);
+					/*
+						Joining players catch up from the last join epoch instead,
+						so only the server decides when everyone starts over - see server_setup::reinfer_if_necessary_for.
+					*/
+
+					const bool shall_reinfer = meta.reinference_necessary;
 
 					if (shall_reinfer) {
-						LOG("Added player in the next entropy. Will reinfer to sync.");
+						LOG("Server requested reinference in the next entropy. Will reinfer to sync.");
 						cosmic::reinfer_solvable(referential_arena.get_cosmos());
 					}
 
 					{
-						const auto& actual_server_entropy = unpack_entropy(actual_server_step.payload);
+						unpack_entropy(actual_server_step.payload, unpacked_entropy);
+
+						const auto& actual_server_entropy = unpacked_entropy;
 
 						advance_referential(actual_server_entropy);
 
@@ -278,6 +296,7 @@ public:
 			);
 
 			::save_interpolations(transfer_caches, std::as_const(predicted_cosmos));
+			::save_organisms(organism_caches, std::as_const(predicted_cosmos));
 
 			predicted_arena.transfer_all_solvables(referential_arena);
 
@@ -292,6 +311,7 @@ public:
 			}
 
 			::restore_interpolations(transfer_caches, predicted_cosmos);
+			::restore_organisms(organism_caches, predicted_cosmos);
 
 			drag_mispredictions_into_past(
 				settings, 
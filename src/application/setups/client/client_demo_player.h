@@ -1,6 +1,9 @@
 #pragma once
 #include "application/gui/client/demo_player_gui.h"
 #include "augs/misc/timing/fixed_delta_timer.h"
+#include "augs/misc/compress.h"
+#include "augs/readwrite/stream_read_error.h"
+#include "application/setups/client/demo_container.h"
 
 struct client_demo_player {
 	int additional_steps = 0;
@@ -9,10 +12,10 @@ struct client_demo_player {
 	demo_player_gui gui = std::string("Player");
 	bool paused = false;
 	demo_file_meta meta;
-	demo_step default_step;
+	demo_step_view default_step;
 
 	std::optional<demo_step_num_type> requested_seek;
-	std::vector<demo_step> demo_steps;
+	demo_container demo_steps;
 	demo_step_num_type current_step = 0;
 
 	double speed = 1.0;
@@ -60,12 +63,22 @@ struct client_demo_player {
 		return is_paused() ? 0.0 : speed;
 	}
 
-	const auto& get_nth_step(const demo_step_num_type n) const {
-		if (all_steps_played()) {
+	const demo_step_view& get_nth_step(const demo_step_num_type n) {
+		if (all_steps_played() || !replay_failed_reason.empty()) {
 			return default_step;
 		}
 
-		return demo_steps[n];
+		try {
+			return demo_steps.get_step(n);
+		}
+		catch (const augs::stream_read_error& err) {
+			replay_failed_reason = err.what();
+		}
+		catch (const augs::decompression_error& err) {
+			replay_failed_reason = err.what();
+		}
+
+		return default_step;
 	}
 
 	void seek_backward(const demo_step_num_type offset) {
@@ -37,6 +37,8 @@
 #include "application/network/net_serialize.h"
 #include "augs/readwrite/byte_file.h"
 #include "application/gui/client/demo_player_gui.hpp"
+#include "game/inferred_caches/is_organism.h"
+#include "game/stateless_systems/movement_path_system.h"
 
 #include "application/setups/client/handle_server_payload.hpp"
 #include "application/network/resolve_address.h"
@@ -46,10 +48,7 @@
 
 void client_demo_player::play_demo_from(const augs::path_type& p) {
 	source_path = p;
-	auto source = augs::open_binary_input_stream(source_path);
-
-	augs::read_bytes(source, meta);
-	augs::read_vector_until_eof(source, demo_steps);
+	meta = demo_steps.open(source_path);
 
 	gui.open();
 }
@@ -96,7 +95,7 @@ bool client_demo_player::control(const handle_input_before_game_input in) {
 	return false;
 }
 
-void client_setup::demo_replay_server_messages_from(const demo_step& step) {
+void client_setup::demo_replay_server_messages_from(const demo_step_view& step) {
 	for (auto& s : step.serialized_messages) {
 		auto replay_message = [this](auto& typed_msg) -> message_handler_result {
 			using net_message_type = remove_cref<decltype(typed_msg)>;
@@ -166,9 +165,7 @@ void client_setup::flush_demo_steps() {
 				was_demo_meta_written = true;
 			}
 
-			for (const auto& s : demo_steps_being_flushed) {
-				augs::write_bytes(out, s);
-			}
+			write_demo_blocks(out, demo_steps_being_flushed);
 
 			out.flush();
 			demo_steps_being_flushed.clear();
@@ -860,6 +857,8 @@ bool client_setup::is_connected() const {
 void client_setup::send_to_server(
 	total_client_entropy& new_local_entropy
 ) {
+	outgoing_motions.encode(new_local_entropy);
+
 	send_payload(
 		game_channel_type::CLIENT_COMMANDS,
 		new_local_entropy
@@ -1074,6 +1073,58 @@ void restore_interpolations(
 	);
 }
 
+void save_organisms(
+	organism_transfer_caches& caches,
+	const cosmos& source
+) {
+	source.get_solvable().significant.entity_pools.for_each_container(
+		[&](const auto& p) {
+			using P = remove_cref<decltype(p)>;
+			using V = typename P::mapped_type;
+			using E = entity_type_of<V>;
+
+			if constexpr(has_all_of_v<E, invariants::movement_path>) {
+				auto& c = caches.get_for<E>();
+				c.transforms = p.template get_corresponding_array<components::transform>();
+				c.movement_paths = p.template get_corresponding_array<components::movement_path>();
+				c.animations = p.template get_corresponding_array<components::animation>();
+				c.indirectors = p.get_indirectors();
+			}
+		}
+	);
+}
+
+void restore_organisms(
+	const organism_transfer_caches& caches,
+	cosmos& target
+) {
+	target.for_each_having<invariants::movement_path>(
+		[&](const auto& typed_organism) {
+			using E = entity_type_of<decltype(typed_organism)>;
+
+			const auto id = typed_organism.get_id();
+			const auto& c = caches.get_for<E>();
+
+			const auto transform = ::find_in_indirectors(c.indirectors, c.transforms, id.raw);
+
+			if (transform == nullptr) {
+				return;
+			}
+
+			auto& restored_transform = typed_organism.template get<components::transform>();
+			const auto old_position = restored_transform.pos;
+
+			restored_transform = *transform;
+			typed_organism.template get<components::movement_path>() = *::find_in_indirectors(c.indirectors, c.movement_paths, id.raw);
+			typed_organism.template get<components::animation>() = *::find_in_indirectors(c.indirectors, c.animations, id.raw);
+
+			if (::is_organism(typed_organism)) {
+				movement_path_system().recalculate_cell_for(target, id, old_position, transform->pos);
+			}
+		}
+	);
+}
+
 void client_setup::handle_new_session(const add_player_input& in) {
 	const auto new_player = in.id;
 	const auto new_session_id = find_session_id(new_player);
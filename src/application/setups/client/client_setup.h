@@ -20,6 +20,7 @@
 
 #include "application/predefined_rulesets.h"
 #include "application/arena/mode_and_rules.h"
+#include "game/modes/round_template.h"
 #include "augs/readwrite/memory_stream_declaration.h"
 #include "augs/misc/serialization_buffers.h"
 
@@ -30,6 +31,7 @@
 #include "application/network/requested_client_settings.h"
 
 #include "application/network/simulation_receiver.h"
+#include "application/network/motion_delta_coder.h"
 #include "application/session_profiler.h"
 #include "application/setups/client/lag_compensation_settings.h"
 
@@ -67,6 +69,9 @@ class client_setup :
 	intercosm scene;
 	cosmos_solvable_significant initial_signi;
 
+	/* Built from the above at the first round start, see round_template. */
+	round_template initial_round;
+
 	predefined_rulesets rulesets;
 
 	/* Other replicated state */
@@ -82,6 +87,12 @@ class client_setup :
 	std::vector<special_client_request> pending_requests;
 	bool now_resyncing = false;
 
+	/* Steps the server replays to us after the initial state, see join_epoch. */
+	uint32_t catch_up_steps_left = 0;
+
+	/* The cosmos whose decorative organisms were last advanced, see organism_transfer.h. */
+	std::optional<client_arena_type> organisms_advanced_in;
+
 	arena_player_metas player_metas;
 
 	/* The rest is client-specific */
@@ -89,6 +100,9 @@ class client_setup :
 
 	simulation_receiver receiver;
 
+	motion_delta_coder incoming_motions;
+	motion_delta_coder outgoing_motions;
+
 	address_and_port last_addr;
 	netcode_address_t resolved_server_address;
 	client_state_type state = client_state_type::INITIATING_CONNECTION;
@@ -163,7 +177,8 @@ class client_setup :
 				self.scene,
 				self.predicted_cosmos,
 				self.rulesets,
-				self.initial_signi
+				self.initial_signi,
+				std::addressof(self.initial_round)
 			};
 		}
 		else {
@@ -174,7 +189,8 @@ class client_setup :
 				self.scene,
 				self.scene.world,
 				self.rulesets,
-				self.initial_signi
+				self.initial_signi,
+				std::addressof(self.initial_round)
 			};
 		}
 	}
@@ -203,11 +219,17 @@ class client_setup :
 	void play_demo_from(const augs::path_type&);
 	void record_demo_to(const augs::path_type&);
 
-	void demo_replay_server_messages_from(const demo_step&);
+	void demo_replay_server_messages_from(const demo_step_view&);
 
 	auto make_accumulator_input(const client_advance_input& in) {
 		auto accumulator_in = in.make_accumulator_input();
 		accumulator_in.settings.character = current_requested_settings.public_settings.character_input;
+
+		/* Assigned by the server, so predict with whatever it last broadcast for us. */
+		if (const auto local_id = get_local_player_id(); local_id.value < player_metas.size()) {
+			accumulator_in.settings.character.lag_compensation_steps = player_metas[local_id.value].public_settings.character_input.lag_compensation_steps;
+		}
+
 		return accumulator_in;
 	}
 
@@ -242,9 +264,19 @@ class client_setup :
 			}
 		});
 
+		/*
+			Decorative organisms are not authoritative.
+			They are only advanced in the cosmos that is being viewed, once per step that moves it forward,
+			and never when reconciling - see organism_transfer.h.
+		*/
+
+		const bool organisms_in_referential = get_viewed_arena_type() == client_arena_type::REFERENTIAL;
+
 		const auto referential_solve_settings = [&]() {
 			solve_settings out;
 			out.effect_prediction = in.lag_compensation.effect_prediction;
+			out.simulate_decorative_organisms = organisms_in_referential;
+			out.organism_pool = &in.pool;
 			return out;
 		}();
 
@@ -256,14 +288,15 @@ class client_setup :
 				out.disable_knockouts = get_viewed_character();
 			}
 
-			out.simulate_decorative_organisms = in.lag_compensation.simulate_decorative_organisms_during_reconciliation;
+			out.simulate_decorative_organisms = false;
 
 			return out;
 		}();
 
 		const auto predicted_solve_settings = [&]() {
 			auto out = repredicted_solve_settings;
-			out.simulate_decorative_organisms = true;
+			out.simulate_decorative_organisms = !organisms_in_referential;
+			out.organism_pool = &in.pool;
 			return out;
 		}();
 
@@ -322,6 +355,25 @@ class client_setup :
 			auto referential_arena = get_arena_handle(client_arena_type::REFERENTIAL);
 			auto predicted_arena = get_arena_handle(client_arena_type::PREDICTED);
 
+			{
+				/* 
+					Organisms were frozen in the cosmos that was not viewed,
+					so carry them over once the other one is viewed, or they would teleport.
+				*/
+
+				const auto now_advanced_in = organisms_in_referential ? client_arena_type::REFERENTIAL : client_arena_type::PREDICTED;
+
+				if (organisms_advanced_in != std::nullopt && *organisms_advanced_in != now_advanced_in) {
+					auto& from = organisms_in_referential ? predicted_arena.advanced_cosm : referential_arena.advanced_cosm;
+					auto& to = organisms_in_referential ? referential_arena.advanced_cosm : predicted_arena.advanced_cosm;
+
+					::save_organisms(receiver.organism_caches, std::as_const(from));
+					::restore_organisms(receiver.organism_caches, to);
+				}
+
+				organisms_advanced_in = now_advanced_in;
+			}
+
 			auto audiovisual_post_solve = callbacks.post_solve;
 
 			auto for_each_effect_queue = [&](const const_logic_step step, auto callback) {
@@ -344,6 +396,11 @@ class client_setup :
 				auto scope = measure_scope(performance.unpacking_remote_steps);
 
 				auto referential_post_solve = [&](const const_logic_step step) {
+					if (catch_up_steps_left > 0) {
+						/* These have long been seen and heard by everyone else. */
+						return;
+					}
+
 					audiovisual_post_solve_settings settings;
 
 					if (is_spectating_referential()) {
@@ -387,6 +444,10 @@ class client_setup :
 				auto advance_referential = [&](const auto& entropy) {
 					referential_arena.advance(entropy, referential_callbacks, referential_solve_settings);
 
+					if (catch_up_steps_left > 0) {
+						--catch_up_steps_left;
+					}
+
 					const auto& added = entropy.general.added_player;
 
 					if (logically_set(added)) {
@@ -409,7 +470,7 @@ class client_setup :
 					schedule_reprediction_if_inconsistent(reprediction_result);
 				};
 
-				auto unpack = [&](const compact_server_step_entropy& entropy) {
+				auto unpack = [&](const compact_server_step_entropy& entropy, server_step_entropy& into) {
 					auto mode_id_to_entity_id = [&](const mode_player_id& mode_id) {
 						return get_arena_handle(client_arena_type::REFERENTIAL).on_mode(
 							[&](const auto& typed_mode) {
@@ -422,7 +483,7 @@ class client_setup :
 						return player_metas[mode_id.value].public_settings.character_input;
 					};
 
-					return entropy.unpack(mode_id_to_entity_id, get_settings_for);
+					entropy.unpack_into(into, mode_id_to_entity_id, get_settings_for);
 				};
 
 				const auto result = receiver.unpack_deterministic_steps(
@@ -593,7 +654,7 @@ public:
 		const Callbacks& callbacks
 	) {
 		if (is_replaying()) {
-			auto advance_with = [&](const demo_step& step) {
+			auto advance_with = [&](const demo_step_view& step) {
 				const auto dt = get_inv_tickrate();
 
 				auto local_entropy_provider = [&]() {
@@ -606,7 +667,7 @@ public:
 
 			bool needs_snap = false;
 
-			auto seeking_advance = [&](const demo_step& step) {
+			auto seeking_advance = [&](const demo_step_view& step) {
 				const auto dt = get_inv_tickrate();
 
 				auto local_entropy_provider = [&]() {
@@ -643,6 +704,11 @@ public:
 				get_inv_tickrate()
 			);
 
+			if (!demo_player.replay_failed_reason.empty()) {
+				set_demo_failed_reason(demo_player.replay_failed_reason);
+				disconnect();
+			}
+
 			if (needs_snap) {
 				snap_interpolation_of_viewed();
 			}
@@ -0,0 +1,444 @@
+#include <cstring>
+#include <fstream>
+#include <utility>
+#include <algorithm>
+
+#include "augs/log.h"
+#include "augs/misc/compress.h"
+#include "augs/readwrite/to_bytes.h"
+#include "augs/readwrite/memory_stream.h"
+#include "augs/readwrite/byte_readwrite.h"
+#include "augs/filesystem/file.h"
+#include "augs/readwrite/byte_file.h"
+
+#include "application/setups/client/demo_container.h"
+#include "application/setups/client/demo_step.h"
+
+/*
+	Reads a serialized demo_step, except that the message bytes are not copied:
+	their sizes are read and the view remembers where they begin.
+*/
+
+template <class S>
+static void read_step_view(S& ar, demo_step_view& into) {
+	into.local_entropy.reset();
+	into.serialized_messages.clear();
+
+	augs::read_bytes(ar, into.local_entropy);
+
+	unsigned num_messages = 0;
+	augs::read_bytes(ar, num_messages);
+
+	for (unsigned i = 0; i < num_messages; ++i) {
+		unsigned num_bytes = 0;
+		augs::read_bytes(ar, num_bytes);
+
+		const auto pos = ar.get_read_pos();
+
+		if (pos + num_bytes > ar.size()) {
+			throw augs::stream_read_error(
+				"Message %x of %x takes %x bytes but only %x are left.",
+				i,
+				num_messages,
+				num_bytes,
+				ar.size() - pos
+			);
+		}
+
+		into.serialized_messages.push_back({ std::as_const(ar).data() + pos, num_bytes });
+		ar.set_read_pos(pos + num_bytes);
+	}
+}
+
+void write_demo_blocks(std::ofstream& out, const std::vector<demo_step>& steps) {
+	auto state = augs::make_compression_state();
+
+	std::vector<std::byte> uncompressed;
+	std::vector<std::byte> compressed;
+
+	for (std::size_t first = 0; first < steps.size(); first += max_demo_steps_per_block_v) {
+		const auto last = std::min(steps.size(), first + max_demo_steps_per_block_v);
+
+		uncompressed.clear();
+		compressed.clear();
+
+		{
+			auto s = augs::ref_memory_stream(uncompressed);
+
+			for (std::size_t i = first; i < last; ++i) {
+				augs::write_bytes(s, steps[i]);
+			}
+		}
+
+		augs::compress(state, uncompressed, compressed);
+
+		demo_block_header header;
+		header.num_steps = static_cast<uint32_t>(last - first);
+		header.compressed_size = static_cast<uint32_t>(compressed.size());
+		header.uncompressed_size = static_cast<uint32_t>(uncompressed.size());
+
+		augs::write_bytes(out, header);
+		out.write(reinterpret_cast<const char*>(compressed.data()), compressed.size());
+	}
+}
+
+demo_file_meta demo_container::open(const augs::path_type& path) {
+	*this = demo_container();
+	file = augs::mapped_file(path);
+
+	auto ar = augs::make_read_stream(file.data(), file.size());
+
+	demo_file_meta meta;
+	augs::read_bytes(ar, meta);
+
+	steps_offset = ar.get_read_pos();
+
+	uint32_t magic = 0;
+
+	if (steps_offset + sizeof(magic) <= file.size()) {
+		std::memcpy(&magic, file.data() + steps_offset, sizeof(magic));
+	}
+
+	if (magic == demo_block_magic_v || magic == demo_block_magic_older_simulation_v) {
+		index_blocks(magic);
+	}
+	else {
+		index_legacy_steps();
+	}
+
+	older_simulation = magic != demo_block_magic_v;
+
+	if (older_simulation) {
+		LOG("%x was recorded with an older version of the simulation (%x). It will not replay faithfully.", path, meta.version.get_summary());
+	}
+
+	return meta;
+}
+
+void demo_container::index_blocks(const uint32_t magic) {
+	/*
+		The recording client appends to the file while the game runs,
+		so if it crashed, the last block might be cut short.
+		Everything before it still plays.
+	*/
+
+	auto offset = steps_offset;
+
+	while (offset < file.size()) {
+		demo_block_header header;
+
+		if (offset + sizeof(header) > file.size()) {
+			LOG("The demo ends with a truncated block header at %x. Ignoring it.", offset);
+			break;
+		}
+
+		std::memcpy(&header, file.data() + offset, sizeof(header));
+
+		if (header.magic != magic) {
+			LOG("Demo block at %x has a wrong magic number (%x). Ignoring the rest of the demo.", offset, header.magic);
+			break;
+		}
+
+		if (header.num_steps == 0 || header.num_steps > max_demo_steps_per_block_v) {
+			LOG("Demo block at %x has an invalid number of steps (%x). Ignoring the rest of the demo.", offset, header.num_steps);
+			break;
+		}
+
+		if (header.uncompressed_size < header.num_steps || header.uncompressed_size > std::size_t(header.compressed_size) * max_demo_block_compression_ratio_v) {
+			LOG(
+				"Demo block at %x has an implausible size (%x compressed, %x uncompressed). Ignoring the rest of the demo.", 
+				offset, 
+				header.compressed_size, 
+				header.uncompressed_size
+			);
+
+			break;
+		}
+
+		const auto payload_offset = offset + sizeof(header);
+
+		if (payload_offset + header.compressed_size > file.size()) {
+			LOG("The demo ends with a truncated block at %x. Ignoring it.", offset);
+			break;
+		}
+
+		blocks.push_back({ payload_offset, static_cast<demo_step_num_type>(total_steps), header });
+
+		total_steps += header.num_steps;
+		offset = payload_offset + header.compressed_size;
+	}
+}
+
+void demo_container::index_legacy_steps() {
+	auto ar = augs::make_read_stream(file.data(), file.size());
+	ar.set_read_pos(steps_offset);
+
+	demo_step_view scratch;
+
+	try {
+		while (ar.get_read_pos() < ar.size()) {
+			const auto pos = ar.get_read_pos();
+
+			read_step_view(ar, scratch);
+			legacy_step_offsets.push_back(pos);
+		}
+	}
+	catch (const augs::stream_read_error& err) {
+		LOG("The demo is truncated at step %x: %x", legacy_step_offsets.size(), err.what());
+	}
+
+	total_steps = legacy_step_offsets.size();
+}
+
+void demo_container::load_block(const std::size_t index) {
+	cached_block = std::nullopt;
+
+	auto& block = blocks[index];
+
+	std::size_t num_read = 0;
+
+	try {
+		decompressed.resize(block.header.uncompressed_size);
+		augs::decompress(file.data() + block.payload_offset, block.header.compressed_size, decompressed);
+
+		auto ar = augs::make_read_stream(decompressed.data(), decompressed.size());
+
+		cached_steps.resize(block.header.num_steps);
+
+		for (auto& s : cached_steps) {
+			read_step_view(ar, s);
+			++num_read;
+		}
+	}
+	catch (const augs::stream_read_error& err) {
+		LOG("The demo is truncated at step %x: %x", block.first_step + num_read, err.what());
+	}
+	catch (const augs::decompression_error& err) {
+		LOG("The demo is truncated at step %x: %x", block.first_step + num_read, err.what());
+	}
+
+	if (num_read < block.header.num_steps) {
+		/* Everything from this step on is gone, the same as when a legacy demo is indexed. */
+		block.header.num_steps = static_cast<uint32_t>(num_read);
+		cached_steps.resize(num_read);
+
+		blocks.resize(index + 1);
+		total_steps = block.first_step + num_read;
+	}
+
+	cached_block = index;
+}
+
+const demo_step_view& demo_container::get_step(const demo_step_num_type n) {
+	if (!legacy_step_offsets.empty()) {
+		auto ar = augs::make_read_stream(file.data(), file.size());
+		ar.set_read_pos(legacy_step_offsets[n]);
+
+		read_step_view(ar, legacy_step);
+		return legacy_step;
+	}
+
+	if (n >= total_steps) {
+		throw augs::stream_read_error("Step %x is past the end of the demo (%x steps).", n, total_steps);
+	}
+
+	const auto found = std::upper_bound(
+		blocks.begin(),
+		blocks.end(),
+		n,
+		[](const demo_step_num_type step, const block_entry& b) {
+			return step < b.first_step;
+		}
+	);
+
+	const auto index = static_cast<std::size_t>(std::distance(blocks.begin(), found) - 1);
+
+	if (cached_block != index) {
+		load_block(index);
+	}
+
+	const auto in_block = n - blocks[index].first_step;
+
+	if (in_block >= cached_steps.size()) {
+		throw augs::stream_read_error("Step %x is past the end of the demo, which was truncated at %x.", n, total_steps);
+	}
+
+	return cached_steps[in_block];
+}
+
+#if BUILD_UNIT_TESTS
+#include <Catch/single_include/catch2/catch.hpp>
+
+TEST_CASE("DemoContainer BlocksAndLegacy") {
+	const auto path = augs::path_type(GENERATED_FILES_DIR "/test_demo_container.dem");
+
+	std::vector<demo_step> steps;
+	steps.resize(max_demo_steps_per_block_v + 10);
+
+	for (std::size_t i = 0; i < steps.size(); ++i) {
+		auto& s = steps[i];
+
+		if (i % 3 == 0) {
+			s.local_entropy.emplace();
+		}
+
+		for (std::size_t m = 0; m < i % 4; ++m) {
+			s.serialized_messages.emplace_back(m + 1, static_cast<std::byte>(i));
+		}
+	}
+
+	auto require_same = [&](demo_container& demo) {
+		REQUIRE(demo.size() == steps.size());
+
+		/* Out of order, so that blocks are evicted and reloaded. */
+		for (const auto n : { std::size_t(0), steps.size() - 1, std::size_t(5), max_demo_steps_per_block_v, std::size_t(1) }) {
+			const auto& view = demo.get_step(static_cast<demo_step_num_type>(n));
+			const auto& original = steps[n];
+
+			REQUIRE(view.local_entropy.has_value() == original.local_entropy.has_value());
+			REQUIRE(view.serialized_messages.size() == original.serialized_messages.size());
+
+			for (std::size_t m = 0; m < view.serialized_messages.size(); ++m) {
+				const auto& a = view.serialized_messages[m];
+				const auto& b = original.serialized_messages[m];
+
+				REQUIRE(a.size() == b.size());
+				REQUIRE(std::equal(a.data(), a.data() + a.size(), b.data()));
+			}
+		}
+	};
+
+	demo_file_meta meta;
+	meta.server_address = "127.0.0.1:8412";
+
+	{
+		auto out = augs::with_exceptions<std::ofstream>();
+		out.open(path, std::ios::out | std::ios::binary);
+
+		augs::write_bytes(out, meta);
+
+		/* Two flushes, the first of them spanning two blocks. */
+		write_demo_blocks(out, { steps.begin(), steps.begin() + max_demo_steps_per_block_v + 3 });
+		write_demo_blocks(out, { steps.begin() + max_demo_steps_per_block_v + 3, steps.end() });
+	}
+
+	{
+		demo_container demo;
+		REQUIRE(demo.open(path).server_address == meta.server_address);
+		REQUIRE(!demo.is_legacy());
+		REQUIRE(!demo.is_recorded_with_older_simulation());
+
+		require_same(demo);
+	}
+
+	{
+		auto out = augs::with_exceptions<std::ofstream>();
+		out.open(path, std::ios::out | std::ios::binary);
+
+		augs::write_bytes(out, meta);
+
+		for (const auto& s : steps) {
+			augs::write_bytes(out, s);
+		}
+	}
+
+	{
+		demo_container demo;
+		demo.open(path);
+		REQUIRE(demo.is_legacy());
+		REQUIRE(demo.is_recorded_with_older_simulation());
+
+		require_same(demo);
+	}
+
+	augs::remove_file(path);
+}
+
+TEST_CASE("DemoContainer CorruptBlocks") {
+	const auto path = augs::path_type(GENERATED_FILES_DIR "/test_demo_container_corrupt.dem");
+
+	std::vector<demo_step> steps;
+	steps.resize(max_demo_steps_per_block_v * 2);
+
+	for (std::size_t i = 0; i < steps.size(); ++i) {
+		steps[i].serialized_messages.emplace_back(i % 7 + 1, static_cast<std::byte>(i));
+	}
+
+	demo_file_meta meta;
+
+	const auto first_header_offset = augs::to_bytes(meta).size();
+
+	auto change_header_at = [](std::vector<std::byte>& bytes, const std::size_t offset, auto callback) {
+		demo_block_header header;
+		std::memcpy(&header, bytes.data() + offset, sizeof(header));
+		callback(header);
+		std::memcpy(bytes.data() + offset, &header, sizeof(header));
+
+		return header;
+	};
+
+	auto second_header_offset = [&](std::vector<std::byte>& bytes) {
+		const auto first = change_header_at(bytes, first_header_offset, [](auto&) {});
+		return first_header_offset + sizeof(demo_block_header) + first.compressed_size;
+	};
+
+	auto with_damaged_demo = [&](auto damage, auto check) {
+		{
+			auto out = augs::open_binary_output_stream(path);
+			augs::write_bytes(out, meta);
+			write_demo_blocks(out, steps);
+		}
+
+		auto bytes = augs::file_to_bytes(path);
+		damage(bytes);
+
+		{
+			auto out = augs::open_binary_output_stream(path);
+			out.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+		}
+
+		demo_container demo;
+		demo.open(path);
+		check(demo);
+	};
+
+	with_damaged_demo(
+		[&](auto& bytes) {
+			change_header_at(bytes, second_header_offset(bytes), [](auto& h) { h.num_steps = max_demo_steps_per_block_v + 1; });
+		},
+		[&](auto& demo) {
+			REQUIRE(demo.size() == max_demo_steps_per_block_v);
+			REQUIRE(demo.get_step(0).serialized_messages.size() == 1);
+		}
+	);
+
+	with_damaged_demo(
+		[&](auto& bytes) {
+			change_header_at(bytes, first_header_offset, [](auto& h) { h.uncompressed_size = 0xFFFFFFFF; });
+		},
+		[&](auto& demo) {
+			REQUIRE(demo.size() == 0);
+			REQUIRE_THROWS_AS(demo.get_step(0), augs::stream_read_error);
+		}
+	);
+
+	with_damaged_demo(
+		[&](auto& bytes) {
+			const auto payload = second_header_offset(bytes) + sizeof(demo_block_header);
+			std::fill(bytes.begin() + payload, bytes.end(), std::byte(0xFF));
+		},
+		[&](auto& demo) {
+			REQUIRE(demo.size() == steps.size());
+			REQUIRE(demo.get_step(max_demo_steps_per_block_v - 1).serialized_messages.size() == 1);
+
+			REQUIRE_THROWS_AS(demo.get_step(max_demo_steps_per_block_v), augs::stream_read_error);
+			REQUIRE(demo.size() == max_demo_steps_per_block_v);
+
+			/* The steps before the corrupt block still play. */
+			REQUIRE(demo.get_step(0).serialized_messages.size() == 1);
+		}
+	);
+
+	augs::remove_file(path);
+}
+#endif
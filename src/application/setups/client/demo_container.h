@@ -0,0 +1,122 @@
+#pragma once
+#include <vector>
+#include <optional>
+#include <iosfwd>
+#include "augs/filesystem/mapped_file.h"
+#include "application/setups/client/demo_file.h"
+#include "game/modes/mode_entropy.h"
+
+/*
+	Demo files are appended to in blocks of steps:
+
+		demo_file_meta
+		demo_block_header, LZ4-compressed steps
+		demo_block_header, LZ4-compressed steps
+		...
+
+	A block holds whatever was recorded between two flushes, split so that no block exceeds max_demo_steps_per_block_v.
+	Each step inside is serialized exactly like demo_step.
+
+	For playback the file is mapped, not read.
+	Opening only walks the block headers to index where each block starts,
+	and a block is decompressed once the player reaches a step inside it.
+	The serialized server messages are then replayed straight from the decompressed bytes.
+
+	Demos recorded before the blocks existed are just the meta followed by bare demo_steps.
+	These are told apart by the first byte after the meta (the has_value of an optional vs the magic),
+	indexed per step and replayed straight from the mapped file.
+
+	The magic also tells which simulation the demo was recorded with.
+	Change it whenever the simulation stops reproducing older recordings bit for bit,
+	so that these can still be opened, but with a warning that they will not replay faithfully.
+*/
+
+constexpr uint32_t demo_block_magic_v = 0x324B4244; /* "DBK2", since static geometry is kept apart in the broadphase */
+constexpr uint32_t demo_block_magic_older_simulation_v = 0x4B4C4244; /* "DBLK" */
+constexpr std::size_t max_demo_steps_per_block_v = 256;
+
+/* No more than LZ4 can possibly achieve, so that a corrupt header can't make us allocate gigabytes. */
+constexpr std::size_t max_demo_block_compression_ratio_v = 255;
+
+struct demo_block_header {
+	uint32_t magic = demo_block_magic_v;
+	uint32_t num_steps = 0;
+	uint32_t compressed_size = 0;
+	uint32_t uncompressed_size = 0;
+};
+
+void write_demo_blocks(std::ofstream& out, const std::vector<demo_step>& steps);
+
+struct demo_message_bytes {
+	const std::byte* ptr = nullptr;
+	std::size_t n = 0;
+
+	const std::byte* data() const {
+		return ptr;
+	}
+
+	std::size_t size() const {
+		return n;
+	}
+};
+
+/* Same as demo_step, but the messages point into the bytes held by demo_container. */
+
+struct demo_step_view {
+	std::optional<mode_entropy> local_entropy;
+	std::vector<demo_message_bytes> serialized_messages;
+};
+
+class demo_container {
+	struct block_entry {
+		std::size_t payload_offset = 0;
+		demo_step_num_type first_step = 0;
+		demo_block_header header;
+	};
+
+	augs::mapped_file file;
+	std::size_t steps_offset = 0;
+
+	std::vector<block_entry> blocks;
+	std::vector<std::size_t> legacy_step_offsets;
+
+	std::optional<std::size_t> cached_block;
+	std::vector<std::byte> decompressed;
+	std::vector<demo_step_view> cached_steps;
+
+	demo_step_view legacy_step;
+
+	std::size_t total_steps = 0;
+	bool older_simulation = false;
+
+	void index_blocks(uint32_t magic);
+	void index_legacy_steps();
+	void load_block(std::size_t);
+
+public:
+	demo_container() = default;
+
+	/* Throws augs::file_open_error or augs::stream_read_error if even the meta can't be read. */
+	demo_file_meta open(const augs::path_type&);
+
+	/*
+		Throws augs::stream_read_error if the step is past the end of the demo.
+		A corrupt block truncates the demo right before the first step that could not be read,
+		just like a corrupt step of a legacy demo does when it is opened.
+		The returned view is valid until the next call.
+	*/
+	const demo_step_view& get_step(demo_step_num_type);
+
+	std::size_t size() const {
+		return total_steps;
+	}
+
+	bool is_legacy() const {
+		return blocks.empty() && !legacy_step_offsets.empty();
+	}
+
+	/* Such demos play, but are bound to diverge from what was recorded. */
+	bool is_recorded_with_older_simulation() const {
+		return older_simulation;
+	}
+};
@@ -167,6 +167,7 @@ message_handler_result client_setup::handle_server_payload(
 		now_resyncing = false;
 
 		uint32_t read_client_id;
+		uint32_t read_num_catch_up_steps;
 
 		cosmic::change_solvable_significant(
 			scene.world, 
@@ -180,7 +181,8 @@ message_handler_result client_setup::handle_server_payload(
 						signi,
 						current_mode,
 						read_client_id,
-						client_gui.rcon.level
+						client_gui.rcon.level,
+						read_num_catch_up_steps
 					}
 				);
 
@@ -192,6 +194,9 @@ message_handler_result client_setup::handle_server_payload(
 
 		LOG("Received initial state from the server at step: %x.", scene.world.get_timestamp().step);
 		LOG("Received client id: %x", client_player_id.value);
+		LOG("Steps to catch up on: %x", read_num_catch_up_steps);
+
+		catch_up_steps_left = read_num_catch_up_steps;
 
 		state = client_state_type::IN_GAME;
 
@@ -202,12 +207,14 @@ message_handler_result client_setup::handle_server_payload(
 
 		if (was_resyncing) {
 			::save_interpolations(receiver.transfer_caches, std::as_const(predicted_cosmos));
+			::save_organisms(receiver.organism_caches, std::as_const(predicted_cosmos));
 		}
 
 		predicted.transfer_all_solvables(referential);
 
 		if (was_resyncing) {
 			::restore_interpolations(receiver.transfer_caches, predicted_cosmos);
+			::restore_organisms(receiver.organism_caches, predicted_cosmos);
 			receiver.schedule_reprediction = true;
 		}
 
@@ -237,13 +244,21 @@ message_handler_result client_setup::handle_server_payload(
 			return abort_v;
 		}
 
+		/*
+			Demos store the messages as they were received,
+			so replaying them also goes through here and decodes the motions in the same order.
+		*/
+
+		incoming_motions.decode(payload.payload);
+
 		receiver.acquire_next_server_entropy(
 			payload.context,
 			payload.meta, 
 			payload.payload
 		);
 
-		const auto& max_commands = vars.max_buffered_server_commands;
+		/* The steps to catch up on are all sent at once. */
+		const auto max_commands = vars.max_buffered_server_commands + catch_up_steps_left;
 		const auto num_commands = receiver.incoming_entropies.size();
 
 		if (num_commands > max_commands) {
@@ -58,10 +58,12 @@ void delete_entities_command::undo(const debugger_command_input in) {
 		deleted_entities.for_each_reverse([&](const auto& e) {
 			const auto undeleted = cosmic::undo_delete_entity(cosm, e.undo_delete_input, e.content, reinference_type::NONE);
 			selections.emplace(undeleted.get_id());
+
+			cosmic::mark_as_dirty(undeleted);
 		});
 	}
 
-	cosmic::reinfer_all_entities(cosm);
+	cosmic::reinfer_dirty_entities(cosm);
 }
 
 void delete_entities_command::sanitize(const debugger_command_input in) {
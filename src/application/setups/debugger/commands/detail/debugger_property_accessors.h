@@ -180,6 +180,31 @@ struct debugger_property_accessors {
 		}
 	}
 
+	static bool changes_inferred_state(
+		const entity_property_id& self,
+		const entity_type_id type_id
+	) {
+		bool reinfer = false;
+
+		get_by_dynamic_id(
+			all_entity_types(),
+			type_id,
+			[&](auto e) {
+				using E = decltype(e);
+
+				get_by_dynamic_index(
+					components_of<E> {},
+					self.component_id,
+					[&](const auto& c) {
+						reinfer = should_reinfer_after_change(c);
+					}
+				);
+			}
+		);
+
+		return reinfer;
+	}
+
 	template <class T, class F>
 	static void access_each_property(
 		const change_flavour_property_command& self,
@@ -212,9 +237,16 @@ struct debugger_property_accessors {
 	) {
 		auto& cosm = in.get_cosmos();
 
-		if (access(self.property_id, cosm, self.type_id, self.affected_entities, continue_if_nullopt(std::forward<F>(callback)))) {
-			cosmic::reinfer_all_entities(cosm);
+		if (changes_inferred_state(self.property_id, self.type_id)) {
+			/* Only the edited entities need reinferring, but their caches must be destroyed before the change. */
+
+			for (const auto& e : self.affected_entities) {
+				cosmic::mark_as_dirty(cosm[entity_id(e, self.type_id)]);
+			}
 		}
+
+		access(self.property_id, cosm, self.type_id, self.affected_entities, continue_if_nullopt(std::forward<F>(callback)));
+		cosmic::reinfer_dirty_entities(cosm);
 	}
 
 	template <class T, class F>
@@ -1,3 +1,4 @@
+#include "augs/log.h"
 #include "augs/string/string_templates.h"
 
 #include "application/intercosm.h"
@@ -15,6 +16,51 @@
 
 #include "application/arena/arena_handle.hpp"
 
+/*
+	The snapshots in the .player file are only readable by the same format of the player,
+	so the file starts with a magic number and a version to tell the older ones apart.
+	Bump the version whenever the format of the recorded snapshots changes,
+	or when the simulation stops reproducing the recorded steps bit for bit.
+*/
+
+static constexpr uint32_t player_file_magic_v = 0x52594C50; /* "PLYR" */
+static constexpr uint32_t player_file_version_v = 1;
+
+static void save_player_file(const debugger_player& player, const augs::path_type& path) {
+	auto out = augs::open_binary_output_stream(path);
+
+	augs::write_bytes(out, player_file_magic_v);
+	augs::write_bytes(out, player_file_version_v);
+	augs::write_bytes(out, player);
+}
+
+static void load_player_file(debugger_player& player, const augs::path_type& path) {
+	if (!augs::exists(path)) {
+		return;
+	}
+
+	try {
+		auto in = augs::open_binary_input_stream(path);
+
+		uint32_t magic = 0;
+		uint32_t version = 0;
+
+		augs::read_bytes(in, magic);
+		augs::read_bytes(in, version);
+
+		if (magic != player_file_magic_v || version != player_file_version_v) {
+			LOG("%x is of an unknown format (magic: %x, version: %x). Discarding the recorded snapshots.", path, magic, version);
+			return;
+		}
+
+		augs::read_bytes(in, player);
+	}
+	catch (const std::exception& err) {
+		LOG("Failed to read %x: %x\nDiscarding the recorded snapshots.", path, err.what());
+		player = {};
+	}
+}
+
 std::string debugger_folder::get_display_path() const {
 	return ::get_project_name(current_path);
 }
@@ -68,7 +114,7 @@ void debugger_folder::save_folder(const augs::path_type& to, const augs::path_ty
 	augs::save_as_bytes(commanded->rulesets, paths.arena.rulesets_file_path);
 	augs::save_as_bytes(view, paths.view_file);
 	augs::save_as_bytes(history, paths.hist_file);
-	augs::save_as_bytes(player, paths.player_file);
+	save_player_file(player, paths.player_file);
 
 	augs::save_as_text(paths.version_info_file, hypersomnia_version().get_summary());
 
@@ -108,11 +154,12 @@ void debugger_folder::load_folder(const augs::path_type& from, const augs::path_
 		augs::load_from_bytes(commanded->view_ids, paths.view_ids_file);
 		augs::load_from_bytes(view, paths.view_file);
 		augs::load_from_bytes(history, paths.hist_file);
-		augs::load_from_bytes(player, paths.player_file);
 	}
 	catch (const augs::file_open_error&) {
 		/* We just let it happen. These files are not necessary. */
 	}
+
+	load_player_file(player, paths.player_file);
 }
 
 void debugger_folder::mark_as_just_saved() {
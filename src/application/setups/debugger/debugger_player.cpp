@@ -399,5 +399,5 @@ debugger_arena_handle<true> debugger_player::get_arena_handle(const debugger_fol
 
 template class augs::snapshotted_player<
 	debugger_player_entropy_type,
-	debugger_solvable_snapshot
+	augs::delta_snapshots
 >;
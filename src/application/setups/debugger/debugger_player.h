@@ -13,6 +13,7 @@
 
 #include "application/arena/mode_and_rules.h"
 #include "augs/templates/snapshotted_player.h"
+#include "augs/misc/delta_snapshots.h"
 
 struct cosmos_solvable_significant;
 
@@ -39,11 +40,11 @@ enum class finish_testing_type {
 	DISCARD_CHANGES
 };
 
-using debugger_solvable_snapshot = std::vector<std::byte>;
+using debugger_solvable_snapshot = augs::delta_snapshots::snapshot_type;
 using debugger_player_entropy_type = mode_entropy;
 using debugger_player_base = augs::snapshotted_player<
 	debugger_player_entropy_type,
-	debugger_solvable_snapshot
+	augs::delta_snapshots
 >;
 
 template <class C>
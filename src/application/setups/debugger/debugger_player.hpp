@@ -75,6 +75,15 @@ auto debugger_player::make_snapshotted_advance_input(const player_advance_input_
 			
 			augs::memory_stream ms;
 
+			/*
+				Snapshots of the same scene are all about the same size.
+				Pre-size the buffer so that it is not regrown (and copied) several times over while writing.
+			*/
+
+			if (const auto last_size = get_snapshots().get_last_uncompressed_size(); last_size > 0) {
+				ms.reserve(last_size + last_size / 8);
+			}
+
 			augs::write_bytes(ms, history.get_current_revision());
 
 			augs::write_bytes(ms, current_mode.state);
@@ -97,21 +97,18 @@ void debugger_player_gui::perform(const debugger_command_input cmd_in) {
 		text("Step to entropy size: %x", readable_bytesize(player.estimate_step_to_entropy_size()));
 
 		const auto& snapshots = player.get_snapshots();
+		const auto total_snapshot_bytes = snapshots.get_compressed_bytes();
 
-		std::size_t total_snapshot_bytes = 0;
+		text("Snapshots: %x, keyframes: %x (%x)", snapshots.size(), snapshots.num_keyframes(), readable_bytesize(total_snapshot_bytes));
 
-		for (const auto& s : snapshots) {
-			total_snapshot_bytes += s.second.size();
+		if (total > 0.0) {
+			const auto bytes_per_minute = static_cast<std::size_t>(total_snapshot_bytes * 60.0 / total);
+			text("Snapshot memory per minute: %x", readable_bytesize(bytes_per_minute));
 		}
 
-		text("Snapshots: %x (%x)", snapshots.size(), readable_bytesize(total_snapshot_bytes));
-
-		if (snapshots.size() > 0) {
-			auto it = snapshots.upper_bound(player.get_current_step());
-			--it;
-
-			const auto dist = std::distance(snapshots.begin(), it);
-			text("Current snapshot: %x (step: %x)", dist, (*it).first); 
+		if (const auto current_snapshot = snapshots.find_at_or_before(player.get_current_step())) {
+			const auto dist = snapshots.count_at_or_before(*current_snapshot) - 1;
+			text("Current snapshot: %x (step: %x)", dist, *current_snapshot); 
 		}
 	}
 
@@ -0,0 +1,234 @@
+#include <thread>
+#include <algorithm>
+
+#include "augs/log.h"
+#include "augs/misc/process_usage.h"
+#include "augs/misc/readable_bytesize.h"
+#include "augs/misc/lua/lua_utils.h"
+#include "augs/templates/container_templates.h"
+
+#include "game/cosmos/solvers/standard_solver.h"
+
+#include "application/config_lua_table.h"
+#include "application/session_profiler.h"
+#include "application/setups/server/server_setup.h"
+#include "application/setups/server/arena_host.h"
+
+struct arena_host::hosted_arena {
+	std::string name;
+	port_type port = 0;
+
+	sol::state lua;
+	network_profiler network_performance;
+	server_network_info server_stats;
+
+	std::unique_ptr<server_setup> server;
+
+	std::size_t memory_at_start = 0;
+
+	/* Since the last report. */
+	double cpu_secs = 0.0;
+
+	hosted_arena() : lua(augs::create_lua_state()) {}
+};
+
+static std::size_t get_default_num_host_workers() {
+	/* The scheduler thread advances arenas too. */
+	const auto cores = std::max(std::thread::hardware_concurrency(), 1u);
+	return static_cast<std::size_t>(cores - 1);
+}
+
+arena_host::arena_host(
+	const config_lua_table& config,
+	const server_start_input start,
+	const server_nat_traversal_input& nat_traversal_input
+) :
+	config(config),
+	vars(config.arena_host),
+	pool(
+		vars.num_workers > 0 ? static_cast<std::size_t>(vars.num_workers) : get_default_num_host_workers(),
+		vars.pin_workers_to_cores
+	),
+	when_last_reported(server_setup::get_current_time())
+{
+	if (vars.pin_workers_to_cores) {
+		augs::pin_this_thread_to_core(0);
+	}
+
+	for (std::size_t i = 0; i < vars.arenas.size(); ++i) {
+		auto arena = std::make_unique<hosted_arena>();
+
+		arena->name = vars.arenas[i];
+		arena->port = start.port == 0 ? port_type(0) : static_cast<port_type>(start.port + i);
+
+		auto arena_start = start;
+		arena_start.port = arena->port;
+
+		/* The host is meant for machines with a public address. */
+		auto server_vars = config.server;
+		server_vars.allow_nat_traversal = false;
+
+		if (vars.arenas.size() > 1) {
+			server_vars.server_name = typesafe_sprintf("%x #%x", std::string(server_vars.server_name), i + 1);
+		}
+
+		auto solvable_vars = config.server_solvable;
+		solvable_vars.current_arena = arena->name;
+
+		const auto memory_before = augs::get_resident_memory();
+
+		try {
+			arena->server = std::make_unique<server_setup>(
+				arena->lua,
+				arena_start,
+				server_vars,
+				solvable_vars,
+				config.client,
+				config.private_server,
+				config.dedicated_server,
+				nat_traversal_input
+			);
+		}
+		catch (const std::runtime_error& err) {
+			LOG("Failed to host %x at port %x: %x", arena->name, arena->port, err.what());
+			continue;
+		}
+
+		/* 
+			Keep a single copy of the flavours and the logical assets of every map.
+			An arena that later changes its map gets a private copy again.
+		*/
+
+		for (const auto& other : arenas) {
+			if (arena->server->share_arena_common_with(*other->server)) {
+				LOG("%x at port %x shares its flavours with port %x.", arena->name, arena->port, other->port);
+				break;
+			}
+		}
+
+		const auto memory_after = augs::get_resident_memory();
+		arena->memory_at_start = memory_after > memory_before ? memory_after - memory_before : 0;
+
+		LOG("Hosting %x at port %x (%x).", arena->name, arena->port, readable_bytesize(arena->memory_at_start));
+
+		arenas.emplace_back(std::move(arena));
+	}
+
+	LOG("Hosting %x arenas on %x workers.", arenas.size(), pool.size() + 1);
+}
+
+arena_host::~arena_host() = default;
+
+bool arena_host::is_running() const {
+	return !arenas.empty();
+}
+
+void arena_host::advance(const nat_detection_result& last_detected_nat) {
+	const auto now = server_setup::get_current_time();
+
+	thread_local std::vector<hosted_arena*> due;
+	due.clear();
+
+	for (const auto& a : arenas) {
+		if (a->server->get_next_tick_time() <= now) {
+			due.push_back(a.get());
+		}
+	}
+
+	pool.fork_join(due.size(), [&](const std::size_t i) {
+		auto& a = *due[i];
+
+		const auto cpu_before = augs::get_this_thread_cpu_time();
+		const auto zoom = 1.f;
+
+		a.server->advance(
+			{
+				vec2i(),
+				config.input,
+				zoom,
+				last_detected_nat,
+				a.network_performance,
+				a.server_stats
+			},
+			solver_callbacks()
+		);
+
+		a.cpu_secs += augs::get_this_thread_cpu_time() - cpu_before;
+	});
+
+	erase_if(arenas, [](const auto& a) {
+		if (!a->server->is_running()) {
+			LOG("%x at port %x has stopped.", a->name, a->port);
+			return true;
+		}
+
+		return false;
+	});
+
+	report_usage(now);
+
+	if (arenas.empty()) {
+		return;
+	}
+
+	auto next_tick = arenas[0]->server->get_next_tick_time();
+
+	for (const auto& a : arenas) {
+		next_tick = std::min(next_tick, a->server->get_next_tick_time());
+	}
+
+	const auto sleep_dt = next_tick - server_setup::get_current_time();
+
+	if (config.server.precise_tick_scheduling) {
+		/* Arenas receive their packets at their own ticks, so there is no single socket to wake up on. */
+		scheduler.wait_for(sleep_dt);
+		return;
+	}
+
+	if (sleep_dt > 0.0) {
+		const auto mult = std::clamp(config.server.sleep_mult, 0.f, 0.9f);
+
+		if (mult > 0.f) {
+			yojimbo_sleep(static_cast<float>(sleep_dt) * mult);
+		}
+	}
+}
+
+void arena_host::report_usage(const double now) {
+	const auto interval = vars.report_usage_once_every_secs;
+
+	if (interval <= 0.f) {
+		return;
+	}
+
+	const auto elapsed = now - when_last_reported;
+
+	if (elapsed < interval) {
+		return;
+	}
+
+	when_last_reported = now;
+
+	const auto total_memory = augs::get_resident_memory();
+	const auto num_arenas = std::max(arenas.size(), std::size_t(1));
+
+	LOG(
+		"Hosting %x arenas. Resident memory: %x (%x per arena).",
+		arenas.size(),
+		readable_bytesize(total_memory),
+		readable_bytesize(total_memory / num_arenas)
+	);
+
+	for (const auto& a : arenas) {
+		LOG(
+			"%x at port %x: %x connected, CPU: %2f% of a core, memory at start: %x",
+			a->name,
+			a->port,
+			a->server->get_num_connected(),
+			100.0 * a->cpu_secs / elapsed,
+			readable_bytesize(a->memory_at_start)
+		);
+
+		a->cpu_secs = 0.0;
+	}
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <memory>
+#include <vector>
+#include <string>
+#include "augs/templates/thread_pool.h"
+#include "augs/misc/timing/tick_scheduler.h"
+#include "application/setups/server/server_start_input.h"
+#include "application/setups/server/arena_host_vars.h"
+
+struct config_lua_table;
+struct server_nat_traversal_input;
+struct nat_detection_result;
+
+/*
+	Runs many dedicated servers, each with its own arena and port, in a single process.
+
+	The executable and the config are loaded once for all of them.
+	Arenas playing the same map also hold a single copy of its flavours and logical assets,
+	see cosmos::share_common_significant_with.
+
+	Each arena still owns its own entities and Lua state,
+	as servers can change their arenas at any time and advance on different threads.
+	Changing the map through rcon gives the arena a private copy of the new one.
+
+	A single scheduler thread wakes up at the earliest tick due among all arenas
+	and advances every arena whose tick is due on the shared worker pool.
+	Every arena only ever runs on one thread at a time.
+*/
+
+class arena_host {
+	struct hosted_arena;
+
+	const config_lua_table& config;
+	arena_host_vars vars;
+
+	std::vector<std::unique_ptr<hosted_arena>> arenas;
+	augs::thread_pool pool;
+	augs::tick_scheduler scheduler;
+
+	double when_last_reported = 0.0;
+
+	void report_usage(double now);
+
+public:
+	arena_host(
+		const config_lua_table& config,
+		server_start_input start,
+		const server_nat_traversal_input& nat_traversal_input
+	);
+
+	~arena_host();
+
+	bool is_running() const;
+
+	/* Advances the arenas due and sleeps until the next tick of any of them. */
+	void advance(const nat_detection_result& last_detected_nat);
+};
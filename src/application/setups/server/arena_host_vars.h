@@ -0,0 +1,21 @@
+#pragma once
+#include <string>
+#include <vector>
+
+/*
+	If arenas is not empty, the dedicated server hosts all of them in a single process.
+	The i-th arena listens at default_server_start.port + i.
+*/
+
+struct arena_host_vars {
+	// GEN INTROSPECTOR struct arena_host_vars
+	std::vector<std::string> arenas;
+	int num_workers = 0;
+	bool pin_workers_to_cores = true;
+	float report_usage_once_every_secs = 60.f;
+	// END GEN INTROSPECTOR
+
+	bool is_enabled() const {
+		return !arenas.empty();
+	}
+};
@@ -0,0 +1,50 @@
+#pragma once
+#include <vector>
+#include <variant>
+#include "game/cosmos/cosmos_solvable_significant.h"
+#include "application/arena/mode_and_rules.h"
+#include "application/network/server_step_entropy.h"
+#include "application/setups/server/public_settings_update.h"
+
+/*
+	Caches like the physics world depend on their entire history (e.g. the contacts),
+	so a client joining in the middle of the game can't just infer them from the current state
+	without everyone else having to start over from scratch as well.
+
+	Instead, the server remembers the state from the last step at which every machine
+	inferred its caches from scratch, along with everything that was sent on the solvable channel since.
+	A joining client receives that state instead of the current one and replays the steps on its own,
+	arriving at exactly the caches that everyone else has.
+*/
+
+/*
+	The logged messages are all sent at once to the joining client,
+	so they have to fit in the send queue of the solvable channel (see game_connection_config).
+	Past that, the epoch expires and a new one has to be started with a complete reinference.
+*/
+
+constexpr std::size_t max_join_epoch_messages_v = 4096;
+
+struct join_epoch {
+	using logged_message = std::variant<compact_server_step_entropy, public_settings_update>;
+
+	cosmos_solvable_significant signi;
+	online_mode_and_rules mode;
+	std::vector<logged_message> messages;
+	bool expired = true;
+
+	template <class T>
+	void log(T&& message) {
+		if (expired) {
+			return;
+		}
+
+		if (messages.size() >= max_join_epoch_messages_v) {
+			expired = true;
+			messages.clear();
+			return;
+		}
+
+		messages.emplace_back(std::forward<T>(message));
+	}
+};
@@ -6,6 +6,7 @@
 
 #include "application/network/requested_client_settings.h"
 #include "application/network/client_state_type.h"
+#include "application/network/motion_delta_coder.h"
 
 #include "view/mode_gui/arena/arena_player_meta.h"
 
@@ -17,12 +18,16 @@ struct server_client_state {
 	type state = type::INITIATING_CONNECTION;
 	net_time_t last_valid_payload_time = -1.0;
 	net_time_t last_keyboard_activity_time = -1.0;
+	net_time_t when_last_assigned_lag_compensation = -1.0;
 	requested_client_settings settings;
 	bool rebroadcast_public_settings = false;
 
 	client_pending_entropies pending_entropies;
 	uint8_t num_entropies_accepted = 0;
 
+	motion_delta_coder incoming_motions;
+	motion_delta_coder outgoing_motions;
+
 	unsigned resyncs_counter = 0;
 	net_time_t last_resync_counter_reset_at = 0;
 	unsigned unauthorized_rcon_commands = 0;
@@ -11,6 +11,9 @@ struct server_profiler : public augs::profiler_mixin<server_profiler> {
 	augs::time_measurements solve_simulation;
 	augs::time_measurements send_entropies;
 	augs::time_measurements send_packets;
+
+	/* How long after its due time each step has begun. */
+	augs::time_measurements tick_lateness;
 	// END GEN INTROSPECTOR
 };
 
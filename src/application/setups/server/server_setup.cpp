@@ -38,7 +38,9 @@
 #include "application/detail_file_paths.h"
 #include "3rdparty/include_httplib.h"
 #include "application/setups/server/webhooks.h"
+#include "application/network/http_executor.h"
 #include "game/messages/hud_message.h"
+#include "game/detail/lag_compensation/hitbox_history.h"
 
 const auto connected_and_integrated_v = server_setup::for_each_flags { server_setup::for_each_flag::WITH_INTEGRATED, server_setup::for_each_flag::ONLY_CONNECTED };
 const auto only_connected_v = server_setup::for_each_flags { server_setup::for_each_flag::ONLY_CONNECTED };
@@ -87,13 +89,37 @@ bool server_heartbeat::is_valid() const {
 	return max_online >= 2 && !server_name.empty() && !current_arena.empty();
 }
 
-template <class F>
-void server_setup::push_webhook_job(F&& f, mode_player_id id) {
-	auto ptr = std::make_unique<std::future<std::string>>(
-		std::async(std::launch::async, std::forward<F>(f))
-	);
+void server_setup::push_webhook_job(http_request request, const mode_player_id id) {
+	if (private_vars.webhook_url.empty()) {
+		return;
+	}
+
+	const auto webhook_url = parsed_url(private_vars.webhook_url);
+
+	if (webhook_executor == nullptr) {
+		const auto& w = vars.webhooks;
+
+		http_executor_settings settings;
+		settings.num_workers = w.num_http_workers;
+		settings.max_queued_requests = w.max_queued_http_requests;
+		settings.batch_window_secs = w.batch_window_secs;
+
+		webhook_executor = std::make_unique<http_executor>(settings);
+	}
+
+	request.scheme_host_port = webhook_url.protocol + "://" + webhook_url.host;
+	request.location = webhook_url.location;
+
+	if (id.is_set()) {
+		request.wants_response = true;
 
-	pending_jobs.emplace_back(webhook_job{ id, std::move(ptr) });
+		const auto request_id = webhook_executor->push(std::move(request));
+		pending_jobs.emplace_back(webhook_job{ id, request_id });
+	}
+	else {
+		request.merge = discord_webhooks::merge_payloads;
+		webhook_executor->push(std::move(request));
+	}
 }
 
 void server_setup::default_server_post_solve(const const_logic_step step) {
@@ -125,121 +151,58 @@ std::string server_setup::get_next_duel_pic_link() {
 }
 
 void server_setup::push_duel_interrupted_webhook(const messages::duel_interrupted_message& interrupt_info) {
-	finalize_webhook_jobs();
-
-	auto webhook_url = parsed_url(private_vars.webhook_url);
-	auto server_name = get_server_name();
-
 	LOG("pushing duel interrupted webhook.");
 
-	auto fled = vars.webhooks.fled_pic_link;
-	auto reconsidered = vars.webhooks.reconsidered_pic_link;
-
-	push_webhook_job(
-		[webhook_url, server_name, fled, reconsidered, interrupt_info]() -> std::string {
-			const auto ca_path = CA_CERT_PATH;
-			http_client_type http_client(webhook_url.host);
-
-#if BUILD_OPENSSL
-			http_client.set_ca_cert_path(ca_path.c_str());
-			http_client.enable_server_certificate_verification(true);
-#endif
-			http_client.set_follow_location(true);
-			http_client.set_read_timeout(5);
-			http_client.set_write_timeout(5);
-
-			auto items = discord_webhooks::form_duel_interrupted(
-				server_name,
-				fled,
-				reconsidered,
-				interrupt_info
-			);
-
-			http_client.Post(webhook_url.location.c_str(), items);
+	http_request request;
 
-			return "";
-		}
+	request.items = discord_webhooks::form_duel_interrupted(
+		get_server_name(),
+		vars.webhooks.fled_pic_link,
+		vars.webhooks.reconsidered_pic_link,
+		interrupt_info
 	);
+
+	push_webhook_job(std::move(request));
 }
 
 void server_setup::push_match_summary_webhook(const messages::match_summary_message& summary) {
-	finalize_webhook_jobs();
-
-	auto webhook_url = parsed_url(private_vars.webhook_url);
-	auto server_name = get_server_name();
-
 	const auto mvp_state = find_client_state(summary.mvp_player_id);
 
 	if (mvp_state == nullptr) {
 		return;
 	}
 
-	auto mvp_nickname = mvp_state->get_nickname();
-	auto mvp_player_avatar_url = mvp_state->uploaded_avatar_url;
 	const auto this_duel_index = (duel_pic_counter - 1) % vars.webhooks.num_duel_pics;
-	auto duel_victory_pic_link = typesafe_sprintf(vars.webhooks.duel_victory_pic_link_pattern, this_duel_index);
+	const auto duel_victory_pic_link = typesafe_sprintf(vars.webhooks.duel_victory_pic_link_pattern, this_duel_index);
 
 	LOG("pushing match summary webhook.");
 
-	push_webhook_job(
-		[webhook_url, server_name, mvp_nickname, mvp_player_avatar_url, duel_victory_pic_link, summary]() -> std::string {
-			const auto ca_path = CA_CERT_PATH;
-			http_client_type http_client(webhook_url.host);
-
-#if BUILD_OPENSSL
-			http_client.set_ca_cert_path(ca_path.c_str());
-			http_client.enable_server_certificate_verification(true);
-#endif
-			http_client.set_follow_location(true);
-			http_client.set_read_timeout(5);
-			http_client.set_write_timeout(5);
-
-			auto items = discord_webhooks::form_match_summary(
-				server_name,
-				mvp_nickname,
-				mvp_player_avatar_url,
-				duel_victory_pic_link,
-				summary
-			);
-
-			http_client.Post(webhook_url.location.c_str(), items);
+	http_request request;
 
-			return "";
-		}
+	request.items = discord_webhooks::form_match_summary(
+		get_server_name(),
+		mvp_state->get_nickname(),
+		mvp_state->uploaded_avatar_url,
+		duel_victory_pic_link,
+		summary
 	);
+
+	push_webhook_job(std::move(request));
 }
 
 void server_setup::push_duel_of_honor_webhook(const std::string& first, const std::string& second) {
-	auto webhook_url = parsed_url(private_vars.webhook_url);
-	auto server_name = get_server_name();
-
 	LOG("pushing duel webhook with %x versus %x", first, second);
 
-	push_webhook_job(
-		[first, second, webhook_url, server_name, duel_pic_link = get_next_duel_pic_link()]() -> std::string {
-			const auto ca_path = CA_CERT_PATH;
-			http_client_type http_client(webhook_url.host);
-
-#if BUILD_OPENSSL
-			http_client.set_ca_cert_path(ca_path.c_str());
-			http_client.enable_server_certificate_verification(true);
-#endif
-			http_client.set_follow_location(true);
-			http_client.set_read_timeout(5);
-			http_client.set_write_timeout(5);
-
-			auto items = discord_webhooks::form_duel_of_honor(
-				server_name,
-				first,
-				second,
-				duel_pic_link
-			);
-
-			http_client.Post(webhook_url.location.c_str(), items);
+	http_request request;
 
-			return "";
-		}
+	request.items = discord_webhooks::form_duel_of_honor(
+		get_server_name(),
+		first,
+		second,
+		get_next_duel_pic_link()
 	);
+
+	push_webhook_job(std::move(request));
 }
 
 void server_setup::push_connected_webhook(const mode_player_id id) {
@@ -255,67 +218,50 @@ void server_setup::push_connected_webhook(const mode_player_id id) {
 
 	state->pushed_connected_webhook = true;
 
-	auto webhook_url = parsed_url(private_vars.webhook_url);
-	auto server_name = get_server_name();
-	auto avatar = state->meta.avatar.image_bytes;
-	auto connected_player_nickname = state->get_nickname();
-	auto all_nicknames = get_all_nicknames();
-	auto current_arena_name = get_current_arena_name();
-
-	push_webhook_job(
-		[webhook_url, server_name, avatar, connected_player_nickname, all_nicknames, current_arena_name]() -> std::string {
-			const auto ca_path = CA_CERT_PATH;
-			http_client_type http_client(webhook_url.host);
-
-#if BUILD_OPENSSL
-			http_client.set_ca_cert_path(ca_path.c_str());
-			http_client.enable_server_certificate_verification(true);
-#endif
-			http_client.set_follow_location(true);
-			http_client.set_read_timeout(5);
-			http_client.set_write_timeout(5);
-
-			auto items = discord_webhooks::form_player_connected(
-				avatar,
-				server_name,
-				connected_player_nickname,
-				all_nicknames,
-				current_arena_name
-			);
+	http_request request;
 
-			auto response = http_client.Post(webhook_url.location.c_str(), items);
+	request.items = discord_webhooks::form_player_connected(
+		state->meta.avatar.image_bytes,
+		get_server_name(),
+		state->get_nickname(),
+		get_all_nicknames(),
+		get_current_arena_name()
+	);
 
-			LOG("PUSH RESPONSE:");
+	push_webhook_job(std::move(request), id);
+}
 
-			if (response) {
-				LOG_NVPS(response->body);
+void server_setup::finalize_webhook_jobs() {
+	if (webhook_executor == nullptr) {
+		return;
+	}
 
-				return discord_webhooks::find_attachment_url(response->body);
-			}
-			else {
-				LOG("Response was null");
-			}
+	for (const auto& response : webhook_executor->take_responses()) {
+		const auto it = std::find_if(
+			pending_jobs.begin(),
+			pending_jobs.end(),
+			[&](const webhook_job& j) { return j.request_id == response.id; }
+		);
 
-			return "";
-		}, 
-		id
-	);
-}
+		if (it == pending_jobs.end()) {
+			continue;
+		}
 
-void server_setup::finalize_webhook_jobs() {
-	auto finalize = [&](auto& webhook_job) {
-		if (is_ready(*webhook_job.job)) {
-			if (auto client = find_client_state(webhook_job.player_id)) {
-				client->uploaded_avatar_url = webhook_job.job->get();
-			}
+		LOG("PUSH RESPONSE:");
 
-			return true;
+		if (response.dropped || response.status == 0) {
+			LOG("Response was null");
 		}
+		else {
+			LOG_NVPS(response.body);
 
-		return false;
-	};
+			if (auto client = find_client_state(it->player_id)) {
+				client->uploaded_avatar_url = discord_webhooks::find_attachment_url(response.body);
+			}
+		}
 
-	erase_if(pending_jobs, finalize);
+		pending_jobs.erase(it);
+	}
 }
 
 bool server_setup::respond_to_ping_requests(
@@ -826,6 +772,10 @@ void server_setup::apply(const server_vars& new_vars, const bool force) {
 		if (force || old_vars.network_simulator != new_vars.network_simulator) {
 			server->set(new_vars.network_simulator);
 		}
+
+		if (force || old_vars.pace_client_sends_kbps != new_vars.pace_client_sends_kbps) {
+			server->set_send_pacing(new_vars.pace_client_sends_kbps);
+		}
 	}
 }
 
@@ -918,6 +868,9 @@ void server_setup::choose_arena(const std::string& name) {
 		initial_signi
 	);
 
+	/* Everyone loads the new arena from scratch. */
+	begin_join_epoch();
+
 	arena_gui.reset();
 	arena_gui.choose_team.show = ::is_spectator(arena, get_local_player_id());
 
@@ -941,6 +894,15 @@ void server_setup::choose_arena(const std::string& name) {
 	}
 }
 
+bool server_setup::share_arena_common_with(const server_setup& b) {
+	if (solvable_vars.current_arena != b.solvable_vars.current_arena) {
+		return false;
+	}
+
+	scene.world.share_common_significant_with(b.scene.world);
+	return true;
+}
+
 void server_setup::accept_game_gui_events(const game_gui_entropy_type& events) {
 	control(events);
 }
@@ -975,13 +937,45 @@ void server_setup::perform_automoves_to_spectators() {
 	moved_to_spectators.clear();
 }
 
+bool server_setup::controls_living_character(const mode_player_id mode_id) const {
+	const auto arena = get_arena_handle();
+
+	const auto controlled = arena.on_mode(
+		[&](const auto& typed_mode) {
+			return typed_mode.lookup(mode_id);
+		}
+	);
+
+	return logically_set(controlled) && arena.get_cosmos()[controlled].alive();
+}
+
 void server_setup::accept_entropy_of_client(
 	const mode_player_id mode_id,
 	const total_client_entropy& entropy
 ) {
-	if (!entropy.empty()) {
-		step_collected += { mode_id, entropy };
+	if (entropy.empty()) {
+		return;
+	}
+
+	/*
+		Every client simulates everything, so inputs can't be filtered per recipient.
+		What can be filtered is the input that has no effect on anyone:
+		the cosmic commands of spectators and of players whose character is gone
+		would be discarded by every client when unpacking the step anyway.
+	*/
+
+	if (vars.broadcast_only_effective_inputs && logically_set(entropy.cosmic) && !controls_living_character(mode_id)) {
+		auto effective = entropy;
+		effective.cosmic = {};
+
+		if (!effective.empty()) {
+			step_collected += { mode_id, effective };
+		}
+
+		return;
 	}
+
+	step_collected += { mode_id, entropy };
 }
 
 void server_setup::advance_clients_state() {
@@ -1015,6 +1009,40 @@ void server_setup::advance_clients_state() {
 		}
 	};
 
+	auto assign_lag_compensation = [&](const client_id_type client_id, auto& c) {
+		const auto interval = std::max(vars.update_lag_compensation_once_every_secs, 0.1f);
+
+		if (server_time - c.when_last_assigned_lag_compensation < interval) {
+			return;
+		}
+
+		c.when_last_assigned_lag_compensation = server_time;
+
+		/* 
+			Rewind by the round trip: the client sees the others that much in the past
+			and its shot arrives that much later. The value reaches the simulation
+			through the public settings, so every client applies it at the same step.
+		*/
+
+		const auto steps = [&]() -> uint32_t {
+			if (to_mode_player_id(client_id) == get_local_player_id()) {
+				return 0;
+			}
+
+			const auto rtt_ms = std::max(0.0, static_cast<double>(server->get_network_info(client_id).rtt_ms));
+			const auto max_ms = static_cast<double>(vars.max_lag_compensation_ms);
+
+			return std::min(in_steps(std::min(rtt_ms, max_ms)), max_lag_compensation_steps_v);
+		}();
+
+		auto& assigned = c.settings.public_settings.character_input.lag_compensation_steps;
+
+		if (assigned != steps) {
+			assigned = static_cast<uint8_t>(steps);
+			c.rebroadcast_public_settings = true;
+		}
+	};
+
 	auto process_client = [&](const client_id_type client_id, auto& c) {
 		using S = client_state_type;
 		const auto mode_id = to_mode_player_id(client_id);
@@ -1129,8 +1157,6 @@ void server_setup::advance_clients_state() {
 		};
 
 		auto send_state_for_the_first_time = [&]() {
-			const auto sent_client_id = static_cast<uint32_t>(client_id);
-
 			server->send_payload(
 				client_id, 
 				game_channel_type::SERVER_SOLVABLE_AND_STEPS, 
@@ -1138,9 +1164,7 @@ void server_setup::advance_clients_state() {
 				solvable_vars
 			);
 
-			const auto rcon_level = get_rcon_level(client_id);
-
-			if (rcon_level >= rcon_level_type::BASIC) {
+			if (get_rcon_level(client_id) >= rcon_level_type::BASIC) {
 				server->send_payload(
 					client_id, 
 					game_channel_type::COMMUNICATIONS, 
@@ -1149,22 +1173,7 @@ void server_setup::advance_clients_state() {
 				);
 			}
 
-			server->send_payload(
-				client_id, 
-				game_channel_type::SERVER_SOLVABLE_AND_STEPS, 
-
-				buffers,
-
-				initial_signi,
-				scene.world.get_common_significant().flavours,
-
-				initial_arena_state_payload<true> {
-					scene.world.get_solvable().significant,
-					current_mode,
-					sent_client_id,
-					rcon_level
-				}
-			);
+			send_join_epoch_to(client_id, c);
 
 			{
 				auto download_existing_avatar = [this, recipient_client_id = client_id](const auto client_id_of_avatar, auto& cc) {
@@ -1226,6 +1235,7 @@ void server_setup::advance_clients_state() {
 			}
 
 			automove_to_spectators_if_afk(client_id, c);
+			assign_lag_compensation(client_id, c);
 		}
 
 		if (c.state > client_state_type::INITIATING_CONNECTION) {
@@ -1378,7 +1388,13 @@ message_handler_result server_setup::handle_client_message(
 			}
 		}
 
-		c.settings = std::move(payload);
+		{
+			/* Assigned by the server, never requested. */
+			const auto lag_compensation_steps = c.settings.public_settings.character_input.lag_compensation_steps;
+
+			c.settings = std::move(payload);
+			c.settings.public_settings.character_input.lag_compensation_steps = lag_compensation_steps;
+		}
 
 		if (c.state == S::PENDING_WELCOME) {
 			LOG("Client %x requested nickname: %x", client_id, c.get_nickname());
@@ -1450,6 +1466,15 @@ message_handler_result server_setup::handle_client_message(
 			return abort_v;
 		}
 
+		c.incoming_motions.decode(payload);
+
+		/* The wire format can carry any 16-bit motion, but a mouse can't produce more than this in a step. */
+
+		if (auto* const motion = mapped_or_nullptr(payload.cosmic.motions, game_motion_type::MOVE_CROSSHAIR)) {
+			motion->x = std::clamp(motion->x, mouse_rel_min_v, mouse_rel_max_v);
+			motion->y = std::clamp(motion->y, mouse_rel_min_v, mouse_rel_max_v);
+		}
+
 		if (!payload.empty()) {
 			c.last_keyboard_activity_time = server_time;
 		}
@@ -1479,28 +1504,7 @@ message_handler_result server_setup::handle_client_message(
 					return abort_v;
 				}
 
-				{
-					const auto rcon_level = get_rcon_level(client_id);
-
-					server->send_payload(
-						client_id, 
-						game_channel_type::SERVER_SOLVABLE_AND_STEPS, 
-
-						buffers,
-
-						initial_signi,
-						scene.world.get_common_significant().flavours,
-
-						initial_arena_state_payload<true> {
-							scene.world.get_solvable().significant,
-							current_mode,
-							client_id,
-							rcon_level
-						}
-					);
-				}
-
-				reinference_necessary = true;
+				send_join_epoch_to(client_id, c);
 
 				break;
 
@@ -1599,6 +1603,7 @@ void server_setup::send_server_step_entropies(const compact_server_step_entropy&
 				c.rebroadcast_public_settings = false;
 
 				const auto broadcasted_update = make_public_settings_update_from(c, client_id);
+				epoch.log(broadcasted_update);
 
 				auto update_for_client = [this, &broadcasted_update](const auto recipient_client_id, auto&) {
 					server->send_payload(
@@ -1616,6 +1621,11 @@ void server_setup::send_server_step_entropies(const compact_server_step_entropy&
 		for_each_id_and_client(process_client, connected_and_integrated_v);
 	}
 
+	if (!reinference_necessary) {
+		/* Otherwise it begins a new epoch, see reinfer_if_necessary_for. */
+		epoch.log(total_input);
+	}
+
 	networked_server_step_entropy total;
 	total.payload = total_input;
 	total.meta.reinference_necessary = reinference_necessary;
@@ -1633,6 +1643,9 @@ void server_setup::send_server_step_entropies(const compact_server_step_entropy&
 		return std::nullopt;
 	}();
 
+	std::optional<motion_delta_coder> encoded_for_coder;
+	motion_delta_coder coder_after_encoding;
+
 	auto process_client = [&](const auto client_id, auto& c) {
 		const bool its_time_already = 
 			c.state >= client_state_type::RECEIVING_INITIAL_STATE
@@ -1663,12 +1676,31 @@ void server_setup::send_server_step_entropies(const compact_server_step_entropy&
 			c.num_entropies_accepted = 0;
 		}
 
-		/* TODO PERFORMANCE: only serialize the message once and multicast the same buffer to all clients! */
+		/* 
+			Motions are delta-coded against what this particular client has received so far.
+			Every client that received the previous step holds the same coder state though,
+			so in practice the payload is encoded once per step, not once per client.
+		*/
+
+		if (encoded_for_coder != std::nullopt && c.outgoing_motions == *encoded_for_coder) {
+			c.outgoing_motions = coder_after_encoding;
+		}
+		else {
+			encoded_for_coder = c.outgoing_motions;
+
+			step_delta_coded = total;
+			c.outgoing_motions.encode(step_delta_coded.payload);
+
+			coder_after_encoding = c.outgoing_motions;
+		}
+
+		step_delta_coded.context = total.context;
+
 		server->send_payload(
 			client_id,
 			game_channel_type::SERVER_SOLVABLE_AND_STEPS,
 
-			total
+			step_delta_coded
 		);
 	};
 
@@ -1723,10 +1755,178 @@ void server_setup::send_server_step_entropies(const compact_server_step_entropy&
 }
 
 void server_setup::reinfer_if_necessary_for(const compact_server_step_entropy& entropy) {
-	if (reinference_necessary || logically_set(entropy.general.added_player)) {
-		LOG("Server: Added player or reinference_necessary. Will reinfer to sync.");
+	if (reinference_necessary) {
+		/*
+			Joining players do not need this - they catch up from the last join epoch.
+			Only once the epoch expires does everyone have to start over from scratch to begin a new one.
+		*/
+
+		LOG("Server: reinference_necessary. Will reinfer to sync.");
 		cosmic::reinfer_solvable(get_arena_handle().get_cosmos());
 		reinference_necessary = false;
+
+		begin_join_epoch();
+
+		/* This step has already been sent before we got here. */
+		epoch.log(entropy);
+	}
+}
+
+void server_setup::begin_join_epoch() {
+	LOG("Beginning a new join epoch at step: %x", scene.world.get_total_steps_passed());
+
+	epoch.signi = scene.world.get_solvable().significant;
+	epoch.mode = current_mode;
+	epoch.messages.clear();
+	epoch.expired = false;
+
+	/* The steps can only be unpacked with the settings that were in effect when they were sent. */
+
+	auto log_existing_public_settings = [this](const auto client_id, auto& c) {
+		epoch.log(make_public_settings_update_from(c, client_id));
+	};
+
+	for_each_id_and_client(log_existing_public_settings, connected_and_integrated_v);
+}
+
+void server_setup::send_join_epoch_to(const client_id_type& client_id, server_client_state& c) {
+	const auto sent_client_id = static_cast<uint32_t>(client_id);
+	const auto rcon_level = get_rcon_level(client_id);
+
+	if (epoch.expired) {
+		/*
+			Too much has happened since the last complete reinference to replay it all.
+			Send the current state and have everyone start over from scratch at this very step,
+			just like this client is going to.
+		*/
+
+		LOG("Join epoch has expired. Sending the current state to %x. Everyone will reinfer to sync.", client_id);
+
+		server->send_payload(
+			client_id, 
+			game_channel_type::SERVER_SOLVABLE_AND_STEPS, 
+
+			buffers,
+
+			initial_signi,
+			scene.world.get_common_significant().flavours,
+
+			initial_arena_state_payload<true> {
+				scene.world.get_solvable().significant,
+				current_mode,
+				sent_client_id,
+				rcon_level,
+				0u
+			}
+		);
+
+		reinference_necessary = true;
+		return;
+	}
+
+	const auto num_catch_up_steps = static_cast<uint32_t>(std::count_if(
+		epoch.messages.begin(),
+		epoch.messages.end(),
+		[](const auto& m) { return std::holds_alternative<compact_server_step_entropy>(m); }
+	));
+
+	server->send_payload(
+		client_id, 
+		game_channel_type::SERVER_SOLVABLE_AND_STEPS, 
+
+		buffers,
+
+		initial_signi,
+		scene.world.get_common_significant().flavours,
+
+		initial_arena_state_payload<true> {
+			epoch.signi,
+			epoch.mode,
+			sent_client_id,
+			rcon_level,
+			num_catch_up_steps
+		}
+	);
+
+	/*
+		The client did not take part in these steps,
+		so none of its entropies were accepted in any of them.
+	*/
+
+	prestep_client_context context;
+	context.num_entropies_accepted = 0;
+
+	for (const auto& m : epoch.messages) {
+		std::visit(
+			[&](const auto& logged) {
+				using L = remove_cref<decltype(logged)>;
+
+				if constexpr(std::is_same_v<L, compact_server_step_entropy>) {
+#if CONTEXTS_SEPARATE
+					server->send_payload(
+						client_id, 
+						game_channel_type::SERVER_SOLVABLE_AND_STEPS,
+
+						context
+					);
+#endif
+
+					step_delta_coded.context = context;
+					step_delta_coded.meta = {};
+					step_delta_coded.payload = logged;
+
+					c.outgoing_motions.encode(step_delta_coded.payload);
+
+					server->send_payload(
+						client_id,
+						game_channel_type::SERVER_SOLVABLE_AND_STEPS,
+
+						step_delta_coded
+					);
+				}
+				else {
+					server->send_payload(
+						client_id,
+						game_channel_type::SERVER_SOLVABLE_AND_STEPS,
+
+						logged
+					);
+				}
+			},
+			m
+		);
+	}
+
+	LOG("Sent the join epoch to %x with %x steps to catch up on.", client_id, num_catch_up_steps);
+}
+
+bool server_setup::is_quiet_moment() const {
+	return get_arena_handle().on_mode(
+		[&](const auto& typed_mode) {
+			using M = remove_cref<decltype(typed_mode)>;
+
+			if constexpr(std::is_same_v<M, bomb_defusal>) {
+				const auto state = typed_mode.get_state();
+
+				if (state == arena_mode_state::ROUND_END_DELAY || state == arena_mode_state::MATCH_SUMMARY) {
+					return true;
+				}
+			}
+
+			return typed_mode.get_num_active_players() == 0;
+		}
+	);
+}
+
+void server_setup::renew_expired_join_epoch_if_quiet() {
+	/*
+		Start over while nobody is fighting so that the next join is not the one to cause a hitch.
+		This has to be decided before the step is sent as the clients reinfer along with us.
+	*/
+
+	if (epoch.expired && !reinference_necessary && is_quiet_moment()) {
+		LOG("Join epoch has expired. Renewing it while it's quiet.");
+		reinference_necessary = true;
 	}
 }
 
@@ -1847,6 +2047,36 @@ bool server_setup::should_have_admin_character() const {
 void server_setup::sleep_until_next_tick() {
 	const auto sleep_dt = server_time - get_current_time();
 
+	if (vars.precise_tick_scheduling) {
+		if (sleep_dt <= 0.0) {
+			return;
+		}
+
+		const auto deadline = augs::tick_scheduler::clock::now() + std::chrono::duration_cast<augs::tick_scheduler::clock::duration>(
+			std::chrono::duration<double>(sleep_dt)
+		);
+
+		auto wake_on_readable = std::optional<augs::tick_scheduler::socket_handle_type>();
+
+		if (vars.receive_packets_between_ticks) {
+			if (const auto socket = find_underlying_socket()) {
+				wake_on_readable = static_cast<augs::tick_scheduler::socket_handle_type>(socket->handle);
+			}
+		}
+
+		/*
+			Whatever the clients send is received as soon as it arrives,
+			so the next step starts with their commands already queued.
+			They are still applied no sooner than at that step.
+		*/
+
+		while (tick_scheduler.wait_until(deadline, wake_on_readable) == augs::tick_wait_result::READABLE) {
+			server->receive_packets();
+		}
+
+		return;
+	}
+
 	if (sleep_dt > 0.0) {
 		const auto mult = std::clamp(vars.sleep_mult, 0.f, 0.9f);
 
@@ -1930,7 +2160,7 @@ std::string server_setup::get_current_arena_name() const {
 	return solvable_vars.current_arena;
 }
 
-server_step_entropy server_setup::unpack(const compact_server_step_entropy& n) const {
+void server_setup::unpack(const compact_server_step_entropy& n, server_step_entropy& into) const {
 	auto mode_id_to_entity_id = [&](const mode_player_id& mode_id) {
 		return get_arena_handle().on_mode(
 			[&](const auto& typed_mode) {
@@ -1943,7 +2173,7 @@ server_step_entropy server_setup::unpack(const compact_server_step_entropy& n) c
 		return get_client_state(mode_id).settings.public_settings.character_input;
 	};
 
-	return n.unpack(mode_id_to_entity_id, get_settings_for);
+	n.unpack_into(into, mode_id_to_entity_id, get_settings_for);
 }
 
 augs::path_type server_setup::get_unofficial_content_dir() const {
@@ -2209,9 +2439,15 @@ void server_setup::log_performance() {
 			if (server_time - last_logged_at >= once_every) {
 				profiler.prepare_summary_info();
 
+				const auto& step_percentiles = profiler.step.get_percentiles_info();
+				const auto& lateness_percentiles = profiler.tick_lateness.get_percentiles_info();
+
 				const auto summary = typesafe_sprintf(
-					"S: %3f, SS: %3f, AA: %3f, ACS: %3f, SE: %3f, SP: %3f",
+					"S: %3f (p50: %3f, p99: %3f, p999: %3f), SS: %3f, AA: %3f, ACS: %3f, SE: %3f, SP: %3f",
 					1000 * profiler.step.get_summary_info().value,
+					1000 * step_percentiles.p50,
+					1000 * step_percentiles.p99,
+					1000 * step_percentiles.p999,
 					1000 * profiler.solve_simulation.get_summary_info().value,
 					1000 * profiler.advance_adapter.get_summary_info().value,
 					1000 * profiler.advance_clients_state.get_summary_info().value,
@@ -2219,8 +2455,60 @@ void server_setup::log_performance() {
 					1000 * profiler.send_packets.get_summary_info().value
 				);
 
+				const auto elapsed = server_time - last_logged_at;
+				const auto& sched = tick_scheduler.get_stats();
+
+				/* Spun is the CPU burnt while waiting; slept is what was given back to the OS. */
+				const auto scheduling = typesafe_sprintf(
+					"Late: p50: %3f, p99: %3f, p999: %3f, Spun: %2f%, Slept: %2f%, Early wakeups: %x, Spin margin: %3f",
+					1000 * lateness_percentiles.p50,
+					1000 * lateness_percentiles.p99,
+					1000 * lateness_percentiles.p999,
+					100 * sched.spun_secs / elapsed,
+					100 * sched.slept_secs / elapsed,
+					sched.early_wakeups,
+					1000 * tick_scheduler.get_spin_margin()
+				);
+
+				const auto sent = server->take_send_totals();
+
+				client_send_rates busiest;
+
+				for_each_id_and_client(
+					[&](const auto client_id, auto&) {
+						const auto rates = server->get_send_rates(client_id);
+
+						if (rates.bytes_per_second >= busiest.bytes_per_second) {
+							busiest = rates;
+						}
+					},
+					only_connected_v
+				);
+
+				const auto egress = typesafe_sprintf(
+					"Egress: %x pkt/s, %x B/s, %2f datagrams per syscall. Busiest client: %x pkt/s, %x B/s, %x held, %x dropped",
+					static_cast<uint64_t>(sent.datagrams / elapsed),
+					static_cast<uint64_t>(sent.bytes / elapsed),
+					static_cast<double>(sent.datagrams) / std::max(sent.system_calls, uint64_t(1)),
+					static_cast<uint64_t>(busiest.packets_per_second),
+					static_cast<uint64_t>(busiest.bytes_per_second),
+					busiest.num_held,
+					busiest.num_dropped
+				);
+
 				last_logged_at = server_time;
 				LOG(summary);
+
+				if (vars.precise_tick_scheduling) {
+					LOG(scheduling);
+				}
+
+				LOG(egress);
+
+				tick_scheduler.reset_stats();
+
+				/* So that the logged percentiles cover only the time since the last log. */
+				profiler.clear_histograms();
 			}
 		}
 	}
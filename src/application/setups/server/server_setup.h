@@ -21,6 +21,7 @@
 #include "application/setups/server/server_client_state.h"
 #include "application/predefined_rulesets.h"
 #include "application/arena/mode_and_rules.h"
+#include "game/modes/round_template.h"
 #include "augs/readwrite/memory_stream_declaration.h"
 #include "augs/misc/serialization_buffers.h"
 
@@ -31,6 +32,8 @@
 #include "application/setups/server/chat_structs.h"
 #include "application/gui/client/client_gui_state.h"
 #include "application/setups/server/server_profiler.h"
+#include "application/setups/server/join_epoch.h"
+#include "augs/misc/timing/tick_scheduler.h"
 #include "3rdparty/yojimbo/netcode.io/netcode.h"
 #include "application/nat/nat_type.h"
 #include "application/setups/server/server_nat_traversal.h"
@@ -52,6 +55,8 @@ struct add_to_arena_input {
 };
 
 class server_adapter;
+class http_executor;
+struct http_request;
 
 struct resolve_address_result;
 
@@ -65,6 +70,9 @@ class server_setup :
 	intercosm scene;
 	cosmos_solvable_significant initial_signi;
 
+	/* Built from the above at the first round start, see round_template. */
+	round_template initial_round;
+
 	predefined_rulesets rulesets;
 
 	/* Other replicated state */
@@ -89,8 +97,12 @@ class server_setup :
 	std::vector<mode_player_id> moved_to_spectators;
 
 	compact_server_step_entropy step_collected;
+	server_step_entropy step_unpacked;
+	networked_server_step_entropy step_delta_coded;
 	bool reinference_necessary = false;
 
+	join_epoch epoch;
+
 	augs::propagate_const<std::unique_ptr<server_adapter>> server;
 	std::array<server_client_state, max_incoming_connections_v> clients;
 	server_client_state integrated_client;
@@ -123,15 +135,18 @@ class server_setup :
 
 	struct webhook_job {
 		mode_player_id player_id;
-		std::unique_ptr<std::future<std::string>> job;
+		uint64_t request_id = 0;
 	};
 
 	std::vector<webhook_job> pending_jobs;
 
+	/* Created with the first webhook, so that servers without any spawn no threads. */
+	std::unique_ptr<http_executor> webhook_executor;
+
 	uint32_t duel_pic_counter = 0;
 
-	template <class F>
-	void push_webhook_job(F&& f, mode_player_id = mode_player_id());
+	/* With a player id, the response is awaited for the url of the uploaded avatar. */
+	void push_webhook_job(http_request, mode_player_id = mode_player_id());
 
 	void finalize_webhook_jobs();
 
@@ -144,6 +159,8 @@ class server_setup :
 public:
 	net_time_t last_logged_at = 0;
 	server_profiler profiler;
+private:
+	augs::tick_scheduler tick_scheduler;
 private:
 	/* No server state follows later in code. */
 
@@ -156,7 +173,8 @@ private:
 			self.scene,
 			self.scene.world,
 			self.rulesets,
-			self.initial_signi
+			self.initial_signi,
+			std::addressof(self.initial_round)
 		};
 	}
 
@@ -175,6 +193,7 @@ private:
 	void request_immediate_heartbeat();
 
 	void perform_automoves_to_spectators();
+	bool controls_living_character(mode_player_id) const;
 	void accept_entropy_of_client(
 		const mode_player_id,
 		const total_client_entropy&
@@ -200,6 +219,12 @@ private:
 	client_id_type get_integrated_client_id() const;
 
 	void reinfer_if_necessary_for(const compact_server_step_entropy& entropy);
+
+	void begin_join_epoch();
+	void send_join_epoch_to(const client_id_type&, server_client_state&);
+	void renew_expired_join_epoch_if_quiet();
+	bool is_quiet_moment() const;
+
 	bool server_list_enabled() const;
 	bool has_sent_any_heartbeats() const;
 	void shutdown();
@@ -260,6 +285,13 @@ public:
 
 	void choose_arena(const std::string& name);
 
+	/* 
+		Lets this server hold the flavours and the logical assets of another server playing the same arena.
+		Does nothing if the arenas differ.
+	*/
+
+	bool share_arena_common_with(const server_setup& b);
+
 	std::string describe_client(const client_id_type id) const;
 	void log_malicious_client(const client_id_type id);
 
@@ -293,6 +325,9 @@ public:
 		const auto current_time = get_current_time();
 
 		while (server_time <= current_time) {
+			/* Catch-up steps count as late too, since that is how late their inputs are applied. */
+			profiler.tick_lateness.measure(current_time - server_time);
+
 			auto scope = measure_scope(profiler.step);
 
 			step_collected.clear();
@@ -333,6 +368,8 @@ public:
 				local_collected.clear();
 			}
 
+			renew_expired_join_epoch_if_quiet();
+
 			{
 				auto scope = measure_scope(profiler.send_entropies);
 				send_server_step_entropies(step_collected);
@@ -352,7 +389,9 @@ public:
 			{
 				auto scope = measure_scope(profiler.solve_simulation);
 
-				const auto unpacked = unpack(step_collected);
+				unpack(step_collected, step_unpacked);
+
+				const auto& unpacked = step_unpacked;
 				const auto arena = get_arena_handle();
 
 				if (is_dedicated()) {
@@ -412,6 +451,7 @@ public:
 			step_collected.clear();
 		}
 
+		finalize_webhook_jobs();
 		log_performance();
 	}
 
@@ -453,9 +493,13 @@ public:
 
 	void sleep_until_next_tick();
 
+	net_time_t get_next_tick_time() const {
+		return server_time;
+	}
+
 	void update_stats(server_network_info&) const;
 
-	server_step_entropy unpack(const compact_server_step_entropy&) const;
+	void unpack(const compact_server_step_entropy&, server_step_entropy& into) const;
 
 	rcon_level_type get_rcon_level(const client_id_type&) const;
 
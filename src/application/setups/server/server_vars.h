@@ -57,12 +57,17 @@ struct server_vars {
 	uint32_t max_client_resyncs = 3;
 
 	uint32_t send_packets_once_every_tick = 1;
+	uint32_t pace_client_sends_kbps = 0;
 
 	uint32_t max_buffered_client_commands = 1000;
+	bool broadcast_only_effective_inputs = true;
 
 	uint32_t state_hash_once_every_tick = 1;
 	float send_net_statistics_update_once_every_secs = 1;
 
+	uint32_t max_lag_compensation_ms = 150;
+	float update_lag_compensation_once_every_secs = 1;
+
 	float max_kick_ban_linger_secs = 2;
 
 	augs::maybe_network_simulator network_simulator;
@@ -72,6 +77,8 @@ struct server_vars {
 	uint32_t max_bots = 0;
 	float log_performance_once_every_secs = 1;
 	float sleep_mult = 0.1f;
+	bool precise_tick_scheduling = true;
+	bool receive_packets_between_ticks = true;
 
 	server_webhook_vars webhooks;
 	// END GEN INTROSPECTOR
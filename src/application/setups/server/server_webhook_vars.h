@@ -11,6 +11,10 @@ struct server_webhook_vars {
 	augs::constant_size_string<400> fled_pic_link = "https://hypersomnia.xyz/duels/shameful.jpg";
 	augs::constant_size_string<400> reconsidered_pic_link = "https://hypersomnia.xyz/duels/reconsidered.jpg";
 	uint32_t num_duel_pics = 6;
+
+	uint32_t num_http_workers = 2;
+	uint32_t max_queued_http_requests = 64;
+	float batch_window_secs = 1.0f;
 	// END GEN INTROSPECTOR
 
 	bool operator==(const server_webhook_vars&) const = default;
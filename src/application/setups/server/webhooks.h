@@ -581,4 +581,70 @@ namespace discord_webhooks {
 		};
 	}
 
+	/*
+		Discord shows up to 10 embeds in a single message,
+		so notifications posted by the same hook at about the same time can share one.
+		Only plain payloads are merged; anything with attachments goes out on its own.
+	*/
+
+	inline bool merge_payloads(httplib::MultipartFormDataItems& into, const httplib::MultipartFormDataItems& from) {
+		using namespace rapidjson;
+
+		const auto max_embeds = 10u;
+
+		auto is_plain = [](const httplib::MultipartFormDataItems& items) {
+			return items.size() == 1 && items[0].name == "payload_json" && items[0].filename.empty();
+		};
+
+		if (!is_plain(into) || !is_plain(from)) {
+			return false;
+		}
+
+		Document a;
+		Document b;
+
+		if (a.Parse(into[0].content).HasParseError() || b.Parse(from[0].content).HasParseError()) {
+			return false;
+		}
+
+		auto embeds_of = [](const Document& d) -> const Value* {
+			if (d.IsObject() && d.HasMember("embeds") && d["embeds"].IsArray()) {
+				return &d["embeds"];
+			}
+
+			return nullptr;
+		};
+
+		auto username_of = [](const Document& d) -> std::string {
+			if (d.HasMember("username") && d["username"].IsString()) {
+				return d["username"].GetString();
+			}
+
+			return "";
+		};
+
+		const auto a_embeds = embeds_of(a);
+		const auto b_embeds = embeds_of(b);
+
+		if (a_embeds == nullptr || b_embeds == nullptr) {
+			return false;
+		}
+
+		if (username_of(a) != username_of(b) || a_embeds->Size() + b_embeds->Size() > max_embeds) {
+			return false;
+		}
+
+		auto& merged_embeds = a["embeds"];
+
+		for (const auto& e : b_embeds->GetArray()) {
+			merged_embeds.PushBack(Value(e, a.GetAllocator()), a.GetAllocator());
+		}
+
+		StringBuffer s;
+		Writer<StringBuffer> writer(s);
+		a.Accept(writer);
+
+		into[0].content = s.GetString();
+		return true;
+	}
 }
@@ -44,6 +44,10 @@ struct network_profiler;
 struct network_info;
 struct lag_compensation_settings;
 
+namespace augs {
+	class thread_pool;
+}
+
 struct server_advance_input {
 	const vec2i screen_size;
 	const input_settings settings;
@@ -79,6 +83,8 @@ struct client_advance_input {
 	interpolation_system& interp;
 	past_infection_system& past_infection;
 
+	augs::thread_pool& pool;
+
 	auto make_accumulator_input() const {
 		return entropy_accumulator::input {
 			settings,
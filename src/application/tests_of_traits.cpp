@@ -291,6 +291,11 @@ struct tests_of_traits {
 	static_assert(can_reserve_v<std::vector<int>>, "Trait has failed");
 	static_assert(!can_reserve_v<std::map<int, int>>, "Trait has failed");
 
+	/* So that it is read and written with the same format as std::map. */
+	static_assert(is_associative_v<augs::sorted_vector_map<int, int>>, "Trait has failed");
+	static_assert(!can_access_data_v<augs::sorted_vector_map<int, int>>, "Trait has failed");
+	static_assert(can_reserve_v<augs::sorted_vector_map<int, int>>, "Trait has failed");
+
 	static_assert(!has_introspect_v<unsigned>, "Trait has failed");
 	static_assert(has_introspect_v<basic_ltrb<float>>, "Trait has failed");
 	static_assert(has_introspect_v<basic_ltrb<int>>, "Trait has failed");
@@ -4,6 +4,7 @@
 #endif
 
 #include <cstring>
+#include <algorithm>
 
 #if BUILD_SOUND_FORMAT_DECODERS
 #include <ogg/ogg.h>
@@ -15,25 +16,80 @@
 #include "augs/audio/sound_data.h"
 #include "augs/ensure.h"
 #include "augs/filesystem/file.h"
-#include "augs/audio/sound_data.h"
+#include "augs/filesystem/content_store.h"
 #include "augs/build_settings/setting_log_audio_files.h"
 
-template <class T>
-auto fclosed_unique(T* const ptr) {
-	return std::unique_ptr<T, decltype(fclose)*>(ptr, fclose);
-}
+#if BUILD_SOUND_FORMAT_DECODERS
+/* Lets vorbisfile read straight from the bytes instead of a FILE. */
+
+struct ogg_memory_source {
+	std::span<const std::byte> bytes;
+	std::size_t pos = 0;
+
+	static size_t read(void* const ptr, const size_t size, const size_t nmemb, void* const source) {
+		auto& self = *static_cast<ogg_memory_source*>(source);
+
+		const auto requested = size * nmemb;
+		const auto n = std::min(requested, self.bytes.size() - self.pos);
+
+		std::memcpy(ptr, self.bytes.data() + self.pos, n);
+		self.pos += n;
+
+		return size > 0 ? n / size : 0;
+	}
+
+	static int seek(void* const source, const ogg_int64_t offset, const int whence) {
+		auto& self = *static_cast<ogg_memory_source*>(source);
+
+		const auto base = 
+			whence == SEEK_SET ? ogg_int64_t(0) :
+			whence == SEEK_CUR ? static_cast<ogg_int64_t>(self.pos) :
+			static_cast<ogg_int64_t>(self.bytes.size())
+		;
+
+		const auto new_pos = base + offset;
+
+		if (new_pos < 0 || new_pos > static_cast<ogg_int64_t>(self.bytes.size())) {
+			return -1;
+		}
+
+		self.pos = static_cast<std::size_t>(new_pos);
+		return 0;
+	}
+
+	static long tell(void* const source) {
+		return static_cast<long>(static_cast<ogg_memory_source*>(source)->pos);
+	}
+};
+#endif
 
 namespace augs {
 	sound_data::sound_data(const path_type& path) {
-		channels = 1;
-
 		if (path.empty()) {
 			throw sound_decoding_error("Failed to decode a sound file: empty path was passed.");
 		}
 
+		content_bytes loaded_bytes;
+
+		try {
+			loaded_bytes.load(path);
+		}
+		catch (const file_open_error&) {
+			throw sound_decoding_error("Failed to decode %x: could not open the file for reading.", path);
+		}
+
+		decode(loaded_bytes.view, path);
+	}
+
+	sound_data::sound_data(const std::span<const std::byte> bytes, const path_type& reported_path) {
+		decode(bytes, reported_path);
+	}
+
+	void sound_data::decode(const std::span<const std::byte> from, const path_type& path) {
+		channels = 1;
+
 #if BUILD_SOUND_FORMAT_DECODERS
 		const auto extension = path.extension();
-		const auto path_str = path.string();
 
 		if (extension == ".ogg") {
 			std::vector<char> buffer;
@@ -46,7 +102,15 @@ namespace augs {
 
 			OggVorbis_File oggFile;
 
-			if (0 != ov_fopen(path_str.c_str(), &oggFile)) {
+			auto source = ogg_memory_source { from };
+
+			ov_callbacks callbacks;
+			callbacks.read_func = ogg_memory_source::read;
+			callbacks.seek_func = ogg_memory_source::seek;
+			callbacks.close_func = nullptr;
+			callbacks.tell_func = ogg_memory_source::tell;
+
+			if (0 != ov_open_callbacks(&source, &oggFile, nullptr, 0, callbacks)) {
 				throw sound_decoding_error("Error! Failed to load %x.", path);
 			}
 			
@@ -67,12 +131,6 @@ namespace augs {
 			std::memcpy(samples.data(), buffer.data(), buffer.size());
 		}
 		else if (extension == ".wav") {
-			auto wav_file = fclosed_unique(fopen(path_str.c_str(), "rb"));
-
-			if (!wav_file) {
-				throw sound_decoding_error("Failed to decode %x: could not open the file for reading.", path);
-			}
-
 			typedef struct WAV_HEADER {
 				/* RIFF Chunk Descriptor */
 				uint8_t         RIFF[4];        // RIFF Header Magic header
@@ -94,17 +152,19 @@ namespace augs {
 
 			wav_hdr wav_header;
 
-			if (fread(&wav_header, 1, sizeof(wav_hdr), wav_file.get()) > 0) {
+			if (from.size() >= sizeof(wav_hdr)) {
+				std::memcpy(&wav_header, from.data(), sizeof(wav_hdr));
+
 				if (wav_header.bitsPerSample == 16) {
 					channels = wav_header.NumOfChan;
 					frequency = wav_header.SamplesPerSec;
-					samples.resize(wav_header.Subchunk2Size / sizeof(sound_sample_type));
-					
-					if (const auto bytes_read = fread(samples.data(), sizeof(char), wav_header.Subchunk2Size, wav_file.get());
-						bytes_read != wav_header.Subchunk2Size
-					) {
+
+					if (from.size() - sizeof(wav_hdr) < wav_header.Subchunk2Size) {
 						throw sound_decoding_error("Failed to decode %x as WAV file.", path);
 					}
+
+					samples.resize(wav_header.Subchunk2Size / sizeof(sound_sample_type));
+					std::memcpy(samples.data(), from.data() + sizeof(wav_hdr), samples.size() * sizeof(sound_sample_type));
 				}
 				else {
 					throw sound_decoding_error(
@@ -149,6 +209,9 @@ namespace augs {
 			compute_length_in_seconds()
 		);
 #endif
+#else
+		(void)from;
+		(void)path;
 #endif
 	}
 	
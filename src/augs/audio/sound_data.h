@@ -1,4 +1,5 @@
 #pragma once
+#include <span>
 #include <vector>
 #include "augs/filesystem/path.h"
 #include "augs/templates/exception_templates.h"
@@ -17,6 +18,12 @@ namespace augs {
 
 		sound_data(const path_type& path);
 
+		/* The extension of reported_path tells the format. */
+		sound_data(std::span<const std::byte> bytes, const path_type& reported_path);
+
 		double compute_length_in_seconds() const;
+
+	private:
+		void decode(std::span<const std::byte> bytes, const path_type& reported_path);
 	};
 }
\ No newline at end of file
@@ -0,0 +1,2 @@
+#pragma once
+#define DEBUG_VERIFY_INCREMENTAL_REINFERENCE 0 && !IS_PRODUCTION_BUILD
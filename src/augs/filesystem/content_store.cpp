@@ -0,0 +1,231 @@
+#include <memory>
+#include <optional>
+#include <algorithm>
+#include "augs/log.h"
+#include "augs/ensure.h"
+#include "augs/filesystem/content_store.h"
+#include "augs/filesystem/file.h"
+#include "augs/filesystem/directory.h"
+#include "augs/readwrite/byte_file.h"
+#include "augs/misc/process_usage.h"
+
+#if PLATFORM_UNIX
+#include <unistd.h>
+#include <sys/wait.h>
+#endif
+
+namespace augs {
+	static path_type make_comparable(const path_type& path) {
+		return std::filesystem::absolute(path).lexically_normal();
+	}
+
+	content_store::content_store(const path_type& root) : root(make_comparable(root)) {}
+
+	bool content_store::is_under_root(const path_type& path) const {
+		const auto p = make_comparable(path);
+		return std::mismatch(root.begin(), root.end(), p.begin(), p.end()).first == root.end();
+	}
+
+	const_byte_span content_store::map(const path_type& path) {
+		const auto key = make_comparable(path);
+
+		std::scoped_lock lock(lk);
+
+		auto it = files.find(key);
+
+		if (it == files.end()) {
+			/* Throws before anything is inserted, so a missing file can be retried later. */
+			auto file = mapped_file(key);
+
+			mapped_bytes += file.size();
+			it = files.emplace(key, std::move(file)).first;
+		}
+
+		const auto& file = it->second;
+		return { file.data(), file.size() };
+	}
+
+	std::size_t content_store::get_num_mapped_files() const {
+		std::scoped_lock lock(lk);
+		return files.size();
+	}
+
+	std::size_t content_store::get_mapped_bytes() const {
+		std::scoped_lock lock(lk);
+		return mapped_bytes;
+	}
+
+	static std::optional<content_store> official_store;
+
+	void create_official_content_store(const path_type& root) {
+		ensure(!official_store.has_value());
+		official_store.emplace(root);
+	}
+
+	content_store* find_official_content_store() {
+		return official_store ? std::addressof(*official_store) : nullptr;
+	}
+
+	void content_bytes::load(const path_type& path) {
+		if (const auto store = find_official_content_store(); store && store->is_under_root(path)) {
+			owned.clear();
+			view = store->map(path);
+			return;
+		}
+
+		file_to_bytes(path, owned);
+		view = owned;
+	}
+
+	void content_bytes::clear() {
+		owned.clear();
+		view = {};
+	}
+
+#if PLATFORM_UNIX
+	static void load_all_content_and_wait(
+		const path_type& root,
+		const bool mapped,
+		const int ready_fd,
+		const int go_fd,
+		const int result_fd
+	) {
+		content_store store(root);
+		std::vector<std::vector<std::byte>> copies;
+
+		std::size_t checksum = 0;
+
+		for_each_in_directory_recursive(
+			root,
+			[](const auto&) {},
+			[&](const auto& path) {
+				try {
+					if (mapped) {
+						/* Touch every page, as only then is it resident. */
+						const auto bytes = store.map(path);
+
+						for (std::size_t i = 0; i < bytes.size(); i += 4096) {
+							checksum += static_cast<std::size_t>(bytes[i]);
+						}
+					}
+					else {
+						copies.emplace_back(file_to_bytes(path));
+					}
+				}
+				catch (const file_open_error&) {
+
+				}
+			}
+		);
+
+		const char ready = static_cast<char>(checksum);
+		(void)!::write(ready_fd, &ready, 1);
+
+		/* So that the parent sees the end of the pipe once every process is either ready or gone. */
+		::close(ready_fd);
+
+		/* Blocks until the parent closes its end, which it does once every process is loaded. */
+		char go;
+		(void)!::read(go_fd, &go, 1);
+
+		content_memory_usage usage;
+		usage.resident = get_resident_memory();
+		usage.proportional = get_proportional_memory();
+
+		(void)!::write(result_fd, &usage, sizeof(usage));
+	}
+
+	std::vector<content_memory_usage> measure_content_memory(
+		const path_type& root,
+		const unsigned num_processes,
+		const bool mapped
+	) {
+		int ready_pipe[2];
+		int go_pipe[2];
+		int result_pipe[2];
+
+		if (::pipe(ready_pipe) != 0 || ::pipe(go_pipe) != 0 || ::pipe(result_pipe) != 0) {
+			return {};
+		}
+
+		std::vector<pid_t> children;
+
+		for (unsigned i = 0; i < num_processes; ++i) {
+			const auto pid = ::fork();
+
+			if (pid == 0) {
+				::close(ready_pipe[0]);
+				::close(go_pipe[1]);
+				::close(result_pipe[0]);
+
+				/* Nothing may unwind past this point, as the rest of the stack belongs to the parent. */
+				try {
+					load_all_content_and_wait(root, mapped, ready_pipe[1], go_pipe[0], result_pipe[1]);
+				}
+				catch (...) {
+					::_exit(1);
+				}
+
+				::_exit(0);
+			}
+
+			if (pid > 0) {
+				children.push_back(pid);
+			}
+		}
+
+		/* 
+			Close our own write ends, so that a read reaches the end of the pipe
+			instead of blocking forever once a child has died without writing.
+		*/
+
+		::close(ready_pipe[1]);
+		::close(go_pipe[0]);
+		::close(result_pipe[1]);
+
+		std::size_t num_ready = 0;
+
+		for (std::size_t i = 0; i < children.size(); ++i) {
+			char ready;
+
+			if (::read(ready_pipe[0], &ready, 1) != 1) {
+				break;
+			}
+
+			++num_ready;
+		}
+
+		::close(go_pipe[1]);
+
+		std::vector<content_memory_usage> results;
+
+		for (std::size_t i = 0; i < num_ready; ++i) {
+			content_memory_usage usage;
+
+			if (::read(result_pipe[0], &usage, sizeof(usage)) != static_cast<ssize_t>(sizeof(usage))) {
+				break;
+			}
+
+			results.push_back(usage);
+		}
+
+		for (const auto pid : children) {
+			::waitpid(pid, nullptr, 0);
+		}
+
+		::close(ready_pipe[0]);
+		::close(result_pipe[0]);
+
+		if (children.size() != num_processes || results.size() != children.size()) {
+			LOG("Only %x out of %x content loading processes have finished.", results.size(), num_processes);
+			return {};
+		}
+
+		return results;
+	}
+#else
+	std::vector<content_memory_usage> measure_content_memory(const path_type&, unsigned, bool) {
+		return {};
+	}
+#endif
+}
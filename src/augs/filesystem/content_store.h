@@ -0,0 +1,98 @@
+#pragma once
+#include <map>
+#include <mutex>
+#include <span>
+#include <vector>
+#include <cstddef>
+
+#include "augs/filesystem/path.h"
+#include "augs/filesystem/mapped_file.h"
+
+namespace augs {
+	using const_byte_span = std::span<const std::byte>;
+
+	/*
+		Hands out the bytes of read-only content files without copying them to the heap.
+
+		A file is mapped on its first request and stays mapped for as long as the store lives,
+		so the returned spans stay valid just as long. Mapped pages belong to the file cache of the system:
+		every process on the host that loads the same content shares a single copy of it in RAM,
+		and the pages can be dropped under memory pressure instead of being swapped out.
+
+		Only the files under the root are ever mapped, as these are not written to while the game runs.
+		The files of projects edited by the user may change on disk at any time,
+		so they should be read to own buffers instead - see content_bytes.
+	*/
+
+	class content_store {
+		path_type root;
+
+		mutable std::mutex lk;
+		std::map<path_type, mapped_file> files;
+		std::size_t mapped_bytes = 0;
+
+	public:
+		explicit content_store(const path_type& root);
+
+		bool is_under_root(const path_type&) const;
+
+		/* Throws augs::file_open_error if the file can't be mapped. */
+		const_byte_span map(const path_type&);
+
+		std::size_t get_num_mapped_files() const;
+		std::size_t get_mapped_bytes() const;
+	};
+
+	/*
+		The store of the official content, one for the whole process.
+		It has to be created on the main thread before any other thread loads content,
+		as the threads that load content only ever read the pointer.
+	*/
+
+	void create_official_content_store(const path_type& root);
+
+	/* Returns nullptr if create_official_content_store was not called. */
+	content_store* find_official_content_store();
+
+	/*
+		The bytes of a single file. If it's official content, they are mapped by the official content store,
+		otherwise they are read to the owned buffer, which is reused between loads.
+		Without the official store, all files are read to the owned buffer.
+	*/
+
+	struct content_bytes {
+		std::vector<std::byte> owned;
+		const_byte_span view;
+
+		/* Throws augs::file_open_error if the file can't be read. */
+		void load(const path_type&);
+		void clear();
+
+		bool empty() const {
+			return view.empty();
+		}
+	};
+
+	struct content_memory_usage {
+		std::size_t resident = 0;
+		std::size_t proportional = 0;
+	};
+
+	/*
+		Loads every file under the root in num_processes processes running at once,
+		either mapped through a content_store or read to heap buffers,
+		and returns the memory usage of every process once all of them have finished loading.
+
+		Resident memory counts a shared page in full for every process that has it,
+		so it is the proportional memory that tells how much the sharing saves.
+
+		Returns nothing if any of the processes failed, as the rest would no longer share as much.
+		Only implemented on Unix, returns nothing elsewhere.
+	*/
+
+	std::vector<content_memory_usage> measure_content_memory(
+		const path_type& root,
+		unsigned num_processes,
+		bool mapped
+	);
+}
@@ -0,0 +1,149 @@
+#include <utility>
+#include "augs/filesystem/mapped_file.h"
+#include "augs/filesystem/file.h"
+#include "augs/string/typesafe_sprintf.h"
+
+#if PLATFORM_WINDOWS
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace augs {
+	static auto make_mapping_error(const path_type& path, const char* const what) {
+		return file_open_error(typesafe_sprintf("Failed to map %x: %x", path, what));
+	}
+
+#if PLATFORM_WINDOWS
+	mapped_file::mapped_file(const path_type& path) {
+		const auto file = CreateFileW(
+			path.c_str(),
+			GENERIC_READ,
+			FILE_SHARE_READ | FILE_SHARE_WRITE,
+			nullptr,
+			OPEN_EXISTING,
+			FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+			nullptr
+		);
+
+		if (file == INVALID_HANDLE_VALUE) {
+			throw make_mapping_error(path, "could not open the file");
+		}
+
+		LARGE_INTEGER file_size;
+
+		if (!GetFileSizeEx(file, &file_size)) {
+			CloseHandle(file);
+			throw make_mapping_error(path, "could not get the file size");
+		}
+
+		if (file_size.QuadPart == 0) {
+			CloseHandle(file);
+			return;
+		}
+
+		const auto mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+		/* The mapping keeps the file open on its own. */
+		CloseHandle(file);
+
+		if (mapping == nullptr) {
+			throw make_mapping_error(path, "CreateFileMapping failed");
+		}
+
+		const auto view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+		if (view == nullptr) {
+			CloseHandle(mapping);
+			throw make_mapping_error(path, "MapViewOfFile failed");
+		}
+
+		mapping_handle = mapping;
+		mapped = reinterpret_cast<const std::byte*>(view);
+		mapped_size = static_cast<std::size_t>(file_size.QuadPart);
+	}
+
+	void mapped_file::unmap() {
+		if (mapped != nullptr) {
+			UnmapViewOfFile(mapped);
+		}
+
+		if (mapping_handle != nullptr) {
+			CloseHandle(mapping_handle);
+		}
+
+		mapped = nullptr;
+		mapped_size = 0;
+		mapping_handle = nullptr;
+	}
+#else
+	mapped_file::mapped_file(const path_type& path) {
+		const auto fd = ::open(path.c_str(), O_RDONLY);
+
+		if (fd == -1) {
+			throw make_mapping_error(path, "could not open the file");
+		}
+
+		struct stat st;
+
+		if (::fstat(fd, &st) != 0) {
+			::close(fd);
+			throw make_mapping_error(path, "could not get the file size");
+		}
+
+		if (st.st_size == 0) {
+			::close(fd);
+			return;
+		}
+
+		const auto size = static_cast<std::size_t>(st.st_size);
+		const auto view = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+		/* The mapping keeps the file open on its own. */
+		::close(fd);
+
+		if (view == MAP_FAILED) {
+			throw make_mapping_error(path, "mmap failed");
+		}
+
+		::madvise(view, size, MADV_SEQUENTIAL);
+
+		mapped = reinterpret_cast<const std::byte*>(view);
+		mapped_size = size;
+	}
+
+	void mapped_file::unmap() {
+		if (mapped != nullptr) {
+			::munmap(const_cast<std::byte*>(mapped), mapped_size);
+		}
+
+		mapped = nullptr;
+		mapped_size = 0;
+	}
+#endif
+
+	mapped_file::~mapped_file() {
+		unmap();
+	}
+
+	mapped_file::mapped_file(mapped_file&& b) noexcept {
+		*this = std::move(b);
+	}
+
+	mapped_file& mapped_file::operator=(mapped_file&& b) noexcept {
+		if (this != &b) {
+			unmap();
+
+			mapped = std::exchange(b.mapped, nullptr);
+			mapped_size = std::exchange(b.mapped_size, 0);
+#if PLATFORM_WINDOWS
+			mapping_handle = std::exchange(b.mapping_handle, nullptr);
+#endif
+		}
+
+		return *this;
+	}
+}
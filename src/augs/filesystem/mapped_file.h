@@ -0,0 +1,43 @@
+#pragma once
+#include <cstddef>
+#include "augs/filesystem/path_declaration.h"
+
+namespace augs {
+	/*
+		A read-only view of a whole file, mapped into the address space.
+		The system reads the pages in on first access,
+		so opening even a huge file costs nothing until its bytes are touched.
+
+		Throws augs::file_open_error if the file can't be opened or mapped.
+	*/
+
+	class mapped_file {
+		const std::byte* mapped = nullptr;
+		std::size_t mapped_size = 0;
+
+#if PLATFORM_WINDOWS
+		void* mapping_handle = nullptr;
+#endif
+
+		void unmap();
+
+	public:
+		mapped_file() = default;
+		explicit mapped_file(const path_type&);
+		~mapped_file();
+
+		mapped_file(mapped_file&&) noexcept;
+		mapped_file& operator=(mapped_file&&) noexcept;
+
+		mapped_file(const mapped_file&) = delete;
+		mapped_file& operator=(const mapped_file&) = delete;
+
+		const std::byte* data() const {
+			return mapped;
+		}
+
+		std::size_t size() const {
+			return mapped_size;
+		}
+	};
+}
@@ -0,0 +1,230 @@
+#include <mutex>
+#include <unordered_map>
+
+#include "augs/misc/timing/timer.h"
+#include "augs/gui/text/drafter.h"
+#include "augs/gui/text/layout_cache.h"
+
+namespace augs {
+	namespace gui {
+		namespace text {
+			/*
+				Shared by all threads that print.
+				The lock is only held for the lookup, the drafting of a miss happens outside of it.
+				Layouts are handed out as shared pointers so that eviction never pulls one from under a printing thread.
+			*/
+
+			static constexpr uint32_t unused_frames_before_eviction_v = 60;
+
+			struct cached_layout_entry {
+				formatted_string str;
+				unsigned wrapping_width = 0;
+				bool use_kerning = false;
+
+				uint32_t last_used_frame = 0;
+				std::shared_ptr<const text_layout> layout;
+
+				bool matches(const formatted_string& s, const unsigned w, const bool k) const {
+					return wrapping_width == w && use_kerning == k && str == s;
+				}
+			};
+
+			struct layout_cache {
+				std::mutex lock;
+				std::unordered_map<uint64_t, cached_layout_entry> entries;
+
+				uint32_t current_frame = 0;
+				layout_cache_stats stats;
+
+				double average_draft_secs = 0.0;
+			};
+
+			static layout_cache cache;
+
+			static uint64_t hash_layout_key(const formatted_string& str, const unsigned wrapping_width, const bool use_kerning) {
+				/* FNV-1a over the characters and their styles. */
+				uint64_t h = 14695981039346656037ull;
+
+				auto mix = [&h](const uint64_t v) {
+					h ^= v;
+					h *= 1099511628211ull;
+				};
+
+				mix(wrapping_width);
+				mix(use_kerning ? 1 : 0);
+
+				for (const auto& c : str) {
+					mix(reinterpret_cast<uintptr_t>(c.format.font));
+					mix(static_cast<uint64_t>(c.format.color.r) | (c.format.color.g << 8) | (c.format.color.b << 16) | (static_cast<uint64_t>(c.format.color.a) << 24));
+					mix(static_cast<unsigned char>(c.utf_unit));
+				}
+
+				return h;
+			}
+
+			static std::shared_ptr<text_layout> draft_layout(
+				const formatted_string& str,
+				const unsigned wrapping_width,
+				const bool use_kerning
+			) {
+				thread_local drafter draft;
+
+				draft.wrap_width = wrapping_width;
+				draft.kerning = use_kerning;
+				draft.draw(str);
+
+				auto result = std::make_shared<text_layout>();
+				result->bbox = draft.get_bbox();
+
+				const auto& colors = draft.cached_str;
+				const auto& lines = draft.lines;
+				const auto& sectors = draft.sectors;
+
+				if (lines.empty() || sectors.empty()) {
+					return result;
+				}
+
+				for (const auto& l : lines) {
+					for (unsigned i = l.begin; i < l.end; ++i) {
+						const auto& g = *draft.cached[i];
+
+						/* Whitespace has no quad. */
+						if (g.in_atlas.exists()) {
+							result->quads.push_back({
+								g.in_atlas,
+								xywhi({ sectors[i] + g.meta.bear_x, l.top + l.asc - g.meta.bear_y }, g.in_atlas.get_original_size()),
+								style(colors[i]).color
+							});
+						}
+					}
+				}
+
+				return result;
+			}
+
+			std::shared_ptr<const text_layout> find_or_draft_layout(
+				const formatted_string& str,
+				const unsigned wrapping_width,
+				const bool use_kerning
+			) {
+				const auto key = hash_layout_key(str, wrapping_width, use_kerning);
+
+				{
+					std::unique_lock<std::mutex> lk(cache.lock);
+
+					if (const auto it = cache.entries.find(key); it != cache.entries.end()) {
+						auto& entry = it->second;
+
+						if (entry.matches(str, wrapping_width, use_kerning)) {
+							entry.last_used_frame = cache.current_frame;
+							++cache.stats.hits;
+
+							return entry.layout;
+						}
+					}
+				}
+
+				timer draft_timer;
+				auto layout = draft_layout(str, wrapping_width, use_kerning);
+				const auto draft_secs = draft_timer.get<std::chrono::seconds>();
+
+				std::unique_lock<std::mutex> lk(cache.lock);
+
+				++cache.stats.misses;
+				cache.stats.drafting_secs += draft_secs;
+
+				/*
+					On a hash collision, keep the entry that is already there.
+					Another thread might have drafted the same string meanwhile, in which case try_emplace is a no-op too.
+				*/
+
+				const auto [it, inserted] = cache.entries.try_emplace(key);
+
+				if (inserted) {
+					auto& entry = it->second;
+
+					entry.str = str;
+					entry.wrapping_width = wrapping_width;
+					entry.use_kerning = use_kerning;
+					entry.last_used_frame = cache.current_frame;
+					entry.layout = layout;
+				}
+
+				return layout;
+			}
+
+			layout_cache_stats layout_cache_next_frame() {
+				std::unique_lock<std::mutex> lk(cache.lock);
+
+				auto result = cache.stats;
+				cache.stats = {};
+
+				if (result.misses > 0) {
+					const auto this_frame_average = result.drafting_secs / result.misses;
+					cache.average_draft_secs = cache.average_draft_secs == 0.0 ? this_frame_average : (cache.average_draft_secs * 0.9 + this_frame_average * 0.1);
+				}
+
+				result.saved_secs = result.hits * cache.average_draft_secs;
+
+				++cache.current_frame;
+
+				const auto current_frame = cache.current_frame;
+
+				for (auto it = cache.entries.begin(); it != cache.entries.end();) {
+					if (current_frame - it->second.last_used_frame > unused_frames_before_eviction_v) {
+						it = cache.entries.erase(it);
+					}
+					else {
+						++it;
+					}
+				}
+
+				return result;
+			}
+
+			void clear_layout_cache() {
+				std::unique_lock<std::mutex> lk(cache.lock);
+				cache.entries.clear();
+			}
+		}
+	}
+}
+
+#if BUILD_UNIT_TESTS
+#include <Catch/single_include/catch2/catch.hpp>
+
+TEST_CASE("LayoutCache HitsOnSameContent") {
+	using namespace augs::gui::text;
+
+	augs::baked_font font;
+	font.metrics.ascender = 10;
+	font.metrics.descender = -2;
+
+	for (const auto c : std::string("Player 12")) {
+		font.glyphs[c].meta.adv = 8;
+	}
+
+	clear_layout_cache();
+	layout_cache_next_frame();
+
+	const auto a = formatted_string("Player 1", style(font, white));
+	const auto b = formatted_string("Player 2", style(font, white));
+	const auto a_red = formatted_string("Player 1", style(font, red));
+
+	const auto first = find_or_draft_layout(a, 0, false);
+	const auto second = find_or_draft_layout(a, 0, false);
+
+	REQUIRE(first == second);
+	REQUIRE(find_or_draft_layout(b, 0, false) != first);
+	REQUIRE(find_or_draft_layout(a_red, 0, false) != first);
+	REQUIRE(find_or_draft_layout(a, 100, false) != first);
+
+	const auto stats = layout_cache_next_frame();
+
+	REQUIRE(stats.hits == 1);
+	REQUIRE(stats.misses == 4);
+
+	clear_layout_cache();
+	REQUIRE(find_or_draft_layout(a, 0, false) != first);
+}
+#endif
@@ -0,0 +1,55 @@
+#pragma once
+#include <memory>
+#include <vector>
+
+#include "augs/gui/formatted_string.h"
+#include "augs/math/rects.h"
+
+/*
+	Most strings on the HUD (nicknames, health, scoreboard cells) are identical from frame to frame,
+	yet print() used to draft them from scratch every time.
+
+	The cache keeps the finished glyph quads of a string, relative to its left-top corner,
+	keyed by the content of the string together with its styles, wrapping width and kerning.
+	Printing a cached string only translates the quads.
+
+	The quads refer to the atlas entries of the glyphs,
+	so the cache must be cleared whenever the fonts are reloaded.
+*/
+
+namespace augs {
+	namespace gui {
+		namespace text {
+			struct text_layout {
+				struct glyph_quad {
+					atlas_entry tex;
+					xywhi rect;
+					rgba col;
+				};
+
+				std::vector<glyph_quad> quads;
+				vec2i bbox;
+			};
+
+			struct layout_cache_stats {
+				std::size_t hits = 0;
+				std::size_t misses = 0;
+				double drafting_secs = 0.0;
+
+				/* The drafting the hits would have cost, estimated from the average cost of a miss. */
+				double saved_secs = 0.0;
+			};
+
+			std::shared_ptr<const text_layout> find_or_draft_layout(
+				const formatted_string& str,
+				const unsigned wrapping_width,
+				const bool use_kerning
+			);
+
+			/* Call once per frame when nothing is being printed. Evicts the layouts that went unused for a while. */
+			layout_cache_stats layout_cache_next_frame();
+
+			void clear_layout_cache();
+		}
+	}
+}
@@ -5,6 +5,7 @@
 #include "augs/gui/text/ui.h"
 #include "augs/gui/text/drafter.h"
 #include "augs/gui/text/printer.h"
+#include "augs/gui/text/layout_cache.h"
 
 namespace augs {
 	namespace gui {
@@ -224,16 +225,36 @@ namespace augs {
 				}
 			}
 
+			static void draw_layout(
+				const drawer out,
+				const vec2i pos,
+				const text_layout& layout,
+				const ltrbi clipper
+			) {
+				for (const auto& q : layout.quads) {
+					out.aabb_clipped(q.tex, q.rect + pos, clipper, q.col);
+				}
+			}
+
+			static void draw_layout(
+				const drawer out,
+				const vec2i pos,
+				const text_layout& layout,
+				const ltrbi clipper,
+				const rgba overridden_col
+			) {
+				for (const auto& q : layout.quads) {
+					out.aabb_clipped(q.tex, q.rect + pos, clipper, overridden_col);
+				}
+			}
+
 			vec2i get_text_bbox(
 				const formatted_string& str, 
 				const unsigned wrapping_width,
 				const bool use_kerning
 			) {
-				thread_local drafter dr;
-				dr.kerning = use_kerning;
-				dr.wrap_width = wrapping_width;
-				dr.draw(str);
-				return dr.get_bbox();
+				/* Mostly asked right before printing the same string, so the layout will be reused by print. */
+				return find_or_draft_layout(str, wrapping_width, use_kerning)->bbox;
 			}
 
 			vec2i print(
@@ -244,16 +265,10 @@ namespace augs {
 				const ltrbi clipper,
 				const bool use_kerning
 			) {
-				thread_local drafter draft;
-				thread_local printer print;
-				
-				draft.wrap_width = wrapping_width;
-				draft.kerning = use_kerning;
-
-				draft.draw(str);
-				print.draw_text(out, pos, draft, clipper);
+				const auto layout = find_or_draft_layout(str, wrapping_width, use_kerning);
+				draw_layout(out, pos, *layout, clipper);
 				
-				return draft.get_bbox();
+				return layout->bbox;
 			}
 
 			vec2i print_stroked(
@@ -266,35 +281,19 @@ namespace augs {
 				const ltrbi clipper,
 				const bool use_kerning
 			) {
-				thread_local drafter draft;
-				thread_local printer print;
-
-				draft.wrap_width = wrapping_width;
-				draft.kerning = use_kerning;
-
-				draft.draw(str);
-
-				auto coloured_str = str;
-
-				for (auto& col : coloured_str) {
-					col.set_color(stroke_color);
-				}
-
-				thread_local formatted_utf32_string prev;
-				prev = draft.cached_str;
-
-				draft.cached_str = coloured_str;
+				const auto layout = find_or_draft_layout(str, wrapping_width, use_kerning);
+				const auto bbox = layout->bbox;
 
 				if (c.test(ralign::CX)) {
-					pos.x -= draft.get_bbox().x / 2;
+					pos.x -= bbox.x / 2;
 				}
 
 				if (c.test(ralign::CY)) {
-					pos.y -= draft.get_bbox().y / 2;
+					pos.y -= bbox.y / 2;
 				}
 
 				if (c.test(ralign::RB)) {
-					pos -= draft.get_bbox();
+					pos -= bbox;
 				}
 
 				if (c.test(ralign::T)) {
@@ -302,7 +301,7 @@ namespace augs {
 				}
 
 				if (c.test(ralign::B)) {
-					pos.y -= draft.get_bbox().y;
+					pos.y -= bbox.y;
 				}
 
 				if (c.test(ralign::L)) {
@@ -310,19 +309,17 @@ namespace augs {
 				}
 
 				if (c.test(ralign::R)) {
-					pos.x -= draft.get_bbox().x;
+					pos.x -= bbox.x;
 				}
 
-				print.draw_text(out, pos + vec2i(-1, 0), draft, clipper);
-				print.draw_text(out, pos + vec2i(1, 0), draft, clipper);
-				print.draw_text(out, pos + vec2i(0, -1), draft, clipper);
-				print.draw_text(out, pos + vec2i(0, 1), draft, clipper);
+				draw_layout(out, pos + vec2i(-1, 0), *layout, clipper, stroke_color);
+				draw_layout(out, pos + vec2i(1, 0), *layout, clipper, stroke_color);
+				draw_layout(out, pos + vec2i(0, -1), *layout, clipper, stroke_color);
+				draw_layout(out, pos + vec2i(0, 1), *layout, clipper, stroke_color);
 
-				draft.cached_str = prev;
+				draw_layout(out, pos, *layout, clipper);
 
-				print.draw_text(out, pos, draft, clipper);
-
-				return draft.get_bbox() + vec2i(2, 2);
+				return bbox + vec2i(2, 2);
 			}
 
 			vec2i print(
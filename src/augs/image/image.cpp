@@ -19,6 +19,8 @@
 #define STB_IMAGE_IMPLEMENTATION
 #include "3rdparty/stb/stb_image.h"
 #include "augs/readwrite/memory_stream.h"
+#include "augs/readwrite/pointer_to_buffer.h"
+#include "augs/filesystem/content_store.h"
 
 #define STB_IMAGE_RESIZE_IMPLEMENTATION
 #include "3rdparty/stb/stb_image_resize.h"
@@ -73,7 +75,7 @@ unsigned decode_rgba(std::vector<rgba>& out, unsigned& w, unsigned& h, const uns
   return error;
 }
 
-unsigned decode_rgba(std::vector<rgba>& out, unsigned& w, unsigned& h, const std::vector<std::byte>& from) {
+unsigned decode_rgba(std::vector<rgba>& out, unsigned& w, unsigned& h, const std::span<const std::byte> from) {
 	return decode_rgba(out, w, h, reinterpret_cast<const unsigned char*>(from.data()), from.size());
 }
 
@@ -150,7 +152,7 @@ static void Line(
 }
 
 auto& thread_local_file_buffer() {
-	thread_local std::vector<std::byte> loaded_bytes;
+	thread_local augs::content_bytes loaded_bytes;
 	loaded_bytes.clear();
 	return loaded_bytes;
 }
@@ -263,7 +265,7 @@ namespace augs {
 #endif
 	}
 
-	vec2u image::get_size(const std::vector<std::byte>& bytes) {
+	vec2u image::get_size(const std::span<const std::byte> bytes) {
 		int x;
 		int y;
 		int comp;
@@ -275,7 +277,7 @@ namespace augs {
 		return vec2u(x, y);
 	}
 
-	vec2u image::get_png_size(const std::vector<std::byte>& bytes) {
+	vec2u image::get_png_size(const std::span<const std::byte> bytes) {
 #if BUILD_IMAGE
 		const auto minimum_bytes = 16 + 4 + 4 + 1;
 
@@ -333,8 +335,8 @@ namespace augs {
 		auto& loaded_bytes = thread_local_file_buffer();
 
 		try {
-			augs::file_to_bytes(path, loaded_bytes);
-			from_image_bytes(loaded_bytes, path);
+			loaded_bytes.load(path);
+			from_image_bytes(loaded_bytes.view, path);
 		}
 		catch (const augs::file_open_error& err) {
 			throw image_loading_error(
@@ -359,7 +361,7 @@ namespace augs {
 	}
 
 	void image::from_bytes(
-		const std::vector<std::byte>& from, 
+		const std::span<const std::byte> from, 
 		const path_type& reported_path
 	) {
 		const auto extension = reported_path.extension();
@@ -368,7 +370,7 @@ namespace augs {
 			from_image_bytes(from, reported_path);
 		}
 		else if (extension == ".bin") {
-			auto in = augs::cref_memory_stream(from);
+			auto in = augs::cptr_memory_stream(augs::cpointer_to_buffer { from.data(), from.size() });
 
 			augs::read_bytes(in, size);
 			augs::read_bytes(in, v);
@@ -391,7 +393,7 @@ namespace augs {
 	}
 
 	void image::from_image_bytes(
-		const std::vector<std::byte>& from, 
+		const std::span<const std::byte> from, 
 		const path_type& reported_path
 	) {
 		v.clear();
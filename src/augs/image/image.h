@@ -1,4 +1,5 @@
 #pragma once
+#include <span>
 #include <vector>
 #include <variant>
 #include <memory>
@@ -76,20 +77,20 @@ namespace augs {
 		static image white_pixel();
 
 		static vec2u get_size(const path_type& file_path);
-		static vec2u get_size(const std::vector<std::byte>& bytes);
-		static vec2u get_png_size(const std::vector<std::byte>& bytes);
+		static vec2u get_size(std::span<const std::byte> bytes);
+		static vec2u get_png_size(std::span<const std::byte> bytes);
 
 		void from_file(const path_type& path);
 		void from_png(const path_type& path);
 		void from_binary_file(const path_type& path);
 
 		void from_bytes(
-			const std::vector<std::byte>& from, 
+			std::span<const std::byte> from, 
 			const path_type& reported_path
 		);
 
 		void from_image_bytes(
-			const std::vector<std::byte>& from, 
+			std::span<const std::byte> from, 
 			const path_type& reported_path
 		);
 
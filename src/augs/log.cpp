@@ -1,6 +1,9 @@
 #include <string>
 #include <thread>
 #include <mutex>
+#include <atomic>
+#include <chrono>
+#include <fstream>
 
 #include "augs/log.h"
 #include "augs/math/vec2.h"
@@ -9,6 +12,7 @@
 #include "augs/filesystem/file.h"
 #include "augs/string/string_templates.h"
 #include "augs/log_path_getters.h"
+#include "augs/misc/mpsc_ring.h"
 
 #define ENABLE_LOG 1
 
@@ -18,7 +22,6 @@
 
 std::mutex log_mutex;
 
-extern bool log_to_live_file;
 app_type current_app_type;
 
 std::string get_path_in_log_files(const std::string& name) {
@@ -94,22 +97,183 @@ std::string get_dumped_log_path() {
 	return get_path_in_log_files("dumped_debug_log.txt");
 }
 
+static constexpr std::size_t log_ring_capacity_v = 4096;
+
+struct program_log_queue {
+	augs::mpsc_ring<std::string> ring { log_ring_capacity_v };
+
+	/* Only one thread drains at a time, whether it is the writer or a producer that found no writer. */
+	std::atomic_flag draining = ATOMIC_FLAG_INIT;
+
+	std::atomic<uint32_t> pushed = 0;
+	std::atomic<bool> writer_running = false;
+	std::atomic<bool> stop_requested = false;
+	std::thread writer;
+
+	std::string batch;
+
+	std::mutex live_file_mutex;
+	std::ofstream live_file;
+	std::atomic<bool> live_file_open = false;
+};
+
 program_log program_log::global_instance = 10000;
 
 program_log::program_log(const unsigned max_all_entries) 
-	: max_all_entries(max_all_entries) 
+	: max_all_entries(max_all_entries),
+	queue(std::make_unique<program_log_queue>())
 {
 }
 
-void program_log::push_entry(const log_entry& new_entry) {
-	all_entries.push_back(new_entry);
+program_log::~program_log() {
+	stop_writer();
+}
+
+void program_log::push_entry(log_entry&& new_entry) {
+	auto& q = *queue;
+
+	while (!q.ring.try_push(new_entry.text)) {
+		/* 
+			The ring is full.
+			Help the writer instead of dropping the line, or just wait if it is already draining.
+		*/
+
+		if (!drain()) {
+			std::this_thread::yield();
+		}
+	}
+
+	if (q.writer_running.load(std::memory_order_relaxed)) {
+		q.pushed.fetch_add(1, std::memory_order_release);
+		q.pushed.notify_one();
+	}
+	else {
+		drain();
+	}
+}
+
+bool program_log::drain() {
+	auto& q = *queue;
+
+	if (q.draining.test_and_set(std::memory_order_acquire)) {
+		return false;
+	}
+
+	auto& batch = q.batch;
+	batch.clear();
+
+	{
+		std::string line;
+		std::unique_lock<std::mutex> lock(log_mutex, std::defer_lock);
+
+		while (q.ring.try_pop(line)) {
+			batch += line;
+			batch += '\n';
+
+			if (!lock.owns_lock()) {
+				lock.lock();
+			}
+
+			all_entries.push_back({ std::move(line) });
+
+			if (all_entries.size() > max_all_entries) {
+				all_entries.pop_front();
+
+				if (init_logs_count > 0) {
+					--init_logs_count;
+				}
+			}
+		}
+	}
+
+	if (!batch.empty()) {
+#if BUILD_IN_CONSOLE_MODE
+		if (this == &global_instance) {
+			std::cout << batch << std::flush;
+		}
+#endif
+
+		if (q.live_file_open.load(std::memory_order_acquire)) {
+			std::scoped_lock lock(q.live_file_mutex);
+			q.live_file << batch << std::flush;
+		}
+	}
+
+	q.draining.clear(std::memory_order_release);
+	return true;
+}
+
+void program_log::flush() {
+	while (!drain()) {
+		std::this_thread::yield();
+	}
+}
+
+void program_log::flush_before_abort() {
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(200);
 
-	if (all_entries.size() > max_all_entries) {
-		all_entries.erase(all_entries.begin(), all_entries.begin() + max_all_entries/5);
+	while (!drain()) {
+		if (std::chrono::steady_clock::now() > deadline) {
+			return;
+		}
+
+		std::this_thread::yield();
 	}
 }
 
+void program_log::open_live_file(const std::string& path) {
+	auto& q = *queue;
+
+	std::scoped_lock lock(q.live_file_mutex);
+
+	q.live_file.close();
+	q.live_file.clear();
+	q.live_file.open(path, std::ios::out | std::ios::app);
+
+	q.live_file_open.store(q.live_file.is_open(), std::memory_order_release);
+}
+
+void program_log::start_writer() {
+	auto& q = *queue;
+
+	if (q.writer_running.exchange(true)) {
+		return;
+	}
+
+	q.stop_requested = false;
+
+	q.writer = std::thread([this, &q]() {
+		while (!q.stop_requested.load(std::memory_order_acquire)) {
+			const auto seen = q.pushed.load(std::memory_order_acquire);
+
+			drain();
+
+			/* Sleep until anything else is pushed. */
+			q.pushed.wait(seen, std::memory_order_acquire);
+		}
+	});
+}
+
+void program_log::stop_writer() {
+	auto& q = *queue;
+
+	if (!q.writer_running.load()) {
+		return;
+	}
+
+	q.stop_requested.store(true, std::memory_order_release);
+	q.pushed.fetch_add(1, std::memory_order_release);
+	q.pushed.notify_one();
+
+	q.writer.join();
+	q.writer_running = false;
+
+	flush();
+}
+
 void program_log::mark_last_init_log() {
+	flush();
+
 	std::unique_lock<std::mutex> lock(log_mutex);
 
 	init_logs_count = all_entries.size();
@@ -125,7 +289,9 @@ std::size_t program_log::get_init_logs_count_nomutex() const {
 	return init_logs_count;
 }
 
-std::string program_log::get_complete() const {
+std::string program_log::get_complete() {
+	flush();
+
 	std::unique_lock<std::mutex> lock(log_mutex);
 
 	auto logs = std::string();
@@ -139,19 +305,171 @@ std::string program_log::get_complete() const {
 
 void LOG_DIRECT(const std::string& f) {
 #if ENABLE_LOG 
-	std::unique_lock<std::mutex> lock(log_mutex);
-
 	program_log::get_current().push_entry({ f });
-
-#if BUILD_IN_CONSOLE_MODE
-	std::cout << f << std::endl;
+#else
+	(void)f;
 #endif
+}
+
+double benchmark_log_throughput(const unsigned num_threads, const unsigned logs_per_thread) {
+	/* A separate instance, so that the benchmark neither floods the console nor evicts the real history. */
+	program_log bench_log(1000);
+	bench_log.start_writer();
+
+	std::vector<std::thread> producers;
+	producers.reserve(num_threads);
+
+	const auto started = std::chrono::steady_clock::now();
 
-	if (log_to_live_file) {
-		std::ofstream recording_file(get_path_in_log_files("live_debug.txt"), std::ios::out | std::ios::app);
-		recording_file << f << std::endl;
+	for (unsigned t = 0; t < num_threads; ++t) {
+		producers.emplace_back([&bench_log, t, logs_per_thread]() {
+			for (unsigned i = 0; i < logs_per_thread; ++i) {
+				bench_log.push_entry({ typesafe_sprintf("Thread %x: benchmark line %x", t, i) });
+			}
+		});
 	}
-#else
-	(void)f;
+
+	for (auto& p : producers) {
+		p.join();
+	}
+
+	bench_log.stop_writer();
+
+	const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+	const auto total = static_cast<double>(num_threads) * logs_per_thread;
+
+	return elapsed > 0.0 ? total / elapsed : 0.0;
+}
+
+#if BUILD_UNIT_TESTS
+#include <Catch/single_include/catch2/catch.hpp>
+
+TEST_CASE("MpscRing FifoOrder") {
+	augs::mpsc_ring<int> ring(4);
+
+	for (int i = 0; i < 4; ++i) {
+		auto v = i;
+		REQUIRE(ring.try_push(v));
+	}
+
+	{
+		auto v = 4;
+		REQUIRE(!ring.try_push(v));
+		REQUIRE(v == 4);
+	}
+
+	int out = -1;
+
+	for (int i = 0; i < 4; ++i) {
+		REQUIRE(ring.try_pop(out));
+		REQUIRE(out == i);
+	}
+
+	REQUIRE(!ring.try_pop(out));
+
+	for (int i = 0; i < 10; ++i) {
+		auto v = i;
+		REQUIRE(ring.try_push(v));
+		REQUIRE(ring.try_pop(out));
+		REQUIRE(out == i);
+	}
+}
+
+TEST_CASE("MpscRing ManyProducers") {
+	constexpr unsigned num_threads = 4;
+	constexpr unsigned per_thread = 20000;
+
+	augs::mpsc_ring<unsigned> ring(64);
+	std::vector<std::thread> producers;
+
+	for (unsigned t = 0; t < num_threads; ++t) {
+		producers.emplace_back([&ring, t]() {
+			for (unsigned i = 0; i < per_thread; ++i) {
+				auto v = t * per_thread + i;
+
+				while (!ring.try_push(v)) {
+					std::this_thread::yield();
+				}
+			}
+		});
+	}
+
+	std::vector<unsigned> last_per_thread(num_threads, 0);
+	std::vector<unsigned> counts(num_threads, 0);
+
+	unsigned received = 0;
+	unsigned out = 0;
+
+	while (received < num_threads * per_thread) {
+		if (ring.try_pop(out)) {
+			const auto t = out / per_thread;
+			const auto i = out % per_thread;
+
+			/* Lines of a single thread must never be reordered. */
+			if (counts[t] > 0) {
+				REQUIRE(i > last_per_thread[t]);
+			}
+
+			last_per_thread[t] = i;
+			++counts[t];
+			++received;
+		}
+	}
+
+	for (auto& p : producers) {
+		p.join();
+	}
+
+	for (const auto c : counts) {
+		REQUIRE(c == per_thread);
+	}
+}
+
+TEST_CASE("ProgramLog BoundedHistory") {
+	program_log l(100);
+	l.start_writer();
+
+	std::vector<std::thread> producers;
+
+	for (unsigned t = 0; t < 4; ++t) {
+		producers.emplace_back([&l]() {
+			for (unsigned i = 0; i < 1000; ++i) {
+				l.push_entry({ "line" });
+			}
+		});
+	}
+
+	for (auto& p : producers) {
+		p.join();
+	}
+
+	l.stop_writer();
+
+	REQUIRE(l.all_entries.size() == 100);
+}
+
+TEST_CASE("ProgramLog LiveFileBeforeAbort") {
+	const auto path = augs::path_type(GENERATED_FILES_DIR "/test_live_debug.txt");
+	augs::remove_file(path);
+
+	{
+		program_log l(100);
+		l.open_live_file(path.string());
+		l.start_writer();
+
+		l.push_entry({ "first line" });
+		l.push_entry({ "last line before the crash" });
+
+		/* What the terminate handler does right before std::abort, whether or not the writer has woken up yet. */
+		l.flush_before_abort();
+
+		REQUIRE(augs::file_to_string(path) == "first line\nlast line before the crash\n");
+		REQUIRE(l.all_entries.size() == 2);
+		REQUIRE(l.all_entries.back().text == "last line before the crash");
+
+		l.stop_writer();
+	}
+
+	augs::remove_file(path);
+}
 #endif
-}
\ No newline at end of file
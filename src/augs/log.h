@@ -1,5 +1,7 @@
 #pragma once
+#include <deque>
 #include <vector>
+#include <memory>
 #include <cstring>
 
 #include "augs/log_direct.h"
@@ -11,12 +13,26 @@ struct log_entry {
 	std::string text;
 };
 
+struct program_log_queue;
+
+/*
+	LOG_DIRECT only pushes the line into a lock-free ring.
+	Whoever drains the ring - the writer thread if it was started, otherwise the logging thread itself -
+	appends the batch to the bounded history below and writes it to the console and the live file at once.
+
+	Lines still in the ring when the program dies are lost,
+	so the exit and crash paths flush the ring explicitly - see flush_before_abort.
+
+	all_entries and init_logs_count are guarded by log_mutex.
+*/
+
 class program_log {
 	static program_log global_instance;
 	unsigned max_all_entries;
 
-	void push_entry(const log_entry&);
-	friend void LOG_DIRECT(const std::string& f);
+	std::unique_ptr<program_log_queue> queue;
+
+	bool drain();
 
 public:
 	static auto& get_current() {
@@ -24,17 +40,37 @@ public:
 	}
 
 	program_log(const unsigned max_all_entries);
+	~program_log();
 
-	std::vector<log_entry> all_entries;
+	std::deque<log_entry> all_entries;
 	std::size_t init_logs_count = 0;
 
+	void push_entry(log_entry&&);
+
+	void start_writer();
+	void stop_writer();
+
+	/* Blocks until every line logged so far is in the history and on disk. */
+	void flush();
+
+	/*
+		For the terminate handler. Same as flush, but gives up after a while,
+		as the crashing thread might have been the one draining the ring.
+	*/
+	void flush_before_abort();
+
+	void open_live_file(const std::string& path);
+
 	void mark_last_init_log();
 	std::size_t get_init_logs_count() const;
 	std::size_t get_init_logs_count_nomutex() const;
 
-	std::string get_complete() const;
+	std::string get_complete();
 };
 
+/* Returns LOG calls per second. */
+double benchmark_log_throughput(unsigned num_threads, unsigned logs_per_thread);
+
 template <class... A>
 FORCE_NOINLINE void LOG(const std::string& f, A&&... a) {
 	LOG_DIRECT(typesafe_sprintf(f, std::forward<A>(a)...));
@@ -0,0 +1,246 @@
+#include <algorithm>
+#include "augs/ensure.h"
+#include "augs/misc/compress.h"
+#include "augs/misc/delta_snapshots.h"
+
+namespace augs {
+	void delta_snapshots::invalidate_caches_from(const step_type step) {
+		if (last_pushed_step && *last_pushed_step >= step) {
+			last_pushed_step = std::nullopt;
+			last_pushed.clear();
+		}
+
+		if (restored_step && *restored_step >= step) {
+			restored_step = std::nullopt;
+		}
+	}
+
+	void delta_snapshots::apply(const compressed_snapshot& entry, snapshot_type& state) const {
+		if (entry.keyframe) {
+			state.resize(entry.uncompressed_size);
+			decompress(entry.bytes.data(), entry.bytes.size(), state);
+			return;
+		}
+
+		scratch.resize(entry.uncompressed_size);
+		decompress(entry.bytes.data(), entry.bytes.size(), scratch);
+
+		const auto n = std::min(state.size(), scratch.size());
+
+		for (std::size_t i = 0; i < n; ++i) {
+			scratch[i] ^= state[i];
+		}
+
+		state.swap(scratch);
+	}
+
+	void delta_snapshots::push(const step_type step, snapshot_type&& snapshot, const unsigned keyframe_interval) {
+		entries.erase(entries.lower_bound(step), entries.end());
+		invalidate_caches_from(step);
+
+		if (compression_state.empty()) {
+			compression_state = make_compression_state();
+		}
+
+		const bool keyframe = [&]() {
+			if (entries.empty() || keyframe_interval <= 1) {
+				return true;
+			}
+
+			unsigned deltas_since_keyframe = 0;
+
+			for (auto it = entries.rbegin(); it != entries.rend() && !it->second.keyframe; ++it) {
+				++deltas_since_keyframe;
+			}
+
+			return deltas_since_keyframe + 1 >= keyframe_interval;
+		}();
+
+		compressed_snapshot entry;
+		entry.keyframe = keyframe;
+		entry.uncompressed_size = static_cast<uint32_t>(snapshot.size());
+
+		if (keyframe) {
+			compress(compression_state, snapshot, entry.bytes);
+		}
+		else {
+			const auto previous_step = entries.rbegin()->first;
+			const auto& previous = last_pushed_step == previous_step ? last_pushed : get(previous_step);
+
+			scratch.resize(snapshot.size());
+
+			const auto n = std::min(previous.size(), snapshot.size());
+
+			for (std::size_t i = 0; i < n; ++i) {
+				scratch[i] = snapshot[i] ^ previous[i];
+			}
+
+			std::copy(snapshot.begin() + n, snapshot.end(), scratch.begin() + n);
+
+			compress(compression_state, scratch, entry.bytes);
+		}
+
+		entries.emplace(step, std::move(entry));
+
+		last_pushed_step = step;
+		last_pushed = std::move(snapshot);
+	}
+
+	const delta_snapshots::snapshot_type& delta_snapshots::get(const step_type step) const {
+		if (last_pushed_step == step) {
+			return last_pushed;
+		}
+
+		if (restored_step == step) {
+			return restored;
+		}
+
+		const auto target = entries.find(step);
+		ensure(target != entries.end());
+
+		auto keyframe = target;
+
+		while (!keyframe->second.keyframe) {
+			ensure(keyframe != entries.begin());
+			--keyframe;
+		}
+
+		auto it = keyframe;
+
+		if (restored_step && *restored_step > keyframe->first && *restored_step < step) {
+			it = entries.find(*restored_step);
+		}
+		else {
+			/* Leave no stale state behind if decompression throws. */
+			restored_step = std::nullopt;
+
+			apply(keyframe->second, restored);
+			restored_step = keyframe->first;
+		}
+
+		while (it != target) {
+			++it;
+
+			restored_step = std::nullopt;
+
+			apply(it->second, restored);
+			restored_step = it->first;
+		}
+
+		return restored;
+	}
+
+	std::optional<delta_snapshots::step_type> delta_snapshots::find_at_or_before(const step_type step) const {
+		auto it = entries.upper_bound(step);
+
+		if (it == entries.begin()) {
+			return std::nullopt;
+		}
+
+		return std::prev(it)->first;
+	}
+
+	bool delta_snapshots::contains(const step_type step) const {
+		return entries.find(step) != entries.end();
+	}
+
+	std::size_t delta_snapshots::count_at_or_before(const step_type step) const {
+		return static_cast<std::size_t>(std::distance(entries.begin(), entries.upper_bound(step)));
+	}
+
+	void delta_snapshots::erase_after(const step_type step) {
+		entries.erase(entries.upper_bound(step), entries.end());
+		invalidate_caches_from(step + 1);
+	}
+
+	void delta_snapshots::clear() {
+		entries.clear();
+
+		last_pushed_step = std::nullopt;
+		last_pushed.clear();
+
+		restored_step = std::nullopt;
+		restored.clear();
+	}
+
+	std::size_t delta_snapshots::num_keyframes() const {
+		return std::count_if(entries.begin(), entries.end(), [](const auto& e) { return e.second.keyframe; });
+	}
+
+	std::size_t delta_snapshots::get_compressed_bytes() const {
+		std::size_t total = 0;
+
+		for (const auto& e : entries) {
+			total += e.second.bytes.size();
+		}
+
+		return total;
+	}
+
+	std::size_t delta_snapshots::get_last_uncompressed_size() const {
+		if (entries.empty()) {
+			return 0;
+		}
+
+		return entries.rbegin()->second.uncompressed_size;
+	}
+}
+
+#if BUILD_UNIT_TESTS
+#include <Catch/single_include/catch2/catch.hpp>
+
+TEST_CASE("DeltaSnapshots RestoresEverySnapshot") {
+	using snapshot_type = augs::delta_snapshots::snapshot_type;
+
+	/* A state that mostly stays the same and sometimes grows or shrinks. */
+
+	auto make_state = [](const unsigned n) {
+		snapshot_type s;
+		s.resize(4096 + (n % 5) * 100, std::byte(7));
+
+		for (unsigned i = 0; i < n; ++i) {
+			s[(i * 131) % s.size()] = static_cast<std::byte>(i);
+		}
+
+		return s;
+	};
+
+	const unsigned num_snapshots = 40;
+	const unsigned keyframe_interval = 8;
+
+	augs::delta_snapshots snapshots;
+
+	for (unsigned n = 0; n < num_snapshots; ++n) {
+		snapshots.push(n * 10, make_state(n), keyframe_interval);
+	}
+
+	REQUIRE(snapshots.size() == num_snapshots);
+	REQUIRE(snapshots.num_keyframes() == num_snapshots / keyframe_interval);
+
+	/* Forward, as when replaying, and backward, as when seeking. */
+
+	for (unsigned n = 0; n < num_snapshots; ++n) {
+		REQUIRE(snapshots.get(n * 10) == make_state(n));
+	}
+
+	for (unsigned n = num_snapshots; n-- > 0;) {
+		REQUIRE(snapshots.get(n * 10) == make_state(n));
+	}
+
+	REQUIRE(snapshots.find_at_or_before(15) == 10u);
+	REQUIRE(snapshots.count_at_or_before(15) == 2);
+
+	/* Recording again from the middle. */
+
+	snapshots.erase_after(200);
+	REQUIRE(snapshots.size() == 21);
+
+	snapshots.push(210, make_state(100), keyframe_interval);
+
+	REQUIRE(snapshots.get(210) == make_state(100));
+	REQUIRE(snapshots.get(200) == make_state(20));
+	REQUIRE(snapshots.get(210) == make_state(100));
+
+	REQUIRE(snapshots.get_compressed_bytes() < num_snapshots * 4096 / 4);
+}
+#endif
@@ -0,0 +1,86 @@
+#pragma once
+#include <map>
+#include <vector>
+#include <cstdint>
+#include <optional>
+#include "augs/templates/snapshotted_player_step_type.h"
+
+namespace augs {
+	struct introspection_access;
+
+	struct compressed_snapshot {
+		// GEN INTROSPECTOR struct augs::compressed_snapshot
+		bool keyframe = true;
+		uint32_t uncompressed_size = 0;
+		std::vector<std::byte> bytes;
+		// END GEN INTROSPECTOR
+	};
+
+	/*
+		Byte snapshots of a recording, kept in as little memory as possible.
+
+		Every snapshot is XORed against the one before it and then LZ4-compressed.
+		Whatever did not change between the two becomes zeros which compress to almost nothing.
+		Once every keyframe_interval snapshots, one is compressed whole,
+		so that restoring any snapshot never needs more than keyframe_interval deltas.
+
+		Restoring is done forward from the nearest keyframe,
+		or from the last restored snapshot if it lies in between, as it does when replaying.
+	*/
+
+	class delta_snapshots {
+	public:
+		using step_type = snapshotted_player_step_type;
+		using snapshot_type = std::vector<std::byte>;
+
+	private:
+		friend introspection_access;
+
+		// GEN INTROSPECTOR class augs::delta_snapshots
+		std::map<step_type, compressed_snapshot> entries;
+		// END GEN INTROSPECTOR
+
+		std::optional<step_type> last_pushed_step;
+		snapshot_type last_pushed;
+
+		mutable std::optional<step_type> restored_step;
+		mutable snapshot_type restored;
+		mutable std::vector<std::byte> scratch;
+
+		std::vector<std::byte> compression_state;
+
+		void invalidate_caches_from(step_type);
+		void apply(const compressed_snapshot&, snapshot_type& state) const;
+
+	public:
+		/* Removes all snapshots at and after the step first. */
+		void push(step_type, snapshot_type&&, unsigned keyframe_interval);
+
+		/* The returned reference is valid until the next call to any member. */
+		const snapshot_type& get(step_type) const;
+
+		std::optional<step_type> find_at_or_before(step_type) const;
+		bool contains(step_type) const;
+
+		/* How many snapshots there are at or before the step. */
+		std::size_t count_at_or_before(step_type) const;
+
+		void erase_after(step_type);
+		void clear();
+
+		bool empty() const {
+			return entries.empty();
+		}
+
+		std::size_t size() const {
+			return entries.size();
+		}
+
+		std::size_t num_keyframes() const;
+
+		/* Bytes taken by the compressed snapshots alone. */
+		std::size_t get_compressed_bytes() const;
+
+		std::size_t get_last_uncompressed_size() const;
+	};
+}
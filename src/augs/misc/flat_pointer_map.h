@@ -0,0 +1,147 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <stdexcept>
+
+namespace augs {
+	/*
+		An open-addressing hash map from non-null pointers to values.
+
+		Meant for scratch maps that are filled and thrown away many times per second,
+		like the pointer migrations done when cloning a physics world.
+		clear() preserves the capacity, so a map that is reused
+		stops allocating once it has grown to the largest number of entries it had to hold.
+	*/
+
+	template <class T>
+	class flat_pointer_map {
+		struct slot {
+			const void* key = nullptr;
+			T value = T();
+		};
+
+		std::vector<slot> slots;
+		std::size_t count = 0;
+
+		std::size_t first_index_of(const void* const key) const {
+			/* Pointers are aligned so their lowest bits carry no information - mix them. */
+			auto h = static_cast<uint64_t>(reinterpret_cast<std::uintptr_t>(key));
+
+			h ^= h >> 33;
+			h *= 0xff51afd7ed558ccdull;
+			h ^= h >> 33;
+
+			return static_cast<std::size_t>(h) & (slots.size() - 1);
+		}
+
+		std::size_t index_of(const void* const key) const {
+			auto i = first_index_of(key);
+
+			while (slots[i].key != nullptr && slots[i].key != key) {
+				i = (i + 1) & (slots.size() - 1);
+			}
+
+			return i;
+		}
+
+		void rehash(const std::size_t new_slot_count) {
+			auto old_slots = std::move(slots);
+
+			slots.clear();
+			slots.resize(new_slot_count);
+
+			for (auto& s : old_slots) {
+				if (s.key != nullptr) {
+					slots[index_of(s.key)] = std::move(s);
+				}
+			}
+		}
+
+	public:
+		void reserve(const std::size_t n) {
+			/* Keep the load factor at most 1/2. */
+			std::size_t wanted = 16;
+
+			while (wanted < n * 2) {
+				wanted *= 2;
+			}
+
+			if (wanted > slots.size()) {
+				rehash(wanted);
+			}
+		}
+
+		void clear() {
+			if (count == 0) {
+				return;
+			}
+
+			for (auto& s : slots) {
+				s.key = nullptr;
+			}
+
+			count = 0;
+		}
+
+		std::size_t size() const {
+			return count;
+		}
+
+		bool empty() const {
+			return count == 0;
+		}
+
+		/* Returns false if the key was already there, in which case the value is not overwritten. */
+
+		bool insert(const void* const key, const T& value) {
+			reserve(count + 1);
+
+			auto& s = slots[index_of(key)];
+
+			if (s.key != nullptr) {
+				return false;
+			}
+
+			s.key = key;
+			s.value = value;
+			++count;
+
+			return true;
+		}
+
+		T* find(const void* const key) {
+			if (slots.empty()) {
+				return nullptr;
+			}
+
+			auto& s = slots[index_of(key)];
+			return s.key != nullptr ? &s.value : nullptr;
+		}
+
+		const T* find(const void* const key) const {
+			if (slots.empty()) {
+				return nullptr;
+			}
+
+			const auto& s = slots[index_of(key)];
+			return s.key != nullptr ? &s.value : nullptr;
+		}
+
+		T& at(const void* const key) {
+			if (const auto found = find(key)) {
+				return *found;
+			}
+
+			throw std::out_of_range("flat_pointer_map::at");
+		}
+
+		const T& at(const void* const key) const {
+			if (const auto found = find(key)) {
+				return *found;
+			}
+
+			throw std::out_of_range("flat_pointer_map::at");
+		}
+	};
+}
@@ -0,0 +1,114 @@
+#pragma once
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+namespace augs {
+	/*
+		Log-linear histogram of durations in nanoseconds, in the spirit of HdrHistogram.
+
+		Values below 32 ns have a bucket each.
+		Above that, every power-of-two range is split into 16 equal buckets,
+		so a value is never reported more than ~6% larger than it was.
+
+		Recording is O(1) and never allocates.
+		Percentiles are found by walking the bucket counts, so query them once per summary, not per sample.
+	*/
+
+	class latency_histogram {
+		static constexpr unsigned sub_bucket_bits = 4;
+		static constexpr unsigned sub_buckets = 1u << sub_bucket_bits;
+
+		/* 2^36 ns is a bit over a minute; longer durations land in the last bucket. */
+		static constexpr unsigned max_value_bits = 36;
+		static constexpr unsigned num_buckets = (max_value_bits - sub_bucket_bits + 1) * sub_buckets;
+
+		std::array<uint32_t, num_buckets> counts = {};
+		uint64_t total = 0;
+		uint64_t max_recorded = 0;
+
+		static unsigned msb_of(uint64_t v) {
+			unsigned n = 0;
+
+			while (v >>= 1) {
+				++n;
+			}
+
+			return n;
+		}
+
+		static unsigned bucket_of(const uint64_t ns) {
+			if (ns < 2 * sub_buckets) {
+				return static_cast<unsigned>(ns);
+			}
+
+			const auto shift = msb_of(ns) - sub_bucket_bits;
+			const auto top = static_cast<unsigned>(ns >> shift);
+			const auto bucket = shift * sub_buckets + top;
+
+			return bucket < num_buckets ? bucket : num_buckets - 1;
+		}
+
+		static uint64_t highest_value_in(const unsigned bucket) {
+			if (bucket < 2 * sub_buckets) {
+				return bucket;
+			}
+
+			const auto shift = bucket / sub_buckets - 1;
+			const auto top = uint64_t(bucket % sub_buckets + sub_buckets);
+
+			return ((top + 1) << shift) - 1;
+		}
+
+	public:
+		void record(const uint64_t ns) {
+			++counts[bucket_of(ns)];
+			++total;
+
+			if (ns > max_recorded) {
+				max_recorded = ns;
+			}
+		}
+
+		/*
+			Returns the smallest value that is not exceeded by the given fraction of the samples,
+			e.g. percentile(0.99) for the p99.
+		*/
+
+		uint64_t percentile(const double fraction) const {
+			if (total == 0) {
+				return 0;
+			}
+
+			const auto wanted = static_cast<uint64_t>(std::ceil(fraction * static_cast<double>(total)));
+			const auto threshold = wanted > 0 ? wanted : 1;
+
+			uint64_t seen = 0;
+
+			for (unsigned b = 0; b < num_buckets; ++b) {
+				seen += counts[b];
+
+				if (seen >= threshold) {
+					const auto highest = highest_value_in(b);
+					return highest < max_recorded ? highest : max_recorded;
+				}
+			}
+
+			return max_recorded;
+		}
+
+		uint64_t get_max() const {
+			return max_recorded;
+		}
+
+		uint64_t get_count() const {
+			return total;
+		}
+
+		void clear() {
+			counts.fill(0);
+			total = 0;
+			max_recorded = 0;
+		}
+	};
+}
@@ -1,4 +1,5 @@
 #pragma once
+#include <memory>
 #include <string>
 
 #include "augs/ensure.h"
@@ -7,6 +8,8 @@
 #include "augs/templates/algorithm_templates.h"
 #include "augs/misc/timing/timer.h"
 #include "augs/misc/scope_guard.h"
+#include "augs/misc/latency_histogram.h"
+#include "augs/misc/profiling.h"
 
 namespace augs {
 	template <class derived, class T = double>
@@ -14,9 +17,8 @@ namespace augs {
 	protected:
 		std::size_t measurement_index = 0;
 
+		T running_sum = T();
 		T last_average = T();
-		T last_minimum = T();
-		T last_maximum = T();
 		T last_measurement = T();
 
 		bool measured = false;
@@ -41,19 +43,29 @@ namespace augs {
 			measured = true;
 			last_measurement = value;
 
+			/*
+				O(1) per sample: the sum of the window is updated in place
+				and the extremes are only found when they are asked for.
+			*/
+
+			running_sum -= tracked[measurement_index];
+			running_sum += last_measurement;
+
 			tracked[measurement_index] = last_measurement;
 			++measurement_index;
-			measurement_index %= tracked.size();
 
-			T avg = T();
+			if (measurement_index == tracked.size()) {
+				measurement_index = 0;
+
+				/* Recalculate every lap so that floating-point errors don't pile up. */
+				running_sum = T();
 
-			for (auto v : tracked) {
-				avg += v;
+				for (auto v : tracked) {
+					running_sum += v;
+				}
 			}
 
-			last_average = avg / static_cast<unsigned>(tracked.size());
-			last_maximum = maximum_of(tracked);
-			last_minimum = minimum_of(tracked);
+			last_average = running_sum / static_cast<unsigned>(tracked.size());
 		}
 
 		std::string summary() const {
@@ -70,11 +82,11 @@ namespace augs {
 		}
 
 		T get_maximum_units() const {
-			return last_maximum;
+			return maximum_of(tracked);
 		}
 
 		T get_minimum_units() const {
-			return last_minimum;
+			return minimum_of(tracked);
 		}
 
 		T get_last_measurement_units() const {
@@ -108,9 +120,66 @@ namespace augs {
 		using base::base;
 	};
 
+	/*
+		Allocated only once the first sample is recorded, as most measurements never are.
+		Profilers are copied along with whole cosmoi, where the samples of one mean nothing to the other,
+		so a copy starts out without the histogram and an assignment keeps the one it had.
+	*/
+
+	class lazy_latency_histogram {
+		std::unique_ptr<latency_histogram> histogram;
+
+	public:
+		lazy_latency_histogram() = default;
+		lazy_latency_histogram(const lazy_latency_histogram&) {}
+		lazy_latency_histogram(lazy_latency_histogram&&) = default;
+
+		lazy_latency_histogram& operator=(const lazy_latency_histogram&) {
+			return *this;
+		}
+
+		lazy_latency_histogram& operator=(lazy_latency_histogram&&) = default;
+
+		void record(const uint64_t ns) {
+			if (histogram == nullptr) {
+				histogram = std::make_unique<latency_histogram>();
+			}
+
+			histogram->record(ns);
+		}
+
+		uint64_t percentile(const double fraction) const {
+			return histogram ? histogram->percentile(fraction) : 0;
+		}
+
+		void clear() {
+			if (histogram) {
+				histogram->clear();
+			}
+		}
+	};
+
 	class time_measurements : public measurements<time_measurements, double> {
 		timer tm;
 
+		/*
+			The rolling average hides tick spikes,
+			so every sample also goes into a histogram that is never averaged out.
+		*/
+
+		lazy_latency_histogram histogram;
+
+		struct percentiles_data {
+			double p50 = 0.0;
+			double p99 = 0.0;
+			double p999 = 0.0;
+		};
+
+		percentiles_data percentiles_info;
+
+		profiling::trace_name_id trace_name = profiling::no_trace_name_v;
+		uint64_t trace_start_ns = 0;
+
 		using base = measurements<time_measurements, double>;
 		friend base;
 
@@ -118,12 +187,17 @@ namespace augs {
 			const auto value = base::summary_info.value;
 			const bool division_by_secs_safe = std::abs(value) > AUGS_EPSILON<double>;
 
+			const auto& p = percentiles_info;
+
 			if (division_by_secs_safe) {
 				return typesafe_sprintf(
-					"%x: %f2 ms (%f2 FPS)\n", 
+					"%x: %f2 ms (%f2 FPS) p50: %f2 p99: %f2 p999: %f2\n", 
 					title,
 					value * 1000,
-					1 / value
+					1 / value,
+					p.p50 * 1000,
+					p.p99 * 1000,
+					p.p999 * 1000
 				);
 			}
 			else {
@@ -137,14 +211,54 @@ namespace augs {
 
 	public:
 		using base::base;
-		using base::measure;
+
+		void measure(const double secs) {
+			base::measure(secs);
+			histogram.record(static_cast<uint64_t>(secs * 1e9));
+		}
 
 		void start() {
 			tm.reset();
+
+			if (profiling::tracing_enabled()) {
+				trace_start_ns = profiling::now_ns();
+			}
 		}
 
 		void stop() {
 			measure(tm.get<std::chrono::seconds>());
+
+			if (trace_start_ns != 0) {
+				if (trace_name == profiling::no_trace_name_v) {
+					trace_name = profiling::intern_trace_name(title);
+				}
+
+				profiling::record_trace_event(trace_name, trace_start_ns, profiling::now_ns() - trace_start_ns);
+				trace_start_ns = 0;
+			}
+		}
+
+		/* In seconds, like the average. */
+		double get_percentile(const double fraction) const {
+			return static_cast<double>(histogram.percentile(fraction)) / 1e9;
+		}
+
+		void clear_histogram() {
+			histogram.clear();
+		}
+
+		void prepare_summary_info() {
+			base::prepare_summary_info();
+
+			auto& p = percentiles_info;
+
+			p.p50 = get_percentile(0.5);
+			p.p99 = get_percentile(0.99);
+			p.p999 = get_percentile(0.999);
+		}
+
+		const auto& get_percentiles_info() const {
+			return percentiles_info;
 		}
 	};
 
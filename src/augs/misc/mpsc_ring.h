@@ -0,0 +1,94 @@
+#pragma once
+#include <atomic>
+#include <memory>
+#include <cstddef>
+#include <utility>
+
+#include "augs/ensure.h"
+
+/*
+	Bounded lock-free queue for many producers and a single consumer
+	(D. Vyukov's bounded MPMC queue with the consumer side relaxed to a plain counter).
+
+	Every cell carries a sequence number telling whose turn it is:
+	a producer may write into a cell whose sequence equals its claimed position,
+	the consumer may read it once the sequence equals position + 1.
+
+	try_push fails only when the ring is full, so the caller decides whether to wait, drain or drop.
+	try_pop must only ever be called from one thread at a time.
+*/
+
+namespace augs {
+	template <class T>
+	class mpsc_ring {
+		struct cell {
+			std::atomic<std::size_t> sequence;
+			T value;
+		};
+
+		std::unique_ptr<cell[]> cells;
+		std::size_t mask;
+
+		alignas(64) std::atomic<std::size_t> enqueue_pos = 0;
+		alignas(64) std::size_t dequeue_pos = 0;
+
+	public:
+		explicit mpsc_ring(const std::size_t capacity) :
+			cells(std::make_unique<cell[]>(capacity)),
+			mask(capacity - 1)
+		{
+			ensure(capacity >= 2 && (capacity & (capacity - 1)) == 0);
+
+			for (std::size_t i = 0; i < capacity; ++i) {
+				cells[i].sequence.store(i, std::memory_order_relaxed);
+			}
+		}
+
+		mpsc_ring(const mpsc_ring&) = delete;
+		mpsc_ring& operator=(const mpsc_ring&) = delete;
+
+		/* Moves from the argument only if the push succeeds. */
+		bool try_push(T& value) {
+			auto pos = enqueue_pos.load(std::memory_order_relaxed);
+
+			for (;;) {
+				auto& c = cells[pos & mask];
+				const auto seq = c.sequence.load(std::memory_order_acquire);
+				const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+
+				if (diff == 0) {
+					if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+						c.value = std::move(value);
+						c.sequence.store(pos + 1, std::memory_order_release);
+						return true;
+					}
+				}
+				else if (diff < 0) {
+					return false;
+				}
+				else {
+					pos = enqueue_pos.load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+		bool try_pop(T& out) {
+			auto& c = cells[dequeue_pos & mask];
+			const auto seq = c.sequence.load(std::memory_order_acquire);
+
+			if (seq != dequeue_pos + 1) {
+				return false;
+			}
+
+			out = std::move(c.value);
+			c.sequence.store(dequeue_pos + mask + 1, std::memory_order_release);
+			++dequeue_pos;
+
+			return true;
+		}
+
+		auto capacity() const {
+			return mask + 1;
+		}
+	};
+}
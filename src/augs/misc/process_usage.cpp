@@ -0,0 +1,154 @@
+#include <thread>
+#include "augs/misc/process_usage.h"
+
+#if PLATFORM_WINDOWS
+#include <Windows.h>
+#include <Psapi.h>
+#elif PLATFORM_UNIX
+#include <ctime>
+#include <string>
+#include <fstream>
+#include <pthread.h>
+#include <unistd.h>
+#if PLATFORM_MACOS
+#include <mach/mach.h>
+#endif
+#endif
+
+namespace augs {
+	static unsigned get_num_cores() {
+		const auto n = std::thread::hardware_concurrency();
+		return n > 0 ? n : 1;
+	}
+
+#if PLATFORM_WINDOWS
+	std::size_t get_resident_memory() {
+		PROCESS_MEMORY_COUNTERS counters;
+
+		if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+			return static_cast<std::size_t>(counters.WorkingSetSize);
+		}
+
+		return 0;
+	}
+
+	std::size_t get_proportional_memory() {
+		return 0;
+	}
+
+	double get_this_thread_cpu_time() {
+		FILETIME creation, exit, kernel, user;
+
+		if (GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user)) {
+			auto to_100ns = [](const FILETIME t) {
+				return (static_cast<unsigned long long>(t.dwHighDateTime) << 32) | t.dwLowDateTime;
+			};
+
+			return (to_100ns(kernel) + to_100ns(user)) / 1e7;
+		}
+
+		return 0.0;
+	}
+
+	bool pin_this_thread_to_core(const unsigned core) {
+		const auto mask = DWORD_PTR(1) << (core % get_num_cores());
+		return SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+	}
+#elif PLATFORM_MACOS
+	std::size_t get_resident_memory() {
+		mach_task_basic_info info;
+		mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+
+		if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) == KERN_SUCCESS) {
+			return static_cast<std::size_t>(info.resident_size);
+		}
+
+		return 0;
+	}
+
+	std::size_t get_proportional_memory() {
+		return 0;
+	}
+
+	double get_this_thread_cpu_time() {
+		timespec ts;
+
+		if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0) {
+			return ts.tv_sec + ts.tv_nsec / 1e9;
+		}
+
+		return 0.0;
+	}
+
+	bool pin_this_thread_to_core(unsigned) {
+		/* macOS only takes affinity hints, not bindings. */
+		return false;
+	}
+#elif PLATFORM_UNIX
+	std::size_t get_resident_memory() {
+		std::ifstream statm("/proc/self/statm");
+
+		std::size_t total_pages = 0;
+		std::size_t resident_pages = 0;
+
+		if (statm >> total_pages >> resident_pages) {
+			return resident_pages * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+		}
+
+		return 0;
+	}
+
+	std::size_t get_proportional_memory() {
+		std::ifstream rollup("/proc/self/smaps_rollup");
+		std::string field;
+
+		while (rollup >> field) {
+			if (field == "Pss:") {
+				std::size_t kilobytes = 0;
+
+				if (rollup >> kilobytes) {
+					return kilobytes * 1024;
+				}
+
+				return 0;
+			}
+		}
+
+		return 0;
+	}
+
+	double get_this_thread_cpu_time() {
+		timespec ts;
+
+		if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0) {
+			return ts.tv_sec + ts.tv_nsec / 1e9;
+		}
+
+		return 0.0;
+	}
+
+	bool pin_this_thread_to_core(const unsigned core) {
+		cpu_set_t set;
+		CPU_ZERO(&set);
+		CPU_SET(core % get_num_cores(), &set);
+
+		return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+	}
+#else
+	std::size_t get_resident_memory() {
+		return 0;
+	}
+
+	std::size_t get_proportional_memory() {
+		return 0;
+	}
+
+	double get_this_thread_cpu_time() {
+		return 0.0;
+	}
+
+	bool pin_this_thread_to_core(unsigned) {
+		return false;
+	}
+#endif
+}
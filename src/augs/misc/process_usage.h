@@ -0,0 +1,20 @@
+#pragma once
+#include <cstddef>
+
+namespace augs {
+	/* Resident memory of the whole process, in bytes. 0 where it can't be told. */
+	std::size_t get_resident_memory();
+
+	/*
+		Like resident memory, except that every page shared with other processes
+		counts only as its share among them. Linux only, 0 elsewhere.
+	*/
+
+	std::size_t get_proportional_memory();
+
+	/* CPU time spent by the calling thread so far, in seconds. 0 where it can't be told. */
+	double get_this_thread_cpu_time();
+
+	/* Binds the calling thread to a single core, modulo the number of cores. Returns false on failure. */
+	bool pin_this_thread_to_core(unsigned core);
+}
@@ -47,6 +47,21 @@ namespace augs {
 			);
 		}
 
+		void clear_histograms() {
+			auto& self = *static_cast<derived*>(this);
+
+			for_each_measurement(
+				[](const auto&, auto& m) {
+					using T = remove_cref<decltype(m)>;
+
+					if constexpr(std::is_same_v<T, time_measurements>) {
+						m.clear_histogram();
+					}
+				},
+				self
+			);
+		}
+
 		void summary(std::string& output) const {
 			thread_local std::vector<const time_measurements*> all_with_time;
 			thread_local std::string amounts_summary;
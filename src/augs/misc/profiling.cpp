@@ -0,0 +1,335 @@
+#include <mutex>
+#include <thread>
+#include <memory>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <unordered_map>
+
+#include "augs/misc/profiling.h"
+#include "augs/filesystem/file.h"
+
+namespace augs {
+	namespace profiling {
+		std::atomic<bool> tracing_enabled_flag = false;
+
+		namespace {
+			struct trace_event {
+				trace_name_id name = no_trace_name_v;
+				uint64_t start_ns = 0;
+				uint64_t duration_ns = 0;
+			};
+
+			struct thread_trace_buffer {
+				std::string thread_name;
+				std::vector<trace_event> events;
+				std::atomic<uint64_t> num_written = 0;
+			};
+
+			struct trace_registry {
+				std::mutex lock;
+
+				std::vector<std::unique_ptr<thread_trace_buffer>> buffers;
+
+				std::vector<std::string> names;
+				std::unordered_map<std::string, trace_name_id> ids_of_names;
+
+				std::size_t events_per_thread = 0;
+			};
+
+			/*
+				Not a function-local static, as these are not thread-safe with -fno-threadsafe-statics
+				and the first to register might be any of the worker threads.
+			*/
+
+			trace_registry registry;
+
+			thread_local thread_trace_buffer* this_thread_buffer = nullptr;
+			thread_local std::string this_thread_name;
+
+			const auto process_start = std::chrono::steady_clock::now();
+
+			thread_trace_buffer& acquire_this_thread_buffer() {
+				if (this_thread_buffer == nullptr) {
+					auto& r = registry;
+					auto lock = std::unique_lock<std::mutex>(r.lock);
+
+					auto& new_buffer = r.buffers.emplace_back(std::make_unique<thread_trace_buffer>());
+					new_buffer->thread_name = this_thread_name;
+					new_buffer->events.resize(r.events_per_thread);
+
+					/*
+						The buffer is owned by the registry so that it outlives the thread,
+						e.g. the thread pool workers that are joined before the trace is written.
+					*/
+
+					this_thread_buffer = new_buffer.get();
+				}
+
+				return *this_thread_buffer;
+			}
+
+			void append_escaped(std::string& out, const std::string& s) {
+				for (const auto c : s) {
+					if (c == '"' || c == '\\') {
+						out += '\\';
+						out += c;
+					}
+					else if (static_cast<unsigned char>(c) < 0x20) {
+						out += ' ';
+					}
+					else {
+						out += c;
+					}
+				}
+			}
+		}
+
+		void enable_tracing(const std::size_t events_per_thread) {
+			auto& r = registry;
+
+			{
+				auto lock = std::unique_lock<std::mutex>(r.lock);
+
+				/* Buffers that were already allocated keep their size. */
+				r.events_per_thread = std::max(events_per_thread, std::size_t(1));
+			}
+
+			tracing_enabled_flag.store(true);
+		}
+
+		void disable_tracing() {
+			tracing_enabled_flag.store(false);
+		}
+
+		void discard_recorded_events() {
+			auto& r = registry;
+			auto lock = std::unique_lock<std::mutex>(r.lock);
+
+			for (auto& b : r.buffers) {
+				b->num_written.store(0);
+			}
+		}
+
+		uint64_t now_ns() {
+			using namespace std::chrono;
+			return static_cast<uint64_t>(duration_cast<nanoseconds>(steady_clock::now() - process_start).count());
+		}
+
+		trace_name_id intern_trace_name(const std::string& name) {
+			auto& r = registry;
+			auto lock = std::unique_lock<std::mutex>(r.lock);
+
+			if (const auto it = r.ids_of_names.find(name); it != r.ids_of_names.end()) {
+				return it->second;
+			}
+
+			const auto new_id = static_cast<trace_name_id>(r.names.size());
+
+			r.names.push_back(name);
+			r.ids_of_names.emplace(name, new_id);
+
+			return new_id;
+		}
+
+		void name_this_thread(const std::string& name) {
+			this_thread_name = name;
+
+			if (this_thread_buffer != nullptr) {
+				auto& r = registry;
+				auto lock = std::unique_lock<std::mutex>(r.lock);
+
+				this_thread_buffer->thread_name = name;
+			}
+		}
+
+		void record_trace_event(const trace_name_id name, const uint64_t start_ns, const uint64_t duration_ns) {
+			if (!tracing_enabled()) {
+				return;
+			}
+
+			auto& b = acquire_this_thread_buffer();
+			const auto n = b.num_written.load(std::memory_order_relaxed);
+
+			b.events[n % b.events.size()] = { name, start_ns, duration_ns };
+			b.num_written.store(n + 1, std::memory_order_release);
+		}
+
+		std::string make_chrome_trace() {
+			auto& r = registry;
+			auto lock = std::unique_lock<std::mutex>(r.lock);
+
+			std::string out;
+			out += "{\"traceEvents\":[\n";
+
+			bool first = true;
+
+			auto begin_event = [&]() {
+				if (!first) {
+					out += ",\n";
+				}
+
+				first = false;
+			};
+
+			char number[64];
+
+			for (std::size_t lane = 0; lane < r.buffers.size(); ++lane) {
+				const auto& b = *r.buffers[lane];
+				const auto tid = lane + 1;
+				const auto num_written = b.num_written.load(std::memory_order_acquire);
+
+				if (num_written == 0) {
+					continue;
+				}
+
+				begin_event();
+				std::snprintf(number, sizeof(number), "%zu", tid);
+
+				out += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":";
+				out += number;
+				out += ",\"args\":{\"name\":\"";
+				append_escaped(out, b.thread_name.empty() ? std::string("Thread ") + number : b.thread_name);
+				out += "\"}}";
+
+				const auto capacity = static_cast<uint64_t>(b.events.size());
+				const auto first_kept = num_written > capacity ? num_written - capacity : 0;
+
+				for (auto i = first_kept; i < num_written; ++i) {
+					const auto& e = b.events[i % capacity];
+
+					if (e.name >= r.names.size()) {
+						continue;
+					}
+
+					begin_event();
+
+					out += "{\"name\":\"";
+					append_escaped(out, r.names[e.name]);
+					out += "\",\"ph\":\"X\",\"pid\":1,\"tid\":";
+
+					std::snprintf(
+						number,
+						sizeof(number),
+						"%zu,\"ts\":%.3f,\"dur\":%.3f}",
+						tid,
+						static_cast<double>(e.start_ns) / 1000.0,
+						static_cast<double>(e.duration_ns) / 1000.0
+					);
+
+					out += number;
+				}
+			}
+
+			out += "\n],\"displayTimeUnit\":\"ms\"}\n";
+			return out;
+		}
+
+		bool write_chrome_trace(const path_type& output_path) {
+			try {
+				augs::save_as_text(output_path, make_chrome_trace());
+				return true;
+			}
+			catch (...) {
+				return false;
+			}
+		}
+	}
+}
+
+#if BUILD_UNIT_TESTS
+#include <Catch/single_include/catch2/catch.hpp>
+#include "augs/misc/latency_histogram.h"
+#include "augs/misc/measurements.h"
+
+TEST_CASE("Profiling LatencyHistogramPercentiles") {
+	augs::latency_histogram h;
+
+	REQUIRE(h.percentile(0.5) == 0);
+
+	for (uint64_t i = 1; i <= 1000; ++i) {
+		h.record(i * 1000);
+	}
+
+	auto within_bucket_error = [](const uint64_t reported, const uint64_t exact) {
+		return reported >= exact && reported <= exact + exact / 16;
+	};
+
+	REQUIRE(h.get_count() == 1000);
+	REQUIRE(within_bucket_error(h.percentile(0.5), 500 * 1000));
+	REQUIRE(within_bucket_error(h.percentile(0.99), 990 * 1000));
+	REQUIRE(h.percentile(1.0) == 1000 * 1000);
+
+	/* A single spike among a thousand samples is what the p999 is for. */
+	h.record(uint64_t(250) * 1000 * 1000);
+	REQUIRE(h.percentile(0.5) < 600 * 1000);
+	REQUIRE(h.percentile(0.9995) == uint64_t(250) * 1000 * 1000);
+
+	for (uint64_t v = 0; v < 64; ++v) {
+		augs::latency_histogram small;
+		small.record(v);
+		REQUIRE(within_bucket_error(small.percentile(0.5), v));
+	}
+
+	h.clear();
+	REQUIRE(h.get_count() == 0);
+	REQUIRE(h.percentile(0.99) == 0);
+}
+
+TEST_CASE("Profiling HistogramsAreNotCopied") {
+	augs::time_measurements a;
+	REQUIRE(a.get_percentile(0.5) == 0.0);
+
+	a.measure(0.001);
+	REQUIRE(a.get_percentile(0.5) > 0.0);
+
+	auto b = a;
+	REQUIRE(b.get_average_units() == a.get_average_units());
+	REQUIRE(b.get_percentile(0.5) == 0.0);
+
+	b.measure(0.5);
+	a = b;
+
+	REQUIRE(a.get_average_units() == b.get_average_units());
+	REQUIRE(a.get_percentile(1.0) < 0.002);
+}
+
+TEST_CASE("Profiling ChromeTraceExport") {
+	using namespace augs::profiling;
+
+	REQUIRE(!tracing_enabled());
+
+	/* A separate thread so that the main thread's buffer is not allocated with the tiny test size. */
+
+	std::string trace;
+	bool names_interned_once = false;
+
+	std::thread([&]() {
+		enable_tracing(4);
+		name_this_thread("Unit \"tests\"");
+
+		const auto name = intern_trace_name("test_scope");
+		names_interned_once = name == intern_trace_name("test_scope");
+
+		for (int i = 0; i < 10; ++i) {
+			record_trace_event(name, 1000 * i, 500);
+		}
+
+		trace = make_chrome_trace();
+
+		disable_tracing();
+		discard_recorded_events();
+	}).join();
+
+	REQUIRE(names_interned_once);
+	REQUIRE(trace.find("\"traceEvents\"") != std::string::npos);
+	REQUIRE(trace.find("Unit \\\"tests\\\"") != std::string::npos);
+	REQUIRE(trace.find("\"name\":\"test_scope\",\"ph\":\"X\"") != std::string::npos);
+
+	/* Only the most recent events are kept. */
+	REQUIRE(trace.find("\"ts\":5.000") == std::string::npos);
+	REQUIRE(trace.find("\"ts\":9.000,\"dur\":0.500") != std::string::npos);
+
+	REQUIRE(make_chrome_trace().find("test_scope\",") == std::string::npos);
+}
+#endif
@@ -0,0 +1,47 @@
+#pragma once
+#include <atomic>
+#include <string>
+#include <cstdint>
+
+#include "augs/filesystem/path_declaration.h"
+
+/*
+	Records timed scopes of every thread into per-thread ring buffers
+	and exports them as a Chrome trace (also readable by Perfetto),
+	with a separate lane for each thread.
+
+	Recording is O(1) and never locks, except for the first event of a thread which registers its buffer.
+	Only the most recent events_per_thread events of every thread are kept.
+*/
+
+namespace augs {
+	namespace profiling {
+		using trace_name_id = uint32_t;
+		constexpr trace_name_id no_trace_name_v = static_cast<trace_name_id>(-1);
+
+		extern std::atomic<bool> tracing_enabled_flag;
+
+		inline bool tracing_enabled() {
+			return tracing_enabled_flag.load(std::memory_order_relaxed);
+		}
+
+		void enable_tracing(std::size_t events_per_thread = 1 << 16);
+		void disable_tracing();
+		void discard_recorded_events();
+
+		uint64_t now_ns();
+
+		trace_name_id intern_trace_name(const std::string& name);
+		void name_this_thread(const std::string& name);
+
+		void record_trace_event(trace_name_id name, uint64_t start_ns, uint64_t duration_ns);
+
+		/*
+			Meant to be called once the traced threads are idle, e.g. at shutdown.
+			Events that are being overwritten while exporting may come out garbled.
+		*/
+
+		bool write_chrome_trace(const path_type& output_path);
+		std::string make_chrome_trace();
+	}
+}
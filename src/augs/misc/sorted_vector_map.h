@@ -0,0 +1,172 @@
+#pragma once
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+
+namespace augs {
+	/*
+		A map kept as a sorted vector of pairs.
+
+		Meant for small, frequently rebuilt maps like per-step entropies.
+		clear() preserves the capacity, so an object that is reused from step to step
+		stops allocating once it has grown to the largest number of entries it had to hold.
+
+		Exposes the same interface as std::map where it is used by readwrite and container_templates,
+		so the binary format is identical to that of std::map.
+	*/
+
+	template <class Key, class T>
+	class sorted_vector_map {
+	public:
+		using key_type = Key;
+		using mapped_type = T;
+		using value_type = std::pair<Key, T>;
+
+	private:
+		using storage_type = std::vector<value_type>;
+		storage_type entries;
+
+		struct key_less {
+			bool operator()(const value_type& a, const key_type& b) const {
+				return a.first < b;
+			}
+		};
+
+		auto lower_bound(const key_type& key) {
+			return std::lower_bound(entries.begin(), entries.end(), key, key_less());
+		}
+
+		auto lower_bound(const key_type& key) const {
+			return std::lower_bound(entries.begin(), entries.end(), key, key_less());
+		}
+
+	public:
+		using iterator = typename storage_type::iterator;
+		using const_iterator = typename storage_type::const_iterator;
+
+		auto begin() { return entries.begin(); }
+		auto end() { return entries.end(); }
+		auto begin() const { return entries.begin(); }
+		auto end() const { return entries.end(); }
+
+		std::size_t size() const {
+			return entries.size();
+		}
+
+		std::size_t capacity() const {
+			return entries.capacity();
+		}
+
+		std::size_t max_size() const {
+			return entries.max_size();
+		}
+
+		bool empty() const {
+			return entries.empty();
+		}
+
+		void reserve(const std::size_t n) {
+			entries.reserve(n);
+		}
+
+		void clear() {
+			entries.clear();
+		}
+
+		iterator find(const key_type& key) {
+			const auto it = lower_bound(key);
+
+			if (it != entries.end() && !(key < it->first)) {
+				return it;
+			}
+
+			return entries.end();
+		}
+
+		const_iterator find(const key_type& key) const {
+			const auto it = lower_bound(key);
+
+			if (it != entries.end() && !(key < it->first)) {
+				return it;
+			}
+
+			return entries.end();
+		}
+
+		std::size_t count(const key_type& key) const {
+			return find(key) != end() ? 1 : 0;
+		}
+
+		template <class... Args>
+		std::pair<iterator, bool> try_emplace(const key_type& key, Args&&... args) {
+			const auto it = lower_bound(key);
+
+			if (it != entries.end() && !(key < it->first)) {
+				return { it, false };
+			}
+
+			return {
+				entries.emplace(
+					it,
+					std::piecewise_construct,
+					std::forward_as_tuple(key),
+					std::forward_as_tuple(std::forward<Args>(args)...)
+				),
+				true
+			};
+		}
+
+		template <class K, class M>
+		std::pair<iterator, bool> emplace(K&& key, M&& mapped) {
+			return try_emplace(std::forward<K>(key), std::forward<M>(mapped));
+		}
+
+		mapped_type& operator[](const key_type& key) {
+			return try_emplace(key).first->second;
+		}
+
+		mapped_type& at(const key_type& key) {
+			const auto it = find(key);
+
+			if (it == entries.end()) {
+				throw std::out_of_range("sorted_vector_map::at");
+			}
+
+			return it->second;
+		}
+
+		const mapped_type& at(const key_type& key) const {
+			const auto it = find(key);
+
+			if (it == entries.end()) {
+				throw std::out_of_range("sorted_vector_map::at");
+			}
+
+			return it->second;
+		}
+
+		iterator erase(const const_iterator it) {
+			return entries.erase(it);
+		}
+
+		std::size_t erase(const key_type& key) {
+			const auto it = find(key);
+
+			if (it == entries.end()) {
+				return 0;
+			}
+
+			entries.erase(it);
+			return 1;
+		}
+
+		bool operator==(const sorted_vector_map& b) const {
+			return entries == b.entries;
+		}
+
+		bool operator!=(const sorted_vector_map& b) const {
+			return !operator==(b);
+		}
+	};
+}
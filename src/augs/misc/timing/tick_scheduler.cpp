@@ -0,0 +1,198 @@
+#include <thread>
+#include <algorithm>
+#include "augs/misc/timing/tick_scheduler.h"
+
+#if PLATFORM_WINDOWS
+#include <winsock2.h>
+#elif PLATFORM_LINUX
+#include <ctime>
+#include <cerrno>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/timerfd.h>
+#else
+#include <poll.h>
+#endif
+
+/*
+	Whatever the OS oversleeps by, we spin at least this long and at most this long.
+	The upper bound keeps a misbehaving timer from turning the scheduler back into a spinning loop.
+*/
+
+constexpr double min_spin_margin_v = 0.00005;
+constexpr double max_spin_margin_v = 0.004;
+
+namespace augs {
+	static double to_secs(const tick_scheduler::clock::duration d) {
+		return std::chrono::duration<double>(d).count();
+	}
+
+#if PLATFORM_LINUX
+	/* Both libstdc++ and libc++ implement steady_clock with CLOCK_MONOTONIC on Linux. */
+
+	static timespec to_timespec(const tick_scheduler::clock::time_point when) {
+		const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(when.time_since_epoch()).count();
+
+		timespec ts;
+		ts.tv_sec = static_cast<time_t>(ns / 1000000000);
+		ts.tv_nsec = static_cast<long>(ns % 1000000000);
+		return ts;
+	}
+#endif
+
+	tick_scheduler::~tick_scheduler() {
+#if PLATFORM_LINUX
+		if (timer_fd != -1) {
+			::close(timer_fd);
+		}
+#endif
+	}
+
+	bool tick_scheduler::sleep_until(const clock::time_point when, const std::optional<socket_handle_type> wake_on_readable) {
+#if PLATFORM_LINUX
+		const auto ts = to_timespec(when);
+
+		if (wake_on_readable == std::nullopt) {
+			::clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr);
+			return false;
+		}
+
+		if (timer_fd == -1) {
+			timer_fd = ::timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+		}
+
+		const auto socket = static_cast<int>(*wake_on_readable);
+
+		if (timer_fd == -1) {
+			/* Without a timer we can only poll with a relative timeout in milliseconds, so round down. */
+			const auto ms = static_cast<int>(to_secs(when - clock::now()) * 1000);
+			pollfd fd = { socket, POLLIN, 0 };
+
+			return ::poll(&fd, 1, std::max(ms, 0)) > 0 && (fd.revents & POLLIN);
+		}
+
+		itimerspec deadline = {};
+		deadline.it_value = ts;
+
+		::timerfd_settime(timer_fd, TFD_TIMER_ABSTIME, &deadline, nullptr);
+
+		pollfd fds[2] = {
+			{ timer_fd, POLLIN, 0 },
+			{ socket, POLLIN, 0 }
+		};
+
+		if (::poll(fds, 2, -1) <= 0) {
+			/* Interrupted. The caller will check the clock and wait again. */
+			return false;
+		}
+
+		if (fds[0].revents & POLLIN) {
+			uint64_t expirations = 0;
+			[[maybe_unused]] const auto n = ::read(timer_fd, &expirations, sizeof(expirations));
+		}
+
+		return fds[1].revents & POLLIN;
+#elif PLATFORM_WINDOWS
+		if (wake_on_readable == std::nullopt) {
+			std::this_thread::sleep_until(when);
+			return false;
+		}
+
+		const auto us = std::max(static_cast<long>(to_secs(when - clock::now()) * 1000000), 0l);
+
+		fd_set readable;
+		FD_ZERO(&readable);
+		FD_SET(static_cast<SOCKET>(*wake_on_readable), &readable);
+
+		timeval timeout;
+		timeout.tv_sec = us / 1000000;
+		timeout.tv_usec = us % 1000000;
+
+		return ::select(0, &readable, nullptr, nullptr, &timeout) > 0;
+#else
+		if (wake_on_readable == std::nullopt) {
+			std::this_thread::sleep_until(when);
+			return false;
+		}
+
+		const auto ms = static_cast<int>(to_secs(when - clock::now()) * 1000);
+		pollfd fd = { static_cast<int>(*wake_on_readable), POLLIN, 0 };
+
+		return ::poll(&fd, 1, std::max(ms, 0)) > 0 && (fd.revents & POLLIN);
+#endif
+	}
+
+	void tick_scheduler::calibrate(const double oversleep) {
+		/*
+			Wakeups are mostly punctual with a long tail,
+			so follow the average closely but make room for the tail.
+		*/
+
+		oversleep_estimate = 0.9 * oversleep_estimate + 0.1 * oversleep;
+		spin_margin = std::clamp(2 * oversleep_estimate + min_spin_margin_v, min_spin_margin_v, max_spin_margin_v);
+	}
+
+	tick_wait_result tick_scheduler::wait_until(const clock::time_point deadline, const std::optional<socket_handle_type> wake_on_readable) {
+		for (;;) {
+			const auto now = clock::now();
+
+			if (now >= deadline) {
+				return tick_wait_result::DEADLINE;
+			}
+
+			const auto wake_at = deadline - std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(spin_margin));
+
+			if (now < wake_at) {
+				const bool readable = sleep_until(wake_at, wake_on_readable);
+				const auto woke_at = clock::now();
+
+				stats.slept_secs += to_secs(woke_at - now);
+
+				if (readable) {
+					++stats.early_wakeups;
+					return tick_wait_result::READABLE;
+				}
+
+				if (woke_at >= wake_at) {
+					calibrate(to_secs(woke_at - wake_at));
+				}
+
+				/* Either in the spin window now, or interrupted. */
+				continue;
+			}
+
+			while (clock::now() < deadline) {
+				/* Spin. */
+			}
+
+			stats.spun_secs += to_secs(clock::now() - now);
+			return tick_wait_result::DEADLINE;
+		}
+	}
+
+	tick_wait_result tick_scheduler::wait_for(const double secs, const std::optional<socket_handle_type> wake_on_readable) {
+		const auto deadline = clock::now() + std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(secs));
+		return wait_until(deadline, wake_on_readable);
+	}
+}
+
+#if BUILD_UNIT_TESTS
+#include <Catch/single_include/catch2/catch.hpp>
+
+TEST_CASE("TickScheduler WakesUpOnTime") {
+	augs::tick_scheduler scheduler;
+
+	using clock = augs::tick_scheduler::clock;
+
+	for (int i = 0; i < 20; ++i) {
+		const auto deadline = clock::now() + std::chrono::milliseconds(2);
+
+		REQUIRE(scheduler.wait_until(deadline) == augs::tick_wait_result::DEADLINE);
+		REQUIRE(clock::now() >= deadline);
+	}
+
+	REQUIRE(scheduler.get_spin_margin() >= min_spin_margin_v);
+	REQUIRE(scheduler.get_spin_margin() <= max_spin_margin_v);
+	REQUIRE(scheduler.get_stats().slept_secs > 0.0);
+}
+#endif
@@ -0,0 +1,76 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+namespace augs {
+	enum class tick_wait_result {
+		DEADLINE,
+		READABLE
+	};
+
+	struct tick_scheduler_stats {
+		double slept_secs = 0.0;
+		double spun_secs = 0.0;
+		unsigned early_wakeups = 0;
+	};
+
+	/*
+		Waits until an absolute deadline on the monotonic clock.
+
+		The OS is asked to wake us up a bit before the deadline and the rest is spun away,
+		so that ticks start on time without a whole core burnt on spinning.
+		The spin margin follows how late the OS has recently been waking us up.
+
+		If a socket is passed, the wait returns as soon as the socket has data.
+		The caller can then receive what came and wait again for the same deadline.
+	*/
+
+	class tick_scheduler {
+	public:
+		using clock = std::chrono::steady_clock;
+		using socket_handle_type = std::uint64_t;
+
+	private:
+		double oversleep_estimate = 0.0002;
+		double spin_margin = 0.001;
+
+		tick_scheduler_stats stats;
+
+#if PLATFORM_LINUX
+		int timer_fd = -1;
+#endif
+
+		bool sleep_until(clock::time_point when, std::optional<socket_handle_type> wake_on_readable);
+		void calibrate(double oversleep);
+
+	public:
+		tick_scheduler() = default;
+		~tick_scheduler();
+
+		tick_scheduler(const tick_scheduler&) = delete;
+		tick_scheduler& operator=(const tick_scheduler&) = delete;
+
+		tick_wait_result wait_until(
+			clock::time_point deadline,
+			std::optional<socket_handle_type> wake_on_readable = std::nullopt
+		);
+
+		tick_wait_result wait_for(
+			double secs,
+			std::optional<socket_handle_type> wake_on_readable = std::nullopt
+		);
+
+		double get_spin_margin() const {
+			return spin_margin;
+		}
+
+		const auto& get_stats() const {
+			return stats;
+		}
+
+		void reset_stats() {
+			stats = {};
+		}
+	};
+}
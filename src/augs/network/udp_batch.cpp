@@ -0,0 +1,237 @@
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <algorithm>
+
+#include "augs/ensure.h"
+#include "augs/network/udp_batch.h"
+#include "augs/network/netcode_socket_raii.h"
+#include "augs/network/netcode_socket_includes.h"
+
+namespace augs {
+	void udp_batch::push(const netcode_address_t& to, const std::byte* const data, const std::size_t n) {
+		queued_datagram d;
+		d.to = to;
+		d.offset = static_cast<uint32_t>(bytes.size());
+		d.size = static_cast<uint32_t>(n);
+
+		bytes.insert(bytes.end(), data, data + n);
+		datagrams.push_back(d);
+	}
+
+	void udp_batch::clear() {
+		datagrams.clear();
+		bytes.clear();
+	}
+
+#if PLATFORM_LINUX
+	/* Same as what netcode_socket_send_packet does before calling sendto. */
+
+	static socklen_t to_sockaddr(const netcode_address_t& from, sockaddr_storage& out) {
+		std::memset(&out, 0, sizeof(out));
+
+		if (from.type == NETCODE_ADDRESS_IPV6) {
+			auto& a = reinterpret_cast<sockaddr_in6&>(out);
+			a.sin6_family = AF_INET6;
+
+			for (int i = 0; i < 8; ++i) {
+				reinterpret_cast<uint16_t*>(&a.sin6_addr)[i] = htons(from.data.ipv6[i]);
+			}
+
+			a.sin6_port = htons(from.port);
+			return sizeof(sockaddr_in6);
+		}
+
+		auto& a = reinterpret_cast<sockaddr_in&>(out);
+		a.sin_family = AF_INET;
+		a.sin_addr.s_addr =
+			(static_cast<uint32_t>(from.data.ipv4[0]))
+			| (static_cast<uint32_t>(from.data.ipv4[1]) << 8)
+			| (static_cast<uint32_t>(from.data.ipv4[2]) << 16)
+			| (static_cast<uint32_t>(from.data.ipv4[3]) << 24)
+		;
+
+		a.sin_port = htons(from.port);
+		return sizeof(sockaddr_in);
+	}
+
+	std::size_t udp_batch::send_all(netcode_socket_t& socket) {
+		constexpr auto max_n = max_datagrams_per_call_v;
+
+		std::array<mmsghdr, max_n> headers;
+		std::array<iovec, max_n> vectors;
+		std::array<sockaddr_storage, max_n> addresses;
+
+		std::size_t num_calls = 0;
+		std::size_t first = 0;
+
+		while (first < datagrams.size()) {
+			const auto n = std::min(max_n, datagrams.size() - first);
+
+			for (std::size_t i = 0; i < n; ++i) {
+				const auto& d = datagrams[first + i];
+
+				vectors[i].iov_base = bytes.data() + d.offset;
+				vectors[i].iov_len = d.size;
+
+				auto& h = headers[i];
+				std::memset(&h, 0, sizeof(h));
+
+				h.msg_hdr.msg_name = &addresses[i];
+				h.msg_hdr.msg_namelen = to_sockaddr(d.to, addresses[i]);
+				h.msg_hdr.msg_iov = &vectors[i];
+				h.msg_hdr.msg_iovlen = 1;
+			}
+
+			const auto sent = ::sendmmsg(socket.handle, headers.data(), static_cast<unsigned>(n), 0);
+			++num_calls;
+
+			/*
+				The kernel stops at the first datagram it could not send.
+				Skip just that one and carry on with the rest.
+			*/
+
+			first += sent > 0 ? static_cast<std::size_t>(sent) : 1;
+		}
+
+		clear();
+		return num_calls;
+	}
+#else
+	std::size_t udp_batch::send_all(netcode_socket_t& socket) {
+		for (auto& d : datagrams) {
+			netcode_socket_send_packet(&socket, &d.to, bytes.data() + d.offset, static_cast<int>(d.size));
+		}
+
+		const auto num_calls = datagrams.size();
+
+		clear();
+		return num_calls;
+	}
+#endif
+
+	udp_batch_benchmark_result benchmark_udp_batch(const unsigned num_destinations, const unsigned num_rounds) {
+		using clock_type = std::chrono::steady_clock;
+
+		const auto secs_since = [](const clock_type::time_point started) {
+			return std::chrono::duration<double>(clock_type::now() - started).count();
+		};
+
+		auto loopback_address = []() {
+			netcode_address_t address;
+			const auto result = netcode_parse_address("127.0.0.1", &address);
+			ensure_eq(NETCODE_OK, result);
+
+			return address;
+		};
+
+		netcode_socket_raii sender(loopback_address());
+		std::vector<netcode_socket_raii> receivers;
+
+		for (unsigned i = 0; i < num_destinations; ++i) {
+			receivers.emplace_back(loopback_address());
+		}
+
+		udp_batch_benchmark_result result;
+
+		/* About as much as a step entropy with a few players in it. */
+		result.datagram_bytes = 200;
+
+		std::vector<std::byte> payload(result.datagram_bytes, std::byte(0x5a));
+		std::array<std::byte, NETCODE_MAX_PACKET_BYTES> received;
+
+		auto drain = [&]() {
+			for (auto& r : receivers) {
+				netcode_address_t from;
+
+				while (netcode_socket_receive_packet(&r.socket, &from, received.data(), static_cast<int>(received.size())) > 0) {
+					++result.num_received;
+				}
+			}
+		};
+
+		{
+			for (unsigned round = 0; round < num_rounds; ++round) {
+				const auto started = clock_type::now();
+
+				for (auto& r : receivers) {
+					netcode_socket_send_packet(&sender.socket, &r.socket.address, payload.data(), static_cast<int>(payload.size()));
+					++result.one_by_one_calls;
+				}
+
+				result.one_by_one_secs += secs_since(started);
+				drain();
+			}
+		}
+
+		{
+			udp_batch batch;
+
+			for (unsigned round = 0; round < num_rounds; ++round) {
+				const auto started = clock_type::now();
+
+				for (auto& r : receivers) {
+					batch.push(r.socket.address, payload.data(), payload.size());
+				}
+
+				result.batched_calls += batch.send_all(sender.socket);
+				result.batched_secs += secs_since(started);
+
+				drain();
+			}
+		}
+
+		result.num_datagrams = static_cast<std::size_t>(num_destinations) * num_rounds;
+		return result;
+	}
+}
+
+#if BUILD_UNIT_TESTS
+#include <Catch/single_include/catch2/catch.hpp>
+
+TEST_CASE("UdpBatch SendsInOrderOverLoopback") {
+	netcode_address_t loopback;
+	REQUIRE(NETCODE_OK == netcode_parse_address("127.0.0.1", &loopback));
+
+	netcode_socket_raii sender(loopback);
+	netcode_socket_raii receiver(loopback);
+
+	augs::udp_batch batch;
+
+	/* More than fits in one call, so that the batch has to be split. */
+	const auto n = augs::udp_batch::max_datagrams_per_call_v + 3;
+
+	for (std::size_t i = 0; i < n; ++i) {
+		std::vector<std::byte> datagram(1 + i % 7, static_cast<std::byte>(i));
+		batch.push(receiver.socket.address, datagram.data(), datagram.size());
+	}
+
+	REQUIRE(batch.size() == n);
+
+	const auto num_calls = batch.send_all(sender.socket);
+
+	REQUIRE(batch.empty());
+	REQUIRE(num_calls >= 1);
+	REQUIRE(num_calls <= n);
+
+	std::array<std::byte, NETCODE_MAX_PACKET_BYTES> received;
+	std::size_t num_received = 0;
+
+	for (int attempt = 0; attempt < 1000 && num_received < n; ++attempt) {
+		netcode_address_t from;
+		const auto bytes = netcode_socket_receive_packet(&receiver.socket, &from, received.data(), static_cast<int>(received.size()));
+
+		if (bytes <= 0) {
+			continue;
+		}
+
+		REQUIRE(static_cast<std::size_t>(bytes) == 1 + num_received % 7);
+		REQUIRE(received[0] == static_cast<std::byte>(num_received));
+		REQUIRE(from.port == sender.socket.address.port);
+
+		++num_received;
+	}
+
+	REQUIRE(num_received == n);
+}
+#endif
@@ -0,0 +1,66 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "3rdparty/yojimbo/netcode.io/netcode.h"
+
+struct netcode_socket_t;
+
+namespace augs {
+	/*
+		Datagrams queued for one socket and handed to the kernel all at once.
+		On Linux, a single sendmmsg call carries up to max_datagrams_per_call_v of them.
+		Elsewhere they go out one by one through netcode_socket_send_packet, in the same order.
+
+		A datagram the kernel refuses is dropped, just like a failed sendto would drop it.
+	*/
+
+	class udp_batch {
+		struct queued_datagram {
+			netcode_address_t to;
+			uint32_t offset = 0;
+			uint32_t size = 0;
+		};
+
+		std::vector<queued_datagram> datagrams;
+		std::vector<std::byte> bytes;
+
+	public:
+		static constexpr std::size_t max_datagrams_per_call_v = 64;
+
+		void push(const netcode_address_t& to, const std::byte* data, std::size_t n);
+
+		/* Returns the number of system calls it took. The batch is empty afterwards. */
+		std::size_t send_all(netcode_socket_t& socket);
+
+		void clear();
+
+		bool empty() const {
+			return datagrams.empty();
+		}
+
+		std::size_t size() const {
+			return datagrams.size();
+		}
+	};
+
+	struct udp_batch_benchmark_result {
+		std::size_t num_datagrams = 0;
+		std::size_t datagram_bytes = 0;
+
+		double one_by_one_secs = 0.0;
+		double batched_secs = 0.0;
+
+		std::size_t one_by_one_calls = 0;
+		std::size_t batched_calls = 0;
+		std::size_t num_received = 0;
+	};
+
+	/*
+		Sends num_rounds rounds of a datagram to each of num_destinations sockets on the loopback,
+		once with a system call per datagram and once in batches.
+		The receivers are drained between rounds so that no buffer overflows.
+	*/
+
+	udp_batch_benchmark_result benchmark_udp_batch(unsigned num_destinations, unsigned num_rounds);
+}
@@ -4,6 +4,11 @@
 #include "augs/templates/container_templates.h"
 #include "augs/templates/reversion_wrapper.h"
 #include "augs/misc/constant_size_vector.h"
+#include "augs/misc/sorted_vector_map.h"
+#include "augs/templates/recycling_vector.h"
+#include "augs/misc/flat_pointer_map.h"
+#include "augs/templates/thread_pool.h"
+#include <unordered_map>
 
 TEST_CASE("Templates EraseFromTo") {
 	using v_t = std::vector<int>;
@@ -74,4 +79,130 @@ TEST_CASE("Templates Reverse") {
 	REQUIRE(abc[8] == 2);
 	REQUIRE(abc[9] == 1);
 }
+TEST_CASE("Templates SortedVectorMap") {
+	augs::sorted_vector_map<int, int> m;
+
+	m[5] = 50;
+	m[1] = 10;
+	m.emplace(3, 30);
+
+	REQUIRE(m.size() == 3);
+	REQUIRE(m.begin()->first == 1);
+	REQUIRE((m.begin() + 1)->first == 3);
+	REQUIRE((m.begin() + 2)->first == 5);
+
+	REQUIRE(!m.emplace(3, 31).second);
+	REQUIRE(m.at(3) == 30);
+
+	REQUIRE(mapped_or_nullptr(m, 5) != nullptr);
+	REQUIRE(*mapped_or_nullptr(m, 5) == 50);
+	REQUIRE(mapped_or_nullptr(m, 4) == nullptr);
+
+	erase_if(m, [](const auto& p) { return p.first == 3; });
+	REQUIRE(m.size() == 2);
+	REQUIRE(m.count(3) == 0);
+
+	const auto cap = m.capacity();
+	m.clear();
+	REQUIRE(m.empty());
+	REQUIRE(m.capacity() == cap);
+}
+
+TEST_CASE("Templates RecyclingVector") {
+	augs::recycling_vector<std::vector<int>> v;
+
+	const auto big = std::vector<int>(100, 1);
+
+	v.push_back(big);
+	v.push_back(big);
+
+	const auto* const first_storage = v[0].data();
+
+	erase_first_n(v, 1);
+
+	REQUIRE(v.size() == 1);
+	REQUIRE(v.num_recycled() == 1);
+
+	/* The recycled object's storage should be reused. */
+	v.push_back(big);
+
+	REQUIRE(v.size() == 2);
+	REQUIRE(v.num_recycled() == 0);
+	REQUIRE(v[1].data() == first_storage);
+	REQUIRE(v[1] == big);
+
+	v.clear();
+	REQUIRE(v.empty());
+	REQUIRE(v.num_recycled() == 2);
+}
+
+TEST_CASE("Templates FlatPointerMap") {
+	std::vector<int> objects(1000);
+	augs::flat_pointer_map<int> m;
+
+	REQUIRE(m.find(&objects[0]) == nullptr);
+
+	for (int i = 0; i < 1000; ++i) {
+		REQUIRE(m.insert(&objects[i], i));
+	}
+
+	REQUIRE(m.size() == 1000);
+	REQUIRE(!m.insert(&objects[3], 42));
+	REQUIRE(m.at(&objects[3]) == 3);
+
+	for (int i = 0; i < 1000; ++i) {
+		REQUIRE(m.at(&objects[i]) == i);
+	}
+
+	m.clear();
+
+	REQUIRE(m.empty());
+	REQUIRE(m.find(&objects[500]) == nullptr);
+	REQUIRE_THROWS(m.at(&objects[500]));
+}
+
+TEST_CASE("Templates AssignReusingMapped") {
+	std::unordered_map<int, std::vector<int>> to;
+	std::unordered_map<int, std::vector<int>> from;
+
+	to[1] = std::vector<int>(100, 1);
+	to[2] = { 2 };
+
+	const auto* const storage_of_1 = to[1].data();
+
+	from[1] = { 10, 11 };
+	from[3] = { 30 };
+
+	assign_reusing_mapped(to, from);
+
+	REQUIRE(to == from);
+	REQUIRE(to[1].data() == storage_of_1);
+}
+
+TEST_CASE("Templates ThreadPoolForkJoin") {
+	augs::thread_pool pool(3);
+
+	std::vector<int> visited(1000, 0);
+
+	pool.fork_join(visited.size(), [&visited](const std::size_t i) {
+		visited[i] += static_cast<int>(i);
+	});
+
+	for (std::size_t i = 0; i < visited.size(); ++i) {
+		REQUIRE(visited[i] == static_cast<int>(i));
+	}
+
+	/* Forked jobs must not disturb the completion of the submitted ones. */
+
+	int submitted_runs = 0;
+	pool.enqueue([&submitted_runs]() { ++submitted_runs; });
+	pool.submit();
+
+	pool.fork_join(8, [](std::size_t) {});
+
+	pool.help_until_no_tasks();
+	pool.wait_for_all_tasks_to_complete();
+
+	REQUIRE(submitted_runs == 1);
+}
 #endif
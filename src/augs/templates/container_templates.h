@@ -170,6 +170,24 @@ bool found_in(const Container& v, const K& l) {
 	}
 }
 
+/*
+	Copy-assigns a map by assigning to the mapped values that are already there,
+	so that mapped containers keep their capacity instead of being destroyed and copied anew
+	- which is what the node-reusing operator= of std::unordered_map does.
+
+	Unlike operator=, this does not preserve the iteration order of the source,
+	so only use it for maps that are never iterated in order-sensitive logic.
+*/
+
+template <class Map>
+void assign_reusing_mapped(Map& to, const Map& from) {
+	erase_if(to, [&](const auto& entry) { return !found_in(from, entry.first); });
+
+	for (const auto& entry : from) {
+		to[entry.first] = entry.second;
+	}
+}
+
 template <class T, class... Args>
 T default_or_invalid_enum(Args&&... args) {
 	if constexpr(std::is_enum_v<T>) {
@@ -0,0 +1,109 @@
+#pragma once
+#include <vector>
+#include <utility>
+
+#include "augs/ensure.h"
+#include "augs/ensure_rel.h"
+
+namespace augs {
+	/*
+		A vector that does not destroy the objects that are erased from it.
+		They are moved to a pool of recycled objects instead,
+		and pushing a new element copy-assigns into a recycled object.
+
+		For element types that own heap memory (e.g. entropies with vectors inside),
+		a vector that is frequently pushed to and erased from stops allocating
+		once it reaches its steady-state size.
+	*/
+
+	template <class T>
+	class recycling_vector {
+		using storage_type = std::vector<T>;
+
+		storage_type alive;
+		storage_type recycled;
+
+		T& acquire() {
+			if (recycled.empty()) {
+				return alive.emplace_back();
+			}
+
+			alive.emplace_back(std::move(recycled.back()));
+			recycled.pop_back();
+
+			return alive.back();
+		}
+
+	public:
+		using value_type = T;
+		using iterator = typename storage_type::iterator;
+		using const_iterator = typename storage_type::const_iterator;
+
+		auto begin() { return alive.begin(); }
+		auto end() { return alive.end(); }
+		auto begin() const { return alive.begin(); }
+		auto end() const { return alive.end(); }
+
+		T& operator[](const std::size_t i) {
+			return alive[i];
+		}
+
+		const T& operator[](const std::size_t i) const {
+			return alive[i];
+		}
+
+		T& back() {
+			return alive.back();
+		}
+
+		const T& back() const {
+			return alive.back();
+		}
+
+		std::size_t size() const {
+			return alive.size();
+		}
+
+		std::size_t num_recycled() const {
+			return recycled.size();
+		}
+
+		bool empty() const {
+			return alive.empty();
+		}
+
+		void reserve(const std::size_t n) {
+			alive.reserve(n);
+			recycled.reserve(n);
+		}
+
+		T& push_back(const T& obj) {
+			auto& target = acquire();
+			target = obj;
+			return target;
+		}
+
+		iterator erase(const const_iterator first, const const_iterator last) {
+			const auto first_index = static_cast<std::size_t>(first - alive.cbegin());
+			const auto last_index = static_cast<std::size_t>(last - alive.cbegin());
+
+			ensure_leq(first_index, last_index);
+			ensure_leq(last_index, alive.size());
+
+			for (auto i = first_index; i < last_index; ++i) {
+				recycled.emplace_back(std::move(alive[i]));
+			}
+
+			/*
+				The moved-from objects hold no memory,
+				so shifting the rest into their place neither allocates nor frees.
+			*/
+
+			return alive.erase(alive.begin() + first_index, alive.begin() + last_index);
+		}
+
+		void clear() {
+			erase(alive.cbegin(), alive.cend());
+		}
+	};
+}
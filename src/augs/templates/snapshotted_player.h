@@ -29,9 +29,14 @@ namespace augs {
 		{}
 	};
 
+	/*
+		snapshots_type stores the snapshots and decides how,
+		e.g. augs::delta_snapshots for snapshots that are plain bytes.
+	*/
+
 	template <
 		class entropy_type,
-		class snapshot_type
+		class snapshots_type
 	>
 	class snapshotted_player {
 	public: 
@@ -47,7 +52,6 @@ namespace augs {
 		};
 
 		friend introspection_access;
-		using snapshots_type = std::map<step_type, snapshot_type>;
 
 		// GEN INTROSPECTOR class augs::snapshotted_player class A class B
 		step_to_entropy_type step_to_entropy;
@@ -63,7 +67,7 @@ namespace augs {
 		// END GEN INTROSPECTOR
 
 		template <class GenerateSnapshot>
-		void push_snapshot_if_needed(GenerateSnapshot&&, unsigned interval_in_steps);
+		void push_snapshot_if_needed(GenerateSnapshot&&, const snapshotted_player_settings&);
 
 		template <class I>
 		void advance_single_step(const I& input);
@@ -3,7 +3,8 @@
 namespace augs {
 	struct snapshotted_player_settings {
 		// GEN INTROSPECTOR struct augs::snapshotted_player_settings
-		unsigned snapshot_interval_in_steps = 800;
+		unsigned snapshot_interval_in_steps = 200;
+		unsigned keyframe_once_every_snapshots = 16;
 		// END GEN INTROSPECTOR
 	};
 }
@@ -5,6 +5,10 @@
 #include <atomic>
 #include <condition_variable>
 #include <functional>
+#include <string>
+
+#include "augs/misc/profiling.h"
+#include "augs/misc/process_usage.h"
 
 namespace augs {
 	class thread_pool {
@@ -12,6 +16,9 @@ namespace augs {
 		std::vector<std::function<void()>> tasks;
 		std::vector<std::function<void()>> cold_tasks;
 
+		/* Posted by fork_join. These do not count towards the completion of the submitted tasks. */
+		std::vector<std::function<void()>> forked_tasks;
+
 		int tasks_completed = 0;
 		int tasks_posted = 0;
 
@@ -23,6 +30,9 @@ namespace augs {
 
 		std::atomic<bool> shall_quit = false;
 
+		/* Worker i is bound to core i + 1, leaving core 0 for the thread that submits. */
+		bool pin_workers_to_cores = false;
+
 		auto lock_queue() {
 			return std::unique_lock<std::mutex>(queue_mutex);
 		}
@@ -42,25 +52,42 @@ namespace augs {
 			}
 		}
 
-		auto make_continuous_worker() {
-			return [this] {
+		auto make_continuous_worker(const std::size_t worker_index) {
+			return [this, worker_index] {
+				profiling::name_this_thread("Pool worker " + std::to_string(worker_index));
+
+				if (pin_workers_to_cores) {
+					pin_this_thread_to_core(static_cast<unsigned>(worker_index + 1));
+				}
+
 				for (;;) {
 					std::function<void()> task;
+					bool forked = false;
 
 					{
 						auto lock = lock_queue();
-						cv.wait(lock, [this]{ return shall_quit || !tasks.empty(); });
+						cv.wait(lock, [this]{ return shall_quit || !tasks.empty() || !forked_tasks.empty(); });
 
-						if (shall_quit.load() && tasks.empty()) {
-							return;
+						if (!forked_tasks.empty()) {
+							task = std::move(forked_tasks.back());
+							forked_tasks.pop_back();
+							forked = true;
 						}
+						else {
+							if (shall_quit.load() && tasks.empty()) {
+								return;
+							}
 
-						task = std::move(tasks.back());
-						tasks.pop_back();
+							task = std::move(tasks.back());
+							tasks.pop_back();
+						}
 					}
 
 					task();
-					register_completion();
+
+					if (!forked) {
+						register_completion();
+					}
 				}
 			};
 		}
@@ -83,7 +110,7 @@ namespace augs {
 		}
 
 	public:
-		thread_pool(const std::size_t num_workers) {
+		thread_pool(const std::size_t num_workers, const bool pin_workers_to_cores = false) : pin_workers_to_cores(pin_workers_to_cores) {
 			resize(num_workers);
 		}
 
@@ -96,7 +123,7 @@ namespace augs {
 			shall_quit.store(false);
 
 			for (std::size_t i = 0; i < num_workers; ++i) {
-				workers.emplace_back(make_continuous_worker());
+				workers.emplace_back(make_continuous_worker(i));
 			}
 		}
 
@@ -156,6 +183,74 @@ namespace augs {
 			auto lock = lock_completion();
 			completion_variable.wait(lock, [this]{ return tasks_posted == tasks_completed; });
 		}
+
+		/*
+			Calls job(i) for every i in [0, num_jobs) on the workers and the calling thread,
+			and returns once all of them are done.
+
+			Unlike enqueue, the jobs are posted immediately and independently of submit,
+			so this can be called both between the frames and from within a task.
+		*/
+
+		template <class F>
+		void fork_join(const std::size_t num_jobs, F&& job) {
+			if (num_jobs == 0) {
+				return;
+			}
+
+			if (num_jobs == 1 || workers.empty()) {
+				for (std::size_t i = 0; i < num_jobs; ++i) {
+					job(i);
+				}
+
+				return;
+			}
+
+			std::mutex done_mutex;
+			std::condition_variable done_variable;
+			std::size_t remaining = num_jobs - 1;
+
+			{
+				auto lock = lock_queue();
+
+				for (std::size_t i = 1; i < num_jobs; ++i) {
+					forked_tasks.emplace_back([&job, &done_mutex, &done_variable, &remaining, i]() {
+						job(i);
+
+						/* Notify under the lock, otherwise the caller could return and destroy the variable first. */
+						std::unique_lock<std::mutex> lk(done_mutex);
+
+						if (--remaining == 0) {
+							done_variable.notify_all();
+						}
+					});
+				}
+			}
+
+			cv.notify_all();
+
+			job(0);
+
+			for (;;) {
+				std::function<void()> task;
+
+				{
+					auto lock = lock_queue();
+
+					if (forked_tasks.empty()) {
+						break;
+					}
+
+					task = std::move(forked_tasks.back());
+					forked_tasks.pop_back();
+				}
+
+				task();
+			}
+
+			std::unique_lock<std::mutex> lk(done_mutex);
+			done_variable.wait(lk, [&remaining]{ return remaining == 0; });
+		}
 	};
 }
 
@@ -15,6 +15,7 @@
 #include "augs/texture_atlas/bake_fresh_atlas.h"
 
 #include "augs/readwrite/byte_file.h"
+#include "augs/filesystem/content_store.h"
 #include "augs/filesystem/directory.h"
 
 #define DEBUG_FILL_IMGS_WITH_COLOR 0
@@ -200,7 +201,12 @@ void bake_fresh_atlas(
 #endif
 
 	{
-		thread_local std::vector<std::vector<std::byte>> all_loaded_bytes;
+		/*
+			Official images are mapped by the official content store,
+			so only the images of projects take up memory here between bakes.
+		*/
+
+		thread_local std::vector<augs::content_bytes> all_loaded_bytes;
 
 		{
 			auto scope = measure_scope(out.profiler.loading_images);
@@ -216,7 +222,7 @@ void bake_fresh_atlas(
 
 				try {
 					all_loaded_bytes[current_rect].clear();
-					augs::file_to_bytes(input_img_id, all_loaded_bytes[current_rect]);
+					all_loaded_bytes[current_rect].load(input_img_id);
 				}
 				catch (...) {
 
@@ -311,10 +317,10 @@ void bake_fresh_atlas(
 
 			thread_local augs::image loaded_image;
 
-			const auto& source_bytes = 
+			const auto source_bytes = 
 				is_loaded_image ?
-				subjects.loaded_images[loaded_image_index] :
-				all_loaded_bytes[current_rect]
+				augs::const_byte_span(subjects.loaded_images[loaded_image_index]) :
+				all_loaded_bytes[current_rect].view
 			;
 
 			if (source_bytes.empty()) {
@@ -85,6 +85,36 @@ Options:
                                 --verify-updater Hypersomnia-for-Windows.exe --signature Hypersomnia-for-Windows.exe.sig
 
     --unit-tests-only           Perform unit tests only and quit.
+    --profile-trace [PATH]      Record every profiled scope of every thread and write them to PATH on exit
+                                as a Chrome trace, viewable in chrome://tracing or ui.perfetto.dev.
+    --benchmark-log [THREADS]   Log from THREADS threads at once, log how many lines per second went through, and quit.
+    --benchmark-lag-compensation [PLAYERS]
+                                Ray cast against the rewound hitboxes of PLAYERS characters (at most 64),
+                                log how long a single lag-compensated shot takes, and quit.
+    --benchmark-ray-casts [OBSTACLES]
+                                Cast a fan of rays through OBSTACLES walls one by one and then in a single batch,
+                                log how many rays per second each way goes through,
+                                how long it takes to build such a physics world anew and to clone it, and quit.
+    --measure-content-memory [PROCESSES]
+                                Load the whole official content in 1 and then in PROCESSES processes at once,
+                                first mapped and then copied to the heap, log the resident and the proportional memory
+                                of the processes for each case, and quit.
+    --measure-demo-bandwidth [PATH]
+                                Replay the server messages recorded in the demo at PATH, log how many bytes per tick
+                                the step entropies take on the wire compared to the previous encoding,
+                                project the egress of the server to all players with and without
+                                broadcast_only_effective_inputs, and quit.
+    --client-swarm [CLIENTS]    Connect CLIENTS synthetic clients to the server at the --connect ADDRESS (127.0.0.1 by default).
+                                Each joins, picks a faction and sends scripted inputs every tick.
+                                Log server step intervals, input acceptance latency, RTT and bandwidth, and quit.
+    --client-swarm-secs [SECS]  How long the swarm plays before quitting. 60 by default.
+    --client-swarm-tickrate [HZ]
+                                How many inputs per second each swarm client sends. Has to match the tickrate of the arena. 60 by default.
+    --client-swarm-demo [PATH]  Replay the inputs of the local player recorded in the demo at PATH instead of scripting them.
+    --benchmark-udp-sends [DESTINATIONS]
+                                Send a datagram to each of DESTINATIONS sockets on the loopback, round after round,
+                                first with a system call per datagram and then batched like the server sends them,
+                                log how many datagrams per second and per system call each way goes through, and quit.
     --connect [ADDRESS]         Connect to an arena server in accordance with default_client_start inside the config file.
                                 The ADDRESS argument is optional - if specified, it will override the connect_address field from the config file.
     --server                    Host an arena server in accordance with default_server_start inside the config file.
@@ -8,6 +8,8 @@ struct cmd_line_params {
 	augs::path_type debugger_target;
 	augs::path_type editor_target;
 	augs::path_type consistency_report;
+	augs::path_type measured_demo_bandwidth;
+	augs::path_type profile_trace_path;
 	bool unit_tests_only = false;
 	bool help_only = false;
 	bool version_only = false;
@@ -17,6 +19,15 @@ struct cmd_line_params {
 	bool should_connect = false;
 	bool keep_cwd = false;
 	int test_fp_consistency = -1;
+	int benchmark_log_threads = -1;
+	int benchmark_lag_compensation_players = -1;
+	int benchmark_ray_casts_obstacles = -1;
+	int measure_content_memory_processes = -1;
+	int client_swarm_size = -1;
+	int benchmark_udp_sends_destinations = -1;
+	int client_swarm_secs = 60;
+	int client_swarm_tickrate = 60;
+	augs::path_type client_swarm_demo;
 	std::string connect_address;
 
 	bool disallow_nat_traversal = false;
@@ -75,6 +86,45 @@ struct cmd_line_params {
 			else if (a == "--consistency-report") {
 				consistency_report = argv[i++];
 			}
+			else if (a == "--profile-trace") {
+				profile_trace_path = argv[i++];
+			}
+			else if (a == "--benchmark-log") {
+				benchmark_log_threads = std::atoi(argv[i++]);
+				keep_cwd = true;
+			}
+			else if (a == "--benchmark-lag-compensation") {
+				benchmark_lag_compensation_players = std::atoi(argv[i++]);
+				keep_cwd = true;
+			}
+			else if (a == "--benchmark-ray-casts") {
+				benchmark_ray_casts_obstacles = std::atoi(argv[i++]);
+				keep_cwd = true;
+			}
+			else if (a == "--measure-content-memory") {
+				measure_content_memory_processes = std::atoi(argv[i++]);
+			}
+			else if (a == "--measure-demo-bandwidth") {
+				measured_demo_bandwidth = argv[i++];
+				keep_cwd = true;
+			}
+			else if (a == "--client-swarm") {
+				client_swarm_size = std::atoi(argv[i++]);
+				keep_cwd = true;
+			}
+			else if (a == "--client-swarm-secs") {
+				client_swarm_secs = std::atoi(argv[i++]);
+			}
+			else if (a == "--client-swarm-tickrate") {
+				client_swarm_tickrate = std::atoi(argv[i++]);
+			}
+			else if (a == "--client-swarm-demo") {
+				client_swarm_demo = argv[i++];
+			}
+			else if (a == "--benchmark-udp-sends") {
+				benchmark_udp_sends_destinations = std::atoi(argv[i++]);
+				keep_cwd = true;
+			}
 			else if (a == "--verify-updater") {
 				is_updater = true;
 				verified_archive = argv[i++];
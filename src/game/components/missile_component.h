@@ -40,6 +40,10 @@ namespace components {
 		signi_entity_id particular_homing_target;
 		
 		transformr saved_point_of_impact_before_death;
+
+		/* Copied from the shooter. Steps by which the hitboxes are rewound for this missile, see hitbox_history. */
+		uint8_t lag_compensation_steps = 0;
+		pad_bytes<3> pad;
 		// END GEN INTROSPECTOR
 	};
 }
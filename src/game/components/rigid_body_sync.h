@@ -315,6 +315,9 @@ void component_synchronizer<E, components::rigid_body>::set_transform(const tran
 			{
 				f->Synchronize(broadPhase, body->m_xf, body->m_xf);
 			}
+
+			/* A moved static body changes the static tree, which queries expect to be up to date. */
+			body->m_world->UpdateStaticTree();
 		}
 	}	
 }
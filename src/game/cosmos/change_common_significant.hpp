@@ -20,5 +20,5 @@ void cosmos::change_common_significant(F&& callback) {
 		}
 	});
 
-	status = callback(common.significant);
+	status = callback(common.get_significant_for_change());
 }
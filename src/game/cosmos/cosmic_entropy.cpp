@@ -82,7 +82,7 @@ void basic_cosmic_entropy<key>::clear_dead_entities(const cosmos& cosm) {
 
 template <class K>
 basic_player_commands<K>& basic_player_commands<K>::operator+=(const basic_player_commands<K>& r) {
-	concatenate(intents, r.intents);
+	append_intents(r.intents);
 	
 	for (const auto it : r.motions) {
 		if (auto m = mapped_or_nullptr(motions, it.first)) {
@@ -164,7 +164,7 @@ cosmic_entropy::cosmic_entropy(
 ) {
 	auto& p = players[controlled_entity];
 	p.settings = settings;
-	p.commands.intents = intents;
+	p.commands.append_intents(intents);
 	p.commands.motions = motions;
 }
 
@@ -2,6 +2,9 @@
 #include <vector>
 #include <map>
 
+#include "augs/log.h"
+#include "augs/misc/sorted_vector_map.h"
+
 #include "augs/window_framework/event.h"
 
 #include "game/cosmos/entity_id.h"
@@ -18,10 +21,13 @@ class cosmos;
 
 template <class key>
 struct basic_player_commands {
+	/* Keep the binary format independent of whether the intents are stored inline. */
+	static constexpr bool force_read_field_by_field = true;
+
 	// GEN INTROSPECTOR struct basic_player_commands class key
 	spell_id cast_spell;
 	basic_wielding_setup<key> wield;
-	game_intents intents;
+	step_game_intents intents;
 	raw_game_motion_map motions;
 	basic_item_slot_transfer_request<key> transfer;
 	// END GEN INTROSPECTOR
@@ -33,6 +39,26 @@ struct basic_player_commands {
 	void clear_relevant(cosmic_entropy_recording_options);
 	void clear();
 
+	/* A step carries at most as many intents as the network protocol can, the rest are dropped. */
+
+	template <class C>
+	void append_intents(const C& new_intents) {
+		std::size_t num_dropped = 0;
+
+		for (const auto& i : new_intents) {
+			if (intents.size() == intents.capacity()) {
+				++num_dropped;
+				continue;
+			}
+
+			intents.push_back(i);
+		}
+
+		if (num_dropped > 0) {
+			LOG("Dropped %x intents that did not fit into a single step (at most %x).", num_dropped, intents.capacity());
+		}
+	}
+
 	std::size_t length() const;
 	bool empty() const;
 };
@@ -64,7 +90,7 @@ template <class key>
 struct basic_cosmic_entropy {
 	using player_entropy_type = basic_player_entropy<key>;
 	// GEN INTROSPECTOR struct basic_cosmic_entropy class key
-	std::map<key, player_entropy_type> players;
+	augs::sorted_vector_map<key, player_entropy_type> players;
 	// END GEN INTROSPECTOR
 
 	std::size_t length() const;
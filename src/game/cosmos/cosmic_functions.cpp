@@ -5,6 +5,8 @@
 #include "game/detail/entity_handle_mixins/for_each_slot_and_item.hpp"
 #include "game/detail/inventory/perform_transfer.h"
 #include "augs/templates/introspect.h"
+#include "augs/templates/enum_introspect.h"
+#include "augs/templates/algorithm_templates.h"
 #include "game/cosmos/change_common_significant.hpp"
 #include "game/cosmos/delete_entity.h"
 #include "game/detail/entity_handle_mixins/inventory_mixin.hpp"
@@ -15,7 +17,9 @@
 #include "game/inferred_caches/processing_lists_cache.hpp"
 #include "game/inferred_caches/flavour_id_cache.hpp"
 #include "game/inferred_caches/physics_world_cache.hpp"
+#include "game/inferred_caches/navigation_cache.hpp"
 #include "game/cosmos/just_create_entity_functional.h"
+#include "augs/build_settings/setting_debug_verify_incremental_reinference.h"
 
 void cosmic::set_flavour_id_cache_enabled(const bool flag, cosmos& cosm) {
 	cosm.get_solvable_inferred({}).flavour_ids.enabled = flag;
@@ -160,6 +164,195 @@ void cosmic::reinfer_solvable(cosmos& cosm) {
 	reinfer_all_entities(cosm);
 }
 
+void cosmic::mark_as_dirty(const entity_handle& handle) {
+	/*
+		The caches are destroyed right away, 
+		because destroy_cache_of finds the cached entries by the significant state 
+		(e.g. the current slot, the processing flags or the flavour id)
+		which is just about to be altered by the caller.
+	*/
+
+	auto& cosm = handle.get_cosmos();
+	auto& dirty = cosm.get_solvable({}).dirty_entities;
+
+	if (handle.dead() || found_in(dirty, handle.get_id())) {
+		return;
+	}
+
+	/* 
+		Destroying a body clears the colliders of everything attached to it, 
+		e.g. the items held by a character, so these have to be reinferred as well.
+	*/
+
+	if (const auto body_cache = find_rigid_body_cache(handle)) {
+		thread_local std::vector<entity_id> attached;
+		attached.clear();
+
+		for (const b2Fixture* f = body_cache->body->m_fixtureList; f != nullptr; f = f->m_next) {
+			if (const auto fixture_owner = cosm[f->GetUserData()]) {
+				if (fixture_owner.get_id() != handle.get_id() && !found_in(attached, fixture_owner.get_id())) {
+					attached.push_back(fixture_owner.get_id());
+				}
+			}
+		}
+
+		for (const auto& a : attached) {
+			mark_as_dirty(cosm[a]);
+		}
+	}
+
+	destroy_caches_of(handle);
+	dirty.push_back(handle.get_id());
+}
+
+#if DEBUG_VERIFY_INCREMENTAL_REINFERENCE
+static void verify_incremental_reinference(cosmos& incremental) {
+	cosmos full = incremental;
+	cosmic::reinfer_all_entities(full);
+
+	std::size_t mismatches = 0;
+
+	auto report = [&](const auto& what, const auto& id) {
+		LOG("Incremental reinference mismatch: %x of %x", what, id);
+		++mismatches;
+	};
+
+	auto sorted = [](auto v) {
+		sort_range(v);
+		return v;
+	};
+
+	auto compare = [&](const auto& id, const auto& a, const auto& b) {
+		using T = remove_cref<decltype(a)>;
+
+		if constexpr(std::is_same_v<T, rigid_body_cache>) {
+			if (a.is_constructed() != b.is_constructed()) {
+				report("rigid_body_cache existence", id);
+			}
+			else if (a.is_constructed()) {
+				const auto& ba = *a.body;
+				const auto& bb = *b.body;
+
+				if (ba.GetType() != bb.GetType() || !(ba.m_xf == bb.m_xf) || ba.GetLinearVelocity() != bb.GetLinearVelocity()) {
+					report("rigid_body_cache", id);
+				}
+			}
+		}
+		else if constexpr(std::is_same_v<T, colliders_cache>) {
+			if (a.connection != b.connection || a.constructed_fixtures.size() != b.constructed_fixtures.size()) {
+				report("colliders_cache", id);
+			}
+		}
+		else if constexpr(std::is_same_v<T, tree_of_npo_cache_data>) {
+			if (a.is_constructed() != b.is_constructed() || a.type != b.type || !(a.recorded_aabb == b.recorded_aabb)) {
+				report("tree_of_npo_cache_data", id);
+			}
+		}
+		else if constexpr(std::is_same_v<T, items_of_slots_cache>) {
+			for (std::size_t i = 0; i < a.tracked_children.size(); ++i) {
+				if (sorted(a.tracked_children[i]) != sorted(b.tracked_children[i])) {
+					report("items_of_slots_cache", id);
+				}
+			}
+		}
+		else {
+			static_assert(always_false_v<T>, "Unknown cache type.");
+		}
+	};
+
+	incremental.for_each_entity([&](const auto& typed_handle) {
+		using E = entity_type_of<decltype(typed_handle)>;
+
+		const auto counterpart = full[typed_handle.get_id()];
+
+		for_each_type_in_list<typename E::synchronized_arrays>(
+			[&](auto t) {
+				using T = decltype(t);
+
+				if constexpr(T::is_cache) {
+					compare(typed_handle.get_id(), get_corresponding<T>(typed_handle), get_corresponding<T>(counterpart));
+				}
+			}
+		);
+
+		if constexpr(E::template has<invariants::box_marker>()) {
+			const auto* ga = incremental.get_solvable_inferred().organisms.find_grid(typed_handle.get_id());
+			const auto* gb = full.get_solvable_inferred().organisms.find_grid(typed_handle.get_id());
+
+			if ((ga == nullptr) != (gb == nullptr)) {
+				report("organism grid existence", typed_handle.get_id());
+			}
+			else if (ga != nullptr) {
+				if (!(ga->aabb == gb->aabb) || ga->cells.size() != gb->cells.size()) {
+					report("organism grid", typed_handle.get_id());
+				}
+				else {
+					for (std::size_t i = 0; i < ga->cells.size(); ++i) {
+						if (sorted(ga->cells[i].organisms) != sorted(gb->cells[i].organisms)) {
+							report("organism cell", typed_handle.get_id());
+						}
+					}
+				}
+			}
+		}
+	});
+
+	augs::for_each_enum_except_bounds([&](const processing_subjects key) {
+		const auto& a = incremental.get_solvable_inferred().processing.get(key);
+		const auto& b = full.get_solvable_inferred().processing.get(key);
+
+		if (sorted(a) != sorted(b)) {
+			report("processing list", static_cast<int>(key));
+		}
+	});
+
+	if (incremental.get_solvable_inferred().physics.get_b2world().GetBodyCount() != full.get_solvable_inferred().physics.get_b2world().GetBodyCount()) {
+		report("body count", "b2World");
+	}
+
+	ensure_eq(std::size_t(0), mismatches);
+}
+#endif
+
+void cosmic::reinfer_dirty_entities(cosmos& cosm) {
+	auto& dirty = cosm.get_solvable({}).dirty_entities;
+
+	if (dirty.empty()) {
+		return;
+	}
+
+	{
+		auto scope = measure_scope(cosm.profiler.reinferring_dirty_entities);
+
+		/* 
+			Infer domain-wise, for the same reason as infer_all_entities does:
+			the dirty entities might depend on one another.
+		*/
+
+		auto constructor = [&](auto, auto& sys) {
+			using S = remove_cref<decltype(sys)>;
+
+			for (const auto& id : dirty) {
+				if (const auto handle = cosm[id]) {
+					handle.dispatch([&](const auto& typed_handle) {
+						if constexpr(S::template concerned_with<entity_type_of<decltype(typed_handle)>>::value) {
+							sys.specific_infer_cache_for(typed_handle);
+						}
+					});
+				}
+			}
+		};
+
+		augs::introspect(constructor, cosm.get_solvable_inferred({}));
+
+		dirty.clear();
+	}
+
+#if DEBUG_VERIFY_INCREMENTAL_REINFERENCE
+	verify_incremental_reinference(cosm);
+#endif
+}
+
 entity_handle just_clone_entity(const entity_handle source_entity) {
 	auto& cosm = source_entity.get_cosmos();
 
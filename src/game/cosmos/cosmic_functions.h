@@ -9,6 +9,10 @@
 class cosmic_delta;
 class cosmos;
 
+namespace augs {
+	class thread_pool;
+}
+
 /*
 	The purpose of this class is to centralize all functions 
 	that can arbitrarily alter the solvable state inside the cosmos,
@@ -89,12 +93,29 @@ public:
 	static void reinfer_all_entities(cosmos&);
 	static void infer_caches_for(const entity_handle& h);
 
+	/*
+		Use these instead of reinfer_all_entities when it is known which entities were altered.
+
+		Note that reinfer_all_entities is still required wherever the caches must end up identical 
+		on several machines, e.g. when a player joins - the state of caches like the physics world 
+		depends on their history, not just on the significant state.
+	*/
+
+	static void mark_as_dirty(const entity_handle& h);
+	static void reinfer_dirty_entities(cosmos&);
+
 	template <class C, class F>
 	static void change_solvable_significant(C& cosm, F&& callback);
 
 	template <template <class> class Predicate = always_true, class C, class F>
 	static void for_each_entity(C& self, F callback);
 
+	template <template <class> class Predicate = always_true, class C>
+	static std::size_t count_entities(C& self);
+
+	template <template <class> class Predicate = always_true, class C, class F>
+	static void for_each_entity_parallel(C& self, augs::thread_pool& pool, std::size_t grain, F callback);
+
 	static void after_solvable_copy(cosmos&, const cosmos&);
 	static void set_flavour_id_cache_enabled(bool flag, cosmos&);
 };
@@ -6,15 +6,19 @@ struct cosmic_profiler : public augs::profiler_mixin<cosmic_profiler> {
 
 	// GEN INTROSPECTOR struct cosmic_profiler
 	augs::time_measurements reinferring_all_entities = 1;
+	augs::time_measurements reinferring_dirty_entities = 1;
+	augs::time_measurements round_restart = 1;
 
 	augs::amount_measurements<std::size_t> visibility_raycasts = 1;
 	augs::amount_measurements<std::size_t> pathfinding_raycasts = 1;
+	augs::amount_measurements<std::size_t> path_queries = 1;
 	augs::amount_measurements<std::size_t> total_step_raycasts = 1;
 
 	augs::amount_measurements<std::size_t> entropy_length = 1;
 
 	augs::time_measurements logic;
 	augs::time_measurements missiles;
+	augs::time_measurements missile_sweeps;
 	augs::time_measurements explosives;
 	augs::time_measurements rendering;
 	augs::time_measurements camera_query;
@@ -26,6 +30,8 @@ struct cosmic_profiler : public augs::profiler_mixin<cosmic_profiler> {
 	augs::time_measurements particles;
 	augs::time_measurements ai;
 	augs::time_measurements pathfinding;
+	augs::time_measurements path_query_batches;
+	augs::time_measurements navigation_rasterization = 1;
 	augs::time_measurements movement_paths;
 	augs::time_measurements movement;
 	augs::time_measurements stateful_animations;
@@ -41,6 +47,9 @@ struct cosmic_profiler : public augs::profiler_mixin<cosmic_profiler> {
 
 	augs::time_measurements duplication = 1;
 
+	augs::time_measurements solvable_assignment = 1;
+	augs::amount_measurements<std::size_t> solvable_assignment_allocations = 1;
+
 	augs::time_measurements delta_encoding = 1;
 	augs::time_measurements delta_decoding = 1;
 	// END GEN INTROSPECTOR
@@ -1,5 +1,6 @@
 #include "augs/ensure_rel.h"
 #include "3rdparty/crc32/crc32.h"
+#include "3rdparty/Box2D/Common/b2Settings.h"
 
 #include "augs/readwrite/memory_stream.h"
 
@@ -158,7 +159,28 @@ void cosmos::set_fixed_delta(const augs::delta& dt) {
 }
 
 void cosmos::assign_solvable(const cosmos& b) {
+	auto scope = measure_scope(profiler.solvable_assignment);
+
+	/*
+		This is what every re-prediction does, so it must not allocate in the steady state.
+
+		All containers of the solvable are copy-assigned, which writes into the storage they already have
+		whenever it is large enough - this includes the inferred caches, see organism_cache::operator=.
+		The physics world is cloned into the blocks of the previous one, see physics_world_cache::clone_from.
+
+		Only the allocations of the physics world can be counted cheaply,
+		and only in builds with COUNT_PHYSICS_ALLOCATIONS, so that b2Alloc does not pay for it otherwise.
+	*/
+
+#if B2_COUNT_ALLOCATIONS
+	const auto physics_allocations_before = b2GetNumAllocations();
+#endif
+
 	solvable = b.solvable;
 
 	cosmic::after_solvable_copy(*this, b);
+
+#if B2_COUNT_ALLOCATIONS
+	profiler.solvable_assignment_allocations.measure(static_cast<std::size_t>(b2GetNumAllocations() - physics_allocations_before));
+#endif
 }
@@ -13,6 +13,10 @@
 
 #include "game/enums/processing_subjects.h"
 
+namespace augs {
+	class thread_pool;
+}
+
 using cosmos_id_type = int;
 
 class cosmos {
@@ -71,15 +75,29 @@ public:
 	std::string summary() const;
 
 	const cosmos_common_significant& get_common_significant() const {
-		return common.significant;
+		return common.get_significant();
 	}
 
 	cosmos_common_significant& get_common_significant(cosmos_common_significant_access) {
-		return common.significant;
+		return common.get_significant_for_change();
 	}
 
 	const cosmos_common_significant& get_common_significant(cosmos_common_significant_access) const {
-		return common.significant;
+		return common.get_significant();
+	}
+
+	/*
+		Drops this cosmos's own common significant state in favor of the one held by the other cosmos,
+		which must have been loaded from the same source.
+		Any later change, e.g. a map change, makes a private copy again.
+	*/
+
+	void share_common_significant_with(const cosmos& b) {
+		common.share_significant_with(b.common);
+	}
+
+	bool shares_common_significant_with(const cosmos& b) const {
+		return common.shares_significant_with(b.common);
 	}
 
 	const common_assets& get_common_assets() const {
@@ -164,6 +182,17 @@ public:
 	template <class... MustHaveComponents, class F>
 	void for_each_having(F&& callback) const;
 
+	/* See for_each_entity_parallel.h */
+
+	template <class... MustHaveComponents>
+	std::size_t count_having() const;
+
+	template <class... MustHaveComponents, class F>
+	void for_each_having_parallel(augs::thread_pool& pool, std::size_t grain, F&& callback);
+
+	template <class... MustHaveComponents, class F>
+	void for_each_having_parallel(augs::thread_pool& pool, std::size_t grain, F&& callback) const;
+
 	template <class... MustHaveInvariants, class F>
 	void for_each_flavour_having(F&& callback) const;
 
@@ -1,5 +1,51 @@
 #include "game/cosmos/cosmos_common.h"
 
+cosmos_common::cosmos_common() 
+	: significant(std::make_shared<cosmos_common_significant>())
+{
+}
+
+cosmos_common::cosmos_common(const cosmos_common& b) 
+	: significant(std::make_shared<cosmos_common_significant>(b.get_significant()))
+{
+}
+
+cosmos_common& cosmos_common::operator=(const cosmos_common& b) {
+	if (this == &b) {
+		return *this;
+	}
+
+	if (significant.use_count() > 1) {
+		significant = std::make_shared<cosmos_common_significant>(b.get_significant());
+	}
+	else {
+		get_significant_for_change() = b.get_significant();
+	}
+
+	return *this;
+}
+
+cosmos_common_significant& cosmos_common::get_significant_for_change() {
+	if (significant.use_count() > 1) {
+		significant = std::make_shared<cosmos_common_significant>(*significant);
+	}
+
+	/* 
+		Not shared with anyone at this point,
+		and the pointee was created as non-const, so this is well-defined.
+	*/
+
+	return const_cast<cosmos_common_significant&>(*significant);
+}
+
+void cosmos_common::share_significant_with(const cosmos_common& b) {
+	significant = b.significant;
+}
+
+bool cosmos_common::shares_significant_with(const cosmos_common& b) const {
+	return significant == b.significant;
+}
+
 void cosmos_common::reinfer() {
 	
 }
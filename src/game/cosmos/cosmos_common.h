@@ -1,8 +1,35 @@
 #pragma once
+#include <memory>
 #include "game/cosmos/cosmos_common_significant.h"
 
-struct cosmos_common {
-	cosmos_common_significant significant;
+/*
+	Cosmoi loaded from the same arena may hold a single instance of the common significant state,
+	see cosmos::share_common_significant_with.
+
+	Any mutable access first makes a private copy if the state is shared,
+	so a change in one cosmos is never seen by the others.
+
+	Copying a cosmos still copies the state itself,
+	so that references to it are never invalidated by a change in another cosmos.
+*/
+
+class cosmos_common {
+	/* Never null and always created as non-const, see get_significant_for_change. */
+	std::shared_ptr<const cosmos_common_significant> significant;
+
+public:
+	cosmos_common();
+	cosmos_common(const cosmos_common&);
+	cosmos_common& operator=(const cosmos_common&);
+
+	const cosmos_common_significant& get_significant() const {
+		return *significant;
+	}
+
+	cosmos_common_significant& get_significant_for_change();
+
+	void share_significant_with(const cosmos_common&);
+	bool shares_significant_with(const cosmos_common&) const;
 
 	void reinfer();
 };
@@ -67,6 +67,8 @@ void cosmos_solvable::destroy_all_caches() {
 	);
 
 	new (&inferred) cosmos_solvable_inferred;
+
+	dirty_entities.clear();
 }
 
 void cosmos_solvable::increment_step() {
@@ -48,6 +48,14 @@ public:
 	cosmos_solvable_significant significant;
 	cosmos_solvable_inferred inferred;
 
+	/*
+		Entities whose significant state was altered outside of the logic step,
+		e.g. by an editing command, and whose caches are yet to be reinferred.
+		See cosmic::mark_as_dirty and cosmic::reinfer_dirty_entities.
+	*/
+
+	std::vector<entity_id> dirty_entities;
+
 	cosmos_solvable() = default;
 	explicit cosmos_solvable(const cosmic_pool_size_type reserved_entities);
 
@@ -0,0 +1,110 @@
+#pragma once
+#include <vector>
+#include <functional>
+#include <algorithm>
+
+#include "augs/templates/thread_pool.h"
+#include "game/cosmos/for_each_entity.h"
+
+/*
+	Splits the pools of the matching entity types into chunks and processes them with thread_pool::fork_join.
+
+	The callback may only read the cosmos and write to the entity it is given,
+	or to slots reserved for that entity beforehand.
+	It is called either with just the handle, or with the handle and the index the entity would have
+	in the sequential for_each_entity, so results can be gathered into a presized vector
+	and applied in the same order every time.
+
+	A chunk holds at most "grain" entities of a single type.
+	With a non-zero grain, the partition depends only on the pools, never on the number of workers,
+	so even per-chunk reductions are deterministic.
+	A grain of 0 divides the entities evenly between the workers and the calling thread instead.
+*/
+
+template <template <class> class Predicate, class C>
+std::size_t cosmic::count_entities(C& self) {
+	std::size_t total = 0;
+
+	self.get_solvable({}).significant.for_each_entity_pool(
+		[&](auto& p) {
+			using pool_type = remove_cref<decltype(p)>;
+			using E = entity_type_of<typename pool_type::mapped_type>;
+
+			if constexpr(Predicate<E>::value) {
+				total += p.size();
+			}
+		}
+	);
+
+	return total;
+}
+
+template <template <class> class Predicate, class C, class F>
+void cosmic::for_each_entity_parallel(C& self, augs::thread_pool& pool, std::size_t grain, F callback) {
+	auto& significant = self.get_solvable({}).significant;
+
+	const auto total = count_entities<Predicate>(self);
+
+	if (total == 0) {
+		return;
+	}
+
+	if (grain == 0) {
+		const auto num_threads = pool.size() + 1;
+		grain = (total + num_threads - 1) / num_threads;
+	}
+
+	std::vector<std::function<void()>> chunks;
+	std::size_t offset = 0;
+
+	significant.for_each_entity_pool(
+		[&](auto& p) {
+			using P = decltype(p);
+			using pool_type = remove_cref<P>;
+			using E = entity_type_of<typename pool_type::mapped_type>;
+			using iterated_handle_type = basic_iterated_entity_handle<is_const_ref_v<P>, E>;
+
+			if constexpr(Predicate<E>::value) {
+				const std::size_t n = p.size();
+
+				for (std::size_t first = 0; first < n; first += grain) {
+					const auto last = std::min(n, first + grain);
+
+					chunks.emplace_back([&self, &p, &callback, first, last, offset]() {
+						for (std::size_t i = first; i < last; ++i) {
+							const auto handle = iterated_handle_type(self, { p.data()[i], static_cast<unsigned>(i) });
+
+							if constexpr(std::is_invocable_v<F&, const iterated_handle_type&, std::size_t>) {
+								callback(handle, offset + i);
+							}
+							else {
+								callback(handle);
+							}
+						}
+					});
+				}
+
+				offset += n;
+			}
+		}
+	);
+
+	pool.fork_join(chunks.size(), [&chunks](const std::size_t i) {
+		chunks[i]();
+	});
+}
+
+template <class... MustHaveComponents>
+std::size_t cosmos::count_having() const {
+	return cosmic::count_entities<has_all_of<MustHaveComponents...>::template type>(*this);
+}
+
+template <class... MustHaveComponents, class F>
+void cosmos::for_each_having_parallel(augs::thread_pool& pool, const std::size_t grain, F&& callback) {
+	cosmic::for_each_entity_parallel<has_all_of<MustHaveComponents...>::template type>(*this, pool, grain, std::forward<F>(callback));
+}
+
+template <class... MustHaveComponents, class F>
+void cosmos::for_each_having_parallel(augs::thread_pool& pool, const std::size_t grain, F&& callback) const {
+	cosmic::for_each_entity_parallel<has_all_of<MustHaveComponents...>::template type>(*this, pool, grain, std::forward<F>(callback));
+}
@@ -2,6 +2,10 @@
 #include "game/cosmos/entity_id.h"
 #include "game/detail/view_input/predictability_info.h"
 
+namespace augs {
+	class thread_pool;
+}
+
 struct solve_result {
 	bool state_inconsistent = false;
 };
@@ -10,4 +14,7 @@ struct solve_settings {
 	effect_prediction_settings effect_prediction;
 	entity_id disable_knockouts;
 	bool simulate_decorative_organisms = true;
+
+	/* If set, organisms are advanced on this pool. The outcome is the same either way. */
+	augs::thread_pool* organism_pool = nullptr;
 };
@@ -171,6 +171,8 @@ void standard_solve(const logic_step step) {
 		listener.during_step = false;
 	}
 
+	global.past_hitboxes.record(step);
+
 	physics_system().post_and_clear_accumulated_collision_messages(step);
 
 	trace_system().lengthen_sprites_of_traces(step);
@@ -0,0 +1,332 @@
+#include <cmath>
+#include <chrono>
+#include <vector>
+#include <optional>
+#include <algorithm>
+
+#include "augs/log.h"
+#include "augs/math/repro_math.h"
+#include "augs/math/arithmetical.h"
+#include "game/detail/lag_compensation/hitbox_history.h"
+#include "game/detail/lag_compensation/rewound_queries.h"
+#include "game/cosmos/cosmos.h"
+#include "game/cosmos/logic_step.h"
+#include "game/cosmos/for_each_entity.h"
+#include "game/components/sentience_component.h"
+
+/* A full turn spans the whole range of int16_t. */
+
+static int16_t quantize_rotation(const real32 radians) {
+	const auto full_turn = 2 * PI<real32>;
+
+	auto turns = repro::fmod(radians, full_turn) / full_turn;
+
+	if (turns >= 0.5f) {
+		turns -= 1.f;
+	}
+	else if (turns < -0.5f) {
+		turns += 1.f;
+	}
+
+	const auto quantized = static_cast<int32_t>(repro::round(turns * 65536.f));
+	return static_cast<int16_t>(std::clamp(quantized, -32768, 32767));
+}
+
+static real32 dequantize_rotation(const int16_t quantized) {
+	return static_cast<real32>(quantized) * (2 * PI<real32> / 65536.f);
+}
+
+void hitbox_history::record(const logic_step step) {
+	const auto& cosm = step.get_cosmos();
+
+	hitbox_history_step bodies;
+
+	cosm.for_each_having<components::sentience>([&](const auto& typed_handle) {
+		if (bodies.size() == max_compensated_bodies_v) {
+			return;
+		}
+
+		if (const auto cache = find_rigid_body_cache(typed_handle); cache && cache->is_constructed()) {
+			const auto& body = *cache->body.get();
+
+			bodies.ids.push_back(typed_handle.get_id());
+			bodies.positions.push_back(vec2(body.GetPosition()));
+			bodies.rotations.push_back(body.GetAngle());
+		}
+	});
+
+	write(cosm.get_timestamp().step, bodies);
+}
+
+void hitbox_history::write(const unsigned step, const hitbox_history_step& bodies) {
+	auto& recorded = records[step % records.size()];
+
+	/* Slots referred to by the other recorded steps keep their bodies. */
+	hitbox_slot_mask taken = 0;
+
+	for (const auto& r : records) {
+		if (&r != &recorded) {
+			taken |= r.present;
+		}
+	}
+
+	recorded = {};
+	recorded.step = step;
+
+	auto find_slot = [&](const signi_entity_id id) -> std::optional<std::size_t> {
+		for (std::size_t i = 0; i < max_compensated_bodies_v; ++i) {
+			if (((taken >> i) & 1) && slot_ids[i] == id) {
+				return i;
+			}
+		}
+
+		for (std::size_t i = 0; i < max_compensated_bodies_v; ++i) {
+			if (!((taken >> i) & 1)) {
+				slot_ids[i] = id;
+				return i;
+			}
+		}
+
+		return std::nullopt;
+	};
+
+	for (std::size_t i = 0; i < bodies.size(); ++i) {
+		if (const auto slot = find_slot(bodies.ids[i])) {
+			const auto bit = hitbox_slot_mask(1) << *slot;
+
+			taken |= bit;
+			recorded.present |= bit;
+
+			recorded.positions[*slot] = bodies.positions[i];
+			recorded.rotations[*slot] = quantize_rotation(bodies.rotations[i]);
+		}
+	}
+}
+
+const hitbox_history_step* hitbox_history::find(const unsigned step, hitbox_history_step& decoded) const {
+	const auto& candidate = records[step % records.size()];
+
+	if (candidate.step != step) {
+		return nullptr;
+	}
+
+	decoded.clear();
+
+	for (std::size_t i = 0; i < max_compensated_bodies_v; ++i) {
+		if ((candidate.present >> i) & 1) {
+			decoded.ids.push_back(slot_ids[i]);
+			decoded.positions.push_back(candidate.positions[i]);
+			decoded.rotations.push_back(dequantize_rotation(candidate.rotations[i]));
+		}
+	}
+
+	return &decoded;
+}
+
+void hitbox_history::clear() {
+	*this = {};
+}
+
+double benchmark_rewound_ray_casts(const unsigned num_bodies, const unsigned num_queries) {
+	/*
+		Bodies of roughly the size of a character, in a square arena,
+		each displaced as if it has run for a while since the rewound step.
+	*/
+
+	b2World world(b2Vec2(0.f, 0.f));
+
+	const auto n = std::min(static_cast<std::size_t>(num_bodies), max_compensated_bodies_v);
+	const auto side = static_cast<unsigned>(std::ceil(std::sqrt(static_cast<double>(n))));
+	const auto spacing = 3.f;
+
+	std::vector<b2Body*> bodies;
+	hitbox_history_step rewound;
+
+	for (std::size_t i = 0; i < n; ++i) {
+		const auto pos = vec2(static_cast<real32>(i % side), static_cast<real32>(i / side)) * spacing;
+		const auto angle = 0.3f * i;
+
+		b2BodyDef def;
+		def.type = b2_dynamicBody;
+		def.transform.Set(b2Vec2(pos), angle);
+		def.sweep = {};
+		def.sweep.c0 = def.sweep.c = def.transform.p;
+		def.sweep.a0 = def.sweep.a = angle;
+
+		auto* const body = world.CreateBody(&def);
+
+		b2PolygonShape torso;
+		torso.SetAsBox(0.4f, 0.25f);
+		body->CreateFixture(&torso, 1.f);
+
+		b2CircleShape head;
+		head.m_p.Set(0.3f, 0.f);
+		head.m_radius = 0.2f;
+		body->CreateFixture(&head, 1.f);
+
+		bodies.push_back(body);
+
+		rewound.ids.push_back(signi_entity_id());
+		rewound.positions.push_back(pos - vec2(0.4f, 0.2f));
+		rewound.rotations.push_back(angle - 0.5f);
+	}
+
+	const auto find_body = [&bodies](const std::size_t i) {
+		return bodies[i];
+	};
+
+	const auto extent = side * spacing;
+	const auto filter = b2Filter();
+
+	std::size_t hits = 0;
+
+	const auto started = std::chrono::steady_clock::now();
+
+	for (unsigned q = 0; q < num_queries; ++q) {
+		/* Shots across the whole arena, from the left edge to the right one at varying heights. */
+		const auto t = static_cast<real32>(q % 97) / 97.f;
+		const auto from = b2Vec2(-spacing, t * extent);
+		const auto to = b2Vec2(extent + spacing, (1.f - t) * extent);
+
+		ray_cast_rewound_bodies(rewound, find_body, from, to, filter, [&](auto&&...) { ++hits; });
+	}
+
+	const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+	/* So that the loop is not optimized away. */
+	LOG_NVPS(hits);
+
+	return num_queries > 0 ? elapsed / num_queries : 0.0;
+}
+
+#if BUILD_UNIT_TESTS
+#include <Catch/single_include/catch2/catch.hpp>
+
+TEST_CASE("LagCompensation RewoundRayCast") {
+	b2World world(b2Vec2(0.f, 0.f));
+
+	b2BodyDef def;
+	def.type = b2_dynamicBody;
+	def.transform.p.Set(10.f, 0.f);
+	def.sweep = {};
+	def.sweep.c0 = def.sweep.c = def.transform.p;
+
+	auto* const body = world.CreateBody(&def);
+
+	b2PolygonShape box;
+	box.SetAsBox(1.f, 1.f);
+	body->CreateFixture(&box, 1.f);
+
+	hitbox_history history;
+
+	{
+		hitbox_history_step bodies;
+		bodies.ids.push_back(signi_entity_id());
+		bodies.positions.push_back(vec2(0.f, 0.f));
+		bodies.rotations.push_back(0.f);
+
+		history.write(5, bodies);
+	}
+
+	hitbox_history_step decoded;
+
+	REQUIRE(history.find_rewound(7, 0, decoded) == nullptr);
+	REQUIRE(history.find_rewound(7, 3, decoded) == nullptr);
+	REQUIRE(history.find_rewound(7, max_lag_compensation_steps_v + 1, decoded) == nullptr);
+
+	const auto rewound = history.find_rewound(7, 2, decoded);
+	REQUIRE(rewound != nullptr);
+
+	const auto find_body = [body](std::size_t) { return body; };
+
+	std::vector<b2Vec2> points;
+
+	/* Passes where the body was two steps ago, misses where it is now. */
+	ray_cast_rewound_bodies(*rewound, find_body, b2Vec2(-5.f, 0.f), b2Vec2(5.f, 0.f), b2Filter(), [&](auto&, const b2Vec2 point, const b2Vec2 normal, const real32 fraction) {
+		points.push_back(point);
+
+		REQUIRE(normal.x == Approx(-1.f));
+		REQUIRE(fraction == Approx(0.4f));
+	});
+
+	REQUIRE(points.size() == 1);
+	REQUIRE(points[0].x == Approx(9.f));
+	REQUIRE(points[0].y == Approx(0.f));
+
+	points.clear();
+
+	ray_cast_rewound_bodies(*rewound, find_body, b2Vec2(-5.f, 5.f), b2Vec2(5.f, 5.f), b2Filter(), [&](auto&, const b2Vec2 point, auto&&...) {
+		points.push_back(point);
+	});
+
+	REQUIRE(points.empty());
+}
+
+TEST_CASE("LagCompensation CompactHistory") {
+	hitbox_history history;
+
+	auto id_of = [](const unsigned i) {
+		signi_entity_id id;
+		id.raw.indirection_index = i;
+		id.raw.version = 1;
+		return id;
+	};
+
+	/* A body that leaves, others that come, and one that stays throughout. */
+
+	auto bodies_at = [&](const unsigned step) {
+		hitbox_history_step bodies;
+
+		auto add = [&](const unsigned i) {
+			bodies.ids.push_back(id_of(i));
+			bodies.positions.push_back(vec2(static_cast<real32>(step), static_cast<real32>(i)));
+			bodies.rotations.push_back(0.01f * step - 3.f * i);
+		};
+
+		add(0);
+
+		if (step < 10) {
+			add(1);
+		}
+
+		for (unsigned i = 2; i < 2 + step % 5; ++i) {
+			add(i + step);
+		}
+
+		return bodies;
+	};
+
+	const unsigned num_steps = 3 * (max_lag_compensation_steps_v + 1);
+
+	for (unsigned step = 0; step < num_steps; ++step) {
+		history.write(step, bodies_at(step));
+	}
+
+	hitbox_history_step decoded;
+
+	REQUIRE(history.find(num_steps - 1 - (max_lag_compensation_steps_v + 1), decoded) == nullptr);
+
+	for (unsigned step = num_steps - (max_lag_compensation_steps_v + 1); step < num_steps; ++step) {
+		const auto expected = bodies_at(step);
+
+		REQUIRE(history.find(step, decoded) == &decoded);
+		REQUIRE(decoded.size() == expected.size());
+
+		for (std::size_t i = 0; i < expected.size(); ++i) {
+			const auto slot = std::find(decoded.ids.begin(), decoded.ids.end(), expected.ids[i]);
+			REQUIRE(slot != decoded.ids.end());
+
+			const auto j = static_cast<std::size_t>(slot - decoded.ids.begin());
+
+			REQUIRE(decoded.positions[j] == expected.positions[i]);
+
+			/* Compared as directions, the quantized rotation wraps around. */
+			const auto a = decoded.rotations[j];
+			const auto b = expected.rotations[i];
+
+			REQUIRE(std::abs(std::cos(a) - std::cos(b)) < 1e-3f);
+			REQUIRE(std::abs(std::sin(a) - std::sin(b)) < 1e-3f);
+		}
+	}
+}
+#endif
@@ -0,0 +1,100 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include "augs/misc/constant_size_vector.h"
+#include "augs/math/vec2.h"
+#include "game/cosmos/entity_id.h"
+#include "game/cosmos/step_declaration.h"
+
+/*
+	Lag compensation.
+
+	A player with a high ping aims at where the others were some steps ago.
+	The server measures that delay per client and hands it out as per_character_input_settings::lag_compensation_steps,
+	which travels with the step entropies like any other setting, so every machine sees the same value at the same step.
+
+	After each physics step, the body transforms of sentient entities are appended to a short ring buffer.
+	Missiles and melee attacks of a compensated character are then tested against the bodies
+	as they were that many steps ago, and the points of impact are mapped back onto the bodies as they are now.
+
+	The history is significant state.
+	Every machine records it identically and a client that joins mid-game receives it with the rest of the solvable,
+	so a rewound hit can never cause a desync.
+
+	Since it is copied along with every solvable, it is kept compact.
+	The ids of the bodies are stored once, in slots shared by all recorded steps,
+	and each step keeps only a mask of the slots present in it, their positions and their rotations quantized to 16 bits.
+	A slot is given to another body only once no recorded step refers to it anymore.
+
+	find_rewound decodes a step into a hitbox_history_step, a structure of arrays
+	whose ids are only touched when a candidate is found.
+*/
+
+constexpr unsigned max_lag_compensation_steps_v = 32;
+constexpr std::size_t max_compensated_bodies_v = 64;
+
+using hitbox_slot_mask = uint64_t;
+static_assert(max_compensated_bodies_v <= sizeof(hitbox_slot_mask) * 8);
+
+struct hitbox_history_step {
+	augs::constant_size_vector<signi_entity_id, max_compensated_bodies_v> ids;
+	augs::constant_size_vector<vec2, max_compensated_bodies_v> positions;
+	augs::constant_size_vector<real32, max_compensated_bodies_v> rotations;
+
+	std::size_t size() const {
+		return ids.size();
+	}
+
+	bool has(const unversioned_entity_id id) const {
+		for (const auto& candidate : ids) {
+			if (candidate.to_unversioned() == id) {
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void clear() {
+		ids.clear();
+		positions.clear();
+		rotations.clear();
+	}
+};
+
+struct hitbox_history_record {
+	// GEN INTROSPECTOR struct hitbox_history_record
+	unsigned step = static_cast<unsigned>(-1);
+	hitbox_slot_mask present = 0;
+	std::array<vec2, max_compensated_bodies_v> positions = {};
+	std::array<int16_t, max_compensated_bodies_v> rotations = {};
+	// END GEN INTROSPECTOR
+};
+
+struct hitbox_history {
+	// GEN INTROSPECTOR struct hitbox_history
+	std::array<signi_entity_id, max_compensated_bodies_v> slot_ids = {};
+	std::array<hitbox_history_record, max_lag_compensation_steps_v + 1> records = {};
+	// END GEN INTROSPECTOR
+
+	/* Positions in meters, rotations in radians, exactly as Box2D keeps them. */
+	void record(logic_step);
+
+	/* Bodies beyond what the free slots can take are left out. */
+	void write(unsigned step, const hitbox_history_step& bodies);
+
+	/* Returns &decoded, or nullptr if the step is not recorded. */
+	const hitbox_history_step* find(unsigned step, hitbox_history_step& decoded) const;
+
+	const hitbox_history_step* find_rewound(const unsigned now, const unsigned rewound_steps, hitbox_history_step& decoded) const {
+		if (rewound_steps == 0 || rewound_steps > max_lag_compensation_steps_v || rewound_steps > now) {
+			return nullptr;
+		}
+
+		return find(now - rewound_steps, decoded);
+	}
+
+	void clear();
+};
+
+double benchmark_rewound_ray_casts(unsigned num_bodies, unsigned num_queries);
@@ -0,0 +1,180 @@
+#pragma once
+#include "3rdparty/Box2D/Box2D.h"
+#include "augs/enums/callback_result.h"
+#include "augs/math/si_scaling.h"
+#include "game/inferred_caches/find_physics_cache.h"
+#include "game/detail/lag_compensation/hitbox_history.h"
+
+/*
+	The queries test the present fixtures of a body placed at the transform it had in the rewound step.
+	Only the transforms are historic: the shapes and filters are those of now.
+*/
+
+inline b2Transform to_b2_transform(const vec2 pos, const real32 rotation) {
+	b2Transform result;
+	result.Set(b2Vec2(pos), rotation);
+	return result;
+}
+
+struct rewound_to_present {
+	b2Transform then;
+	b2Transform now;
+
+	/* Where a point found against the body as it was lies on the body as it is now. */
+
+	b2Vec2 point(const b2Vec2 p) const {
+		return b2Mul(now, b2MulT(then, p));
+	}
+
+	b2Vec2 normal(const b2Vec2 n) const {
+		return b2Mul(now.q, b2MulT(then.q, n));
+	}
+};
+
+template <class C>
+auto make_rewound_body_getter(C& cosm, const hitbox_history_step& rewound) {
+	return [&cosm, &rewound](const std::size_t i) -> b2Body* {
+		if (const auto handle = cosm[rewound.ids[i]]) {
+			if (const auto cache = find_rigid_body_cache(handle); cache && cache->is_constructed()) {
+				return cache->body.get();
+			}
+		}
+
+		return nullptr;
+	};
+}
+
+/*
+	Calls callback(fixture, point, normal, fraction) for every fixture of the rewound bodies crossed by the ray from -> to.
+	The point and the normal are already mapped onto the body as it is now.
+	Sensors are skipped just like in missile_sweep_callback.
+*/
+
+template <class BodyGetter, class F>
+void ray_cast_rewound_bodies(
+	const hitbox_history_step& rewound,
+	BodyGetter find_body,
+	const b2Vec2 from,
+	const b2Vec2 to,
+	const b2Filter& filter,
+	F callback
+) {
+	b2RayCastInput input;
+	input.p1 = from;
+	input.p2 = to;
+	input.maxFraction = 1.f;
+
+	for (std::size_t i = 0; i < rewound.size(); ++i) {
+		b2Body* const body = find_body(i);
+
+		if (body == nullptr) {
+			continue;
+		}
+
+		const auto mapping = rewound_to_present { to_b2_transform(rewound.positions[i], rewound.rotations[i]), body->GetTransform() };
+
+		for (b2Fixture* f = body->GetFixtureList(); f != nullptr; f = f->GetNext()) {
+			if (f->IsSensor() || !b2ContactFilter::ShouldCollide(&filter, &f->GetFilterData())) {
+				continue;
+			}
+
+			const auto shape = f->GetShape();
+
+			for (int32 child = 0; child < shape->GetChildCount(); ++child) {
+				b2RayCastOutput output;
+
+				if (shape->RayCast(&output, input, mapping.then, child)) {
+					const auto point = from + output.fraction * (to - from);
+					callback(*f, mapping.point(point), mapping.normal(output.normal), output.fraction);
+				}
+			}
+		}
+	}
+}
+
+/* Calls callback(fixture) for every fixture of the rewound bodies that contained the point. */
+
+template <class BodyGetter, class F>
+void for_each_rewound_fixture_containing(
+	const hitbox_history_step& rewound,
+	BodyGetter find_body,
+	const b2Vec2 point,
+	const b2Filter& filter,
+	F callback
+) {
+	for (std::size_t i = 0; i < rewound.size(); ++i) {
+		b2Body* const body = find_body(i);
+
+		if (body == nullptr) {
+			continue;
+		}
+
+		const auto then = to_b2_transform(rewound.positions[i], rewound.rotations[i]);
+
+		for (b2Fixture* f = body->GetFixtureList(); f != nullptr; f = f->GetNext()) {
+			if (f->IsSensor() || !b2ContactFilter::ShouldCollide(&filter, &f->GetFilterData())) {
+				continue;
+			}
+
+			if (f->GetShape()->TestPoint(then, point)) {
+				callback(*f);
+			}
+		}
+	}
+}
+
+/*
+	The rewound counterpart of for_each_intersection_with_shape_meters.
+	Points of impact are in pixels, mapped onto the bodies as they are now.
+*/
+
+template <class BodyGetter, class S, class F>
+void for_each_rewound_intersection_with_shape_meters(
+	const hitbox_history_step& rewound,
+	BodyGetter find_body,
+	const si_scaling si,
+	const S& shape,
+	const b2Transform queried_shape_transform,
+	const b2Filter filter,
+	F callback
+) {
+	for (std::size_t i = 0; i < rewound.size(); ++i) {
+		b2Body* const body = find_body(i);
+
+		if (body == nullptr) {
+			continue;
+		}
+
+		const auto mapping = rewound_to_present { to_b2_transform(rewound.positions[i], rewound.rotations[i]), body->GetTransform() };
+
+		for (b2Fixture* f = body->GetFixtureList(); f != nullptr; f = f->GetNext()) {
+			if (!b2ContactFilter::ShouldCollide(&filter, &f->GetFilterData())) {
+				continue;
+			}
+
+			constexpr auto index_a = 0;
+			constexpr auto index_b = 0;
+
+			const auto result = b2TestOverlapInfo(
+				&shape,
+				index_a,
+				f->GetShape(),
+				index_b,
+				queried_shape_transform,
+				mapping.then
+			);
+
+			if (result.overlap) {
+				const auto r = callback(
+					*f,
+					si.get_pixels(mapping.point(result.pointA)),
+					si.get_pixels(mapping.point(result.pointB))
+				);
+
+				if (r == callback_result::ABORT) {
+					return;
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,13 @@
+#pragma once
+#include "game/components/missile_component.h"
+
+/*
+	Missiles construct no fixtures.
+	Their b2Body only integrates velocity and forces (e.g. homing),
+	and missile_system::sweep_missiles_through_world finds what they hit with ray casts.
+
+	Thrown explosives and melee weapons are not missiles in this sense, they still collide physically.
+*/
+
+template <class E>
+constexpr bool is_swept_missile_v = E::template has<invariants::missile>();
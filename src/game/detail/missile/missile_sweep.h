@@ -0,0 +1,291 @@
+#pragma once
+#include <vector>
+#include "3rdparty/Box2D/Box2D.h"
+#include "game/cosmos/entity_id.h"
+#include "game/messages/collision_message.h"
+#include "game/detail/lag_compensation/hitbox_history.h"
+#include "game/detail/lag_compensation/rewound_queries.h"
+
+struct missile_sweep_hit {
+	b2Fixture* fixture = nullptr;
+
+	/* Resolved from the fixture's userdata before sorting, the tree reports only unversioned ids. */
+	entity_id surface;
+	short index_in_component = 0;
+
+	b2Vec2 point;
+	b2Vec2 normal;
+	float32 fraction = 0.f;
+
+	bool operator<(const missile_sweep_hit& b) const {
+		/* Never depend on the order in which the tree reports fixtures. */
+
+		if (fraction != b.fraction) {
+			return fraction < b.fraction;
+		}
+
+		if (!(surface == b.surface)) {
+			return surface < b.surface;
+		}
+
+		return index_in_component < b.index_in_component;
+	}
+};
+
+/*
+	Bodies of a lag-compensated missile's rewound step are skipped by the world queries,
+	they are tested where they were instead (see rewound_queries.h).
+*/
+
+inline bool is_rewound_fixture(const hitbox_history_step* const rewound, const b2Fixture& fixture) {
+	return rewound != nullptr && rewound->has(fixture.GetBody()->GetUserData());
+}
+
+/*
+	Collects every fixture along the whole path of a missile.
+	Whether a hit stops the missile depends on game logic (fly-through surfaces, sentience),
+	so the ray cannot be clipped here.
+*/
+
+struct missile_sweep_callback : public b2RayCastCallback {
+	const b2Filter& missile_filter;
+	std::vector<missile_sweep_hit>& hits;
+	const hitbox_history_step* const rewound;
+
+	missile_sweep_callback(
+		const b2Filter& missile_filter,
+		std::vector<missile_sweep_hit>& hits,
+		const hitbox_history_step* const rewound = nullptr
+	) :
+		missile_filter(missile_filter),
+		hits(hits),
+		rewound(rewound)
+	{}
+
+	bool ShouldRaycast(b2Fixture* const fixture) override {
+		/* Every consumer of collision messages skipped the sensor contacts of missiles anyway. */
+		return 
+			!fixture->IsSensor() 
+			&& b2ContactFilter::ShouldCollide(&missile_filter, &fixture->GetFilterData())
+			&& !is_rewound_fixture(rewound, *fixture)
+		;
+	}
+
+	float32 ReportFixture(
+		b2Fixture* const fixture,
+		const b2Vec2& point,
+		const b2Vec2& normal,
+		const float32 fraction
+	) override {
+		missile_sweep_hit hit;
+
+		hit.fixture = fixture;
+		hit.index_in_component = fixture->index_in_component;
+		hit.point = point;
+		hit.normal = normal;
+		hit.fraction = fraction;
+
+		hits.push_back(hit);
+		return 1.f;
+	}
+};
+
+/*
+	A ray that starts inside a fixture does not report it,
+	so a missile spawned with the barrel already in a wall needs a separate point test.
+	That is what Box2D's contact with the overlapping fixture used to catch.
+*/
+
+struct missile_spawn_overlap_callback : public b2QueryCallback {
+	const b2Filter& missile_filter;
+	const b2Vec2 spawn_point;
+	const b2Vec2 normal;
+	std::vector<missile_sweep_hit>& hits;
+	const hitbox_history_step* const rewound;
+
+	missile_spawn_overlap_callback(
+		const b2Filter& missile_filter,
+		const b2Vec2 spawn_point,
+		const b2Vec2 normal,
+		std::vector<missile_sweep_hit>& hits,
+		const hitbox_history_step* const rewound = nullptr
+	) :
+		missile_filter(missile_filter),
+		spawn_point(spawn_point),
+		normal(normal),
+		hits(hits),
+		rewound(rewound)
+	{}
+
+	bool ReportFixture(b2Fixture* const fixture) override {
+		if (fixture->IsSensor() || !b2ContactFilter::ShouldCollide(&missile_filter, &fixture->GetFilterData())) {
+			return true;
+		}
+
+		if (is_rewound_fixture(rewound, *fixture)) {
+			return true;
+		}
+
+		if (fixture->TestPoint(spawn_point)) {
+			missile_sweep_hit hit;
+
+			hit.fixture = fixture;
+			hit.index_in_component = fixture->index_in_component;
+			hit.point = spawn_point;
+			hit.normal = normal;
+			hit.fraction = 0.f;
+
+			hits.push_back(hit);
+		}
+
+		return true;
+	}
+};
+
+/*
+	Everything a missile passes through on its way from -> to in this step,
+	including the bodies of a lag-compensated missile where they were in the rewound step.
+	Left unsorted, as the order depends on the entity ids of the surfaces.
+*/
+
+template <class BodyGetter>
+void gather_missile_sweep_hits(
+	const b2World& world,
+	const b2Vec2 from,
+	const b2Vec2 to,
+	const b2Vec2 velocity,
+	const bool born_this_step,
+	const b2Filter& missile_filter,
+	const hitbox_history_step* const rewound,
+	BodyGetter find_rewound_body,
+	std::vector<missile_sweep_hit>& hits
+) {
+	auto push_hit = [&](b2Fixture& fixture, const b2Vec2 point, const b2Vec2 normal, const float32 fraction) {
+		missile_sweep_hit hit;
+
+		hit.fixture = std::addressof(fixture);
+		hit.index_in_component = fixture.index_in_component;
+		hit.point = point;
+		hit.normal = normal;
+		hit.fraction = fraction;
+
+		hits.push_back(hit);
+	};
+
+	if (born_this_step) {
+		auto against_flight = -velocity;
+
+		if (against_flight.Normalize() > 0.f) {
+			missile_spawn_overlap_callback callback(missile_filter, from, against_flight, hits, rewound);
+
+			b2AABB aabb;
+			aabb.lowerBound = from;
+			aabb.upperBound = from;
+
+			world.QueryAABB(&callback, aabb);
+
+			if (rewound) {
+				for_each_rewound_fixture_containing(*rewound, find_rewound_body, from, missile_filter, [&](b2Fixture& fixture) {
+					push_hit(fixture, from, against_flight, 0.f);
+				});
+			}
+		}
+	}
+
+	if ((to - from).LengthSquared() > 0.f) {
+		missile_sweep_callback callback(missile_filter, hits, rewound);
+		world.RayCast(&callback, from, to);
+
+		if (rewound) {
+			ray_cast_rewound_bodies(*rewound, find_rewound_body, from, to, missile_filter, push_hit);
+		}
+	}
+}
+
+/*
+	How the game treats a surface the missile has hit.
+	Mirrors which contacts contact_listener used to disable for missiles.
+*/
+
+enum class missile_sweep_contact {
+	/* Sentience and surfaces the missile flies through: BEGIN_CONTACT only. */
+	BEGIN_ONLY,
+	/* Standard collision resolution disabled on either side: BEGIN_CONTACT and PRE_SOLVE, but no bounce. */
+	NOT_RESOLVED,
+	/* Stops the missile: BEGIN_CONTACT, PRE_SOLVE, a bounce and POST_SOLVE. */
+	SOLID
+};
+
+/*
+	Walks the sorted hits and calls post(type, hit, normal_impulse) in the order contact_listener would have,
+	with type being BEGIN_CONTACT, PRE_SOLVE or POST_SOLVE.
+
+	The missile stops at the first solid surface.
+	It is bounced off with the impulse the contact solver would have applied for this pair of fixtures,
+	and a dynamic surface is pushed back with the opposite one.
+*/
+
+template <class C, class P>
+void resolve_missile_sweep_hits(
+	b2Body& missile_body,
+	const float32 missile_restitution,
+	const std::vector<missile_sweep_hit>& hits,
+	C classify,
+	P post
+) {
+	using event_type = messages::collision_message::event_type;
+
+	for (const auto& hit : hits) {
+		post(event_type::BEGIN_CONTACT, hit, 0.f);
+
+		const auto contact = classify(hit);
+
+		if (contact == missile_sweep_contact::BEGIN_ONLY) {
+			continue;
+		}
+
+		post(event_type::PRE_SOLVE, hit, 0.f);
+
+		if (contact == missile_sweep_contact::NOT_RESOLVED) {
+			continue;
+		}
+
+		auto& surface_body = *hit.fixture->GetBody();
+		const bool surface_dynamic = surface_body.GetType() == b2_dynamicBody;
+
+		const auto velocity = missile_body.GetLinearVelocity();
+		const auto normal_speed = b2Dot(velocity - surface_body.GetLinearVelocityFromWorldPoint(hit.point), hit.normal);
+
+		float32 normal_impulse = 0.f;
+
+		if (normal_speed < 0.f) {
+			/* The effective mass of the contact, so that a dynamic surface gives way just like in the contact solver. */
+
+			auto inv_mass = missile_body.m_invMass;
+
+			if (surface_dynamic) {
+				const auto rn = b2Cross(hit.point - surface_body.GetWorldCenter(), hit.normal);
+				inv_mass += surface_body.m_invMass + surface_body.m_invI * rn * rn;
+			}
+
+			const auto restitution = 
+				-normal_speed > b2_velocityThreshold 
+				? b2MixRestitution(missile_restitution, hit.fixture->GetRestitution()) 
+				: 0.f
+			;
+
+			normal_impulse = -(1.f + restitution) * normal_speed / inv_mass;
+
+			missile_body.SetLinearVelocity(velocity + (normal_impulse * missile_body.m_invMass) * hit.normal);
+
+			if (surface_dynamic) {
+				surface_body.ApplyLinearImpulse(-normal_impulse * hit.normal, hit.point, true);
+			}
+		}
+
+		missile_body.SetTransform(hit.point + b2_linearSlop * hit.normal, missile_body.GetAngle());
+
+		post(event_type::POST_SOLVE, hit, normal_impulse);
+		break;
+	}
+}
@@ -0,0 +1,638 @@
+#if BUILD_UNIT_TESTS
+#include <Catch/single_include/catch2/catch.hpp>
+#include <vector>
+#include <memory>
+#include <algorithm>
+
+#include "3rdparty/Box2D/Box2D.h"
+#include "game/detail/missile/missile_sweep.h"
+#include "game/detail/missile/headshot_detection.hpp"
+
+/*
+	Missiles used to collide through their own fixtures, with contact_listener disabling the contacts
+	that the game does not want resolved. These tests fly the same missile through two identical worlds:
+	one where it still has its fixture and a listener that mirrors contact_listener,
+	and one where it is fixtureless and swept after the step like in missile_system::sweep_missiles_through_world.
+
+	Damage and ricochets are decided by missile_system from these events alone:
+	damage is dealt once per BEGIN_CONTACT with its point and the missile's velocity (which also place headshots),
+	and a solid surface bounces the missile off.
+	So it suffices to compare the events, their points and the velocities after the hit.
+*/
+
+namespace {
+	using event_type = messages::collision_message::event_type;
+
+	constexpr float32 test_dt = 1.f / 60;
+	constexpr float32 missile_radius = 0.02f;
+	constexpr float32 missile_density = 1000.f;
+
+	struct sweep_event {
+		event_type type = event_type::BEGIN_CONTACT;
+		const b2Fixture* surface = nullptr;
+		b2Vec2 point;
+		b2Vec2 missile_velocity;
+		float32 normal_impulse = 0.f;
+	};
+
+	/* What the game would decide from the entities, here given per fixture. */
+
+	struct surface_kinds {
+		std::vector<const b2Fixture*> begin_only;
+		std::vector<const b2Fixture*> not_resolved;
+
+		missile_sweep_contact classify(const b2Fixture* const f) const {
+			if (std::find(begin_only.begin(), begin_only.end(), f) != begin_only.end()) {
+				return missile_sweep_contact::BEGIN_ONLY;
+			}
+
+			if (std::find(not_resolved.begin(), not_resolved.end(), f) != not_resolved.end()) {
+				return missile_sweep_contact::NOT_RESOLVED;
+			}
+
+			return missile_sweep_contact::SOLID;
+		}
+	};
+
+	struct old_contact_listener : public b2ContactListener {
+		const b2Fixture* missile = nullptr;
+		const surface_kinds& kinds;
+		std::vector<sweep_event>& events;
+
+		old_contact_listener(const surface_kinds& kinds, std::vector<sweep_event>& events) : kinds(kinds), events(events) {}
+
+		const b2Fixture* surface_of(const b2Contact* const contact) const {
+			return contact->GetFixtureA() == missile ? contact->GetFixtureB() : contact->GetFixtureA();
+		}
+
+		bool concerns(const b2Contact* const contact) const {
+			return contact->GetFixtureA() == missile || contact->GetFixtureB() == missile;
+		}
+
+		void push(const event_type type, b2Contact* const contact, const float32 normal_impulse = 0.f) {
+			b2WorldManifold manifold;
+			contact->GetWorldManifold(&manifold);
+
+			sweep_event e;
+
+			e.type = type;
+			e.surface = surface_of(contact);
+			e.point = manifold.points[0];
+			e.missile_velocity = missile->GetBody()->GetLinearVelocity();
+			e.normal_impulse = normal_impulse;
+
+			events.push_back(e);
+		}
+
+		void BeginContact(b2Contact* const contact) override {
+			if (concerns(contact)) {
+				push(event_type::BEGIN_CONTACT, contact);
+			}
+		}
+
+		void PreSolve(b2Contact* const contact, const b2Manifold*) override {
+			if (!concerns(contact)) {
+				return;
+			}
+
+			const auto kind = kinds.classify(surface_of(contact));
+
+			if (kind == missile_sweep_contact::BEGIN_ONLY) {
+				contact->SetEnabled(false);
+				return;
+			}
+
+			if (kind == missile_sweep_contact::NOT_RESOLVED) {
+				contact->SetEnabled(false);
+			}
+
+			push(event_type::PRE_SOLVE, contact);
+		}
+
+		void PostSolve(b2Contact* const contact, const b2ContactImpulse* const impulse) override {
+			if (concerns(contact)) {
+				push(event_type::POST_SOLVE, contact, *std::max_element(impulse->normalImpulses, impulse->normalImpulses + impulse->count));
+			}
+		}
+	};
+
+	/*
+		The old path keeps solving a resting contact for a few steps and reports it each time.
+		Only the first report of every event with every surface ever reached the game logic that matters here.
+	*/
+
+	std::vector<sweep_event> first_of_each(const std::vector<sweep_event>& events) {
+		std::vector<sweep_event> result;
+
+		for (const auto& e : events) {
+			const auto same = [&](const sweep_event& r) { return r.type == e.type && r.surface == e.surface; };
+
+			if (std::find_if(result.begin(), result.end(), same) == result.end()) {
+				result.push_back(e);
+			}
+		}
+
+		return result;
+	}
+
+	unversioned_entity_id test_id(const unsigned i) {
+		unversioned_entity_id id;
+		id.raw.indirection_index = i;
+		return id;
+	}
+
+	/* Builds identical scenes in both worlds so that fixtures can be matched by their order of creation. */
+
+	struct test_world {
+		b2World world = b2World(b2Vec2(0.f, 0.f));
+		std::vector<b2Fixture*> fixtures;
+		b2Body* missile = nullptr;
+
+		b2Body* add_body(const b2BodyType type, const b2Vec2 pos, const unsigned id) {
+			b2BodyDef def;
+			def.type = type;
+			def.transform.p = pos;
+			def.transform.q.SetIdentity();
+			def.sweep = {};
+			def.sweep.c0 = def.sweep.c = pos;
+			def.userData = test_id(id);
+
+			return world.CreateBody(&def);
+		}
+
+		b2Fixture* add_fixture(b2Body& body, b2FixtureDef def) {
+			def.density = 1.f;
+			def.friction = 0.f;
+			def.userData = body.GetUserData();
+
+			short index = 0;
+
+			for (const auto* f = body.GetFixtureList(); f != nullptr; f = f->GetNext()) {
+				++index;
+			}
+
+			auto* const f = body.CreateFixture(&def);
+			f->index_in_component = index;
+			fixtures.push_back(f);
+			return f;
+		}
+
+		b2Fixture* add_box(b2Body& body, const b2Vec2 half_size, const b2Vec2 center = b2Vec2(0.f, 0.f), const float32 restitution = 0.f) {
+			b2PolygonShape box;
+			box.SetAsBox(half_size.x, half_size.y, center, 0.f);
+
+			b2FixtureDef def;
+			def.shape = &box;
+			def.restitution = restitution;
+
+			return add_fixture(body, def);
+		}
+
+		b2Fixture* add_circle(b2Body& body, const float32 radius, const b2Vec2 center = b2Vec2(0.f, 0.f)) {
+			b2CircleShape circle;
+			circle.m_radius = radius;
+			circle.m_p = center;
+
+			b2FixtureDef def;
+			def.shape = &circle;
+
+			return add_fixture(body, def);
+		}
+
+		/* A missile that keeps its fixture, as before. */
+
+		b2Fixture* add_missile_with_fixture(const b2Vec2 pos, const b2Vec2 vel, const float32 restitution) {
+			missile = add_body(b2_dynamicBody, pos, 1000);
+			missile->SetBullet(true);
+			missile->SetLinearVelocity(vel);
+
+			b2CircleShape circle;
+			circle.m_radius = missile_radius;
+
+			b2FixtureDef def;
+			def.shape = &circle;
+			def.density = missile_density;
+			def.friction = 0.f;
+			def.restitution = restitution;
+			def.userData = missile->GetUserData();
+
+			return missile->CreateFixture(&def);
+		}
+
+		/* A fixtureless missile with the mass its fixture would have had, see physics_world_cache. */
+
+		void add_swept_missile(const b2Vec2 pos, const b2Vec2 vel) {
+			missile = add_body(b2_dynamicBody, pos, 1000);
+			missile->SetBullet(true);
+			missile->SetLinearVelocity(vel);
+
+			b2MassData mass_data;
+			mass_data.mass = missile_density * b2_pi * missile_radius * missile_radius;
+			mass_data.center.SetZero();
+			mass_data.I = 0.f;
+
+			missile->SetMassData(&mass_data);
+		}
+
+		int index_of(const b2Fixture* const f) const {
+			return static_cast<int>(std::find(fixtures.begin(), fixtures.end(), f) - fixtures.begin());
+		}
+	};
+
+	template <class Scene>
+	struct comparison {
+		test_world old_path;
+		test_world new_path;
+
+		surface_kinds old_kinds;
+		surface_kinds new_kinds;
+
+		std::vector<sweep_event> old_events;
+		std::vector<sweep_event> new_events;
+
+		old_contact_listener listener = old_contact_listener(old_kinds, old_events);
+
+		comparison(Scene scene, const b2Vec2 missile_pos, const b2Vec2 missile_vel, const float32 missile_restitution = 0.f) {
+			scene(old_path, old_kinds);
+			scene(new_path, new_kinds);
+
+			listener.missile = old_path.add_missile_with_fixture(missile_pos, missile_vel, missile_restitution);
+			old_path.world.SetContactListener(&listener);
+
+			new_path.add_swept_missile(missile_pos, missile_vel);
+			this->missile_restitution = missile_restitution;
+		}
+
+		float32 missile_restitution = 0.f;
+
+		void step_old() {
+			old_path.world.Step(test_dt, 8, 3);
+		}
+
+		/* What missile_system does after the step, with the same filters and without any rewound step. */
+
+		void step_new(const bool born_this_step, const hitbox_history_step* const rewound = nullptr) {
+			auto& world = new_path.world;
+			world.Step(test_dt, 8, 3);
+
+			auto& body = *new_path.missile;
+
+			std::vector<missile_sweep_hit> hits;
+
+			const auto find_body = [&](const std::size_t i) -> b2Body* {
+				for (auto* b = world.GetBodyList(); b != nullptr; b = b->GetNext()) {
+					if (b->GetUserData() == rewound->ids[i].to_unversioned()) {
+						return b;
+					}
+				}
+
+				return nullptr;
+			};
+
+			::gather_missile_sweep_hits(
+				world,
+				body.m_sweep.c0,
+				body.m_sweep.c,
+				body.GetLinearVelocity(),
+				born_this_step,
+				b2Filter(),
+				rewound,
+				find_body,
+				hits
+			);
+
+			for (auto& h : hits) {
+				h.surface.raw.indirection_index = h.fixture->GetUserData().raw.indirection_index;
+			}
+
+			std::sort(hits.begin(), hits.end());
+
+			::resolve_missile_sweep_hits(
+				body,
+				missile_restitution,
+				hits,
+				[&](const missile_sweep_hit& hit) { return new_kinds.classify(hit.fixture); },
+				[&](const event_type type, const missile_sweep_hit& hit, const float32 normal_impulse) {
+					sweep_event e;
+
+					e.type = type;
+					e.surface = hit.fixture;
+					e.point = hit.point;
+					e.missile_velocity = body.GetLinearVelocity();
+					e.normal_impulse = normal_impulse;
+
+					new_events.push_back(e);
+				}
+			);
+		}
+
+		void run(const unsigned steps) {
+			for (unsigned i = 0; i < steps; ++i) {
+				step_old();
+				step_new(i == 0);
+			}
+		}
+
+		/* The same events with the same surfaces in the same order. */
+
+		void require_same_events() const {
+			const auto a = first_of_each(old_events);
+			const auto b = first_of_each(new_events);
+
+			REQUIRE(a.size() == b.size());
+
+			for (std::size_t i = 0; i < a.size(); ++i) {
+				REQUIRE(a[i].type == b[i].type);
+				REQUIRE(old_path.index_of(a[i].surface) == new_path.index_of(b[i].surface));
+			}
+		}
+
+		/*
+			Where the missile was reported to first touch each surface, to within its radius.
+			That is the point of impact for damage and headshots.
+			Later events of the old path are reported wherever the missile has been carried since.
+		*/
+
+		void require_same_points() const {
+			const auto a = first_of_each(old_events);
+			const auto b = first_of_each(new_events);
+
+			for (std::size_t i = 0; i < std::min(a.size(), b.size()); ++i) {
+				if (a[i].type == event_type::BEGIN_CONTACT) {
+					REQUIRE((a[i].point - b[i].point).Length() < 2 * missile_radius + b2_linearSlop);
+				}
+			}
+		}
+
+		const sweep_event* find_old(const event_type type) const {
+			for (const auto& e : old_events) {
+				if (e.type == type) {
+					return &e;
+				}
+			}
+
+			return nullptr;
+		}
+
+		const sweep_event* find_new(const event_type type) const {
+			for (const auto& e : new_events) {
+				if (e.type == type) {
+					return &e;
+				}
+			}
+
+			return nullptr;
+		}
+	};
+
+	template <class Scene>
+	auto make_comparison(Scene scene, const b2Vec2 missile_pos, const b2Vec2 missile_vel, const float32 missile_restitution = 0.f) {
+		return std::make_unique<comparison<Scene>>(scene, missile_pos, missile_vel, missile_restitution);
+	}
+
+	bool approx_vec(const b2Vec2 a, const b2Vec2 b, const float32 tolerance) {
+		return (a - b).Length() <= tolerance * std::max(1.f, b.Length());
+	}
+}
+
+TEST_CASE("MissileSweep WallHit") {
+	/* A wall 5 m ahead, the missile covers 1 m per step. */
+
+	auto c = make_comparison(
+		[](test_world& w, surface_kinds&) {
+			auto& wall = *w.add_body(b2_staticBody, b2Vec2(5.f, 0.f), 1);
+			w.add_box(wall, b2Vec2(0.5f, 3.f));
+		},
+		b2Vec2(0.f, 0.f),
+		b2Vec2(60.f, 0.f)
+	);
+
+	c->run(10);
+
+	c->require_same_events();
+	c->require_same_points();
+
+	REQUIRE(c->find_new(event_type::POST_SOLVE) != nullptr);
+
+	/* Without restitution, the missile stops dead at the wall in both. */
+	REQUIRE(std::abs(c->old_path.missile->GetLinearVelocity().x) < 0.5f);
+	REQUIRE(std::abs(c->new_path.missile->GetLinearVelocity().x) < 0.5f);
+	REQUIRE(c->new_path.missile->GetPosition().x == Approx(c->old_path.missile->GetPosition().x).margin(2 * missile_radius + b2_linearSlop));
+}
+
+TEST_CASE("MissileSweep SentienceHit") {
+	/* The missile passes through the character and stops at the wall behind it. */
+
+	auto c = make_comparison(
+		[](test_world& w, surface_kinds& kinds) {
+			auto& character = *w.add_body(b2_dynamicBody, b2Vec2(3.f, 0.f), 1);
+			kinds.begin_only.push_back(w.add_circle(character, 0.4f));
+
+			auto& wall = *w.add_body(b2_staticBody, b2Vec2(8.f, 0.f), 2);
+			w.add_box(wall, b2Vec2(0.5f, 3.f));
+		},
+		b2Vec2(0.f, 0.f),
+		b2Vec2(60.f, 0.f)
+	);
+
+	c->run(12);
+
+	c->require_same_events();
+	c->require_same_points();
+
+	const auto events = first_of_each(c->new_events);
+
+	REQUIRE(events.size() == 4);
+	REQUIRE(events[0].type == event_type::BEGIN_CONTACT);
+	REQUIRE(c->new_path.index_of(events[0].surface) == 0);
+
+	/* The character was not pushed by a contact the game disables. */
+	REQUIRE(c->new_path.fixtures[0]->GetBody()->GetLinearVelocity().Length() == Approx(0.f).margin(1e-4f));
+	REQUIRE(c->old_path.fixtures[0]->GetBody()->GetLinearVelocity().Length() == Approx(0.f).margin(1e-4f));
+}
+
+TEST_CASE("MissileSweep Headshot") {
+	/*
+		A character with a separate head fixture, hit once through the head and once only through the body.
+		The headshot is decided from the point of the first contact and the missile's velocity.
+	*/
+
+	const auto head_center = b2Vec2(3.f, 0.3f);
+	const auto head_radius = 0.15f;
+
+	auto scene = [](test_world& w, surface_kinds& kinds) {
+		auto& character = *w.add_body(b2_dynamicBody, b2Vec2(3.f, 0.f), 1);
+		kinds.begin_only.push_back(w.add_box(character, b2Vec2(0.3f, 0.5f)));
+		kinds.begin_only.push_back(w.add_circle(character, 0.15f, b2Vec2(0.f, 0.3f)));
+	};
+
+	for (const auto y : { 0.3f, -0.3f }) {
+		auto c = make_comparison(scene, b2Vec2(0.f, y), b2Vec2(60.f, 0.f));
+		c->run(6);
+
+		c->require_same_events();
+		c->require_same_points();
+
+		auto detected = [&](const std::vector<sweep_event>& events) {
+			const auto first = first_of_each(events);
+			REQUIRE(!first.empty());
+
+			const auto& e = first[0];
+
+			return ::headshot_detected(
+				vec2(e.point),
+				vec2(e.missile_velocity).normalize(),
+				vec2(head_center),
+				head_radius
+			);
+		};
+
+		const bool expected = y > 0.f;
+
+		REQUIRE(detected(c->old_events) == expected);
+		REQUIRE(detected(c->new_events) == expected);
+	}
+}
+
+TEST_CASE("MissileSweep Ricochet") {
+	/* An oblique hit on a bouncy wall reflects the normal component of the velocity and keeps the tangent one. */
+
+	auto c = make_comparison(
+		[](test_world& w, surface_kinds&) {
+			auto& wall = *w.add_body(b2_staticBody, b2Vec2(5.f, 0.f), 1);
+			w.add_box(wall, b2Vec2(0.5f, 10.f), b2Vec2(0.f, 0.f), 1.f);
+		},
+		b2Vec2(0.f, 0.f),
+		b2Vec2(40.f, 30.f)
+	);
+
+	c->run(12);
+
+	c->require_same_events();
+	c->require_same_points();
+
+	const auto expected = b2Vec2(-40.f, 30.f);
+
+	REQUIRE(approx_vec(c->old_path.missile->GetLinearVelocity(), expected, 0.05f));
+	REQUIRE(approx_vec(c->new_path.missile->GetLinearVelocity(), expected, 0.05f));
+
+	const auto old_post = c->find_old(event_type::POST_SOLVE);
+	const auto new_post = c->find_new(event_type::POST_SOLVE);
+
+	REQUIRE(old_post != nullptr);
+	REQUIRE(new_post != nullptr);
+	REQUIRE(new_post->normal_impulse == Approx(old_post->normal_impulse).epsilon(0.05f));
+}
+
+TEST_CASE("MissileSweep DynamicBodyImpulse") {
+	/* A crate in the way is pushed with the impulse that stopped the missile. */
+
+	auto c = make_comparison(
+		[](test_world& w, surface_kinds&) {
+			auto& crate = *w.add_body(b2_dynamicBody, b2Vec2(5.f, 0.f), 1);
+			w.add_box(crate, b2Vec2(0.5f, 0.5f));
+		},
+		b2Vec2(0.f, 0.f),
+		b2Vec2(60.f, 0.f)
+	);
+
+	c->run(6);
+
+	c->require_same_events();
+	c->require_same_points();
+
+	const auto old_crate = c->old_path.fixtures[0]->GetBody()->GetLinearVelocity();
+	const auto new_crate = c->new_path.fixtures[0]->GetBody()->GetLinearVelocity();
+
+	REQUIRE(old_crate.x > 0.f);
+	REQUIRE(new_crate.x == Approx(old_crate.x).epsilon(0.1f));
+	REQUIRE(new_crate.y == Approx(old_crate.y).margin(0.05f));
+
+	/* Momentum is conserved in both. */
+	const auto missile_mass = c->new_path.missile->GetMass();
+	const auto crate_mass = c->new_path.fixtures[0]->GetBody()->GetMass();
+
+	REQUIRE(missile_mass * c->new_path.missile->GetLinearVelocity().x + crate_mass * new_crate.x == Approx(missile_mass * 60.f).epsilon(0.01f));
+}
+
+TEST_CASE("MissileSweep BarrelInsideWall") {
+	/* The missile is born already overlapping the wall, so the ray alone would never report it. */
+
+	auto c = make_comparison(
+		[](test_world& w, surface_kinds&) {
+			auto& wall = *w.add_body(b2_staticBody, b2Vec2(0.f, 0.f), 1);
+			w.add_box(wall, b2Vec2(0.5f, 3.f));
+		},
+		b2Vec2(0.2f, 0.f),
+		b2Vec2(-60.f, 0.f)
+	);
+
+	c->run(3);
+
+	c->require_same_events();
+
+	REQUIRE(c->find_new(event_type::BEGIN_CONTACT) != nullptr);
+	REQUIRE(c->find_new(event_type::POST_SOLVE) != nullptr);
+}
+
+TEST_CASE("MissileSweep RewoundHitbox") {
+	/*
+		A lag-compensated missile hits the character where it was in the rewound step.
+		That must be the same as the old path hitting a character actually standing there,
+		with the point of impact carried over onto the character as it is now.
+	*/
+
+	const auto then_pos = b2Vec2(3.f, 0.f);
+	const auto now_pos = b2Vec2(3.f, 4.f);
+
+	auto scene_at = [](const b2Vec2 pos) {
+		return [pos](test_world& w, surface_kinds& kinds) {
+			auto& character = *w.add_body(b2_dynamicBody, pos, 1);
+			kinds.begin_only.push_back(w.add_circle(character, 0.4f));
+		};
+	};
+
+	/* The old path sees the character where it was. */
+	auto old_c = make_comparison(scene_at(then_pos), b2Vec2(0.f, 0.f), b2Vec2(60.f, 0.f));
+
+	/* The new path has it where it is now, and the rewound step where it was. */
+	auto new_c = make_comparison(scene_at(now_pos), b2Vec2(0.f, 0.f), b2Vec2(60.f, 0.f));
+
+	hitbox_history_step rewound;
+
+	{
+		signi_entity_id id;
+		id.raw.indirection_index = 1;
+		id.raw.version = 1;
+
+		rewound.ids.push_back(id);
+		rewound.positions.push_back(vec2(then_pos));
+		rewound.rotations.push_back(0.f);
+	}
+
+	for (unsigned i = 0; i < 6; ++i) {
+		old_c->step_old();
+		new_c->step_new(i == 0, &rewound);
+	}
+
+	const auto old_events = first_of_each(old_c->old_events);
+	const auto new_events = first_of_each(new_c->new_events);
+
+	REQUIRE(old_events.size() == 1);
+	REQUIRE(new_events.size() == 1);
+	REQUIRE(old_events[0].type == event_type::BEGIN_CONTACT);
+	REQUIRE(new_events[0].type == event_type::BEGIN_CONTACT);
+
+	REQUIRE(new_c->new_path.index_of(new_events[0].surface) == 0);
+
+	const auto carried_over = old_events[0].point + (now_pos - then_pos);
+	REQUIRE((new_events[0].point - carried_over).Length() < 2 * missile_radius + b2_linearSlop);
+
+	/* Where the character stands now, nothing is hit without the rewound step. */
+	auto unrewound = make_comparison(scene_at(now_pos), b2Vec2(0.f, 0.f), b2Vec2(60.f, 0.f));
+	unrewound->run(6);
+
+	REQUIRE(unrewound->old_events.empty());
+	REQUIRE(unrewound->new_events.empty());
+}
+#endif
@@ -0,0 +1,812 @@
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+#include "3rdparty/Box2D/Box2D.h"
+#include "game/detail/navigation/navigation_grid.h"
+
+namespace {
+	struct neighbor {
+		vec2i offset;
+		navigation_cost cost;
+	};
+
+	constexpr navigation_cost straight_cost_v = 10;
+	constexpr navigation_cost diagonal_cost_v = 14;
+
+	const std::array<neighbor, 8> neighbors = {{
+		{ { 1, 0 }, straight_cost_v },
+		{ { -1, 0 }, straight_cost_v },
+		{ { 0, 1 }, straight_cost_v },
+		{ { 0, -1 }, straight_cost_v },
+		{ { 1, 1 }, diagonal_cost_v },
+		{ { 1, -1 }, diagonal_cost_v },
+		{ { -1, 1 }, diagonal_cost_v },
+		{ { -1, -1 }, diagonal_cost_v }
+	}};
+
+	navigation_cost octile_distance(const vec2i a, const vec2i b) {
+		const auto dx = static_cast<navigation_cost>(std::abs(a.x - b.x));
+		const auto dy = static_cast<navigation_cost>(std::abs(a.y - b.y));
+
+		return straight_cost_v * std::max(dx, dy) + (diagonal_cost_v - straight_cost_v) * std::min(dx, dy);
+	}
+
+	struct open_entry {
+		navigation_cost f = 0;
+		navigation_cost h = 0;
+		navigation_cell_index index = 0;
+
+		/* Later in the order means popped later from the heap. */
+		bool operator>(const open_entry& b) const {
+			if (f != b.f) {
+				return f > b.f;
+			}
+
+			if (h != b.h) {
+				return h > b.h;
+			}
+
+			return index > b.index;
+		}
+	};
+
+	/*
+		Per-cell search state, reused between searches on the same thread.
+		Stamps tell which entries were written by the current search, so nothing is cleared in between.
+	*/
+
+	struct search_scratch {
+		std::vector<navigation_cost> g;
+		std::vector<navigation_cell_index> parent;
+		std::vector<uint32_t> opened;
+		std::vector<uint32_t> closed;
+		std::vector<open_entry> open;
+
+		uint32_t stamp = 0;
+
+		void begin(const std::size_t num_cells) {
+			if (g.size() != num_cells) {
+				g.assign(num_cells, 0);
+				parent.assign(num_cells, 0);
+				opened.assign(num_cells, 0);
+				closed.assign(num_cells, 0);
+
+				stamp = 0;
+			}
+
+			++stamp;
+
+			if (stamp == 0) {
+				std::fill(opened.begin(), opened.end(), 0);
+				std::fill(closed.begin(), closed.end(), 0);
+
+				stamp = 1;
+			}
+
+			open.clear();
+		}
+
+		void push(const open_entry& e) {
+			open.push_back(e);
+			std::push_heap(open.begin(), open.end(), std::greater<>());
+		}
+
+		open_entry pop() {
+			std::pop_heap(open.begin(), open.end(), std::greater<>());
+
+			const auto top = open.back();
+			open.pop_back();
+			return top;
+		}
+	};
+
+	thread_local search_scratch thread_scratch;
+}
+
+void navigation_grid::rasterize(const b2World& world, const si_scaling si, const b2Filter& filter, const real32 agent_radius) {
+	origin = {};
+	cell_size = navigation_cell_size_v;
+	size = {};
+	blocked.clear();
+
+	auto for_each_obstacle = [&](auto callback) {
+		for (const b2Body* b = world.GetBodyList(); b != nullptr; b = b->GetNext()) {
+			if (b->GetType() != b2_staticBody) {
+				continue;
+			}
+
+			for (const b2Fixture* f = b->GetFixtureList(); f != nullptr; f = f->GetNext()) {
+				if (f->IsSensor() || !b2ContactFilter::ShouldCollide(&filter, &f->GetFilterData())) {
+					continue;
+				}
+
+				const auto& shape = *f->GetShape();
+
+				for (int32 child = 0; child < shape.GetChildCount(); ++child) {
+					b2AABB aabb;
+					shape.ComputeAABB(&aabb, b->GetTransform(), child);
+
+					callback(*b, shape, child, vec2(si.get_pixels(aabb.lowerBound)), vec2(si.get_pixels(aabb.upperBound)));
+				}
+			}
+		}
+	};
+
+	vec2 lo = vec2::square(std::numeric_limits<real32>::max());
+	vec2 hi = vec2::square(std::numeric_limits<real32>::lowest());
+
+	for_each_obstacle([&](const b2Body&, const b2Shape&, int32, const vec2 l, const vec2 h) {
+		lo.x = std::min(lo.x, l.x);
+		lo.y = std::min(lo.y, l.y);
+		hi.x = std::max(hi.x, h.x);
+		hi.y = std::max(hi.y, h.y);
+	});
+
+	if (lo.x > hi.x) {
+		/* Nothing to navigate around. */
+		return;
+	}
+
+	/* Enough margin on every side for the outside of the outermost walls to be walkable too. */
+
+	auto margin_cells = [&]() {
+		return static_cast<int>(std::ceil(agent_radius / cell_size)) + 1;
+	};
+
+	auto cells_for = [&](const real32 extent) {
+		return static_cast<int>(std::ceil(extent / cell_size)) + 2 * margin_cells();
+	};
+
+	while (static_cast<std::size_t>(cells_for(hi.x - lo.x)) * cells_for(hi.y - lo.y) > max_navigation_cells_v) {
+		cell_size *= 2;
+	}
+
+	origin = lo - vec2::square(cell_size * margin_cells());
+	size = { cells_for(hi.x - lo.x), cells_for(hi.y - lo.y) };
+	blocked.assign(static_cast<std::size_t>(size.area()), 0);
+
+	b2CircleShape agent;
+	agent.m_radius = si.get_meters(agent_radius);
+
+	for_each_obstacle([&](const b2Body& body, const b2Shape& shape, const int32 child, const vec2 l, const vec2 h) {
+		const auto first = vec2i((l - origin - vec2::square(agent_radius)) / cell_size);
+		const auto last = vec2i((h - origin + vec2::square(agent_radius)) / cell_size);
+
+		for (int y = std::max(first.y, 0); y <= std::min(last.y, size.y - 1); ++y) {
+			for (int x = std::max(first.x, 0); x <= std::min(last.x, size.x - 1); ++x) {
+				auto& cell = blocked[index_of({ x, y })];
+
+				if (cell) {
+					continue;
+				}
+
+				b2Transform at;
+				at.Set(b2Vec2(si.get_meters(get_cell_center({ x, y }))), 0.f);
+
+				if (b2TestOverlap(&agent, 0, &shape, child, at, body.GetTransform())) {
+					cell = 1;
+				}
+			}
+		}
+	});
+}
+
+bool navigation_grid::is_walkable(const vec2i c) const {
+	return c.x >= 0 && c.y >= 0 && c.x < size.x && c.y < size.y && !blocked[index_of(c)];
+}
+
+bool navigation_grid::can_step(const vec2i from, const vec2i offset) const {
+	if (!is_walkable(from + offset)) {
+		return false;
+	}
+
+	if (offset.x != 0 && offset.y != 0) {
+		return is_walkable({ from.x + offset.x, from.y }) && is_walkable({ from.x, from.y + offset.y });
+	}
+
+	return true;
+}
+
+navigation_cell_index navigation_grid::index_of(const vec2i c) const {
+	return static_cast<navigation_cell_index>(c.y * size.x + c.x);
+}
+
+vec2i navigation_grid::cell_of(const navigation_cell_index i) const {
+	return { static_cast<int>(i) % size.x, static_cast<int>(i) / size.x };
+}
+
+std::optional<vec2i> navigation_grid::find_cell_at_world(const vec2 p) const {
+	const auto local = (p - origin) / cell_size;
+
+	if (!is_set() || local.x < 0 || local.y < 0) {
+		return std::nullopt;
+	}
+
+	const auto c = vec2i(local);
+
+	if (c.x >= size.x || c.y >= size.y) {
+		return std::nullopt;
+	}
+
+	return c;
+}
+
+vec2 navigation_grid::get_cell_center(const vec2i c) const {
+	return origin + (vec2(c) + vec2::square(0.5f)) * cell_size;
+}
+
+std::optional<vec2i> navigation_grid::find_walkable_near(const vec2 p) const {
+	constexpr int max_rings = 3;
+
+	const auto cell = find_cell_at_world(p);
+
+	if (!cell) {
+		return std::nullopt;
+	}
+
+	if (is_walkable(*cell)) {
+		return cell;
+	}
+
+	for (int ring = 1; ring <= max_rings; ++ring) {
+		std::optional<vec2i> closest;
+		real32 closest_dist = 0.f;
+
+		for (int y = cell->y - ring; y <= cell->y + ring; ++y) {
+			for (int x = cell->x - ring; x <= cell->x + ring; ++x) {
+				const auto on_ring = std::abs(x - cell->x) == ring || std::abs(y - cell->y) == ring;
+
+				if (!on_ring || !is_walkable({ x, y })) {
+					continue;
+				}
+
+				const auto dist = (get_cell_center({ x, y }) - p).length_sq();
+
+				if (!closest || dist < closest_dist) {
+					closest = vec2i(x, y);
+					closest_dist = dist;
+				}
+			}
+		}
+
+		if (closest) {
+			return closest;
+		}
+	}
+
+	return std::nullopt;
+}
+
+bool navigation_grid::is_line_walkable(const vec2i a, const vec2i b) const {
+	if (!is_walkable(a)) {
+		return false;
+	}
+
+	const auto dx = std::abs(b.x - a.x);
+	const auto dy = std::abs(b.y - a.y);
+	const auto sx = a.x < b.x ? 1 : -1;
+	const auto sy = a.y < b.y ? 1 : -1;
+
+	auto err = dx - dy;
+	auto p = a;
+
+	while (p != b) {
+		const auto e2 = 2 * err;
+		const bool step_x = e2 > -dy;
+		const bool step_y = e2 < dx;
+
+		const auto offset = vec2i(step_x ? sx : 0, step_y ? sy : 0);
+
+		if (!can_step(p, offset)) {
+			return false;
+		}
+
+		if (step_x) {
+			err -= dy;
+		}
+
+		if (step_y) {
+			err += dx;
+		}
+
+		p += offset;
+	}
+
+	return true;
+}
+
+void navigation_flow_field::build(const navigation_grid& grid, const vec2i new_target) {
+	target = new_target;
+	costs.assign(grid.blocked.size(), unreachable_navigation_cost_v);
+
+	if (!grid.is_walkable(target)) {
+		return;
+	}
+
+	/* Dijkstra from the target. Every step can be taken both ways, so the costs are the same as towards it. */
+
+	auto& scratch = thread_scratch;
+	scratch.open.clear();
+
+	auto& open = scratch.open;
+
+	const auto target_index = grid.index_of(target);
+
+	costs[target_index] = 0;
+	open.push_back({ 0, 0, target_index });
+
+	while (!open.empty()) {
+		std::pop_heap(open.begin(), open.end(), std::greater<>());
+		const auto current = open.back();
+		open.pop_back();
+
+		if (current.f != costs[current.index]) {
+			/* Superseded by a cheaper entry. */
+			continue;
+		}
+
+		const auto cell = grid.cell_of(current.index);
+
+		for (const auto& n : neighbors) {
+			if (!grid.can_step(cell, n.offset)) {
+				continue;
+			}
+
+			const auto next = grid.index_of(cell + n.offset);
+			const auto cost = current.f + n.cost;
+
+			if (cost < costs[next]) {
+				costs[next] = cost;
+
+				open.push_back({ cost, 0, next });
+				std::push_heap(open.begin(), open.end(), std::greater<>());
+			}
+		}
+	}
+}
+
+std::optional<vec2i> navigation_flow_field::find_next_cell(const navigation_grid& grid, const vec2i from) const {
+	if (!grid.is_walkable(from) || from == target) {
+		return std::nullopt;
+	}
+
+	const auto from_cost = costs[grid.index_of(from)];
+
+	if (from_cost == unreachable_navigation_cost_v) {
+		return std::nullopt;
+	}
+
+	/*
+		Not just the neighbor with the lowest cost - a diagonal step might lower it the most
+		while costing more than it saves. Only a step that accounts for the whole difference is on a cheapest path.
+	*/
+
+	for (const auto& n : neighbors) {
+		if (!grid.can_step(from, n.offset)) {
+			continue;
+		}
+
+		const auto cost = costs[grid.index_of(from + n.offset)];
+
+		if (cost != unreachable_navigation_cost_v && cost + n.cost == from_cost) {
+			return from + n.offset;
+		}
+	}
+
+	return std::nullopt;
+}
+
+void find_grid_path(const navigation_grid& grid, const vec2i start, const vec2i goal, std::vector<vec2i>& out_cells) {
+	out_cells.clear();
+
+	if (!grid.is_walkable(start) || !grid.is_walkable(goal)) {
+		return;
+	}
+
+	auto& s = thread_scratch;
+	s.begin(grid.blocked.size());
+
+	const auto start_index = grid.index_of(start);
+	const auto goal_index = grid.index_of(goal);
+
+	s.g[start_index] = 0;
+	s.opened[start_index] = s.stamp;
+	s.push({ octile_distance(start, goal), octile_distance(start, goal), start_index });
+
+	while (!s.open.empty()) {
+		const auto current = s.pop();
+
+		if (s.closed[current.index] == s.stamp) {
+			continue;
+		}
+
+		s.closed[current.index] = s.stamp;
+
+		if (current.index == goal_index) {
+			for (auto i = goal_index; i != start_index; i = s.parent[i]) {
+				out_cells.push_back(grid.cell_of(i));
+			}
+
+			out_cells.push_back(start);
+			std::reverse(out_cells.begin(), out_cells.end());
+
+			smooth_grid_path(grid, out_cells);
+			return;
+		}
+
+		const auto cell = grid.cell_of(current.index);
+
+		for (const auto& n : neighbors) {
+			if (!grid.can_step(cell, n.offset)) {
+				continue;
+			}
+
+			const auto next_cell = cell + n.offset;
+			const auto next = grid.index_of(next_cell);
+
+			if (s.closed[next] == s.stamp) {
+				continue;
+			}
+
+			const auto g = s.g[current.index] + n.cost;
+
+			if (s.opened[next] != s.stamp || g < s.g[next]) {
+				s.opened[next] = s.stamp;
+				s.g[next] = g;
+				s.parent[next] = current.index;
+
+				const auto h = octile_distance(next_cell, goal);
+				s.push({ g + h, h, next });
+			}
+		}
+	}
+}
+
+void follow_flow_field(const navigation_grid& grid, const navigation_flow_field& field, const vec2i start, std::vector<vec2i>& out_cells) {
+	out_cells.clear();
+
+	if (!grid.is_walkable(start) || field.costs[grid.index_of(start)] == unreachable_navigation_cost_v) {
+		return;
+	}
+
+	out_cells.push_back(start);
+
+	/* The costs strictly decrease along the way, so this always ends at the target. */
+
+	while (const auto next = field.find_next_cell(grid, out_cells.back())) {
+		out_cells.push_back(*next);
+	}
+
+	smooth_grid_path(grid, out_cells);
+}
+
+void smooth_grid_path(const navigation_grid& grid, std::vector<vec2i>& cells) {
+	if (cells.size() <= 2) {
+		return;
+	}
+
+	/* Skip every cell that can be seen past from the last corner, in place. */
+
+	std::size_t num_kept = 1;
+	std::size_t anchor = 0;
+
+	for (std::size_t i = 2; i < cells.size(); ++i) {
+		if (!grid.is_line_walkable(cells[anchor], cells[i])) {
+			anchor = i - 1;
+			cells[num_kept++] = cells[anchor];
+		}
+	}
+
+	cells[num_kept++] = cells.back();
+	cells.resize(num_kept);
+}
+
+#if BUILD_UNIT_TESTS
+#include <Catch/single_include/catch2/catch.hpp>
+
+TEST_CASE("NavigationGrid PathsAroundWalls") {
+	const auto si = si_scaling();
+
+	b2World world(b2Vec2(0.f, 0.f));
+
+	auto add_wall = [&](const vec2 center_px, const vec2 half_size_px) {
+		b2BodyDef def;
+		def.type = b2_staticBody;
+		def.transform.p = b2Vec2(si.get_meters(center_px));
+
+		b2PolygonShape box;
+		box.SetAsBox(si.get_meters(half_size_px.x), si.get_meters(half_size_px.y));
+
+		world.CreateBody(&def)->CreateFixture(&box, 0.f);
+	};
+
+	/* A room with a wall down the middle, open only at the bottom. */
+
+	add_wall({ 0.f, -400.f }, { 420.f, 20.f });
+	add_wall({ 0.f, 400.f }, { 420.f, 20.f });
+	add_wall({ -400.f, 0.f }, { 20.f, 420.f });
+	add_wall({ 400.f, 0.f }, { 20.f, 420.f });
+	add_wall({ 0.f, -80.f }, { 20.f, 320.f });
+
+	world.UpdateStaticTree();
+
+	b2Filter filter;
+
+	navigation_grid grid;
+	grid.rasterize(world, si, filter, navigation_agent_radius_v);
+
+	REQUIRE(grid.is_set());
+
+	const auto start = grid.find_walkable_near({ -200.f, -200.f });
+	const auto goal = grid.find_walkable_near({ 200.f, -200.f });
+
+	REQUIRE(start.has_value());
+	REQUIRE(goal.has_value());
+
+	REQUIRE_FALSE(grid.is_walkable(*grid.find_cell_at_world({ 0.f, -100.f })));
+	REQUIRE_FALSE(grid.is_line_walkable(*start, *goal));
+
+	std::vector<vec2i> astar;
+	find_grid_path(grid, *start, *goal, astar);
+
+	REQUIRE(astar.size() >= 3);
+	REQUIRE(astar.front() == *start);
+	REQUIRE(astar.back() == *goal);
+
+	for (std::size_t i = 1; i < astar.size(); ++i) {
+		REQUIRE(grid.is_line_walkable(astar[i - 1], astar[i]));
+	}
+
+	/* The way around goes below the middle wall. */
+
+	const auto lowest = std::max_element(astar.begin(), astar.end(), [](const auto& a, const auto& b) { return a.y < b.y; });
+	REQUIRE(grid.get_cell_center(*lowest).y > 240.f);
+
+	navigation_flow_field field;
+	field.build(grid, *goal);
+
+	std::vector<vec2i> flowed;
+	follow_flow_field(grid, field, *start, flowed);
+
+	REQUIRE(flowed.front() == *start);
+	REQUIRE(flowed.back() == *goal);
+
+	for (std::size_t i = 1; i < flowed.size(); ++i) {
+		REQUIRE(grid.is_line_walkable(flowed[i - 1], flowed[i]));
+	}
+
+	/* Walled off entirely. */
+
+	add_wall({ 0.f, 300.f }, { 20.f, 120.f });
+	grid.rasterize(world, si, filter, navigation_agent_radius_v);
+
+	find_grid_path(grid, *start, *goal, astar);
+	REQUIRE(astar.empty());
+
+	field.build(grid, *goal);
+	follow_flow_field(grid, field, *start, flowed);
+	REQUIRE(flowed.empty());
+}
+
+static navigation_grid make_test_grid(const std::vector<const char*>& rows) {
+	navigation_grid grid;
+	grid.size = { static_cast<int>(std::strlen(rows[0])), static_cast<int>(rows.size()) };
+	grid.blocked.assign(static_cast<std::size_t>(grid.size.area()), 0);
+
+	for (int y = 0; y < grid.size.y; ++y) {
+		for (int x = 0; x < grid.size.x; ++x) {
+			grid.blocked[grid.index_of({ x, y })] = rows[y][x] == '#';
+		}
+	}
+
+	return grid;
+}
+
+/* Every segment of a smoothed path is a straight line, which costs exactly the octile distance. */
+
+static navigation_cost cost_of(const std::vector<vec2i>& corners) {
+	navigation_cost total = 0;
+
+	for (std::size_t i = 1; i < corners.size(); ++i) {
+		total += octile_distance(corners[i - 1], corners[i]);
+	}
+
+	return total;
+}
+
+TEST_CASE("NavigationGrid RasterizesAroundWalls") {
+	const auto si = si_scaling();
+
+	b2World world(b2Vec2(0.f, 0.f));
+
+	const auto wall_half_size = vec2(200.f, 40.f);
+
+	{
+		b2BodyDef def;
+		def.type = b2_staticBody;
+
+		b2PolygonShape box;
+		box.SetAsBox(si.get_meters(wall_half_size.x), si.get_meters(wall_half_size.y));
+
+		world.CreateBody(&def)->CreateFixture(&box, 0.f);
+	}
+
+	{
+		/* Not an obstacle. */
+
+		b2BodyDef def;
+		def.type = b2_staticBody;
+		def.transform.p = b2Vec2(si.get_meters(vec2(0.f, 150.f)));
+
+		b2CircleShape circle;
+		circle.m_radius = si.get_meters(30.f);
+
+		b2FixtureDef sensor;
+		sensor.shape = &circle;
+		sensor.isSensor = true;
+
+		world.CreateBody(&def)->CreateFixture(&sensor);
+	}
+
+	world.UpdateStaticTree();
+
+	navigation_grid grid;
+	grid.rasterize(world, si, b2Filter(), navigation_agent_radius_v);
+
+	REQUIRE(grid.is_set());
+
+	/* The margin around the wall stays walkable. */
+
+	for (int x = 0; x < grid.size.x; ++x) {
+		REQUIRE(grid.is_walkable({ x, 0 }));
+		REQUIRE(grid.is_walkable({ x, grid.size.y - 1 }));
+	}
+
+	for (int y = 0; y < grid.size.y; ++y) {
+		REQUIRE(grid.is_walkable({ 0, y }));
+		REQUIRE(grid.is_walkable({ grid.size.x - 1, y }));
+	}
+
+	/* A cell is blocked exactly when the agent at its center would touch the wall. */
+
+	const auto skin = si.get_pixels(b2_polygonRadius) + 0.5f;
+
+	std::size_t num_blocked = 0;
+
+	for (int y = 0; y < grid.size.y; ++y) {
+		for (int x = 0; x < grid.size.x; ++x) {
+			const auto center = grid.get_cell_center({ x, y });
+
+			const auto outside = vec2(
+				std::max(std::abs(center.x) - wall_half_size.x, 0.f),
+				std::max(std::abs(center.y) - wall_half_size.y, 0.f)
+			);
+
+			const auto distance = outside.length();
+
+			if (std::abs(distance - navigation_agent_radius_v) < skin) {
+				continue;
+			}
+
+			const bool should_block = distance < navigation_agent_radius_v;
+			REQUIRE(grid.is_walkable({ x, y }) == !should_block);
+
+			num_blocked += should_block;
+		}
+	}
+
+	REQUIRE(num_blocked > 0);
+	REQUIRE_FALSE(grid.is_walkable(*grid.find_cell_at_world({ 0.f, 0.f })));
+	REQUIRE(grid.is_walkable(*grid.find_cell_at_world({ 0.f, wall_half_size.y + navigation_agent_radius_v + navigation_cell_size_v })));
+}
+
+TEST_CASE("NavigationGrid NeverCutsCorners") {
+	{
+		const auto grid = make_test_grid({
+			"...",
+			"#..",
+			"..."
+		});
+
+		REQUIRE_FALSE(grid.can_step({ 0, 0 }, { 1, 1 }));
+		REQUIRE(grid.can_step({ 1, 0 }, { 1, 1 }));
+		REQUIRE_FALSE(grid.is_line_walkable({ 0, 2 }, { 1, 0 }));
+
+		std::vector<vec2i> path;
+		find_grid_path(grid, { 0, 0 }, { 0, 2 }, path);
+
+		/* Not through the corners of the blocked cell, diagonally or along a smoothed line. */
+		REQUIRE(path == std::vector<vec2i> { { 0, 0 }, { 1, 0 }, { 1, 2 }, { 0, 2 } });
+
+		navigation_flow_field field;
+		field.build(grid, { 0, 2 });
+
+		REQUIRE(field.costs[grid.index_of({ 0, 0 })] == 40);
+		REQUIRE(*field.find_next_cell(grid, { 0, 0 }) == vec2i(1, 0));
+	}
+
+	{
+		/* The only way through is diagonal, past two corners. */
+
+		const auto grid = make_test_grid({
+			".#",
+			"#."
+		});
+
+		REQUIRE_FALSE(grid.can_step({ 0, 0 }, { 1, 1 }));
+
+		std::vector<vec2i> path;
+		find_grid_path(grid, { 0, 0 }, { 1, 1 }, path);
+		REQUIRE(path.empty());
+
+		navigation_flow_field field;
+		field.build(grid, { 1, 1 });
+		REQUIRE(field.costs[grid.index_of({ 0, 0 })] == unreachable_navigation_cost_v);
+	}
+}
+
+TEST_CASE("NavigationGrid AStarAndFlowFieldCostsMatch") {
+	const auto grid = make_test_grid({
+		"..........#.....",
+		"..####....#..#..",
+		".....#....#..#..",
+		".....#.......#..",
+		"..#..######..#..",
+		"..#..........#..",
+		"..#####..#####..",
+		"........#.......",
+		"..#.....#..###..",
+		"..#..........#.."
+	});
+
+	const auto goal = vec2i(15, 0);
+
+	navigation_flow_field field;
+	field.build(grid, goal);
+
+	std::vector<vec2i> astar;
+	std::vector<vec2i> flowed;
+
+	std::size_t num_compared = 0;
+
+	for (int y = 0; y < grid.size.y; ++y) {
+		for (int x = 0; x < grid.size.x; ++x) {
+			const auto start = vec2i(x, y);
+
+			if (!grid.is_walkable(start) || start == goal) {
+				continue;
+			}
+
+			find_grid_path(grid, start, goal, astar);
+			follow_flow_field(grid, field, start, flowed);
+
+			REQUIRE(astar.size() >= 2);
+			REQUIRE(flowed.size() >= 2);
+
+			REQUIRE(astar.front() == start);
+			REQUIRE(flowed.front() == start);
+			REQUIRE(astar.back() == goal);
+			REQUIRE(flowed.back() == goal);
+
+			for (std::size_t i = 1; i < astar.size(); ++i) {
+				REQUIRE(grid.is_line_walkable(astar[i - 1], astar[i]));
+			}
+
+			for (std::size_t i = 1; i < flowed.size(); ++i) {
+				REQUIRE(grid.is_line_walkable(flowed[i - 1], flowed[i]));
+			}
+
+			const auto optimal = field.costs[grid.index_of(start)];
+
+			REQUIRE(cost_of(astar) == optimal);
+			REQUIRE(cost_of(flowed) == optimal);
+
+			++num_compared;
+		}
+	}
+
+	REQUIRE(num_compared > 100);
+}
+#endif
@@ -0,0 +1,89 @@
+#pragma once
+#include <limits>
+#include <vector>
+#include <cstdint>
+#include <optional>
+
+#include "augs/math/vec2.h"
+#include "augs/math/si_scaling.h"
+
+class b2World;
+struct b2Filter;
+
+/*
+	A uniform grid over the static geometry of an arena.
+
+	A cell is walkable if a character of agent_radius standing at its center would not touch
+	any static fixture that passes the filter, so paths keep their distance from walls by construction.
+	Passages narrower than the character are closed.
+
+	All searches run on integer costs - 10 for a straight step, 14 for a diagonal one -
+	and visit neighbors in a fixed order, so every machine finds exactly the same path.
+	A diagonal step never cuts a corner: both cells adjacent to the diagonal must be walkable too.
+*/
+
+constexpr real32 navigation_cell_size_v = 32.f;
+constexpr real32 navigation_agent_radius_v = 24.f;
+
+/* Beyond this, the cells are made twice as large until the grid fits. */
+constexpr std::size_t max_navigation_cells_v = 1 << 20;
+
+using navigation_cell_index = uint32_t;
+using navigation_cost = uint32_t;
+
+constexpr navigation_cost unreachable_navigation_cost_v = std::numeric_limits<navigation_cost>::max();
+
+struct navigation_grid {
+	vec2 origin;
+	real32 cell_size = navigation_cell_size_v;
+	vec2i size;
+	std::vector<uint8_t> blocked;
+
+	void rasterize(const b2World&, si_scaling, const b2Filter& filter, real32 agent_radius);
+
+	bool is_set() const {
+		return !blocked.empty();
+	}
+
+	bool is_walkable(vec2i) const;
+	bool can_step(vec2i from, vec2i offset) const;
+
+	navigation_cell_index index_of(vec2i) const;
+	vec2i cell_of(navigation_cell_index) const;
+
+	std::optional<vec2i> find_cell_at_world(vec2) const;
+	vec2 get_cell_center(vec2i) const;
+
+	/* The walkable cell closest to the position, if there is one within a few cells. */
+	std::optional<vec2i> find_walkable_near(vec2) const;
+
+	/*
+		True if every cell on the line between the two is walkable, corners included.
+		The line is traced with Bresenham, so a cell it only grazes may go unchecked;
+		walls are already kept at agent_radius from every walkable cell, which covers for that.
+	*/
+
+	bool is_line_walkable(vec2i, vec2i) const;
+};
+
+struct navigation_flow_field {
+	/* The cost of the cheapest path to the target from every cell. */
+	std::vector<navigation_cost> costs;
+	vec2i target;
+
+	void build(const navigation_grid&, vec2i target);
+
+	/* The neighbor one step closer to the target, or nullopt at the target or if it can't be reached. */
+	std::optional<vec2i> find_next_cell(const navigation_grid&, vec2i from) const;
+};
+
+/*
+	The functions below return the cells from start to goal, both included,
+	reduced by smooth_grid_path to the corners that can't be seen past.
+	The output is empty if the goal can't be reached.
+*/
+
+void find_grid_path(const navigation_grid&, vec2i start, vec2i goal, std::vector<vec2i>& out_cells);
+void follow_flow_field(const navigation_grid&, const navigation_flow_field&, vec2i start, std::vector<vec2i>& out_cells);
+
+void smooth_grid_path(const navigation_grid&, std::vector<vec2i>& cells);
@@ -178,13 +178,15 @@ void for_each_intersection_with_triangle(
 	);
 }
 
-template <class C, class F>
-void for_each_intersection_with_polygon(
-	const b2World& b2world,
+struct queried_polygon_meters {
+	b2PolygonShape shape;
+	b2Transform transform;
+};
+
+template <class C>
+auto to_queried_polygon_meters(
 	const si_scaling si,
-	const C& vertices,
-	const b2Filter filter,
-	F callback
+	const C& vertices
 ) {
 	const auto n = static_cast<unsigned>(vertices.size());
 	
@@ -199,10 +201,10 @@ void for_each_intersection_with_polygon(
 		return si.get_meters(result);
 	}();
 
-	const auto poly_shape = [&]() {
-		b2PolygonShape poly_shape;
+	queried_polygon_meters result;
 
-		decltype(poly_shape.m_vertices) verts;
+	{
+		decltype(result.shape.m_vertices) verts;
 
 		for (std::size_t i = 0; i < n; ++i) {
 			const auto meters = si.get_meters(vertices[i]);
@@ -210,19 +212,30 @@ void for_each_intersection_with_polygon(
 			verts[i] = b2Vec2(meters - average_meters);
 		}
 		
-		poly_shape.Set(verts, n);
-		return poly_shape;
-	}();
+		result.shape.Set(verts, n);
+	}
 
-	b2Transform queried_transform;
-	queried_transform.SetIdentity();
-	queried_transform.p = b2Vec2(average_meters);
+	result.transform.SetIdentity();
+	result.transform.p = b2Vec2(average_meters);
+
+	return result;
+}
+
+template <class C, class F>
+void for_each_intersection_with_polygon(
+	const b2World& b2world,
+	const si_scaling si,
+	const C& vertices,
+	const b2Filter filter,
+	F callback
+) {
+	const auto queried = to_queried_polygon_meters(si, vertices);
 
 	for_each_intersection_with_shape_meters(
 		b2world,
 		si,
-		poly_shape,
-		queried_transform,
+		queried.shape,
+		queried.transform,
 		filter, 
 		callback
 	);
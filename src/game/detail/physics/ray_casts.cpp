@@ -1,3 +1,7 @@
+#include <cmath>
+#include <chrono>
+#include <algorithm>
+
 #include "game/inferred_caches/physics_world_cache.h"
 #include "game/cosmos/cosmos.h"
 #include "game/cosmos/entity_handle.h"
@@ -5,6 +9,13 @@
 #include "game/detail/physics/physics_scripts.h"
 #include "game/enums/filters.h"
 
+static bool should_ray_cast(b2Fixture* const fixture, const entity_id subject, const b2Filter& subject_filter) {
+	const auto fixture_entity = fixture->GetBody()->GetUserData();
+	return
+		(subject == entity_id() || fixture_entity != FixtureUserdata(subject)) &&
+		(b2ContactFilter::ShouldCollide(&subject_filter, &fixture->GetFilterData()));
+}
+
 struct raycast_input : public b2RayCastCallback {
 	entity_id subject;
 	b2Filter subject_filter;
@@ -18,10 +29,7 @@ struct raycast_input : public b2RayCastCallback {
 };
 
 bool raycast_input::ShouldRaycast(b2Fixture* const fixture) {
-	const auto fixture_entity = fixture->GetBody()->GetUserData();
-	return
-		(subject == entity_id() || fixture_entity != FixtureUserdata(subject)) &&
-		(b2ContactFilter::ShouldCollide(&subject_filter, &fixture->GetFilterData()));
+	return should_ray_cast(fixture, subject, subject_filter);
 }
 
 float32 raycast_input::ReportFixture(
@@ -64,6 +72,23 @@ std::vector<physics_raycast_output> physics_world_cache::ray_cast_all_intersecti
 	return callback.outputs;
 }
 
+/* Rays in meters, exactly as ray_cast_px would convert them. */
+
+static void make_ray_fan(
+	std::vector<physics_raycast_input>& rays,
+	const si_scaling si,
+	const vec2 position,
+	const float radius,
+	const int ray_amount
+) {
+	rays.clear();
+
+	for (int i = 0; i < ray_amount; ++i) {
+		const auto target = position + vec2::from_degrees((360.f / ray_amount) * i) * radius;
+		rays.push_back({ si.get_meters(position), si.get_meters(target) });
+	}
+}
+
 float physics_world_cache::get_closest_wall_intersection(
 	const si_scaling si,
 	const vec2 position, 
@@ -74,17 +99,15 @@ float physics_world_cache::get_closest_wall_intersection(
 ) const {
 	float worst_distance = radius;
 
-	for (int i = 0; i < ray_amount; ++i) {
-		const auto out = ray_cast_px(
-			si,
-			position, 
-			position + vec2::from_degrees((360.f / ray_amount) * i) * radius, 
-			filter, 
-			ignore_entity
-		);
+	thread_local std::vector<physics_raycast_input> rays;
+	thread_local std::vector<physics_raycast_output> outputs;
 
+	make_ray_fan(rays, si, position, radius, ray_amount);
+	ray_cast_batch(rays, outputs, filter, ignore_entity);
+
+	for (const auto& out : outputs) {
 		if (out.hit) {
-			auto diff = (out.intersection - position);
+			auto diff = (si.get_pixels(out.intersection) - position);
 			auto distance = diff.length();
 
 			if (distance < worst_distance) worst_distance = distance;
@@ -106,17 +129,15 @@ vec2 physics_world_cache::push_away_from_walls(
 
 	float worst_distance = radius;
 
-	for (int i = 0; i < ray_amount; ++i) {
-		const auto out = ray_cast_px(
-			si,
-			position, 
-			position + vec2::from_degrees((360.f / ray_amount) * i) * radius, 
-			filter, 
-			ignore_entity
-		);
+	thread_local std::vector<physics_raycast_input> rays;
+	thread_local std::vector<physics_raycast_output> outputs;
+
+	make_ray_fan(rays, si, position, radius, ray_amount);
+	ray_cast_batch(rays, outputs, filter, ignore_entity);
 
+	for (const auto& out : outputs) {
 		if (out.hit) {
-			auto diff = (out.intersection - position);
+			auto diff = (si.get_pixels(out.intersection) - position);
 			auto distance = diff.length();
 
 			if (distance < worst_distance) worst_distance = distance;
@@ -157,4 +178,470 @@ physics_raycast_output physics_world_cache::ray_cast_px(
 	out.intersection = si.get_pixels(out.intersection);
 
 	return out;
-}
\ No newline at end of file
+}
+namespace {
+	/*
+		The per-ray state of b2DynamicTree::RayCast and b2StaticTree::RayCast.
+		The node tests are the very same so that a batched ray visits the same leaves in the same order.
+	*/
+
+	struct batched_ray {
+		b2Vec2 p1;
+		b2Vec2 p2;
+		b2Vec2 v;
+		b2Vec2 abs_v;
+		b2AABB segment_aabb;
+		float32 max_fraction = 1.0f;
+		bool terminated = false;
+
+		batched_ray(const b2Vec2 p1, const b2Vec2 p2) : p1(p1), p2(p2) {
+			b2Vec2 r = p2 - p1;
+			r.Normalize();
+
+			v = b2Cross(1.0f, r);
+			abs_v = b2Abs(v);
+
+			clip(1.0f);
+		}
+
+		void clip(const float32 new_max_fraction) {
+			max_fraction = new_max_fraction;
+
+			const b2Vec2 t = p1 + max_fraction * (p2 - p1);
+			segment_aabb.lowerBound = b2Min(p1, t);
+			segment_aabb.upperBound = b2Max(p1, t);
+		}
+
+		bool may_cross(const b2AABB& aabb) const {
+			if (terminated || b2TestOverlap(aabb, segment_aabb) == false) {
+				return false;
+			}
+
+			const b2Vec2 c = aabb.GetCenter();
+			const b2Vec2 h = aabb.GetExtents();
+			const float32 separation = b2Abs(b2Dot(v, p1 - c)) - b2Dot(abs_v, h);
+
+			return !(separation > 0.0f);
+		}
+	};
+
+	/* A node together with the rays that reached its parent, as a range in the packet buffer. */
+
+	struct batched_node {
+		int32 node_id;
+		std::size_t first;
+		std::size_t count;
+	};
+}
+
+void physics_world_cache::ray_cast_batch(
+	const std::vector<physics_raycast_input>& rays_meters,
+	std::vector<physics_raycast_output>& outputs,
+	const b2Filter filter,
+	const entity_id ignore_entity
+) const {
+	outputs.assign(rays_meters.size(), physics_raycast_output());
+
+	thread_local std::vector<batched_ray> rays;
+	thread_local std::vector<uint32_t> packets;
+	thread_local std::vector<batched_node> stack;
+
+	rays.clear();
+
+	for (uint32_t i = 0; i < rays_meters.size(); ++i) {
+		const auto& in = rays_meters[i];
+
+		rays.emplace_back(b2Vec2(in.from), b2Vec2(in.to));
+
+		/* ray_cast returns no hit for these without querying at all. */
+		if (!((in.from - in.to).length_sq() > 0.f)) {
+			rays.back().terminated = true;
+		}
+	}
+
+	/*
+		Walks a tree with all the rays that have not yet been terminated.
+		The rays keep their clipped fractions from one tree to the next,
+		just like a single ray does in b2BroadPhase::RayCast.
+	*/
+
+	auto cast_through = [&](const int32 root, const auto& get_node, const auto& get_proxy, const auto& push_children) {
+		packets.clear();
+		stack.clear();
+
+		for (uint32_t i = 0; i < rays.size(); ++i) {
+			if (!rays[i].terminated) {
+				packets.push_back(i);
+			}
+		}
+
+		if (packets.empty()) {
+			return;
+		}
+
+		stack.push_back({ root, 0, packets.size() });
+
+		while (!stack.empty()) {
+			const auto entry = stack.back();
+			stack.pop_back();
+
+			if (entry.node_id == b2_nullNode) {
+				continue;
+			}
+
+			const auto& node = get_node(entry.node_id);
+			const auto first_passed = packets.size();
+
+			for (std::size_t k = entry.first; k < entry.first + entry.count; ++k) {
+				const auto i = packets[k];
+
+				if (rays[i].may_cross(node.aabb)) {
+					packets.push_back(i);
+				}
+			}
+
+			const auto num_passed = packets.size() - first_passed;
+
+			if (num_passed == 0) {
+				continue;
+			}
+
+			if (node.IsLeaf()) {
+				const auto proxy = get_proxy(node);
+				b2Fixture* const fixture = proxy->fixture;
+
+				if (should_ray_cast(fixture, ignore_entity, filter)) {
+					for (std::size_t k = first_passed; k < packets.size(); ++k) {
+						const auto i = packets[k];
+						auto& ray = rays[i];
+
+						b2RayCastInput input;
+						input.p1 = ray.p1;
+						input.p2 = ray.p2;
+						input.maxFraction = ray.max_fraction;
+
+						b2RayCastOutput hit;
+
+						if (fixture->RayCast(&hit, input, proxy->childIndex)) {
+							const float32 fraction = hit.fraction;
+
+							auto& output = outputs[i];
+							output.intersection = (1.0f - fraction) * input.p1 + fraction * input.p2;
+							output.hit = true;
+							output.what_entity = fixture->GetBody()->GetUserData();
+							output.normal = hit.normal;
+
+							if (fraction == 0.0f) {
+								/* b2DynamicTree::RayCast treats a zero as a request to stop. */
+								ray.terminated = true;
+							}
+							else {
+								ray.clip(fraction);
+							}
+						}
+					}
+				}
+
+				/* Nothing above this range is referenced by the nodes still on the stack. */
+				packets.resize(first_passed);
+			}
+			else {
+				push_children(entry.node_id, node, first_passed, num_passed);
+			}
+		}
+	};
+
+	const auto& broad_phase = b2world->GetContactManager().m_broadPhase;
+
+	{
+		/* Children are pushed and popped in the same order as in b2StaticTree::RayCast. */
+		const auto& tree = broad_phase.GetStaticTree();
+
+		cast_through(
+			tree.GetRoot(),
+			[&](const int32 id) -> const b2StaticTreeNode& { return tree.GetNode(id); },
+			[&](const b2StaticTreeNode& leaf) { return static_cast<const b2FixtureProxy*>(broad_phase.GetUserData(leaf.proxyId)); },
+			[&](const int32 id, const b2StaticTreeNode& node, const std::size_t first, const std::size_t count) {
+				stack.push_back({ node.child2, first, count });
+				stack.push_back({ id + 1, first, count });
+			}
+		);
+	}
+
+	{
+		/* Children are pushed and popped in the same order as in b2DynamicTree::RayCast. */
+		const auto& tree = broad_phase.m_tree;
+
+		cast_through(
+			tree.m_root,
+			[&](const int32 id) -> const b2TreeNode& { return tree.m_nodes[id]; },
+			[&](const b2TreeNode& leaf) { return static_cast<const b2FixtureProxy*>(leaf.userData); },
+			[&](int32, const b2TreeNode& node, const std::size_t first, const std::size_t count) {
+				stack.push_back({ node.child1, first, count });
+				stack.push_back({ node.child2, first, count });
+			}
+		);
+	}
+}
+
+/*
+	Walls scattered over a square arena, with a few dozen characters walking between them.
+	Returns the side of the arena.
+*/
+
+static float make_benchmark_arena(b2World& world, const unsigned num_obstacles) {
+	const auto side = static_cast<unsigned>(std::ceil(std::sqrt(static_cast<double>(std::max(num_obstacles, 1u)))));
+	const auto spacing = 4.f;
+
+	for (unsigned i = 0; i < num_obstacles; ++i) {
+		const auto angle = 0.7f * i;
+
+		b2BodyDef def;
+		def.type = b2_staticBody;
+		def.transform.Set(b2Vec2((i % side) * spacing, (i / side) * spacing), angle);
+		def.sweep = {};
+		def.sweep.c0 = def.sweep.c = def.transform.p;
+		def.sweep.a0 = def.sweep.a = angle;
+
+		b2PolygonShape wall;
+		wall.SetAsBox(0.5f + (i % 3) * 0.5f, 0.25f);
+
+		world.CreateBody(&def)->CreateFixture(&wall, 0.f);
+	}
+
+	const auto num_characters = 64u;
+
+	for (unsigned i = 0; i < num_characters; ++i) {
+		b2BodyDef def;
+		def.type = b2_dynamicBody;
+		def.transform.Set(b2Vec2(((i * 7) % side) * spacing + spacing / 2, ((i * 13) % side) * spacing + spacing / 2), 0.f);
+		def.sweep = {};
+		def.sweep.c0 = def.sweep.c = def.transform.p;
+		def.sweep.a0 = def.sweep.a = 0.f;
+
+		b2CircleShape character;
+		character.m_radius = 0.5f;
+
+		world.CreateBody(&def)->CreateFixture(&character, 1.f);
+	}
+
+	world.UpdateStaticTree();
+
+	return side * spacing;
+}
+
+ray_cast_benchmark_result benchmark_ray_casts(const unsigned num_obstacles, const unsigned num_rays) {
+	using clock_type = std::chrono::steady_clock;
+
+	const auto secs_since = [](const clock_type::time_point started) {
+		return std::chrono::duration<double>(clock_type::now() - started).count();
+	};
+
+	const auto filter = b2Filter();
+
+	ray_cast_benchmark_result result;
+
+	{
+		/*
+			Just like inferring the physics of a cosmos anew,
+			including the build of the tree of the static proxies.
+		*/
+
+		const auto started = clock_type::now();
+
+		for (unsigned r = 0; r < result.num_reinferences; ++r) {
+			physics_world_cache physics;
+			make_benchmark_arena(*physics.b2world, num_obstacles);
+			physics.ray_cast(vec2(0, 0), vec2(1, 1), filter);
+		}
+
+		result.reinference_secs = secs_since(started);
+	}
+
+	physics_world_cache physics;
+	const auto extent = make_benchmark_arena(*physics.b2world, num_obstacles);
+
+	physics_world_cache cloned;
+
+	{
+		/* Just like a re-prediction. */
+
+		const auto started = clock_type::now();
+
+		for (unsigned r = 0; r < result.num_clones; ++r) {
+			cloned.clone_world_from(physics);
+		}
+
+		result.clone_secs = secs_since(started);
+	}
+
+	/* A fan of rays from the center, much like what the visibility system casts for a single eye. */
+
+	const auto center = vec2(extent, extent) / 2;
+
+	std::vector<physics_raycast_input> rays;
+
+	for (unsigned i = 0; i < num_rays; ++i) {
+		const auto target = center + vec2::from_degrees((360.f / num_rays) * i) * extent;
+		rays.push_back({ center, target });
+	}
+
+	std::vector<physics_raycast_output> single_outputs;
+	std::vector<physics_raycast_output> batched_outputs;
+
+	const auto repetitions = 100u;
+
+	{
+		const auto started = clock_type::now();
+
+		for (unsigned r = 0; r < repetitions; ++r) {
+			single_outputs.clear();
+
+			for (const auto& ray : rays) {
+				single_outputs.push_back(physics.ray_cast(ray.from, ray.to, filter));
+			}
+		}
+
+		result.single_secs = secs_since(started);
+	}
+
+	{
+		/* Cast through the clone, so that the mismatches account for cloning too. */
+
+		const auto started = clock_type::now();
+
+		for (unsigned r = 0; r < repetitions; ++r) {
+			cloned.ray_cast_batch(rays, batched_outputs, filter);
+		}
+
+		result.batched_secs = secs_since(started);
+	}
+
+	result.num_rays = static_cast<std::size_t>(num_rays) * repetitions;
+
+	for (std::size_t i = 0; i < rays.size(); ++i) {
+		const auto& a = single_outputs[i];
+		const auto& b = batched_outputs[i];
+
+		if (a.hit != b.hit || a.intersection != b.intersection || a.normal != b.normal) {
+			++result.num_mismatches;
+		}
+	}
+
+	return result;
+}
+
+#if BUILD_UNIT_TESTS
+#include <Catch/single_include/catch2/catch.hpp>
+
+TEST_CASE("PhysicsQueries BatchedRayCast") {
+	physics_world_cache physics;
+	auto& world = *physics.b2world;
+
+	for (int i = 0; i < 50; ++i) {
+		const auto angle = 0.4f * i;
+
+		b2BodyDef def;
+		def.type = i % 2 ? b2_dynamicBody : b2_staticBody;
+		def.transform.Set(b2Vec2(static_cast<float32>((i * 7) % 23) - 11.f, static_cast<float32>((i * 5) % 19) - 9.f), angle);
+		def.sweep = {};
+		def.sweep.c0 = def.sweep.c = def.transform.p;
+		def.sweep.a0 = def.sweep.a = angle;
+
+		auto* const body = world.CreateBody(&def);
+
+		if (i % 3 == 0) {
+			b2CircleShape circle;
+			circle.m_radius = 0.6f;
+			body->CreateFixture(&circle, 1.f);
+		}
+		else {
+			b2PolygonShape box;
+			box.SetAsBox(1.f, 0.3f);
+			body->CreateFixture(&box, 1.f);
+		}
+	}
+
+	std::vector<physics_raycast_input> rays;
+
+	for (int i = 0; i < 360; ++i) {
+		const auto from = vec2(static_cast<float>(i % 5) - 2.f, 0.5f);
+		rays.push_back({ from, from + vec2::from_degrees(static_cast<float>(i)) * 30.f });
+	}
+
+	/* A degenerate one in between. */
+	rays.push_back({ vec2(1.f, 1.f), vec2(1.f, 1.f) });
+
+	world.UpdateStaticTree();
+
+	std::vector<physics_raycast_output> outputs;
+	physics.ray_cast_batch(rays, outputs, b2Filter());
+
+	REQUIRE(outputs.size() == rays.size());
+
+	std::size_t num_hits = 0;
+
+	for (std::size_t i = 0; i < rays.size(); ++i) {
+		const auto expected = physics.ray_cast(rays[i].from, rays[i].to, b2Filter());
+
+		REQUIRE(outputs[i].hit == expected.hit);
+		REQUIRE(outputs[i].intersection == expected.intersection);
+		REQUIRE(outputs[i].normal == expected.normal);
+
+		num_hits += expected.hit;
+	}
+
+	REQUIRE(num_hits > 0);
+	REQUIRE(!outputs.back().hit);
+}
+
+TEST_CASE("PhysicsQueries ClonedStaticGeometry") {
+	physics_world_cache source;
+	make_benchmark_arena(*source.b2world, 100);
+
+	physics_world_cache cloned;
+	cloned.clone_world_from(source);
+
+	const auto& source_static = source.b2world->GetContactManager().m_broadPhase.GetStaticTree();
+	const auto& cloned_static = cloned.b2world->GetContactManager().m_broadPhase.GetStaticTree();
+
+	REQUIRE(source_static.GetNodeCount() == 2 * 100 - 1);
+	REQUIRE(&source_static == &cloned_static);
+
+	const auto from = vec2(-5.f, 19.f);
+	const auto to = vec2(60.f, 21.f);
+
+	const auto source_hit = source.ray_cast(from, to, b2Filter());
+	REQUIRE(source_hit.hit);
+
+	{
+		const auto cloned_hit = cloned.ray_cast(from, to, b2Filter());
+
+		REQUIRE(cloned_hit.hit);
+		REQUIRE(cloned_hit.intersection == source_hit.intersection);
+	}
+
+	{
+		/* A new wall right at the start of the ray, only in the clone. */
+
+		b2BodyDef def;
+		def.type = b2_staticBody;
+		def.transform.Set(b2Vec2(-4.f, 19.f), 0.f);
+		def.sweep = {};
+		def.sweep.c0 = def.sweep.c = def.transform.p;
+
+		b2PolygonShape wall;
+		wall.SetAsBox(0.25f, 2.f);
+
+		cloned.b2world->CreateBody(&def)->CreateFixture(&wall, 0.f);
+		cloned.b2world->UpdateStaticTree();
+
+		const auto cloned_hit = cloned.ray_cast(from, to, b2Filter());
+		REQUIRE(cloned_hit.hit);
+		REQUIRE(cloned_hit.intersection.x < -3.f);
+
+		REQUIRE(&source.b2world->GetContactManager().m_broadPhase.GetStaticTree() == &source_static);
+		REQUIRE(source.ray_cast(from, to, b2Filter()).intersection == source_hit.intersection);
+	}
+}
+#endif
@@ -6,6 +6,7 @@
 
 #include "game/cosmos/cosmos.h"
 #include "game/cosmos/entity_handle.h"
+#include "game/cosmos/for_each_entity.h"
 #include "game/components/render_component.h"
 
 #include "game/enums/filters.h"
@@ -152,6 +153,23 @@ void visible_entities::acquire_physical(const visible_entities_query input) {
 			}
 		);
 	}
+
+	/* 
+		Missiles have no fixtures since they are swept with rays (see missile_system::sweep_missiles_through_world),
+		so the physics tree never reports them.
+	*/
+
+	const auto camera_aabb = camera.get_visible_world_rect_aabb();
+
+	cosm.for_each_having<invariants::missile>(
+		[&](const auto& typed_missile) {
+			if (const auto aabb = typed_missile.find_aabb()) {
+				if (camera_aabb.hover(*aabb) && ::passes_filter(input.filter, typed_missile)) {
+					register_unique(typed_missile.get_id());
+				}
+			}
+		}
+	);
 }
 
 void visible_entities::acquire_non_physical(const visible_entities_query input) {
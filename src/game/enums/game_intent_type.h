@@ -1,6 +1,7 @@
 #pragma once
 #include <vector>
 #include "augs/misc/enum/enum_map.h"
+#include "augs/misc/constant_size_vector.h"
 
 #include "augs/misc/basic_input_intent.h"
 #include "augs/misc/basic_input_motion.h"
@@ -67,6 +68,11 @@ using game_intent_map = augs::enum_map<
 using game_intent = basic_input_intent<game_intent_type>;
 using game_intents = std::vector<game_intent>;
 
+/* Bounded by what a single step of the network protocol is able to carry. */
+constexpr std::size_t max_game_intents_per_step_v = 64;
+
+using step_game_intents = augs::constant_size_vector<game_intent, max_game_intents_per_step_v>;
+
 using game_motion = basic_input_motion<game_motion_type, vec2>;
 
 using raw_game_motion = basic_input_motion<game_motion_type, basic_vec2<short>>;
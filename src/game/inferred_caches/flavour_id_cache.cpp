@@ -3,6 +3,18 @@
 #include "game/inferred_caches/flavour_id_cache.hpp"
 #include "game/cosmos/cosmos.h"
 #include "game/cosmos/for_each_entity.h"
+#include "game/organization/for_each_entity_type.h"
+
+flavour_id_cache& flavour_id_cache::operator=(const flavour_id_cache& b) {
+	for_each_entity_type([&](auto e) {
+		using E = decltype(e);
+
+		assign_reusing_mapped(caches.get_for<E>(), b.caches.get_for<E>());
+	});
+
+	enabled = b.enabled;
+	return *this;
+}
 
 void flavour_id_cache::infer_all(const cosmos& cosm) {
 	if (!enabled) {
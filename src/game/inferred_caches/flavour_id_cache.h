@@ -27,6 +27,14 @@ public:
 		static constexpr bool value = true;
 	};
 
+	flavour_id_cache() = default;
+	flavour_id_cache(const flavour_id_cache&) = default;
+	flavour_id_cache(flavour_id_cache&&) = default;
+	flavour_id_cache& operator=(flavour_id_cache&&) = default;
+
+	/* Assigns to the sets that already exist so that they keep their buckets. */
+	flavour_id_cache& operator=(const flavour_id_cache&);
+
 	template <class E>
 	const auto& get_entities_by_flavour_id(const typed_entity_flavour_id<E> id) const {
 		thread_local const std::unordered_set<typed_entity_id<E>> detail_none;
@@ -0,0 +1,413 @@
+#include <algorithm>
+
+#include "3rdparty/Box2D/Box2D.h"
+#include "augs/misc/measurements.h"
+#include "game/enums/filters.h"
+#include "game/cosmos/cosmos.h"
+#include "game/cosmos/entity_handle.h"
+#include "game/inferred_caches/navigation_cache.hpp"
+
+void navigation_cache::invalidate() {
+	grid.reset();
+	flow_fields.clear();
+}
+
+void navigation_cache::infer_all(const cosmos&) {
+	invalidate();
+}
+
+void navigation_cache::infer_cache_for(const const_entity_handle& handle) {
+	handle.conditional_dispatch<entity_types_passing<concerned_with>>([this](const auto& typed_handle) {
+		specific_infer_cache_for(typed_handle);
+	});
+}
+
+void navigation_cache::destroy_cache_of(const const_entity_handle& handle) {
+	handle.conditional_dispatch<entity_types_passing<concerned_with>>([this](const auto& typed_handle) {
+		if (::is_navigation_obstacle(typed_handle)) {
+			invalidate();
+		}
+	});
+}
+
+void navigation_cache::assign_grid(std::shared_ptr<const navigation_grid> new_grid) {
+	grid = std::move(new_grid);
+	flow_fields.clear();
+}
+
+void navigation_cache::rasterize_if_needed(const cosmos& cosm) {
+	if (grid == nullptr) {
+		auto scope = measure_scope(cosm.profiler.navigation_rasterization);
+
+		auto new_grid = std::make_shared<navigation_grid>();
+
+		new_grid->rasterize(
+			cosm.get_solvable_inferred().physics.get_b2world(),
+			cosm.get_si(),
+			predefined_queries::pathfinding(),
+			navigation_agent_radius_v
+		);
+
+		assign_grid(std::move(new_grid));
+	}
+}
+
+bool navigation_cache::is_flow_field_cached(const vec2i target) const {
+	return std::any_of(
+		flow_fields.begin(),
+		flow_fields.end(),
+		[target](const auto& cached) { return cached.target == target; }
+	);
+}
+
+std::shared_ptr<const navigation_flow_field> navigation_cache::get_flow_field(const navigation_grid& for_grid, const vec2i target) {
+	++num_uses;
+
+	for (auto& cached : flow_fields) {
+		if (cached.target == target) {
+			cached.last_used = num_uses;
+			return cached.field;
+		}
+	}
+
+	auto new_field = std::make_shared<navigation_flow_field>();
+	new_field->build(for_grid, target);
+
+	cached_flow_field entry;
+	entry.target = target;
+	entry.last_used = num_uses;
+	entry.field = new_field;
+
+	if (flow_fields.size() < max_cached_flow_fields_v) {
+		flow_fields.emplace_back(std::move(entry));
+	}
+	else {
+		auto& least_recent = *std::min_element(
+			flow_fields.begin(),
+			flow_fields.end(),
+			[](const auto& a, const auto& b) { return a.last_used < b.last_used; }
+		);
+
+		least_recent = std::move(entry);
+	}
+
+	return new_field;
+}
+
+void navigation_cache::find_paths(
+	const cosmos& cosm,
+	const std::vector<navigation_query>& queries,
+	std::vector<navigation_path>& results
+) {
+	rasterize_if_needed(cosm);
+
+	auto scope = measure_scope(cosm.profiler.path_query_batches);
+	cosm.profiler.path_queries.measure(queries.size());
+
+	find_paths(queries, results);
+}
+
+void navigation_cache::find_paths(
+	const std::vector<navigation_query>& queries,
+	std::vector<navigation_path>& results
+) {
+	struct resolved_query {
+		std::size_t index;
+		vec2i start;
+		vec2i goal;
+		navigation_cell_index goal_index;
+	};
+
+	thread_local std::vector<resolved_query> resolved;
+	thread_local std::vector<vec2i> cells;
+
+	resolved.clear();
+	results.resize(queries.size());
+
+	for (auto& result : results) {
+		result.waypoints.clear();
+		result.found = false;
+	}
+
+	if (grid == nullptr) {
+		return;
+	}
+
+	const auto& used_grid = grid;
+
+	for (std::size_t i = 0; i < queries.size(); ++i) {
+		const auto start = used_grid->find_walkable_near(queries[i].from);
+		const auto goal = used_grid->find_walkable_near(queries[i].to);
+
+		if (start && goal) {
+			resolved.push_back({ i, *start, *goal, used_grid->index_of(*goal) });
+		}
+	}
+
+	/*
+		Stable, so that the queries toward a single cell are answered in the order they were given.
+		Although the results don't depend on that order anyway.
+	*/
+
+	std::stable_sort(
+		resolved.begin(),
+		resolved.end(),
+		[](const auto& a, const auto& b) { return a.goal_index < b.goal_index; }
+	);
+
+	auto write_result = [&](const resolved_query& q) {
+		if (cells.empty()) {
+			return;
+		}
+
+		auto& result = results[q.index];
+		const auto to = queries[q.index].to;
+
+		result.found = true;
+
+		for (std::size_t c = 1; c < cells.size(); ++c) {
+			result.waypoints.push_back(used_grid->get_cell_center(cells[c]));
+		}
+
+		const auto to_cell = used_grid->find_cell_at_world(to);
+
+		if (to_cell && *to_cell == q.goal) {
+			/* The destination itself is walkable, so go all the way there instead of stopping at the center of its cell. */
+
+			if (result.waypoints.empty()) {
+				result.waypoints.push_back(to);
+			}
+			else {
+				result.waypoints.back() = to;
+			}
+		}
+		else if (result.waypoints.empty()) {
+			result.waypoints.push_back(used_grid->get_cell_center(q.goal));
+		}
+	};
+
+	for (std::size_t group_begin = 0; group_begin < resolved.size();) {
+		auto group_end = group_begin + 1;
+
+		while (group_end < resolved.size() && resolved[group_end].goal_index == resolved[group_begin].goal_index) {
+			++group_end;
+		}
+
+		/*
+			A lone query is cheaper to answer with A* than with a whole flow field.
+			This decision must never depend on whether the flow field happens to be cached already:
+			A* and the flow field may find different paths of equal cost.
+		*/
+
+		if (group_end - group_begin > 1) {
+			const auto field = get_flow_field(*used_grid, resolved[group_begin].goal);
+
+			for (auto q = group_begin; q < group_end; ++q) {
+				::follow_flow_field(*used_grid, *field, resolved[q].start, cells);
+				write_result(resolved[q]);
+			}
+		}
+		else {
+			::find_grid_path(*used_grid, resolved[group_begin].start, resolved[group_begin].goal, cells);
+			write_result(resolved[group_begin]);
+		}
+
+		group_begin = group_end;
+	}
+}
+
+navigation_path navigation_cache::find_path(const cosmos& cosm, const vec2 from, const vec2 to) {
+	thread_local std::vector<navigation_query> queries;
+	thread_local std::vector<navigation_path> results;
+
+	queries.assign(1, navigation_query { from, to });
+	find_paths(cosm, queries, results);
+
+	return results[0];
+}
+
+#if BUILD_UNIT_TESTS
+#include <Catch/single_include/catch2/catch.hpp>
+
+static std::shared_ptr<const navigation_grid> make_open_test_grid(const vec2i size, const std::vector<vec2i>& blocked = {}) {
+	auto grid = std::make_shared<navigation_grid>();
+	grid->size = size;
+	grid->blocked.assign(static_cast<std::size_t>(size.area()), 0);
+
+	for (const auto& b : blocked) {
+		grid->blocked[grid->index_of(b)] = 1;
+	}
+
+	return grid;
+}
+
+TEST_CASE("NavigationCache UnreachableGoal") {
+	std::vector<vec2i> wall;
+
+	for (int y = 0; y < 12; ++y) {
+		wall.push_back({ 6, y });
+	}
+
+	const auto grid = make_open_test_grid({ 12, 12 }, wall);
+
+	navigation_cache cache;
+	cache.assign_grid(grid);
+
+	const auto left = grid->get_cell_center({ 1, 5 });
+	const auto right = grid->get_cell_center({ 10, 5 });
+	const auto far_outside = vec2(-1000.f, -1000.f);
+
+	const std::vector<navigation_query> queries = {
+		/* A lone query, answered by A*. */
+		{ left, right },
+
+		/* Two toward the same cell, answered by a flow field. */
+		{ left, grid->get_cell_center({ 8, 8 }) },
+		{ grid->get_cell_center({ 2, 2 }), grid->get_cell_center({ 8, 8 }) },
+
+		/* Nowhere near the grid. */
+		{ left, far_outside },
+
+		/* Reachable, to tell the above apart from not answering at all. */
+		{ left, grid->get_cell_center({ 1, 10 }) }
+	};
+
+	std::vector<navigation_path> results;
+	cache.find_paths(queries, results);
+
+	REQUIRE(results.size() == queries.size());
+
+	for (std::size_t i = 0; i < 4; ++i) {
+		REQUIRE_FALSE(results[i].found);
+		REQUIRE(results[i].waypoints.empty());
+	}
+
+	REQUIRE(results[4].found);
+	REQUIRE(results[4].waypoints.back() == queries[4].to);
+
+	/* Without a grid, nothing is found. */
+
+	navigation_cache empty;
+	empty.find_paths(queries, results);
+
+	for (const auto& r : results) {
+		REQUIRE_FALSE(r.found);
+	}
+}
+
+TEST_CASE("NavigationCache EvictsLeastRecentlyUsed") {
+	const auto grid = make_open_test_grid({ 32, 8 });
+
+	navigation_cache cache;
+	cache.assign_grid(grid);
+
+	std::vector<navigation_path> results;
+
+	auto query_twice_toward = [&](const int x) {
+		const auto target = grid->get_cell_center({ x, 0 });
+
+		const std::vector<navigation_query> queries = {
+			{ grid->get_cell_center({ x, 7 }), target },
+			{ grid->get_cell_center({ 31 - x, 7 }), target }
+		};
+
+		cache.find_paths(queries, results);
+
+		REQUIRE(results[0].found);
+		REQUIRE(results[1].found);
+	};
+
+	for (int x = 0; x < static_cast<int>(max_cached_flow_fields_v); ++x) {
+		query_twice_toward(x);
+	}
+
+	REQUIRE(cache.get_num_cached_flow_fields() == max_cached_flow_fields_v);
+
+	/* Makes the second one the least recently used. */
+	query_twice_toward(0);
+
+	query_twice_toward(static_cast<int>(max_cached_flow_fields_v));
+
+	REQUIRE(cache.get_num_cached_flow_fields() == max_cached_flow_fields_v);
+	REQUIRE(cache.is_flow_field_cached({ 0, 0 }));
+	REQUIRE_FALSE(cache.is_flow_field_cached({ 1, 0 }));
+	REQUIRE(cache.is_flow_field_cached({ 2, 0 }));
+	REQUIRE(cache.is_flow_field_cached({ static_cast<int>(max_cached_flow_fields_v), 0 }));
+
+	/* A new grid makes the fields worthless. */
+
+	cache.assign_grid(make_open_test_grid({ 32, 8 }));
+	REQUIRE(cache.get_num_cached_flow_fields() == 0);
+}
+
+TEST_CASE("NavigationCache SameAnswersRegardlessOfCache") {
+	/* Pillars make for many paths of equal cost, which A* and a flow field could choose between differently. */
+
+	std::vector<vec2i> pillars;
+
+	for (int y = 2; y < 14; y += 3) {
+		for (int x = 2; x < 22; x += 3) {
+			pillars.push_back({ x, y });
+		}
+	}
+
+	const auto grid = make_open_test_grid({ 24, 16 }, pillars);
+
+	auto at = [&](const int x, const int y) {
+		return grid->get_cell_center({ x, y });
+	};
+
+	const std::vector<navigation_query> batch = {
+		{ at(0, 0), at(23, 15) },
+		{ at(23, 0), at(0, 15) },
+		{ at(1, 14), at(12, 1) },
+		{ at(22, 1), at(12, 1) },
+		{ at(11, 8), at(12, 1) }
+	};
+
+	navigation_cache fresh;
+	fresh.assign_grid(grid);
+
+	std::vector<navigation_path> fresh_results;
+	fresh.find_paths(batch, fresh_results);
+
+	/* Lone queries are answered by A* and leave no flow field behind. */
+
+	REQUIRE(fresh.get_num_cached_flow_fields() == 1);
+	REQUIRE(fresh.is_flow_field_cached({ 12, 1 }));
+
+	navigation_cache warmed;
+	warmed.assign_grid(grid);
+
+	{
+		/* Flow fields toward the destinations of the lone queries as well. */
+
+		const std::vector<navigation_query> warming = {
+			{ at(5, 5), at(23, 15) },
+			{ at(6, 6), at(23, 15) },
+			{ at(5, 5), at(0, 15) },
+			{ at(6, 6), at(0, 15) }
+		};
+
+		std::vector<navigation_path> warming_results;
+		warmed.find_paths(warming, warming_results);
+
+		REQUIRE(warmed.is_flow_field_cached({ 23, 15 }));
+		REQUIRE(warmed.is_flow_field_cached({ 0, 15 }));
+	}
+
+	std::vector<navigation_path> warmed_results;
+
+	for (int repetition = 0; repetition < 2; ++repetition) {
+		warmed.find_paths(batch, warmed_results);
+
+		REQUIRE(warmed_results.size() == fresh_results.size());
+
+		for (std::size_t i = 0; i < batch.size(); ++i) {
+			REQUIRE(fresh_results[i].found);
+			REQUIRE(warmed_results[i].found == fresh_results[i].found);
+			REQUIRE(warmed_results[i].waypoints == fresh_results[i].waypoints);
+		}
+	}
+}
+#endif
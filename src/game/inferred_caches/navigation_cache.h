@@ -0,0 +1,83 @@
+#pragma once
+#include <memory>
+#include <vector>
+
+#include "augs/math/vec2.h"
+#include "game/cosmos/entity_type_traits.h"
+#include "game/cosmos/entity_handle_declaration.h"
+#include "game/detail/navigation/navigation_grid.h"
+
+class cosmos;
+
+struct navigation_query {
+	vec2 from;
+	vec2 to;
+};
+
+struct navigation_path {
+	/* From the first corner to the destination itself. Empty if the destination can't be reached. */
+	std::vector<vec2> waypoints;
+	bool found = false;
+};
+
+/*
+	The navigation grid of the arena, rasterized from the static physics world on the first query after any static body changed.
+
+	Queries toward the same cell within a single call to find_paths share a flow field,
+	which is then kept for later steps among the max_cached_flow_fields_v most recently used ones.
+	Whether a query is answered by A* or by a flow field depends only on the queries passed together,
+	never on what happens to be cached, so every machine arrives at the same paths.
+
+	The grid and the flow fields are immutable once built and only shared between copies of the cache,
+	so copying the cosmos for a re-prediction doesn't copy them.
+*/
+
+constexpr std::size_t max_cached_flow_fields_v = 16;
+
+class navigation_cache {
+	struct cached_flow_field {
+		vec2i target;
+		uint32_t last_used = 0;
+		std::shared_ptr<const navigation_flow_field> field;
+	};
+
+	std::shared_ptr<const navigation_grid> grid;
+	std::vector<cached_flow_field> flow_fields;
+	uint32_t num_uses = 0;
+
+	void rasterize_if_needed(const cosmos&);
+	std::shared_ptr<const navigation_flow_field> get_flow_field(const navigation_grid&, vec2i target);
+
+public:
+	template <class E>
+	struct concerned_with {
+		static constexpr bool value = has_all_of_v<E, invariants::rigid_body, invariants::fixtures>;
+	};
+
+	void infer_all(const cosmos&);
+
+	template <class E>
+	void specific_infer_cache_for(const E&);
+
+	void infer_cache_for(const const_entity_handle&);
+	void destroy_cache_of(const const_entity_handle&);
+
+	/* The grid will be rasterized anew on the next query. */
+	void invalidate();
+
+	/* Replaces the grid with one that was built elsewhere, dropping the flow fields built on the previous one. */
+	void assign_grid(std::shared_ptr<const navigation_grid>);
+
+	/* Rasterizes the grid anew first if any static body changed since the last query. */
+	void find_paths(const cosmos&, const std::vector<navigation_query>& queries, std::vector<navigation_path>& results);
+	navigation_path find_path(const cosmos&, vec2 from, vec2 to);
+
+	/* On the grid as it is now. Nothing is found if there is no grid. */
+	void find_paths(const std::vector<navigation_query>& queries, std::vector<navigation_path>& results);
+
+	std::size_t get_num_cached_flow_fields() const {
+		return flow_fields.size();
+	}
+
+	bool is_flow_field_cached(vec2i target) const;
+};
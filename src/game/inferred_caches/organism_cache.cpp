@@ -17,6 +17,16 @@ void organism_cache::erase_organism(const organism_id_type id) {
 	}
 }
 
+organism_cache& organism_cache::operator=(const organism_cache& b) {
+	/* 
+		The order of grids does not matter - 
+		they are only ever looked up by their origin or iterated for rendering.
+	*/
+
+	assign_reusing_mapped(grids, b.grids);
+	return *this;
+}
+
 void organism_cache::grid::clear() {
 	aabb = {};
 
@@ -74,6 +74,14 @@ public:
 		;
 	};	
 
+	organism_cache() = default;
+	organism_cache(const organism_cache&) = default;
+	organism_cache(organism_cache&&) = default;
+	organism_cache& operator=(organism_cache&&) = default;
+
+	/* Assigns to the grids that already exist so that their cells keep their capacity. */
+	organism_cache& operator=(const organism_cache&);
+
 	void reserve_caches_for_entities(const size_t n);
 
 	void infer_all(const cosmos&);
@@ -93,6 +101,9 @@ public:
 	template <class F>
 	void for_each_cell_of_all_grids(const ltrb query, F&& callback) const;
 
+	template <class F>
+	void for_each_grid(F&& callback) const;
+
 	bool recalculate_cell_for(const unversioned_entity_id origin, const organism_id_type organism_id, vec2 old_position, vec2 new_position);
 
 	const grid* find_grid(const unversioned_entity_id) const;
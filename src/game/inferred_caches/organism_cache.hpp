@@ -1,4 +1,5 @@
 #pragma once
+#include "augs/templates/container_templates.h"
 #include "game/enums/marker_type.h"
 #include "game/cosmos/for_each_entity.h"
 #include "game/inferred_caches/is_organism.h"
@@ -36,7 +37,16 @@ bool organism_cache::assign_to_grid(const E& organism) {
 		const auto p = t->pos;
 
 		auto& cell = grid.get_cell_at_world(p);
-		cell.organisms.emplace_back(organism.get_id());
+		const auto id = organism_id_type(organism.get_id());
+
+		/*
+			The organism might already be there if its area was recalculated first,
+			e.g. when both were reinferred by cosmic::reinfer_dirty_entities.
+		*/
+
+		if (!found_in(cell.organisms, id)) {
+			cell.organisms.emplace_back(id);
+		}
 
 		return true;
 	}
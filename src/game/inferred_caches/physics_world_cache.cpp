@@ -108,12 +108,14 @@ void physics_world_cache::destroy_joint_cache(const entity_handle& handle) {
 void physics_world_cache::destroy_rigid_body_cache(const entity_handle& handle) {
 	if (auto cache = find_rigid_body_cache(handle)) {
 		cache->clear(handle.get_cosmos(), *this);
+		b2world->UpdateStaticTree();
 	}
 }
 
 void physics_world_cache::destroy_colliders_cache(const entity_handle& handle) {
 	if (auto cache = find_colliders_cache(handle)) {
 		cache->clear(*this);
+		b2world->UpdateStaticTree();
 	}
 }
 
@@ -131,18 +133,24 @@ void physics_world_cache::infer_cache_for(const entity_handle& handle) {
 			specific_infer_cache_for(typed_handle);
 		}
 	);
+
+	b2world->UpdateStaticTree();
 }
 
 void physics_world_cache::infer_colliders(const entity_handle& handle) {
 	handle.dispatch_on_having_all<invariants::fixtures>([this](const auto& typed_handle) {
 		specific_infer_colliders(typed_handle);
 	});
+
+	b2world->UpdateStaticTree();
 }
 
 void physics_world_cache::infer_rigid_body(const entity_handle& handle) {
 	handle.dispatch_on_having_all<invariants::rigid_body>([this](const auto& typed_handle) {
 		specific_infer_rigid_body(typed_handle);
 	});
+
+	b2world->UpdateStaticTree();
 }
 
 #if TODO_JOINTS
@@ -155,6 +163,8 @@ void physics_world_cache::infer_colliders_from_scratch(const entity_handle& hand
 		const auto connection = typed_handle.calc_colliders_connection();
 		specific_infer_colliders_from_scratch(typed_handle, connection);
 	});
+
+	b2world->UpdateStaticTree();
 }
 
 void physics_world_cache::infer_all(cosmos& cosm) {
@@ -166,6 +176,8 @@ void physics_world_cache::infer_all(cosmos& cosm) {
 		const auto connection = typed_handle.calc_colliders_connection();
 		specific_infer_colliders_from_scratch(typed_handle, connection);
 	});
+
+	b2world->UpdateStaticTree();
 }
 
 void physics_world_cache::reserve_caches_for_entities(const std::size_t n) {
@@ -205,15 +217,21 @@ physics_world_cache& physics_world_cache::operator=(const physics_world_cache&)
 	return *this;
 }
 
-void physics_world_cache::clone_from(const physics_world_cache& source_cache, cosmos& target_cosm, const cosmos& source_cosm) {
-	ensure(std::addressof(target_cosm) != std::addressof(source_cosm));
+void physics_world_cache::clone_world_from(const physics_world_cache& source_cache) {
 	ensure(this != std::addressof(source_cache));
 
 	accumulated_messages = source_cache.accumulated_messages;
 
 	b2World& migrated_b2World = *b2world.get();
-	migrated_b2World.~b2World();
-	new (&migrated_b2World) b2World(b2Vec2(0.f, 0.f));
+
+	/*
+		Instead of destroying and constructing the world anew,
+		keep the chunks of its block allocator as well as the buffers of its broadphase.
+		Re-predictions clone worlds of roughly the same size every time,
+		so after the first few clones there is almost nothing left to allocate.
+	*/
+
+	migrated_b2World.ClearKeepingMemory();
 
 	const b2World& source_b2World = *source_cache.b2world.get();
 
@@ -255,9 +273,13 @@ void physics_world_cache::clone_from(const physics_world_cache& source_cache, co
 	migrated_b2World.m_contactManager.m_contactFilter = &migrated_b2World.defaultFilter;
 	migrated_b2World.m_contactManager.m_contactListener = &migrated_b2World.defaultListener;
 
-	std::unordered_map<const void*, void*> pointer_migrations;
-	std::unordered_map<const void*, bool> contact_edge_a_or_b_in_contacts;
-	std::unordered_map<const void*, bool> joint_edge_a_or_b_in_joints;
+	auto& pointer_migrations = scratch.pointer_migrations;
+	auto& contact_edge_a_or_b_in_contacts = scratch.contact_edge_a_or_b_in_contacts;
+	auto& joint_edge_a_or_b_in_joints = scratch.joint_edge_a_or_b_in_joints;
+
+	pointer_migrations.clear();
+	contact_edge_a_or_b_in_contacts.clear();
+	joint_edge_a_or_b_in_joints.clear();
 
 	b2BlockAllocator& migrated_allocator = migrated_b2World.m_blockAllocator;
 
@@ -296,8 +318,8 @@ void physics_world_cache::clone_from(const physics_world_cache& source_cache, co
 		}
 
 		if (
-			auto maybe_already_migrated = pointer_migrations.find(void_ptr);
-			maybe_already_migrated == pointer_migrations.end()
+			const auto maybe_already_migrated = pointer_migrations.find(void_ptr);
+			maybe_already_migrated == nullptr
 		) {
 			const auto bytes_count = std::size_t{ sizeof(type) * count };
 
@@ -306,15 +328,12 @@ void physics_world_cache::clone_from(const physics_world_cache& source_cache, co
 			
 			/* Bookmark position in memory of each and every element */
 
-			pointer_migrations.insert(std::make_pair(
-				void_ptr, 
-				migrated_pointer
-			));
+			pointer_migrations.insert(void_ptr, migrated_pointer);
 			
 			pointer_to_be_migrated = reinterpret_cast<type*>(migrated_pointer);
 		}
 		else {
-			pointer_to_be_migrated = reinterpret_cast<type*>((*maybe_already_migrated).second);
+			pointer_to_be_migrated = reinterpret_cast<type*>(*maybe_already_migrated);
 		}
 	};
 
@@ -351,8 +370,8 @@ void physics_world_cache::clone_from(const physics_world_cache& source_cache, co
 	// make a map of pointers to b2ContactEdges to their respective offsets in
 	// the b2Contacts that own them
 	for (b2Contact* c = migrated_b2World.m_contactManager.m_contactList; c; c = c->m_next) {
-		contact_edge_a_or_b_in_contacts.insert(std::make_pair(&c->m_nodeA, false));
-		contact_edge_a_or_b_in_contacts.insert(std::make_pair(&c->m_nodeB, true));
+		contact_edge_a_or_b_in_contacts.insert(&c->m_nodeA, false);
+		contact_edge_a_or_b_in_contacts.insert(&c->m_nodeB, true);
 	}
 
 	// migrate contact pointers
@@ -441,8 +460,8 @@ void physics_world_cache::clone_from(const physics_world_cache& source_cache, co
 	// make a map of pointers to b2JointEdges to their respective offsets in
 	// the b2Joints that own them
 	for (b2Joint* j = migrated_b2World.m_jointList; j; j = j->m_next) {
-		joint_edge_a_or_b_in_joints.insert(std::make_pair(&j->m_edgeA, false));
-		joint_edge_a_or_b_in_joints.insert(std::make_pair(&j->m_edgeB, true));
+		joint_edge_a_or_b_in_joints.insert(&j->m_edgeA, false);
+		joint_edge_a_or_b_in_joints.insert(&j->m_edgeB, true);
 	}
 
 	// migrate joint pointers
@@ -470,7 +489,7 @@ void physics_world_cache::clone_from(const physics_world_cache& source_cache, co
 		migrate_joint_edge(c->m_edgeB.prev);
 	}
 
-	auto& proxy_tree = migrated_b2World.m_contactManager.m_broadPhase.m_tree;
+	auto& broad_phase = migrated_b2World.m_contactManager.m_broadPhase;
 
 	// migrate bodies and fixtures
 	migrate_pointer(migrated_b2World.m_bodyList);
@@ -505,27 +524,54 @@ void physics_world_cache::clone_from(const physics_world_cache& source_cache, co
 					thus its value should already be found in the pointer map. 
 				*/
 
-				ensure(pointer_migrations.find(f->m_proxies[i].fixture) != pointer_migrations.end())
+				ensure(pointer_migrations.find(f->m_proxies[i].fixture) != nullptr)
 
 				{
-					const auto ff = pointer_migrations[f->m_proxies[i].fixture];
+					const auto ff = pointer_migrations.at(f->m_proxies[i].fixture);
 					ensure_eq(reinterpret_cast<void*>(f), ff);
 				}
 #endif
 				f->m_proxies[i].fixture = f;
 				
-				void*& ud = proxy_tree.m_nodes[f->m_proxies[i].proxyId].userData;
+				const auto proxy_id = f->m_proxies[i].proxyId;
+
+				void*& ud = 
+					b2BroadPhase::IsStaticProxy(proxy_id) 
+					? broad_phase.m_staticProxies[proxy_id - b2BroadPhase::e_staticProxyBase].userData
+					: broad_phase.m_tree.m_nodes[proxy_id].userData
+				;
+
 				ud = pointer_migrations.at(ud);
 			}
 		}
 	}
 
 	/*
-		There is no need to iterate userdatas of the broadphase's dynamic tree,
+		There is no need to iterate userdatas of the broadphase,
 		as for every existing b2FixtureProxy we have manually migrated the correspondent userdata
 		inside the loop that migrated all bodies and fixtures.
+
+		The tree of the static proxies only refers to them by their ids,
+		so it is shared with the source world as it is.
 	*/
 
+#if DEBUG_PHYSICS_SYSTEM_COPY
+	// ensure that all allocations have been migrated
+
+	ensure_eq(
+		migrated_allocator.m_numAllocatedObjects, 
+		source_b2World.m_blockAllocator.m_numAllocatedObjects
+	);
+#endif
+}
+
+void physics_world_cache::clone_from(const physics_world_cache& source_cache, cosmos& target_cosm, const cosmos& source_cosm) {
+	ensure(std::addressof(target_cosm) != std::addressof(source_cosm));
+
+	clone_world_from(source_cache);
+
+	const auto& pointer_migrations = scratch.pointer_migrations;
+
 	target_cosm.for_each_having<invariants::fixtures>(
 		[&](const auto& typed_collider) {
 			const auto id = typed_collider.get_id();
@@ -580,13 +626,4 @@ void physics_world_cache::clone_from(const physics_world_cache& source_cache, co
 		}
 	}
 #endif
-
-#if DEBUG_PHYSICS_SYSTEM_COPY
-	// ensure that all allocations have been migrated
-
-	ensure_eq(
-		migrated_allocator.m_numAllocatedObjects, 
-		source_b2World.m_blockAllocator.m_numAllocatedObjects
-	);
-#endif
 }
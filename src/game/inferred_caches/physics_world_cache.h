@@ -2,6 +2,7 @@
 #include "3rdparty/Box2D/Dynamics/b2Filter.h"
 #include "augs/misc/constant_size_vector.h"
 #include "augs/templates/propagate_const.h"
+#include "augs/misc/flat_pointer_map.h"
 
 #include "game/cosmos/entity_handle_declaration.h"
 #include "game/cosmos/step_declaration.h"
@@ -39,6 +40,11 @@ struct physics_raycast_output {
 	unversioned_entity_id what_entity;
 };
 
+struct physics_raycast_input {
+	vec2 from;
+	vec2 to;
+};
+
 class physics_world_cache {
 	friend rigid_body_cache;
 	friend colliders_cache;
@@ -54,6 +60,15 @@ class physics_world_cache {
 		const colliders_connection&
 	);
 
+	/* Kept between calls to clone_from so that re-predictions do not allocate them anew. */
+	struct clone_scratch {
+		augs::flat_pointer_map<void*> pointer_migrations;
+		augs::flat_pointer_map<bool> contact_edge_a_or_b_in_contacts;
+		augs::flat_pointer_map<bool> joint_edge_a_or_b_in_joints;
+	};
+
+	clone_scratch scratch;
+
 public:
 	template <class E>
 	struct concerned_with {
@@ -76,6 +91,9 @@ public:
 
 	void clone_from(const physics_world_cache& source_world, cosmos& target_cosmos, const cosmos& source_cosmos);
 
+	/* Only the b2World, without pointing the caches of the entities to its bodies and fixtures. */
+	void clone_world_from(const physics_world_cache& source_world);
+
 	std::vector<physics_raycast_output> ray_cast_all_intersections(
 		const vec2 p1_meters,
 		const vec2 p2_meters, 
@@ -97,6 +115,19 @@ public:
 		const b2Filter filter, 
 		const entity_id ignore_entity = entity_id()
 	) const;
+
+	/*
+		Casts all rays_meters in a single traversal of each of the broadphase trees,
+		testing each node against every ray that still reaches it.
+		Each output is exactly what ray_cast would return for the ray at the same index.
+	*/
+
+	void ray_cast_batch(
+		const std::vector<physics_raycast_input>& rays_meters,
+		std::vector<physics_raycast_output>& outputs,
+		const b2Filter filter, 
+		const entity_id ignore_entity = entity_id()
+	) const;
 	
 	vec2 push_away_from_walls(
 		const si_scaling, 
@@ -214,3 +245,17 @@ public:
 	void specific_infer_joint(const E&);
 #endif
 };
+
+struct ray_cast_benchmark_result {
+	std::size_t num_rays = 0;
+	std::size_t num_mismatches = 0;
+	double single_secs = 0.0;
+	double batched_secs = 0.0;
+
+	unsigned num_reinferences = 10;
+	unsigned num_clones = 100;
+	double reinference_secs = 0.0;
+	double clone_secs = 0.0;
+};
+
+ray_cast_benchmark_result benchmark_ray_casts(unsigned num_obstacles, unsigned num_rays);
@@ -7,6 +7,7 @@
 
 #include "game/detail/explosive/like_explosive.h"
 #include "game/detail/melee/like_melee.h"
+#include "game/detail/missile/is_swept_missile.h"
 #include "game/detail/physics/infer_damping.hpp"
 #include "game/detail/entity_handle_mixins/calc_connection.hpp"
 
@@ -302,6 +303,29 @@ void physics_world_cache::specific_infer_colliders_from_scratch(const E& handle,
 	auto& constructed_fixtures = cache.constructed_fixtures;
 	ensure(constructed_fixtures.empty());
 
+	if constexpr(is_swept_missile_v<E>) {
+		/*
+			The connection alone marks the cache as constructed.
+			Without fixtures Box2D would give the body a unit mass,
+			so set the mass that the rectangular fixture would have had - homing forces depend on it.
+		*/
+
+		auto size = handle.get_logical_size();
+
+		size.x = std::max(1.f, size.x);
+		size.y = std::max(1.f, size.y);
+
+		size = si.get_meters(size);
+
+		b2MassData mass_data;
+		mass_data.mass = fixdef.density * size.x * size.y;
+		mass_data.center.SetZero();
+		mass_data.I = 0.f;
+
+		owner_b2Body.SetMassData(&mass_data);
+		return;
+	}
+
 	auto flips = flip_flags();
 
 	if (const auto overridden_flip = handle.calc_flip_flags()) {
@@ -5,6 +5,7 @@
 #include "game/modes/bomb_defusal.hpp"
 #include "game/modes/mode_entropy.h"
 #include "game/modes/mode_helpers.h"
+#include "game/modes/round_template.h"
 #include "game/cosmos/cosmos.h"
 #include "game/cosmos/entity_handle.h"
 #include "game/detail/inventory/generate_equipment.h"
@@ -918,7 +919,16 @@ void bomb_defusal::setup_round(
 
 	round_speeds = in.rules.speeds;
 
-	cosm.set(in.initial_signi);
+	{
+		auto scope = measure_scope(cosm.profiler.round_restart);
+
+		if (in.initial_round != nullptr) {
+			in.initial_round->restore(cosm, in.initial_signi);
+		}
+		else {
+			cosm.set(in.initial_signi);
+		}
+	}
 
 	/* 
 		If there are any entries in message queues, 
@@ -1839,7 +1849,7 @@ mode_player_id bomb_defusal::find_first_free_player() const {
 	return first_free_key(players, mode_player_id::first());
 }
 
-void bomb_defusal::execute_player_commands(const input_type in, mode_entropy& entropy, const logic_step step) {
+void bomb_defusal::execute_player_commands(const input_type in, const mode_entropy& entropy, const logic_step step) {
 	const auto current_round = get_current_round_number();
 	auto& cosm = in.cosm;
 
@@ -229,6 +229,7 @@ enum class round_start_type {
 };
 
 struct debugger_property_accessors;
+class round_template;
 
 class bomb_defusal {
 public:
@@ -242,9 +243,12 @@ public:
 		const cosmos_solvable_significant& initial_signi;
 		maybe_const_ref_t<C, cosmos> cosm;
 
+		/* Optional. If set, rounds are restarted from it instead of from initial_signi. */
+		maybe_const_ptr_t<C, round_template> initial_round = nullptr;
+
 		template <bool is_const = C, class = std::enable_if_t<!is_const>>
 		operator basic_input<!is_const>() const {
-			return { rules, initial_signi, cosm };
+			return { rules, initial_signi, cosm, initial_round };
 		}
 	};
 
@@ -378,7 +382,7 @@ private:
 
 	void end_warmup_and_go_live(input, logic_step);
 
-	void execute_player_commands(input, mode_entropy&, logic_step);
+	void execute_player_commands(input, const mode_entropy&, logic_step);
 	void add_or_remove_players(input, const mode_entropy&, logic_step);
 	void handle_special_commands(input, const mode_entropy&, logic_step);
 	void spawn_characters_for_recently_assigned(input, logic_step);
@@ -500,7 +504,7 @@ public:
 	template <class C>
 	decltype(auto) advance(
 		const input in, 
-		mode_entropy entropy, 
+		const mode_entropy& entropy, 
 		C callbacks,
 		const solve_settings settings
 	) {
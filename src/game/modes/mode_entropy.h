@@ -57,7 +57,7 @@ struct mode_entropy_general {
 struct mode_entropy {
 	// GEN INTROSPECTOR struct mode_entropy
 	cosmic_entropy cosmic;
-	std::map<mode_player_id, mode_player_entropy> players;
+	augs::sorted_vector_map<mode_player_id, mode_player_entropy> players;
 	mode_entropy_general general;
 	// END GEN INTROSPECTOR
 
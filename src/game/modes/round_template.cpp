@@ -0,0 +1,124 @@
+#include "game/modes/round_template.h"
+#include "game/cosmos/cosmos.h"
+
+round_template::round_template() = default;
+round_template::~round_template() = default;
+
+void round_template::restore(cosmos& target, const cosmos_solvable_significant& initial_signi) {
+	if (cosm == nullptr) {
+		target.set(initial_signi);
+		cosm = std::make_unique<cosmos>(target);
+
+		return;
+	}
+
+	target.assign_solvable(*cosm);
+}
+
+void round_template::invalidate() {
+	cosm.reset();
+}
+
+#if BUILD_UNIT_TESTS && BUILD_TEST_SCENES
+#include <Catch/single_include/catch2/catch.hpp>
+
+#include "augs/misc/lua/lua_utils.h"
+#include "game/cosmos/entity_handle.h"
+#include "game/cosmos/for_each_entity.h"
+#include "game/components/sentience_component.h"
+#include "game/cosmos/solvers/standard_solver.h"
+#include "game/modes/test_mode.h"
+#include "test_scenes/test_scene_settings.h"
+#include "application/intercosm.h"
+
+TEST_CASE("RoundTemplate SameStepsAsReassigning") {
+	auto lua = augs::create_lua_state();
+
+	test_mode_ruleset ruleset;
+	intercosm scene;
+
+	scene.make_test_scene(lua, test_scene_settings(), ruleset, nullptr);
+
+	const auto initial_signi = scene.world.get_solvable().significant;
+
+	std::vector<entity_id> characters;
+
+	scene.world.for_each_having<components::sentience>([&](const auto& typed_handle) {
+		characters.push_back(typed_handle.get_id());
+	});
+
+	REQUIRE(characters.size() > 0);
+
+	/* Make the characters run into each other and the walls so that the contacts matter. */
+
+	auto advance = [&](cosmos& cosm, const int steps) {
+		for (int i = 0; i < steps; ++i) {
+			cosmic_entropy entropy;
+
+			if (i == 0) {
+				for (std::size_t c = 0; c < characters.size(); ++c) {
+					auto& intents = entropy[characters[c]].commands.intents;
+
+					intents.push_back({ c % 2 ? game_intent_type::MOVE_FORWARD : game_intent_type::MOVE_BACKWARD, intent_change::PRESSED });
+					intents.push_back({ c % 3 ? game_intent_type::MOVE_RIGHT : game_intent_type::MOVE_LEFT, intent_change::PRESSED });
+				}
+			}
+
+			standard_solver()({ cosm, entropy, solve_settings() }, solver_callbacks());
+		}
+	};
+
+	auto restored = std::make_unique<cosmos>(scene.world);
+	auto reassigned = std::make_unique<cosmos>(scene.world);
+
+	round_template tmpl;
+
+	/* Build the template and play a round, so that the next restore is actually from the template. */
+	tmpl.restore(*restored, initial_signi);
+	REQUIRE(tmpl.is_built());
+	advance(*restored, 90);
+	tmpl.restore(*restored, initial_signi);
+
+	advance(*reassigned, 90);
+	reassigned->set(initial_signi);
+
+	const auto num_steps = 240;
+
+	advance(*restored, num_steps);
+	advance(*reassigned, num_steps);
+
+	REQUIRE(restored->get_total_steps_passed() == reassigned->get_total_steps_passed());
+	REQUIRE(restored->calculate_solvable_signi_hash<uint32_t>() == reassigned->calculate_solvable_signi_hash<uint32_t>());
+
+	for (const auto& id : characters) {
+		const auto a = (*restored)[id].find_logic_transform();
+		const auto b = (*reassigned)[id].find_logic_transform();
+
+		REQUIRE(a.has_value() == b.has_value());
+
+		if (a) {
+			REQUIRE(*a == *b);
+		}
+	}
+
+	/* The bodies must also be created in the same order as it affects how the contacts are solved. */
+
+	const auto& a_world = restored->get_solvable_inferred().physics.get_b2world();
+	const auto& b_world = reassigned->get_solvable_inferred().physics.get_b2world();
+
+	REQUIRE(a_world.GetBodyCount() == b_world.GetBodyCount());
+	REQUIRE(a_world.GetContactCount() == b_world.GetContactCount());
+
+	const b2Body* b_body = b_world.GetBodyList();
+
+	for (const b2Body* a_body = a_world.GetBodyList(); a_body != nullptr; a_body = a_body->GetNext(), b_body = b_body->GetNext()) {
+		REQUIRE(b_body != nullptr);
+
+		REQUIRE(a_body->GetPosition() == b_body->GetPosition());
+		REQUIRE(a_body->GetAngle() == b_body->GetAngle());
+		REQUIRE(a_body->GetLinearVelocity() == b_body->GetLinearVelocity());
+		REQUIRE(a_body->GetAngularVelocity() == b_body->GetAngularVelocity());
+		REQUIRE(a_body->IsAwake() == b_body->IsAwake());
+	}
+}
+#endif
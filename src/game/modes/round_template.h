@@ -0,0 +1,38 @@
+#pragma once
+#include <memory>
+
+class cosmos;
+struct cosmos_solvable_significant;
+
+/*
+	A fully inferred copy of the cosmos as it is at the start of every round,
+	including the built physics world and the trees.
+
+	Assigning the initial significant state rebuilds all inferred caches from scratch,
+	which on big maps made the round-start tick the slowest tick of the match - on every machine at once.
+	Restoring from the template is a bulk copy of the solvable and a clone of the physics world instead.
+
+	Both yield identical caches since a full reinference depends only on the significant state,
+	so the template is safe to use on some machines and not on others.
+
+	The template is built on first use from whatever common state the cosmos has,
+	so the owner must call invalidate() whenever it reassigns the initial significant state or loads another arena.
+*/
+
+class round_template {
+	std::unique_ptr<cosmos> cosm;
+
+public:
+	round_template();
+	~round_template();
+
+	round_template(const round_template&) = delete;
+	round_template& operator=(const round_template&) = delete;
+
+	void restore(cosmos& target, const cosmos_solvable_significant& initial_signi);
+	void invalidate();
+
+	bool is_built() const {
+		return cosm != nullptr;
+	}
+};
@@ -4,13 +4,15 @@ struct per_character_input_settings {
 	// GEN INTROSPECTOR struct per_character_input_settings
 	vec2 crosshair_sensitivity = vec2(1000.f, 1000.f);
 	bool keep_movement_forces_relative_to_crosshair = false;
-	pad_bytes<3> pad;
+	uint8_t lag_compensation_steps = 0;
+	pad_bytes<2> pad;
 	// END GEN INTROSPECTOR
 
 	bool operator==(const per_character_input_settings& b) const {
 		return 
 			crosshair_sensitivity == b.crosshair_sensitivity 
 			&& keep_movement_forces_relative_to_crosshair == b.keep_movement_forces_relative_to_crosshair
+			&& lag_compensation_steps == b.lag_compensation_steps
 		;
 	}
 
@@ -598,6 +598,7 @@ void gun_system::launch_shots_due_to_pressed_triggers(const logic_step step) {
 											missile.power_multiplier_of_sender = gun_def.damage_multiplier;
 											missile.headshot_multiplier_of_sender = gun_def.headshot_multiplier;
 											missile.head_radius_multiplier_of_sender = gun_def.head_radius_multiplier;
+											missile.lag_compensation_steps = sentience.lag_compensation_steps;
 										}
 
 										round_entity.template get<components::rigid_body>().set_velocity(missile_velocity);
@@ -816,6 +817,7 @@ void gun_system::launch_shots_due_to_pressed_triggers(const logic_step step) {
 														missile.power_multiplier_of_sender = gun_def.damage_multiplier;
 														missile.headshot_multiplier_of_sender = gun_def.headshot_multiplier;
 														missile.head_radius_multiplier_of_sender = gun_def.head_radius_multiplier;
+														missile.lag_compensation_steps = sentience.lag_compensation_steps;
 													}
 
 													const auto& missile_def = round_entity.template get<invariants::missile>();
@@ -26,6 +26,10 @@ void input_system::make_input_messages(const logic_step step) {
 			movement->keep_movement_forces_relative_to_crosshair = settings.keep_movement_forces_relative_to_crosshair;
 		}
 
+		if (const auto sentience = subject.template find<components::sentience>()) {
+			sentience->lag_compensation_steps = settings.lag_compensation_steps;
+		}
+
 		for (const auto& intent : commands.intents) {
 			auto msg = messages::intent_message();
 			msg.game_intent::operator=(intent);
@@ -22,6 +22,7 @@
 #include "augs/math/convex_hull.h"
 #include "game/enums/filters.h"
 #include "game/detail/physics/physics_queries.h"
+#include "game/detail/lag_compensation/rewound_queries.h"
 #include "augs/misc/enum/enum_bitset.h"
 #include "game/messages/damage_message.h"
 #include "game/messages/thunder_effect.h"
@@ -70,6 +71,7 @@ void melee_system::initiate_and_update_moves(const logic_step step) {
 	std::vector<vec2> total_verts;
 	const auto si = cosm.get_si();
 	const auto& physics = cosm.get_solvable_inferred().physics;
+	const auto& past_hitboxes = cosm.get_global_solvable().past_hitboxes;
 
 	cosm.for_each_having<components::melee_fighter>([&](const auto& it) {
 		const auto& fighter_def = it.template get<invariants::melee_fighter>();
@@ -653,10 +655,44 @@ void melee_system::initiate_and_update_moves(const logic_step step) {
 								return callback_result::CONTINUE;
 							};
 
+							hitbox_history_step rewound_hitboxes;
+							const auto rewound = past_hitboxes.find_rewound(cosm.get_timestamp().step, sentience.lag_compensation_steps, rewound_hitboxes);
+
+							if (rewound == nullptr) {
+								physics.for_each_intersection_with_polygon(
+									si,
+									convex,
+									filter,
+									handle_intersection
+								);
+
+								return;
+							}
+
+							/* Characters are hit where the attacker saw them, see hitbox_history. */
+
 							physics.for_each_intersection_with_polygon(
 								si,
 								convex,
 								filter,
+								[&](const b2Fixture& fix, const vec2 point_a, const vec2 point_b) {
+									if (rewound->has(get_body_entity_that_owns(fix))) {
+										return callback_result::CONTINUE;
+									}
+
+									return handle_intersection(fix, point_a, point_b);
+								}
+							);
+
+							const auto queried = to_queried_polygon_meters(si, convex);
+
+							for_each_rewound_intersection_with_shape_meters(
+								*rewound,
+								make_rewound_body_getter(cosm, *rewound),
+								si,
+								queried.shape,
+								queried.transform,
+								filter,
 								handle_intersection
 							);
 						};
@@ -1,5 +1,8 @@
+#include "3rdparty/Box2D/Box2D.h"
+
 #include "missile_system.h"
 #include "augs/math/steering.h"
+#include "augs/templates/remove_cref.h"
 #include "game/cosmos/cosmos.h"
 #include "game/cosmos/entity_id.h"
 #include "game/cosmos/for_each_entity.h"
@@ -29,6 +32,7 @@
 #include "game/detail/entity_handle_mixins/get_owning_transfer_capability.hpp"
 
 #include "game/detail/physics/physics_scripts.h"
+#include "game/inferred_caches/physics_world_cache.hpp"
 
 #include "game/assets/ids/asset_ids.h"
 
@@ -61,9 +65,146 @@ void RIC_LOG(Args&&... args) {
 #include "game/detail/missile/missile_utils.h"
 #include "game/detail/missile/missile_collision.h"
 #include "game/detail/missile/missile_ricochet.h"
+#include "game/detail/missile/missile_sweep.h"
+#include "game/detail/lag_compensation/rewound_queries.h"
+#include "game/detail/missile/is_swept_missile.h"
 
 using namespace augs;
 
+void missile_system::sweep_missiles_through_world(const logic_step step) {
+	auto& cosm = step.get_cosmos();
+	auto& physics = cosm.get_solvable_inferred({}).physics;
+	auto& world = physics.get_b2world();
+
+	const auto si = cosm.get_si();
+	const auto now = cosm.get_timestamp();
+	const auto& past_hitboxes = cosm.get_global_solvable().past_hitboxes;
+
+	thread_local std::vector<missile_sweep_hit> hits;
+	thread_local hitbox_history_step rewound_hitboxes;
+
+	cosm.for_each_having<components::missile>(
+		[&](const auto& typed_missile) {
+			if constexpr(is_swept_missile_v<remove_cref<decltype(typed_missile)>>) {
+				const auto rigid_body = typed_missile.template get<components::rigid_body>();
+				const auto cache = rigid_body.find_cache();
+
+				if (cache == nullptr || !cache->is_constructed()) {
+					return;
+				}
+
+				auto& body = *cache->body.get();
+
+				if (!body.IsAwake()) {
+					return;
+				}
+
+				/* The island solver leaves the position from before the step in c0. */
+				const auto from = body.m_sweep.c0;
+				const auto to = body.m_sweep.c;
+
+				const auto missile_filter = ::calc_filters(typed_missile);
+
+				hits.clear();
+
+				const auto rewound = past_hitboxes.find_rewound(now.step, typed_missile.template get<components::missile>().lag_compensation_steps, rewound_hitboxes);
+
+				::gather_missile_sweep_hits(
+					world,
+					from,
+					to,
+					body.GetLinearVelocity(),
+					typed_missile.when_born().step == now.step,
+					missile_filter,
+					rewound,
+					make_rewound_body_getter(cosm, rewound_hitboxes),
+					hits
+				);
+
+				if (hits.empty()) {
+					return;
+				}
+
+				for (auto& h : hits) {
+					h.surface = cosm[h.fixture->GetUserData()].get_id();
+				}
+
+				std::sort(hits.begin(), hits.end());
+
+				const auto& missile_fixtures = typed_missile.template get<invariants::fixtures>();
+
+				auto missile_index = b2Fixture_index_in_component();
+				missile_index.convex_shape_index = 0;
+
+				auto classify = [&](const missile_sweep_hit& hit) {
+					const auto surface = cosm[hit.surface];
+					const auto info = missile_surface_info(typed_missile, surface);
+
+					const bool contact_disabled = 
+						info.ignore_standard_impulse() 
+						|| surface.template has<components::sentience>()
+						|| is_like_thrown_melee(surface)
+						|| is_like_melee_in_action(surface)
+					;
+
+					if (contact_disabled) {
+						return missile_sweep_contact::BEGIN_ONLY;
+					}
+
+					const bool resolution_disabled = 
+						missile_fixtures.standard_collision_resolution_disabled()
+						|| surface.template get<invariants::fixtures>().standard_collision_resolution_disabled()
+					;
+
+					if (resolution_disabled) {
+						return missile_sweep_contact::NOT_RESOLVED;
+					}
+
+					return missile_sweep_contact::SOLID;
+				};
+
+				/* 
+					The same pairs of messages that contact_listener would post,
+					with the surface as the subject first.
+				*/
+
+				auto post = [&](const auto type, const missile_sweep_hit& hit, const real32 normal_impulse_meters) {
+					const auto surface = cosm[hit.surface];
+
+					messages::collision_message msg;
+
+					msg.type = type;
+					msg.subject = surface;
+					msg.collider = typed_missile;
+
+					msg.indices.subject = physics.get_index_in_component(*hit.fixture, surface);
+					msg.indices.collider = missile_index;
+
+					msg.point = si.get_pixels(vec2(hit.point));
+					msg.normal = si.get_pixels(vec2(hit.normal));
+
+					msg.subject_impact_velocity = si.get_pixels(vec2(hit.fixture->GetBody()->GetLinearVelocity()));
+					msg.collider_impact_velocity = si.get_pixels(vec2(body.GetLinearVelocity()));
+
+					msg.normal_impulse = si.get_pixels(normal_impulse_meters);
+					msg.tangent_impulse = msg.normal_impulse;
+
+					physics.accumulated_messages.push_back(msg);
+
+					std::swap(msg.subject, msg.collider);
+					std::swap(msg.indices.subject, msg.indices.collider);
+					std::swap(msg.subject_impact_velocity, msg.collider_impact_velocity);
+					msg.normal *= -1;
+
+					physics.accumulated_messages.push_back(msg);
+				};
+
+				::resolve_missile_sweep_hits(body, missile_fixtures.restitution, hits, classify, post);
+			}
+		}
+	);
+}
+
 void missile_system::ricochet_missiles(const logic_step step) {
 	auto& cosm = step.get_cosmos();
 	const auto& events = step.get_queue<messages::collision_message>();
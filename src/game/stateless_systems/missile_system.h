@@ -5,6 +5,7 @@ class cosmos;
 
 class missile_system {
 public:
+	void sweep_missiles_through_world(const logic_step step);
 
 	void ricochet_missiles(const logic_step step);
 	void detonate_colliding_missiles(const logic_step step);
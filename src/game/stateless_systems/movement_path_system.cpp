@@ -1,3 +1,5 @@
+#include <vector>
+
 #include "augs/misc/randomization.h"
 #include "augs/math/steering.h"
 #include "augs/math/make_rect_points.h"
@@ -6,6 +8,7 @@
 #include "game/cosmos/entity_handle.h"
 #include "game/cosmos/logic_step.h"
 #include "game/cosmos/for_each_entity.h"
+#include "game/cosmos/for_each_entity_parallel.h"
 
 #include "game/messages/interpolation_correction_request.h"
 #include "game/messages/queue_deletion.h"
@@ -17,6 +20,132 @@
 #include "game/inferred_caches/organism_cache.hpp"
 #include "game/inferred_caches/organism_cache_query.hpp"
 
+/*
+	Organisms are advanced in three passes.
+
+	First, the neighbors that every cell of every grid can offer
+	are gathered into flat arrays, so that neighbor queries never have to go through the cosmos.
+
+	Then every organism is advanced against that snapshot of its neighbors.
+	It writes only to its own components and to its own result slot,
+	so the organisms can be split between any number of threads and the outcome stays the same.
+
+	Last, the grid cells are updated and the bubbles are started, in the order of the entities.
+*/
+
+static constexpr std::size_t max_handled_organisms_per_cell_v = 3;
+static constexpr std::size_t organisms_grain_v = 256;
+
+namespace {
+	struct neighbor_table {
+		unversioned_entity_id origin;
+		const organism_cache::grid_type* grid = nullptr;
+
+		/* Neighbors in the i-th cell of the grid are at [cell_offsets[i], cell_offsets[i + 1]). */
+		std::vector<uint32_t> cell_offsets;
+
+		std::vector<organism_id_type> ids;
+		std::vector<vec2> positions;
+		std::vector<vec2> tips;
+		std::vector<vec2> velocities;
+		std::vector<real32> speeds;
+		std::vector<avoidance_rank_type> ranks;
+		std::vector<raw_entity_flavour_id> flavours;
+
+		void clear() {
+			origin = {};
+			grid = nullptr;
+
+			cell_offsets.clear();
+
+			ids.clear();
+			positions.clear();
+			tips.clear();
+			velocities.clear();
+			speeds.clear();
+			ranks.clear();
+			flavours.clear();
+		}
+	};
+
+	struct organism_step_result {
+		bool moved = false;
+		bool start_bubble = false;
+		vec2 old_position;
+		vec2 new_position;
+	};
+
+	struct organisms_scratch {
+		/* Only the first num_tables are in use, the rest are kept for their storage. */
+		std::vector<neighbor_table> tables;
+		std::size_t num_tables = 0;
+
+		std::vector<organism_step_result> results;
+
+		const neighbor_table* find_table(const unversioned_entity_id origin) const {
+			/* There are only ever a handful of organism areas on a map. */
+
+			for (std::size_t i = 0; i < num_tables; ++i) {
+				if (tables[i].origin == origin) {
+					return &tables[i];
+				}
+			}
+
+			return nullptr;
+		}
+	};
+}
+
+static void gather_neighbor_tables(organisms_scratch& scratch, const cosmos& cosm, const organism_cache& grids) {
+	scratch.num_tables = 0;
+
+	grids.for_each_grid([&](const unversioned_entity_id origin, const organism_cache::grid_type& grid) {
+		if (scratch.num_tables == scratch.tables.size()) {
+			scratch.tables.emplace_back();
+		}
+
+		auto& t = scratch.tables[scratch.num_tables++];
+
+		t.clear();
+		t.origin = origin;
+		t.grid = &grid;
+
+		for (const auto& cell : grid.cells) {
+			t.cell_offsets.push_back(static_cast<uint32_t>(t.ids.size()));
+
+			const auto& orgs = cell.organisms;
+			const auto cnt = std::min(orgs.size(), max_handled_organisms_per_cell_v);
+
+			for (std::size_t i = 0; i < cnt; ++i) {
+				const auto neighbor = cosm[orgs[i]];
+
+				if (neighbor.dead()) {
+					continue;
+				}
+
+				const auto& wandering = neighbor.get<invariants::movement_path>().organism_wandering;
+
+				if (!wandering.is_enabled) {
+					continue;
+				}
+
+				const auto transform = neighbor.get_logic_transform();
+				const auto speed = neighbor.get<components::movement_path>().last_speed;
+
+				t.ids.push_back(orgs[i]);
+				t.positions.push_back(transform.pos);
+				t.tips.push_back(neighbor.get_logical_tip(transform));
+				t.velocities.push_back(transform.get_direction() * speed);
+				t.speeds.push_back(speed);
+				t.ranks.push_back(wandering.value.avoidance_rank);
+				t.flavours.push_back(neighbor.get_raw_flavour_id());
+			}
+		}
+
+		t.cell_offsets.push_back(static_cast<uint32_t>(t.ids.size()));
+	});
+}
+
 void movement_path_system::advance_paths(const logic_step step) const {
 	if (!step.get_settings().simulate_decorative_organisms) {
 		return;
@@ -25,93 +154,114 @@ void movement_path_system::advance_paths(const logic_step step) const {
 	auto& cosm = step.get_cosmos();
 	const auto delta = step.get_delta();
 
-	auto& step_rng = step.step_rng;
-
 	auto& grids = cosm.get_solvable_inferred({}).organisms;
 
 	static const auto fov_half_degrees = real32((360 - 90) / 2);
 	static const auto fov_half_degrees_cos = repro::cos(fov_half_degrees);
 
-	cosm.for_each_having<components::movement_path>(
-		[&](const auto& subject) {
-			const auto& movement_path_def = subject.template get<invariants::movement_path>();
+	/* 
+		Arenas might be advanced on several threads at once.
+		The lambdas below must see the scratch of this thread even when they run on the others.
+	*/
 
-			const auto& rotation_speed = movement_path_def.continuous_rotation_speed;
+	thread_local organisms_scratch thread_scratch;
+	auto& scratch = thread_scratch;
 
-			if (augs::is_nonzero(rotation_speed)) {
-				auto& transform = subject.template get<components::transform>();
-				transform.rotation += rotation_speed * delta.in_seconds();
-			}
+	gather_neighbor_tables(scratch, cosm, grids);
 
-			if (movement_path_def.organism_wandering.is_enabled) {
-				auto& movement_path = subject.template get<components::movement_path>();
+	auto& results = scratch.results;
+	results.assign(cosm.count_having<components::movement_path>(), organism_step_result());
 
-				const auto& transform = subject.template get<components::transform>();
-				const auto& pos = transform.pos;
-				const auto tip_pos = subject.get_logical_tip(transform);
+	auto advance_organism = [&](const auto& subject, const std::size_t result_index) {
+		auto& result = results[result_index];
+		const auto& movement_path_def = subject.template get<invariants::movement_path>();
 
-				const auto& def = movement_path_def.organism_wandering.value;
+		const auto& rotation_speed = movement_path_def.continuous_rotation_speed;
 
-				const auto origin = cosm[movement_path.origin];
+		if (augs::is_nonzero(rotation_speed)) {
+			auto& transform = subject.template get<components::transform>();
+			transform.rotation += rotation_speed * delta.in_seconds();
+		}
 
-				if (origin.dead()) {
-					return;
-				}
+		if (movement_path_def.organism_wandering.is_enabled) {
+			auto& movement_path = subject.template get<components::movement_path>();
 
-				const auto global_time = cosm.get_total_seconds_passed() + real32(subject.get_id().raw.indirection_index);
-				const auto global_time_sine = repro::sin(real32(global_time * 2));
+			const auto& transform = subject.template get<components::transform>();
+			const auto& pos = transform.pos;
+			const auto tip_pos = subject.get_logical_tip(transform);
 
-				const auto max_speed_boost = def.sine_speed_boost;
-				const auto boost_mult = static_cast<real32>(global_time_sine * global_time_sine);
-				const auto speed_boost = boost_mult * max_speed_boost;
+			const auto& def = movement_path_def.organism_wandering.value;
 
-				const auto max_avoidance_speed = 20 + speed_boost / 2;
-				const auto max_startle_speed = 250 + 4*speed_boost;
-				const auto max_lighter_startle_speed = 200 + 4*speed_boost;
+			const auto origin = cosm[movement_path.origin];
 
-				const auto cohesion_mult = 0.05f;
-				const auto alignment_mult = 0.08f;
+			if (origin.dead()) {
+				return;
+			}
 
-				const auto base_speed = def.base_speed;
+			const auto global_time = cosm.get_total_seconds_passed() + real32(subject.get_id().raw.indirection_index);
+			const auto global_time_sine = repro::sin(real32(global_time * 2));
 
-				const auto min_speed = base_speed + speed_boost;
-				const auto max_speed = base_speed + max_speed_boost;
+			const auto max_speed_boost = def.sine_speed_boost;
+			const auto boost_mult = static_cast<real32>(global_time_sine * global_time_sine);
+			const auto speed_boost = boost_mult * max_speed_boost;
 
-				const auto current_dir = transform.get_direction();
+			const auto max_avoidance_speed = 20 + speed_boost / 2;
+			const auto max_startle_speed = 250 + 4*speed_boost;
+			const auto max_lighter_startle_speed = 200 + 4*speed_boost;
 
-				const real32 comfort_zone_radius = movement_path_neighbor_query_radius_v;
-				const real32 cohesion_zone_radius = 60.f;
+			const auto cohesion_mult = 0.05f;
+			const auto alignment_mult = 0.08f;
 
-				const auto current_speed_mult = movement_path.last_speed / max_speed;
-				const auto wandering_sine = repro::sin(real32(global_time / def.sine_wandering_period * current_speed_mult)) * def.sine_wandering_amplitude * current_speed_mult;
-				const auto perpendicular_dir = current_dir.perpendicular_cw();
+			const auto base_speed = def.base_speed;
 
-				const auto subject_avoidance_rank = def.avoidance_rank;
+			const auto min_speed = base_speed + speed_boost;
+			const auto max_speed = base_speed + max_speed_boost;
 
-				auto for_each_neighbor_within = [&](const auto radius, auto callback) {
-					if (!def.enable_flocking) {
-						return;
-					}
+			const auto current_dir = transform.get_direction();
+
+			const real32 comfort_zone_radius = movement_path_neighbor_query_radius_v;
+			const real32 cohesion_zone_radius = 60.f;
+
+			const auto current_speed_mult = movement_path.last_speed / max_speed;
+			const auto wandering_sine = repro::sin(real32(global_time / def.sine_wandering_period * current_speed_mult)) * def.sine_wandering_amplitude * current_speed_mult;
+			const auto perpendicular_dir = current_dir.perpendicular_cw();
+
+			const auto subject_avoidance_rank = def.avoidance_rank;
+
+			const auto neighbors = scratch.find_table(origin.get_id());
 
-					constexpr auto max_handled_organisms = std::size_t(3);
+			auto for_each_neighbor_within = [&](const auto radius, auto callback) {
+				if (!def.enable_flocking || neighbors == nullptr) {
+					return;
+				}
+
+				const auto& t = *neighbors;
+				const auto& grid = *t.grid;
 
-					auto cell_callback = [&](const auto& cell) {
-						const auto& orgs = cell.organisms;
-						const auto cnt = std::min(orgs.size(), max_handled_organisms);
+				const auto query = ltrb::center_and_size(tip_pos, vec2::square(radius * 2));
 
-						for (std::size_t i = 0; i < cnt; ++i) {
-							const auto org_id = orgs[i];
+				if (!query.hover(grid.aabb)) {
+					return;
+				}
 
-							if (org_id == subject.get_id()) {
+				const auto lt_bound = grid.get_cell_coord_at_world(query.left_top());
+				const auto rb_bound = grid.get_cell_coord_at_world(query.right_bottom());
+				const auto row_size = grid.cells_size().x;
+
+				for (int y = lt_bound.y; y <= rb_bound.y; ++y) {
+					for (int x = lt_bound.x; x <= rb_bound.x; ++x) {
+						const auto cell_index = row_size * y + x;
+
+						const auto first = t.cell_offsets[cell_index];
+						const auto last = t.cell_offsets[cell_index + 1];
+
+						for (auto n = first; n < last; ++n) {
+							if (t.ids[n] == subject.get_id()) {
 								/* Don't measure against itself */
 								continue;
 							}
 
-							const auto typed_neighbor = cosm[org_id];
-							const auto neighbor_transform = typed_neighbor.get_logic_transform();
-							const auto neighbor_tip = typed_neighbor.get_logical_tip(neighbor_transform);
-							const auto offset_dir = (neighbor_tip - tip_pos).normalize();
-
+							const auto offset_dir = (t.tips[n] - tip_pos).normalize();
 							const auto facing = current_dir.dot(offset_dir);
 
 							/*
@@ -121,193 +271,336 @@ void movement_path_system::advance_paths(const logic_step step) const {
 							*/
 
 							if (facing >= fov_half_degrees_cos) {
-								callback(typed_neighbor, neighbor_transform, neighbor_tip);
+								callback(t, n);
 							}
 						}
-					};
-
-					grids.for_each_cell_of_grid(
-						origin.get_id(),
-						ltrb::center_and_size(tip_pos, vec2::square(radius * 2)),
-						cell_callback
-					);
-				};
+					}
+				}
+			};
 
-				auto velocity = current_dir * min_speed + perpendicular_dir * wandering_sine;
+			auto velocity = current_dir * min_speed + perpendicular_dir * wandering_sine;
 
-				real32 total_startle_applied = 0.f;
+			real32 total_startle_applied = 0.f;
 
-				auto do_startle = [&](const auto type, const auto damping, const auto steer_mult, const auto max_speed) {
-					auto& startle = movement_path.startle[type];
-					//const auto desired_vel = vec2(startle).trim_length(max_speed);
-					const auto desired_vel = startle;
-					const auto total_steering = vec2((desired_vel - velocity) * steer_mult * (0.02f + (0.16f * boost_mult))).trim_length(max_speed);
+			auto do_startle = [&](const auto type, const auto damping, const auto steer_mult, const auto max_speed) {
+				auto& startle = movement_path.startle[type];
+				//const auto desired_vel = vec2(startle).trim_length(max_speed);
+				const auto desired_vel = startle;
+				const auto total_steering = vec2((desired_vel - velocity) * steer_mult * (0.02f + (0.16f * boost_mult))).trim_length(max_speed);
 
-					total_startle_applied += total_steering.length() / velocity.length();
+				total_startle_applied += total_steering.length() / velocity.length();
 
-					velocity += total_steering;
+				velocity += total_steering;
 
-					startle.damp(delta.in_seconds(), vec2::square(damping));
-				};
+				startle.damp(delta.in_seconds(), vec2::square(damping));
+			};
 
-				do_startle(startle_type::LIGHTER, 0.2f, 0.1f, max_lighter_startle_speed);
-				do_startle(startle_type::IMMEDIATE, 5.f, 1.f, max_startle_speed);
+			do_startle(startle_type::LIGHTER, 0.2f, 0.1f, max_lighter_startle_speed);
+			do_startle(startle_type::IMMEDIATE, 5.f, 1.f, max_startle_speed);
 
-				vec2 average_pos;
-				vec2 average_vel;
+			vec2 average_pos;
+			vec2 average_vel;
 
-				unsigned counted_neighbors = 0;
+			unsigned counted_neighbors = 0;
 
-				{
-					auto greatest_avoidance = vec2::zero;
+			{
+				auto greatest_avoidance = vec2::zero;
 
-					for_each_neighbor_within(comfort_zone_radius, [&](const auto& typed_neighbor, const auto& neighbor_transform, const auto& neighbor_tip) {
-						const auto& neighbor_wandering_def = typed_neighbor.template get<invariants::movement_path>().organism_wandering;
-						const auto& neighbor_path = typed_neighbor.template get<components::movement_path>();
+				const auto subject_flavour = subject.get_raw_flavour_id();
 
-						if (neighbor_wandering_def.is_enabled) {
-							if (subject_avoidance_rank > neighbor_wandering_def.value.avoidance_rank) {
-								/* Don't care about lesser species. */
-								return;
-							}
-
-							const auto neighbor_vel = neighbor_transform.get_direction() * neighbor_path.last_speed;
+				for_each_neighbor_within(comfort_zone_radius, [&](const neighbor_table& t, const uint32_t n) {
+					if (subject_avoidance_rank > t.ranks[n]) {
+						/* Don't care about lesser species. */
+						return;
+					}
 
-							const auto avoidance = augs::immediate_avoidance(
-								tip_pos,
-								current_dir * movement_path.last_speed,
-								neighbor_tip,
-								neighbor_vel,
-								comfort_zone_radius,
-								max_avoidance_speed * neighbor_path.last_speed / max_speed
-							);
+					const auto avoidance = augs::immediate_avoidance(
+						tip_pos,
+						current_dir * movement_path.last_speed,
+						t.tips[n],
+						t.velocities[n],
+						comfort_zone_radius,
+						max_avoidance_speed * t.speeds[n] / max_speed
+					);
 
-							greatest_avoidance = std::max(avoidance, greatest_avoidance);
+					greatest_avoidance = std::max(avoidance, greatest_avoidance);
 
-							if (typed_neighbor.get_flavour_id() == subject.get_flavour_id()) {
-								average_pos += neighbor_transform.pos;
-								average_vel += neighbor_vel;
-								++counted_neighbors;
-							}
-						}
-					});
+					if (t.flavours[n] == subject_flavour) {
+						average_pos += t.positions[n];
+						average_vel += t.velocities[n];
+						++counted_neighbors;
+					}
+				});
 
-					velocity += greatest_avoidance;
-				}
+				velocity += greatest_avoidance;
+			}
 
-				if (counted_neighbors) {
-					average_pos /= counted_neighbors;
-					average_vel /= counted_neighbors;
+			if (counted_neighbors) {
+				average_pos /= counted_neighbors;
+				average_vel /= counted_neighbors;
 
-					if (cohesion_mult != 0.f) {
-						const auto total_cohesion = cohesion_mult * total_startle_applied;
+				if (cohesion_mult != 0.f) {
+					const auto total_cohesion = cohesion_mult * total_startle_applied;
 
-						velocity += augs::arrive(
-							velocity,
-							pos,
-							average_pos,
-							velocity.length(),
-							cohesion_zone_radius
-						) * total_cohesion;
-					}
+					velocity += augs::arrive(
+						velocity,
+						pos,
+						average_pos,
+						velocity.length(),
+						cohesion_zone_radius
+					) * total_cohesion;
+				}
 
-					if (alignment_mult != 0.f) {
-						const auto desired_vel = average_vel.set_length(velocity.length());
-						const auto steering = desired_vel - velocity;
+				if (alignment_mult != 0.f) {
+					const auto desired_vel = average_vel.set_length(velocity.length());
+					const auto steering = desired_vel - velocity;
 
-						velocity += steering * alignment_mult;
-					}
+					velocity += steering * alignment_mult;
 				}
+			}
 
-				const auto total_speed = velocity.length();
-
-				const auto bound_avoidance = origin.dispatch([&](const auto& typed_origin) {
-					if (const auto tr = typed_origin.find_logic_transform()) {
-						if (const auto size = typed_origin.get_logical_size(); size.area() > 0) {
-							if (const auto area = typed_origin.template find<invariants::box_marker>()) {
-								return augs::steer_to_avoid_edges(
-									velocity,
-									tip_pos,
-									augs::make_rect_points(tr->pos, size, tr->rotation),
-									tr->pos,
-									60.f,
-									0.2f
-								);
-							}
+			const auto total_speed = velocity.length();
+
+			const auto bound_avoidance = origin.dispatch([&](const auto& typed_origin) {
+				if (const auto tr = typed_origin.find_logic_transform()) {
+					if (const auto size = typed_origin.get_logical_size(); size.area() > 0) {
+						if (const auto area = typed_origin.template find<invariants::box_marker>()) {
+							return augs::steer_to_avoid_edges(
+								velocity,
+								tip_pos,
+								augs::make_rect_points(tr->pos, size, tr->rotation),
+								tr->pos,
+								60.f,
+								0.2f
+							);
 						}
 					}
+				}
 
-					return vec2::zero;
-				});
+				return vec2::zero;
+			});
 
-				velocity += bound_avoidance;
+			velocity += bound_avoidance;
 
-				for (auto& startle : movement_path.startle) {
-					/* 
-						Decrease startle vectors when nearing the bounds,
-						to avoid a glitch where fish is conflicted about where to go.
-					*/
+			for (auto& startle : movement_path.startle) {
+				/* 
+					Decrease startle vectors when nearing the bounds,
+					to avoid a glitch where fish is conflicted about where to go.
+				*/
 
-					if (startle + bound_avoidance * 6 < startle) {
-						startle += bound_avoidance * 6;
-					}
+				if (startle + bound_avoidance * 6 < startle) {
+					startle += bound_avoidance * 6;
 				}
+			}
 
-				movement_path.last_speed = total_speed;
+			movement_path.last_speed = total_speed;
+
+			{
+				const auto speed_mult = total_speed / max_speed;
+				const auto elapsed_anim_ms = delta.in_milliseconds() * speed_mult;
 
 				{
-					const auto speed_mult = total_speed / max_speed;
-					const auto elapsed_anim_ms = delta.in_milliseconds() * speed_mult;
+					const auto& bubble_effect = def.bubble_effect;
+
+					if (bubble_effect.id.is_set()) {
+						/* Resolve bubbles and bubble intervals */
 
-					{
-						const auto& bubble_effect = def.bubble_effect;
+						auto& next_in_ms = movement_path.next_bubble_in_ms;
+						
+						auto choose_new_interval = [&]() {
+							/* 
+								Not the step_rng - its sequence must not depend on whether organisms are simulated,
+								nor on the order in which the threads get to them.
+							*/
 
-						if (bubble_effect.id.is_set()) {
-							/* Resolve bubbles and bubble intervals */
+							auto rng = cosm.get_rng_for(subject);
 
-							auto& next_in_ms = movement_path.next_bubble_in_ms;
-							
-							auto choose_new_interval = [&step_rng, &next_in_ms, &def]() {
-								const auto interval = def.base_bubble_interval_ms;
-								const auto h = interval / 1.5f;
+							const auto interval = def.base_bubble_interval_ms;
+							const auto h = interval / 1.5f;
 
-								next_in_ms = step_rng.randval(interval - h, interval + h);
-							};
+							next_in_ms = rng.randval(interval - h, interval + h);
+						};
+
+						if (next_in_ms < 0.f) {
+							choose_new_interval();
+						}
+						else {
+							next_in_ms -= elapsed_anim_ms;
 
 							if (next_in_ms < 0.f) {
-								choose_new_interval();
-							}
-							else {
-								next_in_ms -= elapsed_anim_ms;
-
-								if (next_in_ms < 0.f) {
-									bubble_effect.start(
-										step,
-										particle_effect_start_input::orbit_local(subject, transformr(vec2(subject.get_logical_size().x / 3, 0), 0)),
-										always_predictable_v
-									);
-								}
+								result.start_bubble = true;
 							}
 						}
 					}
-
-
-					auto& anim_state = subject.template get<components::animation>().state;
-					anim_state.frame_elapsed_ms += elapsed_anim_ms;
 				}
 
-				{
-					auto& mut_transform = subject.template get<components::transform>();
-					mut_transform.rotation = velocity.degrees();//augs::interp(transform.rotation, velocity.degrees(), 50.f * delta.in_seconds());
+				auto& anim_state = subject.template get<components::animation>().state;
+				anim_state.frame_elapsed_ms += elapsed_anim_ms;
+			}
 
-					const auto old_position = transform.pos;
-					const auto new_position = old_position + velocity * delta.in_seconds();
+			{
+				auto& mut_transform = subject.template get<components::transform>();
+				mut_transform.rotation = velocity.degrees();//augs::interp(transform.rotation, velocity.degrees(), 50.f * delta.in_seconds());
 
-					grids.recalculate_cell_for(origin, subject.get_id(), old_position, new_position);
+				const auto old_position = transform.pos;
+				const auto new_position = old_position + velocity * delta.in_seconds();
 
-					mut_transform.pos = new_position;
-				}
+				result.moved = true;
+				result.old_position = old_position;
+				result.new_position = new_position;
+
+				mut_transform.pos = new_position;
 			}
 		}
+	};
+
+	if (const auto pool = step.get_settings().organism_pool) {
+		cosm.for_each_having_parallel<components::movement_path>(*pool, organisms_grain_v, advance_organism);
+	}
+	else {
+		std::size_t result_index = 0;
+
+		cosm.for_each_having<components::movement_path>([&](const auto& subject) {
+			advance_organism(subject, result_index++);
+		});
+	}
+
+	std::size_t result_index = 0;
+
+	cosm.for_each_having<components::movement_path>([&](const auto& subject) {
+		const auto& result = results[result_index++];
+
+		if (result.moved) {
+			const auto& movement_path = subject.template get<components::movement_path>();
+			grids.recalculate_cell_for(movement_path.origin, subject.get_id(), result.old_position, result.new_position);
+		}
+
+		if (result.start_bubble) {
+			const auto& def = subject.template get<invariants::movement_path>().organism_wandering.value;
+
+			def.bubble_effect.start(
+				step,
+				particle_effect_start_input::orbit_local(subject, transformr(vec2(subject.get_logical_size().x / 3, 0), 0)),
+				always_predictable_v
+			);
+		}
+	});
+}
+
+void movement_path_system::recalculate_cell_for(
+	cosmos& cosm,
+	const organism_id_type organism_id,
+	const vec2 old_position,
+	const vec2 new_position
+) const {
+	const auto organism = cosm[organism_id];
+
+	if (organism.dead()) {
+		return;
+	}
+
+	const auto& movement_path = organism.get<components::movement_path>();
+
+	cosm.get_solvable_inferred({}).organisms.recalculate_cell_for(movement_path.origin, organism_id, old_position, new_position);
+}
+
+#if BUILD_UNIT_TESTS && BUILD_TEST_SCENES
+#include <Catch/single_include/catch2/catch.hpp>
+
+#include "augs/log.h"
+#include "augs/misc/timing/timer.h"
+#include "augs/misc/lua/lua_utils.h"
+#include "augs/templates/thread_pool.h"
+#include "game/cosmos/solvers/standard_solver.h"
+#include "game/modes/test_mode.h"
+#include "test_scenes/test_scene_settings.h"
+#include "application/intercosm.h"
+
+static void make_aquarium_scene(intercosm& scene) {
+	auto lua = augs::create_lua_state();
+	test_mode_ruleset ruleset;
+
+	/* The testbed has the aquariums. */
+	scene.make_test_scene(lua, test_scene_settings(), ruleset, nullptr);
+}
+
+static void advance_organisms(cosmos& cosm, const int steps, const solve_settings settings) {
+	for (int i = 0; i < steps; ++i) {
+		standard_solver()({ cosm, {}, settings }, solver_callbacks());
+	}
+}
+
+TEST_CASE("MovementPathSystem ParallelSameAsSequential") {
+	intercosm scene;
+	make_aquarium_scene(scene);
+
+	std::size_t num_organisms = 0;
+	scene.world.for_each_having<components::movement_path>([&](const auto&) { ++num_organisms; });
+
+	REQUIRE(num_organisms > 0);
+
+	augs::thread_pool pool(3);
+
+	auto sequential = std::make_unique<cosmos>(scene.world);
+	auto parallel = std::make_unique<cosmos>(scene.world);
+
+	solve_settings parallel_settings;
+	parallel_settings.organism_pool = &pool;
+
+	const auto num_steps = 300;
+
+	advance_organisms(*sequential, num_steps, solve_settings());
+	advance_organisms(*parallel, num_steps, parallel_settings);
+
+	REQUIRE(sequential->calculate_solvable_signi_hash<uint32_t>() == parallel->calculate_solvable_signi_hash<uint32_t>());
+
+	sequential->for_each_having<components::movement_path>([&](const auto& typed_organism) {
+		const auto other = (*parallel)[typed_organism.get_id()];
+
+		REQUIRE(other.alive());
+		REQUIRE(typed_organism.template get<components::transform>() == other.template get<components::transform>());
+	});
+}
+
+TEST_CASE("MovementPathSystem RepredictionCost") {
+	intercosm scene;
+	make_aquarium_scene(scene);
+
+	/* 
+		Reconciliation re-simulates this many steps on every correction
+		at a typical ping, which is what advancing organisms used to add to. 
+	*/
+
+	const auto num_repredicted = 20;
+	const auto num_repredictions = 50;
+
+	auto measure = [&](const bool simulate_organisms) {
+		solve_settings settings;
+		settings.simulate_decorative_organisms = simulate_organisms;
+
+		auto repredicted = std::make_unique<cosmos>(scene.world);
+
+		augs::timer t;
+
+		for (int i = 0; i < num_repredictions; ++i) {
+			repredicted->assign_solvable(scene.world);
+			advance_organisms(*repredicted, num_repredicted, settings);
+		}
+
+		return t.get<std::chrono::microseconds>() / num_repredictions;
+	};
+
+	const auto with_organisms = measure(true);
+	const auto without_organisms = measure(false);
+
+	LOG(
+		"Repredicting %x steps of the testbed: %x us with organisms, %x us without.",
+		num_repredicted,
+		with_organisms,
+		without_organisms
 	);
+
+	REQUIRE(with_organisms > 0.0);
+	REQUIRE(without_organisms > 0.0);
 }
+#endif
@@ -1,7 +1,19 @@
 #pragma once
+#include "augs/math/vec2.h"
 #include "game/cosmos/step_declaration.h"
+#include "game/inferred_caches/organism_cache.h"
+
+class cosmos;
 
 class movement_path_system {
 public:
 	void advance_paths(const logic_step) const;
+
+	/* For when an organism was moved by anything other than advance_paths. */
+	void recalculate_cell_for(
+		cosmos&,
+		organism_cache::organism_id_type,
+		vec2 old_position,
+		vec2 new_position
+	) const;
 };
\ No newline at end of file
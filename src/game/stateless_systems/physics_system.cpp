@@ -7,6 +7,7 @@
 #include "game/cosmos/for_each_entity.h"
 
 #include "game/stateless_systems/physics_system.h"
+#include "game/stateless_systems/missile_system.h"
 
 #define OVER_BODIES 0
 
@@ -37,10 +38,20 @@ void physics_system::step_and_set_new_transforms(const logic_step step) {
 			velocityIterations,
 			positionIterations
 		);
+	}
+
+	{
+		/*
+			Missiles have no fixtures, so they must be swept before the readback
+			which copies their corrected positions and velocities into the components.
+		*/
 
-		post_and_clear_accumulated_collision_messages(step);
+		auto scope = measure_scope(performance.missile_sweeps);
+		missile_system().sweep_missiles_through_world(step);
 	}
 
+	post_and_clear_accumulated_collision_messages(step);
+
 	auto scope = measure_scope(performance.physics_readback);
 
 #if OVER_BODIES
@@ -592,23 +592,25 @@ void visibility_system::calc_visibility(
 		all_ray_inputs.push_back(new_ray_input);
 	}
 
+	thread_local std::vector<physics_raycast_input> all_batched_rays;
 	thread_local std::vector<ray_output> all_ray_outputs;
 
-	all_ray_outputs.clear();
-	all_ray_outputs.reserve(all_vertices_transformed.size());
+	all_batched_rays.clear();
+	all_batched_rays.reserve(all_ray_inputs.size());
 
-	/* All raycast inputs are processed at once to improve cache coherency. */
-	for (std::size_t j = 0; j < all_ray_inputs.size(); ++j) {
-		auto result = physics.ray_cast(eye_meters, all_ray_inputs[j].destination, request.filter, ignored_entity);
-		all_ray_outputs.emplace_back(std::move(result));
+	for (const auto& r : all_ray_inputs) {
+		all_batched_rays.push_back({ eye_meters, r.destination });
 
 #if LOG_VISIBILITY
 		if (DEBUG_DRAWING.draw_cast_rays) {
-			draw_line(all_ray_inputs[j].destination, pink);
+			draw_line(r.destination, pink);
 		}
 #endif
 	}
 
+	/* All rays share the eye, so they are cast in a single traversal of the tree. */
+	physics.ray_cast_batch(all_batched_rays, all_ray_outputs, request.filter, ignored_entity);
+
 	for (std::size_t i = 0; i < all_ray_outputs.size(); ++i) {
 		const auto& ray_callback = all_ray_outputs[i];
 		auto& vertex = all_vertices_transformed[i];
@@ -7,6 +7,9 @@ struct audiovisual_profiler : public augs::profiler_mixin<audiovisual_profiler>
 	// GEN INTROSPECTOR struct audiovisual_profiler
 	augs::time_measurements advance;
 	augs::time_measurements interpolation;
+	augs::time_measurements desired_transforms;
+	augs::time_measurements integrate_interpolation;
+	augs::time_measurements particle_caches;
 	augs::time_measurements integrate_particles;
 	augs::time_measurements advance_particle_streams;
 	augs::time_measurements wandering_pixels;
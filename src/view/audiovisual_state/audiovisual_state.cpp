@@ -45,6 +45,8 @@ void audiovisual_state::clear() {
 	systems.for_each([](auto& sys) {
 		sys.clear();
 	});
+
+	static_geometry.clear();
 }
 
 void audiovisual_state::reserve_caches_for_entities(const std::size_t n) {
@@ -148,8 +150,21 @@ void audiovisual_state::advance(const audiovisual_advance_input input) {
 		);
 	};
 
+	auto update_particle_caches = [&]() {
+		auto scope = measure_scope(performance.particle_caches);
+
+		particles.update_component_related_caches(
+			rng,
+			input.performance.special_effects,
+			cosm,
+			input.particle_effects,
+			input.pool
+		);
+	};
+
 	auto synchronous_facade = [&]() {
 		advance_visible_particle_streams();
+		update_particle_caches();
 		advance_world_hover_highlighter();
 		advance_highlights();
 		advance_attenuation_variations();
@@ -21,6 +21,7 @@
 
 #include "view/audiovisual_state/all_audiovisual_systems.h"
 #include "view/audiovisual_state/systems/randomizing_system.h"
+#include "view/rendering_scripts/static_geometry_cache.h"
 #include "view/audiovisual_state/audiovisual_post_solve_settings.h"
 #include "view/audiovisual_state/particle_triangle_buffers.h"
 #include "application/performance_settings.h"
@@ -84,6 +85,7 @@ struct audiovisual_state {
 	audiovisual_profiler performance;
 
 	mutable randomizing_system randomizing;
+	mutable static_geometry_cache static_geometry;
 	
 	template <class T>
 	auto& get() {
@@ -4,6 +4,10 @@
 #include "game/cosmos/cosmos.h"
 #include "game/cosmos/entity_handle.h"
 #include "game/cosmos/for_each_entity.h"
+#include "game/cosmos/for_each_entity_parallel.h"
+
+/* Every entity only writes to its own interpolation component. */
+static constexpr std::size_t interpolation_grain_v = 512;
 
 void interpolation_system::set_interpolation_enabled(const bool flag) {
 	enabled = flag;
@@ -20,8 +24,10 @@ void snap_interpolated_to_logical(cosmos& cosm) {
 	);
 }
 
-void interpolation_system::update_desired_transforms(const cosmos& cosm) {
-	cosm.for_each_having<invariants::interpolation>( 
+void interpolation_system::update_desired_transforms(const cosmos& cosm, augs::thread_pool& pool) {
+	cosm.for_each_having_parallel<invariants::interpolation>(
+		pool,
+		interpolation_grain_v,
 		[&](const auto& e) {
 			if (const auto current = e.find_logic_transform()) {
 				const auto& info = get_corresponding<components::interpolation>(e);
@@ -36,7 +42,8 @@ void interpolation_system::integrate_interpolated_transforms(
 	const cosmos& cosm,
 	const augs::delta delta,
 	const augs::delta fixed_delta_for_slowdowns,
-	const double speed_multiplier
+	const double speed_multiplier,
+	augs::thread_pool& pool
 ) {
 	set_interpolation_enabled(settings.enabled);
 
@@ -55,7 +62,9 @@ void interpolation_system::integrate_interpolated_transforms(
 	const auto speed = static_cast<float>(speed_multiplier);
 	const float slowdown_multipliers_decrease = seconds / fixed_delta_for_slowdowns.in_seconds();
 
-	cosm.for_each_having<invariants::interpolation>( 
+	cosm.for_each_having_parallel<invariants::interpolation>(
+		pool,
+		interpolation_grain_v,
 		[&](const auto& e) {
 			const auto& info = get_corresponding<components::interpolation>(e);
 			//const auto& def = e.template get<invariants::interpolation>();
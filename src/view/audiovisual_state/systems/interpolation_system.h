@@ -13,6 +13,10 @@
 
 struct interpolation_settings;
 
+namespace augs {
+	class thread_pool;
+}
+
 class interpolation_system {
 	bool enabled = true;
 	void set_interpolation_enabled(const bool);
@@ -25,10 +29,11 @@ public:
 		const cosmos&,
 		const augs::delta delta, 
 		const augs::delta fixed_delta_for_slowdowns,
-		const double speed_multiplier
+		const double speed_multiplier,
+		augs::thread_pool&
 	);
 
-	void update_desired_transforms(const cosmos&);
+	void update_desired_transforms(const cosmos&, augs::thread_pool&);
 
 	template <class E>
 	transformr get_interpolated(const E& handle) const {
@@ -7,6 +7,7 @@
 #include "game/cosmos/entity_handle.h"
 #include "game/cosmos/data_living_one_step.h"
 #include "game/cosmos/for_each_entity.h"
+#include "game/cosmos/for_each_entity_parallel.h"
 
 #include "game/components/interpolation_component.h"
 #include "game/components/fixtures_component.h"
@@ -495,6 +496,9 @@ void particles_simulation_system::integrate_and_draw_all_particles(const integra
 	}
 }
 
+/* Mostly the slot and the physical connection queries. */
+static constexpr std::size_t particle_cache_grain_v = 256;
+
 template <class Component, class Caches, class EffectProvider>
 void update_component_related_cache(
 	randomization& rng,
@@ -502,11 +506,30 @@ void update_component_related_cache(
 	const cosmos& cosm,
 	Caches& caches,
 	EffectProvider effect_provider,
-	const special_effects_settings& settings
+	const special_effects_settings& settings,
+	augs::thread_pool& pool
 ) {
-	cosm.for_each_having<Component>(
-		[&](const auto& typed_handle) {
-			const auto id = typed_handle.get_id().to_unversioned();
+	/*
+		The effects are calculated in parallel, but applied to the caches sequentially
+		in the order of the entities, so that the new streams draw from rng in the same order as before.
+	*/
+
+	struct calculated_effect {
+		unversioned_entity_id id;
+		std::optional<packaged_particle_effect> effect;
+	};
+
+	thread_local std::vector<calculated_effect> calculated;
+	calculated.resize(cosm.count_having<Component>());
+
+	cosm.for_each_having_parallel<Component>(
+		pool,
+		particle_cache_grain_v,
+		[&](const auto& typed_handle, const std::size_t i) {
+			auto& result = calculated[i];
+
+			result.id = typed_handle.get_id().to_unversioned();
+			result.effect = std::nullopt;
 
 			if (const auto item = typed_handle.template find<components::item>()) {
 				if (const auto slot = typed_handle.get_current_slot(); slot.alive()) {
@@ -516,35 +539,39 @@ void update_component_related_cache(
 					*/
 
 					if (!slot.is_hand_slot()) {
-						caches.erase(id);
 						return;
 					}
 
 					if (typed_handle.find_colliders_connection() == nullptr) {
-						caches.erase(id);
 						return;
 					}
 				}
 			}
 
-			if (const auto particles = effect_provider(typed_handle)) {
-				if (auto* const existing = mapped_or_nullptr(caches, id)) {
-					existing->cache.original = *particles;
-				}
-				else {
-					try {
-						caches.try_emplace(id, particles_simulation_system::continuous_particles_cache { { particles->start.positioning, *particles, manager, rng, settings }, { typed_handle.get_name() } });
-					}
-					catch (const particles_simulation_system::effect_not_found&) {
+			result.effect = effect_provider(typed_handle);
+		}
+	);
 
-					}
-				}
+	for (const auto& result : calculated) {
+		const auto id = result.id;
+
+		if (const auto& particles = result.effect) {
+			if (auto* const existing = mapped_or_nullptr(caches, id)) {
+				existing->cache.original = *particles;
 			}
 			else {
-				caches.erase(id);
+				try {
+					caches.try_emplace(id, particles_simulation_system::continuous_particles_cache { { particles->start.positioning, *particles, manager, rng, settings }, { cosm[id].get_name() } });
+				}
+				catch (const particles_simulation_system::effect_not_found&) {
+
+				}
 			}
 		}
-	);
+		else {
+			caches.erase(id);
+		}
+	}
 
 	erase_if(caches, [&](auto& it) {
 		return cosm[it.first].dead();
@@ -778,7 +805,15 @@ void particles_simulation_system::advance_visible_streams(
 			return false;
 		});
 	}
+}
 
+void particles_simulation_system::update_component_related_caches(
+	randomization& rng,
+	const special_effects_settings& settings,
+	const cosmos& cosm,
+	const particle_effects_map& manager,
+	augs::thread_pool& pool
+) {
 	update_component_related_cache<components::gun>(
 		rng,
 		manager,
@@ -787,7 +822,8 @@ void particles_simulation_system::advance_visible_streams(
 		[](const auto h) {
 			return ::calc_firearm_engine_particles(h);
 		},
-		settings
+		settings,
+		pool
 	);
 
 	update_component_related_cache<components::continuous_particles>(
@@ -811,6 +847,7 @@ void particles_simulation_system::advance_visible_streams(
 
 			return std::make_optional(particles);
 		},
-		settings
+		settings,
+		pool
 	);
 }
@@ -258,6 +258,14 @@ public:
 		const interpolation_system&
 	);
 
+	void update_component_related_caches(
+		randomization& rng,
+		const special_effects_settings&,
+		const cosmos&,
+		const particle_effects_map&,
+		augs::thread_pool&
+	);
+
 	void update_effects_from_messages(
 		randomization& rng,
 		const_logic_step step,
@@ -30,6 +30,17 @@ struct frame_profiler : public augs::profiler_mixin<frame_profiler> {
 	augs::amount_measurements<std::size_t> num_drawn_lights = 1;
 	augs::amount_measurements<std::size_t> num_drawn_wall_lights = 1;
 	augs::amount_measurements<std::size_t> num_visible_entities = 1;
+
+	augs::amount_measurements<std::size_t> text_layout_hits = 1;
+	augs::amount_measurements<std::size_t> text_layout_misses = 1;
+	augs::amount_measurements<double> text_layout_hit_percent = 1;
+	augs::time_measurements text_layout_drafting;
+	augs::time_measurements text_layout_saved;
+
+	augs::amount_measurements<std::size_t> static_geometry_hits = 1;
+	augs::amount_measurements<std::size_t> static_geometry_rebuilds = 1;
+	augs::amount_measurements<std::size_t> static_geometry_triangles = 1;
+	augs::amount_measurements<std::size_t> static_geometry_cached_entities = 1;
 	// END GEN INTROSPECTOR
 };
 
@@ -53,6 +53,17 @@ void enqueue_illuminated_rendering_jobs(
 
 	auto& dedicated = in.renderer.dedicated;
 
+	{
+		/* No job of the previous frame is running anymore. */
+		const auto static_geometry = av.static_geometry.next_frame();
+		auto& profiler = in.frame_performance;
+
+		profiler.static_geometry_hits.measure(static_geometry.hits);
+		profiler.static_geometry_rebuilds.measure(static_geometry.rebuilds);
+		profiler.static_geometry_triangles.measure(static_geometry.copied_triangles);
+		profiler.static_geometry_cached_entities.measure(static_geometry.cached_entities);
+	}
+
 	const auto global_time_seconds = cosm.get_total_seconds_passed(in.interpolation_ratio);
 
 	auto get_drawer_for = [&](const D d) {
@@ -301,7 +312,8 @@ void enqueue_illuminated_rendering_jobs(
 			return helper_drawer {
 				visible,
 				cosm,
-				make_drawing_input(d)
+				make_drawing_input(d),
+				std::addressof(av.static_geometry.for_buffer(d))
 			};
 		};
 
@@ -1,5 +1,6 @@
 #pragma once
 #include "view/rendering_scripts/draw_entity.h"
+#include "view/rendering_scripts/static_geometry_cache.hpp"
 #include "game/cosmos/cosmos.h"
 #include "game/detail/visible_entities.h"
 #include "game/detail/visible_entities.hpp"
@@ -8,6 +9,7 @@ struct helper_drawer {
 	const visible_entities& visible;
 	const cosmos& cosm;
 	const draw_renderable_input in;
+	static_geometry_buffer_cache* const static_geometry = nullptr;
 
 	template <special_render_function... r>
 	void draw() const {
@@ -18,8 +20,22 @@ struct helper_drawer {
 
 	template <render_layer... r>
 	void draw() const {
+		if (static_geometry == nullptr) {
+			visible.for_each<r...>(cosm, [&](const auto& handle) {
+				::draw_entity(handle, in);
+			});
+
+			return;
+		}
+
+		auto& cache = *static_geometry;
+
 		visible.for_each<r...>(cosm, [&](const auto& handle) {
-			::draw_entity(handle, in);
+			handle.template conditional_dispatch<entities_with_renderables>([&](const auto typed_handle) {
+				if (!::draw_cached_static_geometry(typed_handle, in, cache)) {
+					::specific_draw_entity(typed_handle, in);
+				}
+			});
 		});
 	}
 
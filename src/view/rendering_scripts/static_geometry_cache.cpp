@@ -0,0 +1,42 @@
+#include "view/rendering_scripts/static_geometry_cache.h"
+
+static constexpr uint32_t unused_frames_before_eviction_v = 120;
+
+static_geometry_cache::stats static_geometry_cache::next_frame() {
+	stats result;
+
+	++current_frame;
+
+	for (auto& b : per_buffer) {
+		result.hits += b.hits;
+		result.rebuilds += b.rebuilds;
+		result.copied_triangles += b.copied_triangles;
+
+		b.hits = 0;
+		b.rebuilds = 0;
+		b.copied_triangles = 0;
+
+		b.current_frame = current_frame;
+
+		/* Decorations out of view for long enough, or deleted in the editor. */
+
+		for (auto it = b.entities.begin(); it != b.entities.end();) {
+			if (current_frame - it->second.last_used_frame > unused_frames_before_eviction_v) {
+				it = b.entities.erase(it);
+			}
+			else {
+				++it;
+			}
+		}
+
+		result.cached_entities += b.entities.size();
+	}
+
+	return result;
+}
+
+void static_geometry_cache::clear() {
+	for (auto& b : per_buffer) {
+		b.entities.clear();
+	}
+}
@@ -0,0 +1,98 @@
+#pragma once
+#include <vector>
+#include <unordered_map>
+
+#include "augs/graphics/vertex.h"
+#include "augs/graphics/dedicated_buffers.h"
+#include "augs/misc/enum/enum_array.h"
+#include "augs/texture_atlas/atlas_entry.h"
+#include "augs/math/transform.h"
+#include "augs/math/rects.h"
+#include "game/cosmos/entity_id.h"
+#include "game/components/sprite_component.h"
+
+/*
+	Static decorations never change in game (see never_changes_in_game),
+	yet their vertices used to be generated anew every frame.
+
+	This cache keeps the triangles of every static decoration drawn into a dedicated buffer,
+	so that drawing one only copies its triangles.
+	Big tiled sprites (floors) are split into strips of tiles, and only the strips that intersect the camera are copied.
+
+	The entities are still visited in the order of visible_entities.
+	A per-area cache of vertices would have to break the sorting order
+	between static decorations and whatever else shares their layer.
+
+	Whatever the triangles were generated from is kept alongside them,
+	so an entry is rebuilt as soon as the editor moves, resizes or retextures the decoration,
+	or the atlas is regenerated.
+*/
+
+struct static_geometry_key {
+	entity_id id;
+	transformr transform;
+	invariants::sprite sprite;
+	rgba colorize;
+	flip_flags flip;
+	augs::atlas_entry diffuse;
+
+	bool operator==(const static_geometry_key& b) const {
+		return
+			id == b.id
+			&& transform == b.transform
+			&& sprite == b.sprite
+			&& colorize == b.colorize
+			&& flip.horizontally == b.flip.horizontally
+			&& flip.vertically == b.flip.vertically
+			&& diffuse.atlas_space == b.diffuse.atlas_space
+			&& diffuse.was_flipped == b.diffuse.was_flipped
+			&& diffuse.cached_original_size_pixels == b.diffuse.cached_original_size_pixels
+		;
+	}
+};
+
+struct static_geometry_strip {
+	ltrb aabb;
+	uint32_t first = 0;
+	uint32_t count = 0;
+};
+
+struct cached_static_geometry {
+	static_geometry_key key;
+	augs::vertex_triangle_buffer triangles;
+	std::vector<static_geometry_strip> strips;
+	uint32_t last_used_frame = 0;
+};
+
+/* Only ever touched by the single job that fills the corresponding dedicated buffer. */
+
+struct static_geometry_buffer_cache {
+	std::unordered_map<unversioned_entity_id, cached_static_geometry> entities;
+	uint32_t current_frame = 0;
+
+	std::size_t hits = 0;
+	std::size_t rebuilds = 0;
+	std::size_t copied_triangles = 0;
+};
+
+class static_geometry_cache {
+	augs::enum_array<static_geometry_buffer_cache, augs::dedicated_buffer> per_buffer;
+	uint32_t current_frame = 0;
+
+public:
+	struct stats {
+		std::size_t hits = 0;
+		std::size_t rebuilds = 0;
+		std::size_t copied_triangles = 0;
+		std::size_t cached_entities = 0;
+	};
+
+	/* Call when no rendering job runs. Returns the counts of the previous frame and evicts entries unused for a while. */
+	stats next_frame();
+
+	auto& for_buffer(const augs::dedicated_buffer d) {
+		return per_buffer[d];
+	}
+
+	void clear();
+};
@@ -0,0 +1,149 @@
+#pragma once
+#include <algorithm>
+#include "view/rendering_scripts/static_geometry_cache.h"
+#include "view/rendering_scripts/draw_entity.h"
+
+/* Tiles of one sprite copied or skipped together. */
+constexpr uint32_t static_geometry_strip_triangles_v = 64;
+
+/* Beyond this, caching every tile of a floor costs more than walking the visible ones each frame. */
+constexpr uint32_t max_cached_static_geometry_triangles_v = 1 << 15;
+
+template <class E>
+bool draw_cached_static_geometry(
+	const cref_typed_entity_handle<E> typed_handle,
+	const draw_renderable_input& in,
+	static_geometry_buffer_cache& cache
+) {
+	if constexpr(!std::is_same_v<E, static_decoration>) {
+		(void)typed_handle;
+		(void)in;
+		(void)cache;
+
+		return false;
+	}
+	else {
+		auto sprite = typed_handle.template get<invariants::sprite>();
+
+		/* These depend on time or randomness, so they are regenerated every frame. */
+
+		if (sprite.effect != augs::sprite_special_effect::NONE) {
+			return false;
+		}
+
+		if (sprite.neon_intensity_vibration.is_enabled && sprite.vibrate_diffuse_as_well) {
+			return false;
+		}
+
+		{
+			const auto& s = typed_handle.template get<components::overridden_geo>().get();
+
+			if (s.is_enabled) {
+				sprite.size = s.value;
+			}
+		}
+
+		const auto id = typed_handle.get_id();
+
+		static_geometry_key key;
+		key.id = id;
+		key.transform = typed_handle.get_logic_transform();
+		key.sprite = sprite;
+		key.colorize = typed_handle.template get<components::sprite>().colorize;
+		key.flip = typed_handle.calc_flip_flags().value_or(flip_flags());
+		key.diffuse = in.manager.at(sprite.image_id).diffuse;
+
+		auto& entry = cache.entities[id.to_unversioned()];
+
+		const bool up_to_date = !entry.strips.empty() && entry.key == key;
+
+		if (!up_to_date) {
+			const auto aabb = typed_handle.find_aabb(key.transform);
+
+			if (!aabb) {
+				cache.entities.erase(id.to_unversioned());
+				return false;
+			}
+
+			{
+				const auto original_size = vec2(key.diffuse.get_original_size());
+				const auto tiles = vec2(sprite.size) / vec2(std::max(1.f, original_size.x), std::max(1.f, original_size.y));
+
+				if (sprite.tile_excess_size && tiles.x * tiles.y * 2 > max_cached_static_geometry_triangles_v) {
+					cache.entities.erase(id.to_unversioned());
+					return false;
+				}
+			}
+
+			++cache.rebuilds;
+
+			entry.key = key;
+			entry.triangles.clear();
+			entry.strips.clear();
+
+			/* A camera that sees the whole decoration, so that every tile of a tiled sprite is generated. */
+			const auto whole_cone = camera_cone(camera_eye(aabb->get_center(), 1.f), vec2i(aabb->get_size()) + vec2i(2, 2));
+
+			const auto whole_in = draw_renderable_input {
+				{
+					augs::drawer { entry.triangles },
+					in.manager,
+					in.global_time_seconds,
+					in.flip,
+					in.randomizing,
+					whole_cone
+				},
+				in.interp
+			};
+
+			::specific_draw_entity(typed_handle, whole_in);
+
+			const auto n = static_cast<uint32_t>(entry.triangles.size());
+
+			for (uint32_t first = 0; first < n; first += static_geometry_strip_triangles_v) {
+				static_geometry_strip strip;
+				strip.first = first;
+				strip.count = std::min(static_geometry_strip_triangles_v, n - first);
+
+				const auto first_pos = entry.triangles[first].vertices[0].pos;
+				auto& bounds = strip.aabb;
+				bounds = ltrb(first_pos.x, first_pos.y, first_pos.x, first_pos.y);
+
+				for (uint32_t t = first; t < first + strip.count; ++t) {
+					for (const auto& v : entry.triangles[t].vertices) {
+						bounds.l = std::min(bounds.l, v.pos.x);
+						bounds.t = std::min(bounds.t, v.pos.y);
+						bounds.r = std::max(bounds.r, v.pos.x);
+						bounds.b = std::max(bounds.b, v.pos.y);
+					}
+				}
+
+				entry.strips.push_back(strip);
+			}
+
+			if (entry.strips.empty()) {
+				/* Nothing visible, e.g. a missing image. Keep the entry so that it is not regenerated every frame. */
+				entry.strips.push_back({ ltrb(), 0, 0 });
+			}
+		}
+		else {
+			++cache.hits;
+		}
+
+		entry.last_used_frame = cache.current_frame;
+
+		const auto visible_aabb = in.cone.get_visible_world_rect_aabb();
+		auto& out = in.drawer.output_buffer;
+
+		for (const auto& strip : entry.strips) {
+			if (strip.count > 0 && strip.aabb.hover(visible_aabb)) {
+				const auto first = entry.triangles.begin() + strip.first;
+				out.insert(out.end(), first, first + strip.count);
+
+				cache.copied_triangles += strip.count;
+			}
+		}
+
+		return true;
+	}
+}
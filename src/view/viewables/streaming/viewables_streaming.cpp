@@ -12,6 +12,7 @@
 #include "augs/misc/imgui/imgui_control_wrappers.h"
 #include "augs/misc/imgui/imgui_scope_wrappers.h"
 #include "augs/filesystem/file.h"
+#include "augs/gui/text/layout_cache.h"
 
 void viewables_streaming::request_rescan() {
 	if (!general_atlas.empty()) {
@@ -341,6 +342,9 @@ void viewables_streaming::finalize_load(viewables_finalize_input in) {
 		necessary_images_in_atlas = std::move(result.necessary_atlas_entries);
 		loaded_gui_fonts = std::move(result.gui_fonts);
 
+		/* Cached layouts point to the glyphs of the previous atlas. */
+		augs::gui::text::clear_layout_cache();
+
 		now_loaded_gui_font_defs = future_gui_fonts;
 
 		auto& now_loaded_defs = now_all_defs.image_definitions;
@@ -2,6 +2,7 @@
 #include <csignal>
 #endif
 
+#include <exception>
 #include <functional>
 
 #include "fp_consistency_tests.h"
@@ -63,7 +64,11 @@
 #include "application/masterserver/masterserver.h"
 
 #include "application/network/network_common.h"
+#include "application/network/net_bandwidth_benchmark.h"
+#include "application/network/client_swarm.h"
+#include "augs/network/udp_batch.h"
 #include "application/setups/all_setups.h"
+#include "application/setups/server/arena_host.h"
 
 #include "application/setups/editor/editor_paths.h"
 
@@ -92,6 +97,8 @@
 #include "augs/readwrite/byte_readwrite.h"
 #include "view/game_gui/special_indicator_logic.h"
 #include "augs/window_framework/create_process.h"
+#include "augs/misc/profiling.h"
+#include "augs/gui/text/layout_cache.h"
 #include "augs/misc/imgui/simple_popup.h"
 #include "application/main/game_frame_buffer.h"
 #include "application/main/cached_visibility_data.h"
@@ -100,9 +107,13 @@
 #include "view/rendering_scripts/for_each_vis_request.h"
 #include "view/hud_messages/hud_messages_gui.h"
 #include "game/cosmos/for_each_entity.h"
+#include "game/detail/lag_compensation/hitbox_history.h"
+#include "game/inferred_caches/physics_world_cache.h"
 #include "application/setups/client/demo_paths.h"
 #include "application/nat/stun_server_provider.h"
 #include "application/arena/arena_paths.h"
+#include "augs/filesystem/content_store.h"
+#include "augs/misc/readable_bytesize.h"
 
 #include "application/setups/editor/editor_setup_for_each_highlight.hpp"
 
@@ -110,7 +121,6 @@
 #include "work_result.h"
 
 std::function<void()> ensure_handler;
-bool log_to_live_file = false;
 
 /*
 	static is used for all variables because some take massive amounts of space.
@@ -138,6 +148,16 @@ work_result work(const int argc, const char* const * const argv) try {
 	std::signal(SIGSTOP, signal_handler);
 #endif
 
+	/* 
+		So that the lines still in the ring reach the console and the live file.
+		Fatal signals are not hooked, as draining the ring is not async-signal-safe.
+	*/
+
+	std::set_terminate([]() {
+		program_log::get_current().flush_before_abort();
+		std::abort();
+	});
+
 	setup_float_flags();
 
 #if IS_PRODUCTION_BUILD
@@ -170,6 +190,9 @@ work_result work(const int argc, const char* const * const argv) try {
 		}
 	}
 
+	/* Before any thread loads content. */
+	augs::create_official_content_store(OFFICIAL_CONTENT_DIR);
+
 	static const auto canon_config_path = augs::path_type("default_config.lua");
 	static const auto local_config_path = augs::path_type(USER_FILES_DIR "/config.lua");
 
@@ -234,14 +257,22 @@ work_result work(const int argc, const char* const * const argv) try {
 	}();
 
 	if (config.log_to_live_file) {
-		augs::remove_file(get_path_in_log_files("live_debug.txt"));
+		const auto live_file_path = get_path_in_log_files("live_debug.txt");
 
-		log_to_live_file = true;
+		augs::remove_file(live_file_path);
+		program_log::get_current().open_live_file(live_file_path);
 
 		LOG("Live log was enabled due to a flag in config.");
 		LOG("Live log file created at %x", augs::date_time().get_readable());
 	}
 
+	/* From now on, logging threads only push into a queue. The writer batches the lines to the console and the live file. */
+	program_log::get_current().start_writer();
+
+	auto log_writer_stopper = augs::scope_guard([]() {
+		program_log::get_current().stop_writer();
+	});
+
 	LOG("Parsing command-line parameters.");
 
 	static const auto params = cmd_line_params(argc, argv);
@@ -285,6 +316,150 @@ work_result work(const int argc, const char* const * const argv) try {
 		LOG("Unit tests were disabled.");
 	}
 
+	if (!params.profile_trace_path.empty()) {
+		LOG("Tracing profiled scopes. The trace will be written to %x on exit.", params.profile_trace_path);
+
+		augs::profiling::enable_tracing();
+		augs::profiling::name_this_thread("Main thread");
+	}
+
+	auto trace_writer = augs::scope_guard([]() {
+		if (!params.profile_trace_path.empty()) {
+			if (augs::profiling::write_chrome_trace(params.profile_trace_path)) {
+				LOG("Wrote the trace of profiled scopes to %x", params.profile_trace_path);
+			}
+			else {
+				LOG("Failed to write the trace of profiled scopes to %x", params.profile_trace_path);
+			}
+		}
+	});
+
+	if (params.benchmark_log_threads > 0) {
+		const auto num_threads = static_cast<unsigned>(params.benchmark_log_threads);
+		const auto logs_per_thread = 200000u;
+
+		const auto per_second = benchmark_log_throughput(num_threads, logs_per_thread);
+
+		LOG("Logged %x lines from %x threads: %x lines per second.", num_threads * logs_per_thread, num_threads, static_cast<uint64_t>(per_second));
+		return work_result::SUCCESS;
+	}
+
+	if (params.benchmark_lag_compensation_players > 0) {
+		const auto num_players = static_cast<unsigned>(params.benchmark_lag_compensation_players);
+		const auto num_queries = 1000000u;
+
+		const auto secs_per_query = benchmark_rewound_ray_casts(num_players, num_queries);
+
+		LOG("Cast %x rays against the rewound hitboxes of %x players: %x ns per ray.", num_queries, std::min(num_players, static_cast<unsigned>(max_compensated_bodies_v)), secs_per_query * 1e9);
+		return work_result::SUCCESS;
+	}
+
+	if (params.benchmark_ray_casts_obstacles > 0) {
+		const auto num_obstacles = static_cast<unsigned>(params.benchmark_ray_casts_obstacles);
+		const auto result = benchmark_ray_casts(num_obstacles, 720);
+
+		LOG(
+			"Cast %x rays through %x obstacles. One by one: %x rays/s. Batched: %x rays/s. Mismatched outputs: %x.",
+			result.num_rays,
+			num_obstacles,
+			result.num_rays / result.single_secs,
+			result.num_rays / result.batched_secs,
+			result.num_mismatches
+		);
+
+		LOG(
+			"Inferred the world anew in %x ms. Cloned it in %x ms.",
+			result.reinference_secs * 1000 / result.num_reinferences,
+			result.clone_secs * 1000 / result.num_clones
+		);
+
+		return work_result::SUCCESS;
+	}
+
+	if (params.measure_content_memory_processes > 0) {
+		const auto max_processes = static_cast<unsigned>(params.measure_content_memory_processes);
+
+		for (const bool mapped : { true, false }) {
+			for (const auto num_processes : { 1u, max_processes }) {
+				const auto usages = augs::measure_content_memory(augs::path_type(OFFICIAL_CONTENT_DIR), num_processes, mapped);
+
+				if (usages.empty()) {
+					LOG("Could not measure content memory. Either it is not supported on this platform, or loading the content failed.");
+					return work_result::FAILURE;
+				}
+
+				std::size_t total_resident = 0;
+				std::size_t total_proportional = 0;
+
+				for (const auto& u : usages) {
+					total_resident += u.resident;
+					total_proportional += u.proportional;
+				}
+
+				LOG(
+					"Content %x in %x processes: %x resident per process, %x resident in total, %x proportional in total.",
+					mapped ? "mapped" : "copied",
+					usages.size(),
+					readable_bytesize(total_resident / usages.size()),
+					readable_bytesize(total_resident),
+					readable_bytesize(total_proportional)
+				);
+
+				if (num_processes == max_processes) {
+					break;
+				}
+			}
+		}
+
+		return work_result::SUCCESS;
+	}
+
+#if BUILD_NETWORKING
+	if (!params.measured_demo_bandwidth.empty()) {
+		measure_demo_bandwidth(params.measured_demo_bandwidth);
+		return work_result::SUCCESS;
+	}
+
+	if (params.client_swarm_size > 0) {
+		client_swarm_settings swarm;
+
+		if (!params.connect_address.empty()) {
+			swarm.server.address = params.connect_address;
+		}
+
+		swarm.num_clients = static_cast<unsigned>(params.client_swarm_size);
+		swarm.duration_secs = std::max(params.client_swarm_secs, 1);
+		swarm.tickrate = static_cast<unsigned>(std::max(params.client_swarm_tickrate, 1));
+		swarm.replayed_demo = params.client_swarm_demo;
+
+		run_client_swarm(swarm);
+		return work_result::SUCCESS;
+	}
+
+	if (params.benchmark_udp_sends_destinations > 0) {
+		const auto num_destinations = static_cast<unsigned>(params.benchmark_udp_sends_destinations);
+		const auto result = augs::benchmark_udp_batch(num_destinations, 2000);
+
+		LOG(
+			"Sent %x datagrams of %x bytes to %x sockets on the loopback, %x of them arrived.",
+			result.num_datagrams * 2,
+			result.datagram_bytes,
+			num_destinations,
+			result.num_received
+		);
+
+		LOG(
+			"One by one: %x datagrams/s in %x syscalls. Batched: %x datagrams/s in %x syscalls.",
+			result.num_datagrams / result.one_by_one_secs,
+			result.one_by_one_calls,
+			result.num_datagrams / result.batched_secs,
+			result.batched_calls
+		);
+
+		return work_result::SUCCESS;
+	}
+#endif
+
 	LOG("Initializing ImGui.");
 
 	static const auto imgui_ini_path = std::string(USER_FILES_DIR) + "/" + get_preffix_for(current_app_type) + "imgui.ini";
@@ -604,6 +779,28 @@ work_result work(const int argc, const char* const * const argv) try {
 
 		};
 
+#if BUILD_NETWORKING
+		if (config.arena_host.is_enabled()) {
+			const auto base_port = get_bound_local_port();
+			auxiliary_socket.reset();
+
+			auto start = config.default_server_start;
+			start.port = base_port;
+
+			arena_host host(config, start, make_server_nat_traversal_input());
+
+			while (host.is_running()) {
+				if (handle_sigint()) {
+					return work_result::SUCCESS;
+				}
+
+				host.advance(get_detected_nat());
+			}
+
+			return work_result::SUCCESS;
+		}
+#endif
+
 		if (config.server.allow_nat_traversal) {
 			if (nat_detection != std::nullopt) {
 				if (auxiliary_socket != std::nullopt) {
@@ -1877,19 +2074,26 @@ work_result work(const int argc, const char* const * const argv) try {
 		auto& interp = get_audiovisuals().get<interpolation_system>();
 
 		{
-			auto scope = measure_scope(get_audiovisuals().performance.interpolation);
+			auto& performance = get_audiovisuals().performance;
+			auto scope = measure_scope(performance.interpolation);
 
 			if (pending_new_state_sample) {
-				interp.update_desired_transforms(cosm);
+				auto scope = measure_scope(performance.desired_transforms);
+				interp.update_desired_transforms(cosm, thread_pool);
 			}
 
-			interp.integrate_interpolated_transforms(
-				viewing_config.interpolation, 
-				cosm, 
-				frame_delta, 
-				cosm.get_fixed_delta(),
-				speed_multiplier
-			);
+			{
+				auto scope = measure_scope(performance.integrate_interpolation);
+
+				interp.integrate_interpolated_transforms(
+					viewing_config.interpolation, 
+					cosm, 
+					frame_delta, 
+					cosm.get_fixed_delta(),
+					speed_multiplier,
+					thread_pool
+				);
+			}
 		}
 
 		gameplay_camera.tick(
@@ -2081,7 +2285,8 @@ work_result work(const int argc, const char* const * const argv) try {
 						network_performance,
 						network_stats,
 						get_audiovisuals().get<interpolation_system>(),
-						get_audiovisuals().get<past_infection_system>()
+						get_audiovisuals().get<past_infection_system>(),
+						thread_pool
 					},
 					callbacks
 				);
@@ -2248,6 +2453,8 @@ work_result work(const int argc, const char* const * const argv) try {
 	static debug_details_summaries debug_summaries;
 
 	static auto game_thread_worker = []() {
+		augs::profiling::name_this_thread("Game thread");
+
 		auto prepare_next_game_frame = [&]() {
 			auto frame = measure_scope(game_thread_performance.total);
 
@@ -3241,6 +3448,17 @@ work_result work(const int argc, const char* const * const argv) try {
 
 				game_thread_performance.num_triangles.measure(extract_num_total_drawn_triangles());
 
+				{
+					const auto text_layouts = augs::gui::text::layout_cache_next_frame();
+					const auto total_layouts = text_layouts.hits + text_layouts.misses;
+
+					game_thread_performance.text_layout_hits.measure(text_layouts.hits);
+					game_thread_performance.text_layout_misses.measure(text_layouts.misses);
+					game_thread_performance.text_layout_hit_percent.measure(total_layouts > 0 ? 100.0 * text_layouts.hits / total_layouts : 0.0);
+					game_thread_performance.text_layout_drafting.measure(text_layouts.drafting_secs);
+					game_thread_performance.text_layout_saved.measure(text_layouts.saved_secs);
+				}
+
 				buffer_swapper.wait_swap();
 
 				{